@@ -112,6 +112,85 @@ void benchmark_basic_math()
 #endif
 }
 
+void benchmark_gemm()
+{
+    xsimd::run_benchmark_gemm<float>("sgemm", std::cout, 10);
+    xsimd::run_benchmark_gemm<double>("dgemm", std::cout, 10);
+}
+
+void benchmark_fft()
+{
+    xsimd::run_benchmark_fft<float>("fft float", std::cout, 10);
+    xsimd::run_benchmark_fft<double>("fft double", std::cout, 10);
+}
+
+void benchmark_filter()
+{
+    xsimd::run_benchmark_filter<float>("fir float", std::cout, 10);
+    xsimd::run_benchmark_filter<int16_t>("fir int16", std::cout, 10);
+}
+
+void benchmark_image_filter()
+{
+    xsimd::run_benchmark_image_filter<uint8_t>("image filter uint8", std::cout, 10);
+    xsimd::run_benchmark_image_filter<float>("image filter float", std::cout, 10);
+}
+
+void benchmark_color()
+{
+    xsimd::run_benchmark_color("color conversion", std::cout, 10);
+}
+
+void benchmark_for_each()
+{
+    xsimd::run_benchmark_for_each("for_each_batch float", std::cout, 200);
+}
+
+void benchmark_quantize()
+{
+    xsimd::run_benchmark_quantize("quantization", std::cout, 20);
+}
+
+void benchmark_widen()
+{
+    xsimd::run_benchmark_widen("widen and narrow", std::cout, 200);
+}
+
+void benchmark_bitmap()
+{
+    xsimd::run_benchmark_bitmap("bitmap operations", std::cout, 200);
+}
+
+void benchmark_distance()
+{
+    xsimd::run_benchmark_distance("nearest neighbour search", std::cout, 100);
+}
+
+void benchmark_selection()
+{
+    xsimd::run_benchmark_selection("selection", std::cout, 100);
+}
+
+void benchmark_histogram()
+{
+    xsimd::run_benchmark_histogram("histograms", std::cout, 100);
+}
+
+void benchmark_search()
+{
+    xsimd::run_benchmark_search("sorted search", std::cout, 20);
+}
+
+void benchmark_lut()
+{
+    xsimd::run_benchmark_lut("lookup tables", std::cout, 100);
+}
+
+void benchmark_polynomial()
+{
+    xsimd::run_benchmark_polynomial("polynomials with runtime coefficients", std::cout, 100);
+}
+
 int main(int argc, char* argv[])
 {
     const std::map<std::string, std::pair<std::string, void (*)()>> fn_map = {
@@ -122,6 +201,21 @@ int main(int argc, char* argv[])
         { "power", { "power", benchmark_power } },
         { "basic_math", { "basic math", benchmark_basic_math } },
         { "rounding", { "rounding", benchmark_rounding } },
+        { "gemm", { "matrix multiplication", benchmark_gemm } },
+        { "fft", { "fast Fourier transform", benchmark_fft } },
+        { "filter", { "FIR filtering", benchmark_filter } },
+        { "image", { "image filtering", benchmark_image_filter } },
+        { "color", { "color conversion", benchmark_color } },
+        { "for_each", { "short array loops", benchmark_for_each } },
+        { "quantize", { "quantization", benchmark_quantize } },
+        { "widen", { "widening and narrowing", benchmark_widen } },
+        { "bitmap", { "bitmap operations", benchmark_bitmap } },
+        { "distance", { "nearest neighbour search", benchmark_distance } },
+        { "selection", { "argmin, argmax and top-k", benchmark_selection } },
+        { "histogram", { "bucketize and histograms", benchmark_histogram } },
+        { "search", { "batched binary search and B-tree index", benchmark_search } },
+        { "lut", { "interpolated lookup tables", benchmark_lut } },
+        { "polynomial", { "polynomials with runtime coefficients", benchmark_polynomial } },
 #ifdef XSIMD_POLY_BENCHMARKS
         { "utils", { "polynomial evaluation", benchmark_poly_evaluation } },
 #endif
@@ -12,11 +12,32 @@
 #ifndef XSIMD_BENCHMARK_HPP
 #define XSIMD_BENCHMARK_HPP
 
+#include "xsimd/algorithms/xsimd_bitmap.hpp"
+#include "xsimd/algorithms/xsimd_color.hpp"
+#include "xsimd/algorithms/xsimd_distance.hpp"
+#include "xsimd/algorithms/xsimd_fft.hpp"
+#include "xsimd/algorithms/xsimd_filter.hpp"
+#include "xsimd/algorithms/xsimd_for_each.hpp"
+#include "xsimd/algorithms/xsimd_gemm.hpp"
+#include "xsimd/algorithms/xsimd_histogram.hpp"
+#include "xsimd/algorithms/xsimd_image_filter.hpp"
+#include "xsimd/algorithms/xsimd_lut.hpp"
+#include "xsimd/algorithms/xsimd_polynomial.hpp"
+#include "xsimd/algorithms/xsimd_quantize.hpp"
+#include "xsimd/algorithms/xsimd_search.hpp"
+#include "xsimd/algorithms/xsimd_selection.hpp"
 #include "xsimd/arch/xsimd_scalar.hpp"
 #include "xsimd/xsimd.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace xsimd
@@ -425,6 +446,952 @@ namespace xsimd
         out << "============================" << std::endl;
     }
 
+    /*
+     * Peak floating point throughput of a core, in GFLOP/s, measured with
+     * enough independent FMA chains to hide the FMA latency.
+     */
+    template <class T>
+    double fma_peak_gflops(std::size_t iter)
+    {
+        using B = batch<T>;
+        constexpr std::size_t chains = 16;
+        constexpr std::size_t steps = 4096;
+        std::array<B, chains> acc;
+        for (std::size_t c = 0; c < chains; ++c)
+            acc[c] = B(T(c) / T(chains));
+        B const mul(T(0.999999)), add(T(1e-6));
+        duration_type t_res = duration_type::max();
+        for (std::size_t count = 0; count < iter; ++count)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t s = 0; s < steps; ++s)
+            {
+                for (std::size_t c = 0; c < chains; ++c)
+                    acc[c] = fma(acc[c], mul, add);
+            }
+            auto end = std::chrono::steady_clock::now();
+            auto tmp = end - start;
+            t_res = tmp < t_res ? tmp : t_res;
+        }
+        B sum(T(0));
+        for (std::size_t c = 0; c < chains; ++c)
+            sum += acc[c];
+        volatile T sink = reduce_add(sum);
+        (void)sink;
+        double const flops = 2. * chains * steps * B::size;
+        return flops / (t_res.count() * 1e6);
+    }
+
+    template <class T>
+    duration_type benchmark_gemm(std::size_t n, bench_vector<T> const& a, bench_vector<T> const& b, bench_vector<T>& c, std::size_t repeat, std::size_t iter)
+    {
+        duration_type t_res = duration_type::max();
+        for (std::size_t count = 0; count < iter; ++count)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t r = 0; r < repeat; ++r)
+                gemm(n, n, n, a.data(), b.data(), c.data());
+            auto end = std::chrono::steady_clock::now();
+            duration_type tmp = (end - start) / double(repeat);
+            t_res = tmp < t_res ? tmp : t_res;
+        }
+        return t_res;
+    }
+
+    template <std::size_t N, class T>
+    duration_type benchmark_matmul(bench_vector<T>& a, bench_vector<T> const& b, bench_vector<T>& c, std::size_t iter)
+    {
+        constexpr std::size_t repeat = 1000;
+        duration_type t_res = duration_type::max();
+        for (std::size_t count = 0; count < iter; ++count)
+        {
+            auto start = std::chrono::steady_clock::now();
+            // each product feeds the next one so that none is optimized away
+            for (std::size_t r = 0; r < repeat; r += 2)
+            {
+                matmul<N, N, N>(a.data(), b.data(), c.data());
+                matmul<N, N, N>(c.data(), b.data(), a.data());
+            }
+            auto end = std::chrono::steady_clock::now();
+            duration_type tmp = (end - start) / double(repeat);
+            t_res = tmp < t_res ? tmp : t_res;
+        }
+        return t_res;
+    }
+
+    template <class T, class OS>
+    void run_benchmark_gemm(std::string const& name, OS& out, std::size_t iter)
+    {
+        double const peak = fma_peak_gflops<T>(iter);
+        auto gflops = [](std::size_t n, duration_type t)
+        { return 2. * n * n * n / (t.count() * 1e6); };
+
+        out << "============================" << std::endl;
+        out << name << " (FMA peak " << std::fixed << std::setprecision(1) << peak << " GFLOP/s)" << std::endl;
+        for (std::size_t n : { 8, 16, 32, 64, 128, 256, 512 })
+        {
+            bench_vector<T> a(n * n), b(n * n), c(n * n);
+            for (std::size_t i = 0; i < n * n; ++i)
+            {
+                a[i] = T(0.5) + T(i % 7) / T(8);
+                b[i] = T(0.25) + T(i % 5) / T(4);
+            }
+            std::size_t const repeat = std::max<std::size_t>(1, 64 * 64 * 64 / (n * n * n));
+            double const perf = gflops(n, benchmark_gemm(n, a, b, c, repeat, iter));
+            out << "gemm   " << std::setw(4) << n << " : " << std::setw(7) << perf << " GFLOP/s, "
+                << std::setw(5) << 100. * perf / peak << "% of peak" << std::endl;
+        }
+        auto run_matmul = [&](auto size)
+        {
+            constexpr std::size_t n = decltype(size)::value;
+            // rows of b sum to one, which keeps the chained products bounded
+            bench_vector<T> a(n * n, T(0.5)), b(n * n, T(1) / T(n)), c(n * n);
+            double const perf = gflops(n, benchmark_matmul<n>(a, b, c, iter));
+            out << "matmul " << std::setw(4) << n << " : " << std::setw(7) << perf << " GFLOP/s, "
+                << std::setw(5) << 100. * perf / peak << "% of peak" << std::endl;
+        };
+        run_matmul(std::integral_constant<std::size_t, 4> {});
+        run_matmul(std::integral_constant<std::size_t, 8> {});
+        run_matmul(std::integral_constant<std::size_t, 16> {});
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class F>
+    duration_type benchmark_repeated(F&& f, std::size_t repeat, std::size_t iter)
+    {
+        duration_type t_res = duration_type::max();
+        for (std::size_t count = 0; count < iter; ++count)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t r = 0; r < repeat; ++r)
+                f();
+            auto end = std::chrono::steady_clock::now();
+            duration_type tmp = (end - start) / double(repeat);
+            t_res = tmp < t_res ? tmp : t_res;
+        }
+        return t_res;
+    }
+
+    /*
+     * FFT throughput in GFLOP/s, counting the conventional 5 n log2(n)
+     * operations of a complex transform of size n, and half of that for a
+     * real transform.
+     */
+    template <class T, class OS>
+    void run_benchmark_fft(std::string const& name, OS& out, std::size_t iter)
+    {
+        auto gflops = [](double flops, duration_type t)
+        { return flops / (t.count() * 1e6); };
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        for (std::size_t n : { 64, 240, 256, 1000, 1024, 4096, 15360, 16384, 65536 })
+        {
+            fft_plan<T> const plan(n);
+            rfft_plan<T> const rplan(n);
+            bench_vector<std::complex<T>> x(n), y(n);
+            bench_vector<T> r(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = { T(i % 7) / T(7), T(i % 3) / T(3) };
+                r[i] = T(i % 5) / T(5);
+            }
+            std::size_t const repeat = std::max<std::size_t>(1, (1 << 18) / n);
+            double const flops = 5. * n * std::log2(double(n));
+            double const c2c = gflops(flops, benchmark_repeated([&]
+                                                                { plan.forward(x.data(), y.data()); },
+                                                                repeat, iter));
+            double const r2c = gflops(flops / 2, benchmark_repeated([&]
+                                                                    { rplan.forward(r.data(), y.data()); },
+                                                                    repeat, iter));
+            out << "fft " << std::setw(6) << n << " : c2c " << std::setw(7) << c2c << " GFLOP/s, r2c "
+                << std::setw(7) << r2c << " GFLOP/s" << std::endl;
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * FIR throughput in millions of taps per second (samples times taps) for
+     * a streaming filter over blocks of 4096 samples, against the direct
+     * scalar loop.
+     */
+    template <class T, class OS>
+    void run_benchmark_filter(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t n = 4096;
+        constexpr std::size_t static_taps = 16;
+        auto mtaps = [](double taps, duration_type t)
+        { return taps / (t.count() * 1e3); };
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(0);
+        bench_vector<T> x(n), y(n);
+        for (std::size_t i = 0; i < n; ++i)
+            x[i] = static_cast<T>(i % 17);
+        for (std::size_t count : { 4, 16, 64, 256 })
+        {
+            bench_vector<T> taps(count, T(1));
+            fir_filter<T> filter(taps.data(), count);
+            double const simd = mtaps(double(n * count), benchmark_repeated([&]
+                                                                            { filter.process(x.data(), y.data(), n); },
+                                                                            100, iter));
+            double const scalar = mtaps(double(n * count), benchmark_repeated([&]
+                                                                              {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::conditional_t<std::is_integral<T>::value, int32_t, T> acc(0);
+                    for (std::size_t k = 0; k < count && k <= i; ++k)
+                        acc += taps[k] * x[i - k];
+                    y[i] = static_cast<T>(acc);
+                } },
+                                                                              100, iter));
+            out << "fir " << std::setw(4) << count << " taps : scalar " << std::setw(7) << scalar << " Mtaps/s, simd "
+                << std::setw(7) << simd << " Mtaps/s" << std::endl;
+        }
+        std::array<T, static_taps> taps;
+        taps.fill(T(1));
+        static_fir_filter<T, static_taps> filter(taps);
+        double const simd = mtaps(double(n * static_taps), benchmark_repeated([&]
+                                                                              { filter.process(x.data(), y.data(), n); },
+                                                                              100, iter));
+        out << "fir " << std::setw(4) << static_taps << " taps : static  " << std::setw(7) << simd << " Mtaps/s" << std::endl;
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Image filter throughput in megapixels per second on a 1920x1080 plane,
+     * on one thread and on one thread per physical core.
+     */
+    template <class T, class OS>
+    void run_benchmark_image_filter(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t width = 1920;
+        constexpr std::size_t height = 1080;
+        auto mpixels = [](duration_type t)
+        { return double(width * height) / (t.count() * 1e3); };
+
+        bench_vector<T> src(width * height), dst(width * height);
+        bench_vector<sobel_value_t<T>> dx(width * height), dy(width * height);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<T>(i % 251);
+        float const gaussian[5] = { 1.f / 16, 4.f / 16, 6.f / 16, 4.f / 16, 1.f / 16 };
+        float const sharpen[9] = { 0.f, -1.f, 0.f, -1.f, 5.f, -1.f, 0.f, -1.f, 0.f };
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(0);
+        for (std::size_t threads : { 1, 0 })
+        {
+            std::string const suffix = threads == 1 ? " (1 thread)   : " : " (all cores)  : ";
+            out << "gaussian 5x5" << suffix << std::setw(6) << mpixels(benchmark_repeated([&]
+                                                                                            { separable_filter(src.data(), width, dst.data(), width, width, height, gaussian, 5, gaussian, 5, border_mode::reflect, threads); },
+                                                                                            1, iter))
+                << " Mpixel/s" << std::endl;
+            out << "convolve 3x3" << suffix << std::setw(6) << mpixels(benchmark_repeated([&]
+                                                                                            { convolve_2d(src.data(), width, dst.data(), width, width, height, sharpen, 3, border_mode::reflect, threads); },
+                                                                                            1, iter))
+                << " Mpixel/s" << std::endl;
+            out << "box blur r=7" << suffix << std::setw(6) << mpixels(benchmark_repeated([&]
+                                                                                            { box_blur(src.data(), width, dst.data(), width, width, height, 7, border_mode::reflect, threads); },
+                                                                                            1, iter))
+                << " Mpixel/s" << std::endl;
+            out << "sobel       " << suffix << std::setw(6) << mpixels(benchmark_repeated([&]
+                                                                                            { sobel(src.data(), width, dx.data(), width, dy.data(), width, width, height, border_mode::reflect, threads); },
+                                                                                            1, iter))
+                << " Mpixel/s" << std::endl;
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Pixel format conversion throughput in megapixels per second on a
+     * 1920x1080 image.
+     */
+    template <class OS>
+    void run_benchmark_color(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t width = 1920;
+        constexpr std::size_t height = 1080;
+        constexpr std::size_t n = width * height;
+        auto mpixels = [](duration_type t)
+        { return double(n) / (t.count() * 1e3); };
+
+        bench_vector<uint8_t> rgba(4 * n), bgra(4 * n), rgb(3 * n), y(n), u(n / 4), v(n / 4), uv(n / 2);
+        for (std::size_t i = 0; i < rgba.size(); ++i)
+            rgba[i] = static_cast<uint8_t>(i % 251);
+        for (std::size_t i = 0; i < rgb.size(); ++i)
+            rgb[i] = static_cast<uint8_t>(i % 253);
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(0);
+        auto report = [&](char const* label, duration_type t)
+        { out << label << " : " << std::setw(6) << mpixels(t) << " Mpixel/s" << std::endl; };
+        report("rgba -> i420     ", benchmark_repeated([&]
+                                                       { rgb_to_i420<pixel_format::rgba>(rgba.data(), 4 * width, y.data(), width, u.data(), width / 2, v.data(), width / 2, width, height); },
+                                                       1, iter));
+        report("i420 -> rgba     ", benchmark_repeated([&]
+                                                       { i420_to_rgb<pixel_format::rgba>(y.data(), width, u.data(), width / 2, v.data(), width / 2, bgra.data(), 4 * width, width, height); },
+                                                       1, iter));
+        report("rgb -> nv12      ", benchmark_repeated([&]
+                                                       { rgb_to_nv12<pixel_format::rgb>(rgb.data(), 3 * width, y.data(), width, uv.data(), width, width, height, yuv_standard::bt709); },
+                                                       1, iter));
+        report("nv12 -> rgb      ", benchmark_repeated([&]
+                                                       { nv12_to_rgb<pixel_format::rgb>(y.data(), width, uv.data(), width, rgb.data(), 3 * width, width, height, yuv_standard::bt709); },
+                                                       1, iter));
+        report("rgba -> bgra     ", benchmark_repeated([&]
+                                                       { convert_pixels<pixel_format::rgba, pixel_format::bgra>(rgba.data(), bgra.data(), n); },
+                                                       1, iter));
+        report("rgb -> rgba      ", benchmark_repeated([&]
+                                                       { convert_pixels<pixel_format::rgb, pixel_format::rgba>(rgb.data(), bgra.data(), n); },
+                                                       1, iter));
+        report("premultiply      ", benchmark_repeated([&]
+                                                       { premultiply_alpha(rgba.data(), bgra.data(), n); },
+                                                       1, iter));
+        report("unpremultiply    ", benchmark_repeated([&]
+                                                       { unpremultiply_alpha(rgba.data(), bgra.data(), n); },
+                                                       1, iter));
+        report("rgb -> gray      ", benchmark_repeated([&]
+                                                       { rgb_to_gray<pixel_format::rgb>(rgb.data(), y.data(), n); },
+                                                       1, iter));
+        report("rgb -> gray (scalar)", benchmark_repeated([&]
+                                                          {
+            for (std::size_t i = 0; i < n; ++i)
+                y[i] = static_cast<uint8_t>((77 * rgb[3 * i] + 150 * rgb[3 * i + 1] + 29 * rgb[3 * i + 2] + 128) >> 8); },
+                                                          1, iter));
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Short array loops: for_each_batch against a full-batch loop followed by
+     * a scalar remainder, in nanoseconds per array of n floats. The arrays are
+     * adjacent and fit in the L1 cache, so that the tails dominate.
+     */
+    template <class OS>
+    void run_benchmark_for_each(std::string const& name, OS& out, std::size_t iter)
+    {
+        using batch_type = batch<float>;
+        constexpr std::size_t size = batch_type::size;
+        auto f = [](batch_type x)
+        { return fma(x, batch_type(1.0001f), batch_type(0.5f)); };
+        auto scalar_tail = [&](float const* s, float* d, std::size_t n)
+        {
+            std::size_t const vec_size = n - n % size;
+            for (std::size_t i = 0; i < vec_size; i += size)
+                f(batch_type::load_unaligned(s + i)).store_unaligned(d + i);
+            for (std::size_t i = vec_size; i < n; ++i)
+                d[i] = std::fma(s[i], 1.0001f, 0.5f);
+        };
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(1);
+        for (std::size_t n : { 10, 17, 33, 50, 1000 })
+        {
+            std::size_t const count = std::max<std::size_t>(4096 / n, 1);
+            bench_vector<float> src(count * n, 1.f), dst(count * n, 0.f);
+            auto ns = [&](duration_type t)
+            { return t.count() * 1e6 / double(count); };
+            auto run = [&](auto&& loop)
+            {
+                return ns(benchmark_repeated([&]
+                                             {
+                    for (std::size_t a = 0; a < count; ++a)
+                        loop(a * n); },
+                                             1, iter));
+            };
+
+            double const loop_copy = run([&](std::size_t o)
+                                         { for_each_batch(src.data() + o, dst.data() + o, n, f); });
+            double const tail_copy = run([&](std::size_t o)
+                                         { scalar_tail(src.data() + o, dst.data() + o, n); });
+            double const loop_inplace = run([&](std::size_t o)
+                                            { for_each_batch(dst.data() + o, n, f); });
+            double const tail_inplace = run([&](std::size_t o)
+                                            { scalar_tail(dst.data() + o, dst.data() + o, n); });
+            out << "n = " << std::setw(4) << n << " : for_each_batch " << std::setw(6) << loop_copy << " / " << std::setw(6) << loop_inplace
+                << " ns, scalar tail " << std::setw(6) << tail_copy << " / " << std::setw(6) << tail_inplace << " ns (copy / in place)" << std::endl;
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Quantization throughput in billions of values per second, on a tensor
+     * that fits in the L2 cache.
+     */
+    template <class OS>
+    void run_benchmark_quantize(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t n = 64 * 1024;
+        constexpr std::size_t channels = 64;
+        constexpr float scale = 0.05f;
+        auto gvalues = [](duration_type t)
+        { return double(n) / (t.count() * 1e6); };
+
+        bench_vector<float> src(n), back(n), scales(channels, scale);
+        bench_vector<int8_t> q(n);
+        bench_vector<uint8_t> packed(n / 2);
+        for (std::size_t i = 0; i < n; ++i)
+            src[i] = std::sin(0.01f * float(i)) * 8.f;
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](char const* label, duration_type t)
+        { out << label << " : " << std::setw(6) << gvalues(t) << " Gvalues/s" << std::endl; };
+        report("quantize int8         ", benchmark_repeated([&]
+                                                            { quantize(src.data(), q.data(), n, scale, int8_t(3)); },
+                                                            10, iter));
+        report("quantize int8 (scalar)", benchmark_repeated([&]
+                                                            {
+            for (std::size_t i = 0; i < n; ++i)
+                q[i] = static_cast<int8_t>(std::min(std::max(std::nearbyint(src[i] * (1.f / scale)) + 3.f, -128.f), 127.f)); },
+                                                            10, iter));
+        report("quantize per channel  ", benchmark_repeated([&]
+                                                            { quantize_per_channel(src.data(), q.data(), channels, n / channels, scales.data()); },
+                                                            10, iter));
+        report("dequantize int8       ", benchmark_repeated([&]
+                                                            { dequantize(q.data(), back.data(), n, scale, int8_t(3)); },
+                                                            10, iter));
+        report("dequantize (scalar)   ", benchmark_repeated([&]
+                                                            {
+            for (std::size_t i = 0; i < n; ++i)
+                back[i] = float(q[i] - 3) * scale; },
+                                                            10, iter));
+        report("quantize int4         ", benchmark_repeated([&]
+                                                            { quantize_int4(src.data(), packed.data(), n, scale); },
+                                                            10, iter));
+        report("dequantize int4       ", benchmark_repeated([&]
+                                                            { dequantize_int4(packed.data(), back.data(), n, scale); },
+                                                            10, iter));
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Widening and narrowing throughput in billions of narrow values per
+     * second, on arrays that fit in the L1 cache, against the same loops
+     * written on scalars.
+     */
+    template <class T, class OS>
+    void run_benchmark_widen_type(std::string const& type_name, OS& out, std::size_t iter)
+    {
+        using wide_type = widen_t<T>;
+        using batch_type = batch<T>;
+        using wide_batch = batch<wide_type>;
+        constexpr std::size_t n = 4 * 1024;
+        constexpr std::size_t size = batch_type::size;
+        auto gvalues = [](duration_type t)
+        { return double(n) / (t.count() * 1e6); };
+
+        bench_vector<T> narrow_values(n);
+        bench_vector<wide_type> wide_values(n);
+        for (std::size_t i = 0; i < n; ++i)
+            narrow_values[i] = static_cast<T>(i * 37 + 3);
+
+        auto report = [&](std::string const& label, duration_type t)
+        { out << std::left << std::setw(32) << label << std::right << " : " << std::setw(6) << gvalues(t) << " Gvalues/s" << std::endl; };
+        report("widen " + type_name, benchmark_repeated([&]
+                                                        {
+            for (std::size_t i = 0; i < n; i += size)
+            {
+                auto const w = widen(batch_type::load_aligned(narrow_values.data() + i));
+                w[0].store_aligned(wide_values.data() + i);
+                w[1].store_aligned(wide_values.data() + i + wide_batch::size);
+            } },
+                                                        10, iter));
+        report("widen " + type_name + " (scalar)", benchmark_repeated([&]
+                                                                      {
+            for (std::size_t i = 0; i < n; ++i)
+                wide_values[i] = static_cast<wide_type>(narrow_values[i]); },
+                                                                      10, iter));
+        report("narrow_saturate " + type_name, benchmark_repeated([&]
+                                                                  {
+            for (std::size_t i = 0; i < n; i += size)
+            {
+                auto const lo = wide_batch::load_aligned(wide_values.data() + i);
+                auto const hi = wide_batch::load_aligned(wide_values.data() + i + wide_batch::size);
+                narrow_saturate(lo, hi).store_aligned(narrow_values.data() + i);
+            } },
+                                                                  10, iter));
+        report("narrow_saturate " + type_name + " (scalar)", benchmark_repeated([&]
+                                                                                {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                wide_type const x = wide_values[i];
+                if constexpr (std::is_floating_point_v<T>)
+                    narrow_values[i] = static_cast<T>(std::abs(x) > std::numeric_limits<T>::max() && std::abs(x) < std::numeric_limits<wide_type>::infinity()
+                                                          ? std::copysign(wide_type(std::numeric_limits<T>::max()), x)
+                                                          : x);
+                else
+                    narrow_values[i] = static_cast<T>(std::min<wide_type>(std::max<wide_type>(x, std::numeric_limits<T>::min()), std::numeric_limits<T>::max()));
+            } },
+                                                                                10, iter));
+    }
+
+    template <class OS>
+    void run_benchmark_widen(std::string const& name, OS& out, std::size_t iter)
+    {
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        run_benchmark_widen_type<int8_t>("int8", out, iter);
+        run_benchmark_widen_type<uint8_t>("uint8", out, iter);
+        run_benchmark_widen_type<int16_t>("int16", out, iter);
+        run_benchmark_widen_type<int32_t>("int32", out, iter);
+        run_benchmark_widen_type<float>("float", out, iter);
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Bitmap operations over 64 kB bitmaps, in GB/s of input read, against
+     * word by word loops using the scalar popcount.
+     */
+    template <class OS>
+    void run_benchmark_bitmap(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t words = 8 * 1024;
+        auto gbytes = [](std::size_t inputs, duration_type t)
+        { return double(inputs * words * sizeof(uint64_t)) / (t.count() * 1e6); };
+
+        bench_vector<uint64_t> a(words), b(words), res(words + 64);
+        // offset from the inputs, which share their alignment modulo 4 kB
+        uint64_t* const dst = res.data() + 40;
+        bench_vector<uint32_t> indices(64 * words);
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            a[i] = seed;
+            b[i] = seed * 0xD1B54A32D192ED03ull;
+        }
+        volatile std::size_t sink = 0;
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](char const* label, std::size_t inputs, duration_type t)
+        { out << label << " : " << std::setw(6) << gbytes(inputs, t) << " GB/s" << std::endl; };
+        report("cardinality             ", 1, benchmark_repeated([&]
+                                                                { sink = bitmap_cardinality(a.data(), words); },
+                                                                10, iter));
+#if XSIMD_WITH_AVX512VPOPCNTDQ
+        // the carry-save adder tree, which the vpopcntq path replaces
+        report("cardinality (avx512bw)  ", 1, benchmark_repeated([&]
+                                                                { sink = bitmap_cardinality<avx512bw>(a.data(), words); },
+                                                                10, iter));
+#endif
+        report("cardinality (scalar)    ", 1, benchmark_repeated([&]
+                                                                {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < words; ++i)
+                count += detail::popcount(a[i]);
+            sink = count; },
+                                                                10, iter));
+        report("and                     ", 2, benchmark_repeated([&]
+                                                                { sink = bitmap_and(a.data(), b.data(), dst, words); },
+                                                                10, iter));
+        report("and (scalar)            ", 2, benchmark_repeated([&]
+                                                                {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < words; ++i)
+            {
+                dst[i] = a[i] & b[i];
+                count += detail::popcount(dst[i]);
+            }
+            sink = count; },
+                                                                10, iter));
+        report("and_cardinality         ", 2, benchmark_repeated([&]
+                                                                { sink = bitmap_and_cardinality(a.data(), b.data(), words); },
+                                                                10, iter));
+        report("xor_cardinality         ", 2, benchmark_repeated([&]
+                                                                { sink = bitmap_xor_cardinality(a.data(), b.data(), words); },
+                                                                10, iter));
+        report("to_indices              ", 1, benchmark_repeated([&]
+                                                                { sink = bitmap_to_indices(a.data(), words, indices.data()); },
+                                                                10, iter));
+        report("to_indices (scalar)     ", 1, benchmark_repeated([&]
+                                                                {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < words; ++i)
+                for (uint64_t word = a[i]; word != 0; word &= word - 1)
+                    indices[count++] = uint32_t(64 * i + detail::countr_zero(word));
+            sink = count; },
+                                                                10, iter));
+        (void)sink;
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    /*
+     * Brute force nearest neighbour search, in queries per second: each
+     * query computes its distances to all points and selects the 10 nearest.
+     * Block variants process 4 queries per call.
+     */
+    template <class OS>
+    void run_benchmark_distance(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t n = 16 * 1024;
+        constexpr std::size_t dim = 128;
+        constexpr std::size_t words = 4;
+        constexpr std::size_t k = 10;
+        constexpr std::size_t nq = 4;
+        auto qps = [](std::size_t queries, duration_type t)
+        { return double(queries) / (t.count() * 1e-3); };
+
+        bench_vector<float> points(n * dim), queries(nq * dim), distances(nq * n);
+        bench_vector<fp16> points_fp16(n * dim), queries_fp16(nq * dim);
+        bench_vector<int8_t> points_int8(n * dim), queries_int8(nq * dim);
+        bench_vector<int32_t> distances_int8(nq * n);
+        bench_vector<uint64_t> codes(n * words), query_codes(nq * words);
+        bench_vector<uint32_t> distances_hamming(nq * n), nearest(k);
+        for (std::size_t i = 0; i < n * dim; ++i)
+        {
+            points[i] = std::sin(0.37f * float(i));
+            points_fp16[i] = fp16 { static_cast<uint16_t>(0x3000u + (i * 7919) % 0x800u) };
+            points_int8[i] = static_cast<int8_t>((i * 7919) % 255);
+        }
+        for (std::size_t i = 0; i < nq * dim; ++i)
+        {
+            queries[i] = std::cos(0.11f * float(i));
+            queries_fp16[i] = fp16 { static_cast<uint16_t>(0x3000u + (i * 104729) % 0x800u) };
+            queries_int8[i] = static_cast<int8_t>((i * 104729) % 255);
+        }
+        for (std::size_t i = 0; i < n * words; ++i)
+            codes[i] = uint64_t(i) * 0x9E3779B97F4A7C15ull;
+        for (std::size_t i = 0; i < nq * words; ++i)
+            query_codes[i] = uint64_t(i + 1) * 0xD1B54A32D192ED03ull;
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(0);
+        auto report = [&](char const* label, std::size_t queries_per_call, duration_type t)
+        { out << label << " : " << std::setw(8) << qps(queries_per_call, t) << " QPS" << std::endl; };
+        report("l2 float            ", 1, benchmark_repeated([&]
+                                                            {
+            squared_l2_distances(queries.data(), points.data(), n, dim, distances.data());
+            nearest_k(distances.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("l2 float (scalar)   ", 1, benchmark_repeated([&]
+                                                            {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                float sum = 0.f;
+                for (std::size_t i = 0; i < dim; ++i)
+                    sum += (queries[i] - points[j * dim + i]) * (queries[i] - points[j * dim + i]);
+                distances[j] = sum;
+            }
+            nearest_k(distances.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("l2 float, block of 4", nq, benchmark_repeated([&]
+                                                             {
+            squared_l2_distances(queries.data(), nq, points.data(), n, dim, distances.data());
+            for (std::size_t q = 0; q < nq; ++q)
+                nearest_k(distances.data() + q * n, n, k, nearest.data()); },
+                                                             4, iter));
+        report("inner product float ", 1, benchmark_repeated([&]
+                                                            {
+            inner_products(queries.data(), points.data(), n, dim, distances.data());
+            nearest_k(distances.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("cosine float        ", 1, benchmark_repeated([&]
+                                                            {
+            cosine_distances(queries.data(), points.data(), n, dim, distances.data());
+            nearest_k(distances.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("l2 fp16             ", 1, benchmark_repeated([&]
+                                                            {
+            squared_l2_distances(queries_fp16.data(), points_fp16.data(), n, dim, distances.data());
+            nearest_k(distances.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("l2 int8             ", 1, benchmark_repeated([&]
+                                                            {
+            squared_l2_distances(queries_int8.data(), points_int8.data(), n, dim, distances_int8.data());
+            nearest_k(distances_int8.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        report("l2 int8, block of 4 ", nq, benchmark_repeated([&]
+                                                             {
+            squared_l2_distances(queries_int8.data(), nq, points_int8.data(), n, dim, distances_int8.data());
+            for (std::size_t q = 0; q < nq; ++q)
+                nearest_k(distances_int8.data() + q * n, n, k, nearest.data()); },
+                                                             4, iter));
+        report("hamming 256 bits    ", 1, benchmark_repeated([&]
+                                                            {
+            hamming_distances(query_codes.data(), codes.data(), n, words, distances_hamming.data());
+            nearest_k(distances_hamming.data(), n, k, nearest.data()); },
+                                                            4, iter));
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class OS>
+    void run_benchmark_selection(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t n = 64 * 1024;
+        constexpr std::size_t k = 16;
+        auto gelements = [](duration_type t)
+        { return double(n) / (t.count() * 1e6); };
+
+        bench_vector<float> scores(n);
+        bench_vector<int8_t> logits(n);
+        bench_vector<uint32_t> indices(k), ranking(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            scores[i] = std::sin(0.37f * float(i)) * float(i % 1021);
+            logits[i] = static_cast<int8_t>((i * 7919) % 251);
+        }
+        volatile std::size_t sink = 0;
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](char const* label, duration_type t)
+        { out << label << " : " << std::setw(7) << gelements(t) << " Gelements/s" << std::endl; };
+        report("argmax float               ", benchmark_repeated([&]
+                                                                 { sink = argmax(scores.data(), n); },
+                                                                 10, iter));
+        report("argmax float, omit NaN     ", benchmark_repeated([&]
+                                                                 { sink = argmax(scores.data(), n, nan_policy::omit); },
+                                                                 10, iter));
+        report("argmax float (max_element) ", benchmark_repeated([&]
+                                                                 { sink = std::size_t(std::max_element(scores.begin(), scores.end()) - scores.begin()); },
+                                                                 10, iter));
+        report("argmin int8                ", benchmark_repeated([&]
+                                                                 { sink = argmin(logits.data(), n); },
+                                                                 10, iter));
+        report("argmin int8 (min_element)  ", benchmark_repeated([&]
+                                                                 { sink = std::size_t(std::min_element(logits.begin(), logits.end()) - logits.begin()); },
+                                                                 10, iter));
+        report("top 16 float               ", benchmark_repeated([&]
+                                                                 { sink = top_k(scores.data(), n, k, indices.data()); },
+                                                                 10, iter));
+        report("top 16 float (partial_sort)", benchmark_repeated([&]
+                                                                 {
+            for (std::size_t i = 0; i < n; ++i)
+                ranking[i] = static_cast<uint32_t>(i);
+            std::partial_sort(ranking.begin(), ranking.begin() + k, ranking.end(), [&](uint32_t a, uint32_t b)
+                              { return scores[a] > scores[b]; });
+            sink = ranking[0]; },
+                                                                 10, iter));
+        report("top 16 int8                ", benchmark_repeated([&]
+                                                                 { sink = top_k(logits.data(), n, k, indices.data()); },
+                                                                 10, iter));
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class OS>
+    void run_benchmark_histogram(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t n = 64 * 1024;
+        constexpr std::size_t bins = 256;
+        auto gelements = [](duration_type t)
+        { return double(n) / (t.count() * 1e6); };
+
+        bench_vector<float> values(n), boundaries(1023);
+        bench_vector<uint32_t> buckets(n), counts(bins + 1);
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = 0.5f + 0.5f * std::sin(0.37f * float(i)) * std::cos(0.0013f * float(i));
+        for (std::size_t i = 0; i < boundaries.size(); ++i)
+            boundaries[i] = float(i + 1) / float(boundaries.size() + 1);
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](char const* label, duration_type t)
+        { out << label << " : " << std::setw(7) << gelements(t) << " Gelements/s" << std::endl; };
+        for (std::size_t nb : { std::size_t(3), std::size_t(7), std::size_t(15), std::size_t(255), boundaries.size() })
+        {
+            // every (1024 / (nb + 1))-th boundary, evenly spread
+            bench_vector<float> b(nb);
+            for (std::size_t i = 0; i < nb; ++i)
+                b[i] = boundaries[(i + 1) * (boundaries.size() + 1) / (nb + 1) - 1];
+            std::string const label = "bucketize, " + std::to_string(nb) + " boundaries";
+            report((label + std::string(31 - label.size(), ' ')).c_str(), benchmark_repeated([&]
+                                                                                             { bucketize(values.data(), n, b.data(), nb, buckets.data()); },
+                                                                                             10, iter));
+            std::string const scalar_label = "  (upper_bound)";
+            report((scalar_label + std::string(31 - scalar_label.size(), ' ')).c_str(), benchmark_repeated([&]
+                                                                                                           {
+                for (std::size_t i = 0; i < n; ++i)
+                    buckets[i] = static_cast<uint32_t>(std::upper_bound(b.begin(), b.end(), values[i]) - b.begin()); },
+                                                                                                           10, iter));
+        }
+        report("histogram, 256 bins            ", benchmark_repeated([&]
+                                                                     { histogram(values.data(), n, 0.f, 1.f, bins, counts.data()); },
+                                                                     10, iter));
+        report("histogram, 256 bins (scalar)   ", benchmark_repeated([&]
+                                                                     {
+            float const scale = float(bins);
+            for (std::size_t i = 0; i < n; ++i)
+                ++counts[std::size_t(std::min(std::max(values[i] * scale, 0.f), float(bins - 1)))]; },
+                                                                     10, iter));
+        report("histogram, 255 boundaries      ", benchmark_repeated([&]
+                                                                     { histogram(values.data(), n, boundaries.data() + 768, 255, counts.data()); },
+                                                                     10, iter));
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class OS>
+    void run_benchmark_search(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t count = 64 * 1024;
+        auto mkeys = [](duration_type t)
+        { return double(count) / (t.count() * 1e3); };
+
+        bench_vector<int32_t> keys(count);
+        bench_vector<uint32_t> positions(count);
+        uint32_t seed = 0x9E3779B9u;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            keys[i] = static_cast<int32_t>(seed >> 2);
+        }
+        volatile std::size_t sink = 0;
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(1);
+        auto report = [&](std::string const& label, duration_type t)
+        { out << label << std::string(40 - label.size(), ' ') << " : " << std::setw(7) << mkeys(t) << " Mkeys/s" << std::endl; };
+        // in L1, in L2 and in memory
+        for (std::size_t n : { std::size_t(4) * 1024, std::size_t(64) * 1024, std::size_t(16) * 1024 * 1024 })
+        {
+            bench_vector<int32_t> sorted(n);
+            for (std::size_t i = 0; i < n; ++i)
+                sorted[i] = static_cast<int32_t>((uint64_t(i) << 30) / n);
+            btree_index<int32_t> const index(sorted.data(), n);
+            std::string const size = std::to_string(n * sizeof(int32_t) / 1024) + " kB";
+            report("std::lower_bound, " + size, benchmark_repeated([&]
+                                                                   {
+                for (std::size_t i = 0; i < count; ++i)
+                    positions[i] = static_cast<uint32_t>(std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin());
+                sink = positions[count - 1]; },
+                                                                   1, iter));
+            report("lower_bounds, " + size, benchmark_repeated([&]
+                                                               {
+                lower_bounds(sorted.data(), n, keys.data(), count, positions.data());
+                sink = positions[count - 1]; },
+                                                               1, iter));
+            report("btree_index::lower_bounds, " + size, benchmark_repeated([&]
+                                                                            {
+                index.lower_bounds(keys.data(), count, positions.data());
+                sink = positions[count - 1]; },
+                                                                            1, iter));
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class OS>
+    void run_benchmark_lut(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t count = 64 * 1024;
+        auto gelements = [](duration_type t)
+        { return double(count) / (t.count() * 1e6); };
+
+        bench_vector<float> x(count), res(count);
+        for (std::size_t i = 0; i < count; ++i)
+            x[i] = 0.5f + 0.5f * std::sin(0.37f * float(i)) * std::cos(0.0013f * float(i));
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](std::string const& label, duration_type t)
+        { out << label << std::string(36 - label.size(), ' ') << " : " << std::setw(7) << gelements(t) << " Gelements/s" << std::endl; };
+        // in registers on AVX2 and AVX-512, in registers on AVX-512 only, gathered
+        for (std::size_t n : { std::size_t(16), std::size_t(60), std::size_t(1024) })
+        {
+            bench_vector<float> table(n);
+            for (std::size_t i = 0; i < n; ++i)
+                table[i] = std::sqrt(float(i) / float(n - 1));
+            uniform_lut<float> const linear(table.data(), n, 0.f, 1.f);
+            uniform_lut<float> const spline(table.data(), n, 0.f, 1.f, lut_interpolation::catmull_rom);
+            std::string const size = std::to_string(n) + " points";
+            report("linear, " + size + " (scalar)", benchmark_repeated([&]
+                                                                       {
+                float const scale = float(n - 1);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    float const t = std::min(std::max(x[i] * scale, 0.f), scale);
+                    std::size_t const j = std::min(std::size_t(t), n - 2);
+                    float const f = t - float(j);
+                    res[i] = table[j] + f * (table[j + 1] - table[j]);
+                } },
+                                                                       10, iter));
+            report("linear, " + size, benchmark_repeated([&]
+                                                         { linear(x.data(), count, res.data()); },
+                                                         10, iter));
+            report("catmull_rom, " + size, benchmark_repeated([&]
+                                                              { spline(x.data(), count, res.data()); },
+                                                              10, iter));
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
+    template <class OS>
+    void run_benchmark_polynomial(std::string const& name, OS& out, std::size_t iter)
+    {
+        constexpr std::size_t count = 16 * 1024;
+        auto gelements = [](duration_type t)
+        { return double(count) / (t.count() * 1e6); };
+
+        bench_vector<float> x(count), res(count);
+        for (std::size_t i = 0; i < count; ++i)
+            x[i] = 0.9f * std::sin(0.37f * float(i));
+
+        out << "============================" << std::endl;
+        out << name << std::endl;
+        out << std::fixed << std::setprecision(2);
+        auto report = [&](std::string const& label, duration_type t)
+        { out << label << std::string(30 - label.size(), ' ') << " : " << std::setw(7) << gelements(t) << " Gelements/s" << std::endl; };
+        for (std::size_t n : { std::size_t(4), std::size_t(8), std::size_t(16), std::size_t(32) })
+        {
+            bench_vector<float> coeffs(n);
+            for (std::size_t i = 0; i < n; ++i)
+                coeffs[i] = 1.f / float(i + 1);
+            std::string const degree = ", degree " + std::to_string(n - 1);
+            report("scalar Horner" + degree, benchmark_repeated([&]
+                                                                {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    float r = coeffs[n - 1];
+                    for (std::size_t k = n - 1; k > 0; --k)
+                        r = r * x[i] + coeffs[k - 1];
+                    res[i] = r;
+                } },
+                                                                10, iter));
+            report("polyval_horner" + degree, benchmark_repeated([&]
+                                                                 { for_each_batch(x.data(), res.data(), count, [&](batch<float> const& b)
+                                                                                  { return polyval_horner(b, coeffs.data(), n); }); },
+                                                                 10, iter));
+            report("polyval_estrin" + degree, benchmark_repeated([&]
+                                                                 { for_each_batch(x.data(), res.data(), count, [&](batch<float> const& b)
+                                                                                  { return polyval_estrin(b, coeffs.data(), n); }); },
+                                                                 10, iter));
+            report("chebval" + degree, benchmark_repeated([&]
+                                                          { chebval(coeffs.data(), n, x.data(), count, res.data()); },
+                                                          10, iter));
+        }
+        out << std::defaultfloat;
+        out << "============================" << std::endl;
+    }
+
 #define DEFINE_OP_FUNCTOR_2OP(OP, NAME)                       \
     struct NAME##_fn                                          \
     {                                                         \
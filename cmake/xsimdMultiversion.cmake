@@ -0,0 +1,147 @@
+############################################################################
+# Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         #
+# Martin Renou                                                             #
+# Copyright (c) QuantStack                                                 #
+# Copyright (c) Serge Guelton                                              #
+#                                                                          #
+# Distributed under the terms of the BSD 3-Clause License.                 #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+# xsimd_add_multiversion(<name>
+#                        SOURCES <source>...
+#                        ARCHS <arch>...)
+#
+# Compiles the kernel sources once per architecture listed in ARCHS, each
+# time as a separate object library built with the matching instruction set
+# flags and with XSIMD_MULTIVERSION_ARCH defined to the xsimd architecture
+# type, e.g. xsimd::avx2. The objects are gathered in the static library
+# <name>, which also exposes a generated header <name>_archs.hpp defining:
+#
+#   <NAME>_ARCH_LIST             xsimd::arch_list of ARCHS, in the given order
+#   <NAME>_FOR_EACH_ARCH(MACRO)  MACRO(arch) expanded for each of ARCHS
+#
+# ARCHS should be listed from the most to the least capable, as for
+# xsimd::arch_list. Supported names are sse2, sse3, ssse3, sse4_1, sse4_2,
+# avx, fma3_avx, avx2, fma3_avx2, avx512f, avx512cd, avx512dq, avx512bw,
+# neon, neon64, sve128, sve256, sve512, rvv128, rvv256, rvv512 and wasm.
+#
+# xsimd batches have a size fixed at compile time, so that SVE and RVV code
+# is built for one vector length at a time. Listing several lengths, e.g.
+# ARCHS sve512 sve256 sve128 neon64, builds one object per length in the same
+# library; the dispatcher then runs the one matching the vector length of the
+# processor, which makes a single binary use the full width of any of them.
+
+function(_xsimd_multiversion_arch arch out_type out_flags)
+    if(MSVC)
+        set(_sse "")
+        set(_avx "/arch:AVX")
+        set(_avx2 "/arch:AVX2")
+        set(_fma_avx "/arch:AVX2")
+        set(_fma_avx2 "/arch:AVX2")
+        set(_avx512f "/arch:AVX512")
+        set(_avx512cd "/arch:AVX512")
+        set(_avx512dq "/arch:AVX512")
+        set(_avx512bw "/arch:AVX512")
+    else()
+        set(_sse "-m${arch}")
+        set(_avx "-mavx")
+        set(_avx2 "-mavx2")
+        set(_fma_avx "-mavx;-mfma")
+        set(_fma_avx2 "-mavx2;-mfma")
+        set(_avx512f "-mavx512f")
+        set(_avx512cd "-mavx512f;-mavx512cd")
+        set(_avx512dq "-mavx512f;-mavx512cd;-mavx512dq")
+        set(_avx512bw "-mavx512f;-mavx512cd;-mavx512dq;-mavx512bw")
+    endif()
+
+    if(arch STREQUAL "sse2" OR arch STREQUAL "sse3" OR arch STREQUAL "ssse3")
+        set(_type "xsimd::${arch}")
+        set(_flags "${_sse}")
+    elseif(arch STREQUAL "sse4_1" OR arch STREQUAL "sse4_2")
+        set(_type "xsimd::${arch}")
+        string(REPLACE "_" "." _flags "${_sse}")
+    elseif(arch STREQUAL "avx")
+        set(_type "xsimd::avx")
+        set(_flags "${_avx}")
+    elseif(arch STREQUAL "fma3_avx")
+        set(_type "xsimd::fma3<xsimd::avx>")
+        set(_flags "${_fma_avx}")
+    elseif(arch STREQUAL "avx2")
+        set(_type "xsimd::avx2")
+        set(_flags "${_avx2}")
+    elseif(arch STREQUAL "fma3_avx2")
+        set(_type "xsimd::fma3<xsimd::avx2>")
+        set(_flags "${_fma_avx2}")
+    elseif(arch STREQUAL "avx512f" OR arch STREQUAL "avx512cd" OR arch STREQUAL "avx512dq" OR arch STREQUAL "avx512bw")
+        set(_type "xsimd::${arch}")
+        set(_flags "${_${arch}}")
+    elseif(arch STREQUAL "neon" OR arch STREQUAL "neon64")
+        # NEON availability is tied to the target triple rather than to a flag.
+        set(_type "xsimd::${arch}")
+        set(_flags "")
+    elseif(arch MATCHES "^sve(128|256|512)$")
+        set(_type "xsimd::detail::sve<${CMAKE_MATCH_1}>")
+        set(_flags "-march=armv8-a+sve;-msve-vector-bits=${CMAKE_MATCH_1}")
+    elseif(arch MATCHES "^rvv(128|256|512)$")
+        set(_type "xsimd::detail::rvv<${CMAKE_MATCH_1}>")
+        set(_flags "-march=rv64gcv_zvl${CMAKE_MATCH_1}b;-mrvv-vector-bits=zvl")
+    elseif(arch STREQUAL "wasm")
+        set(_type "xsimd::wasm")
+        set(_flags "-msimd128")
+    else()
+        message(FATAL_ERROR "xsimd_add_multiversion: unsupported architecture '${arch}'")
+    endif()
+
+    set(${out_type} "${_type}" PARENT_SCOPE)
+    set(${out_flags} "${_flags}" PARENT_SCOPE)
+endfunction()
+
+function(xsimd_add_multiversion name)
+    cmake_parse_arguments(ARG "" "" "SOURCES;ARCHS" ${ARGN})
+    if(NOT ARG_SOURCES)
+        message(FATAL_ERROR "xsimd_add_multiversion: no SOURCES given for '${name}'")
+    endif()
+    if(NOT ARG_ARCHS)
+        message(FATAL_ERROR "xsimd_add_multiversion: no ARCHS given for '${name}'")
+    endif()
+
+    string(TOUPPER "${name}" _prefix)
+    string(MAKE_C_IDENTIFIER "${_prefix}" _prefix)
+    set(_header_dir "${CMAKE_CURRENT_BINARY_DIR}/${name}_multiversion")
+    set(_objects)
+    set(_arch_types)
+    set(_for_each)
+
+    foreach(_arch IN LISTS ARG_ARCHS)
+        _xsimd_multiversion_arch(${_arch} _type _flags)
+        set(_object_target "${name}_${_arch}")
+        add_library(${_object_target} OBJECT ${ARG_SOURCES})
+        target_link_libraries(${_object_target} PRIVATE xsimd)
+        target_include_directories(${_object_target} PRIVATE "${_header_dir}")
+        target_compile_definitions(${_object_target} PRIVATE "XSIMD_MULTIVERSION_ARCH=${_type}")
+        if(_flags)
+            target_compile_options(${_object_target} PRIVATE ${_flags})
+        endif()
+        set_target_properties(${_object_target} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+        list(APPEND _objects "$<TARGET_OBJECTS:${_object_target}>")
+        list(APPEND _arch_types "${_type}")
+        string(APPEND _for_each " MACRO(${_type})")
+    endforeach()
+
+    string(REPLACE ";" ", " _arch_list "${_arch_types}")
+    file(WRITE "${_header_dir}/${name}_archs.hpp"
+         "// Generated by xsimd_add_multiversion, do not edit.\n"
+         "#ifndef ${_prefix}_ARCHS_HPP\n"
+         "#define ${_prefix}_ARCHS_HPP\n"
+         "#include \"xsimd/config/xsimd_arch.hpp\"\n"
+         "#define ${_prefix}_ARCH_LIST xsimd::arch_list<${_arch_list}>\n"
+         "#define ${_prefix}_FOR_EACH_ARCH(MACRO)${_for_each}\n"
+         "#endif\n")
+
+    add_library(${name} STATIC ${_objects})
+    set_target_properties(${name} PROPERTIES LINKER_LANGUAGE CXX)
+    target_link_libraries(${name} PUBLIC xsimd)
+    target_include_directories(${name} PUBLIC "${_header_dir}")
+endfunction()
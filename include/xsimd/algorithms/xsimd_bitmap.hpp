@@ -0,0 +1,352 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_BITMAP_HPP
+#define XSIMD_ALGORITHMS_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_bitmap Bitmaps
+     *
+     * Bitmaps are arrays of \c uint64_t words, bit \c j of word \c i standing
+     * for the integer <tt>64 * i + j</tt>. The binary operations return the
+     * number of bits set in their result, computed in the same pass; the
+     * \c _cardinality variants only count them and write nothing. Results
+     * may be written to either operand.
+     */
+
+    namespace detail
+    {
+        struct bitmap_and_op
+        {
+            template <class T>
+            T operator()(T const& a, T const& b) const noexcept { return a & b; }
+        };
+
+        struct bitmap_or_op
+        {
+            template <class T>
+            T operator()(T const& a, T const& b) const noexcept { return a | b; }
+        };
+
+        struct bitmap_xor_op
+        {
+            template <class T>
+            T operator()(T const& a, T const& b) const noexcept { return a ^ b; }
+        };
+
+        struct bitmap_andnot_op
+        {
+            template <class T>
+            T operator()(T const& a, T const& b) const noexcept { return a & ~b; }
+        };
+
+        // Whether counting each batch is cheaper than the carry-save adder
+        // tree, i.e. whether the lane popcount is a single instruction.
+        template <class A>
+        constexpr bool bitmap_direct_popcount() noexcept
+        {
+            return std::is_base_of<avx512vpopcntdq, A>::value;
+        }
+
+        template <class V>
+        inline V bitmap_load(uint64_t const* src) noexcept
+        {
+            if constexpr (std::is_same<V, uint64_t>::value)
+                return *src;
+            else
+                return V::load_unaligned(src);
+        }
+
+        inline void bitmap_store(uint64_t word, uint64_t* dst) noexcept
+        {
+            *dst = word;
+        }
+
+        template <class A>
+        inline void bitmap_store(batch<uint64_t, A> const& words, uint64_t* dst) noexcept
+        {
+            words.store_unaligned(dst);
+        }
+
+        // low + a + b = 2 * high + low, bitwise
+        template <class B>
+        inline void bitmap_csa(B& high, B& low, B const& a, B const& b) noexcept
+        {
+            B const u = low ^ a;
+            high = (low & a) | (u & b);
+            low = u ^ b;
+        }
+
+        /*
+         * Sums the popcounts of f(i, V {}) for each word or batch of words at
+         * index i, V being uint64_t or batch<uint64_t, A>. Without a popcount
+         * instruction, batches go sixteen at a time through a Harley-Seal
+         * carry-save adder tree, so that a single popcount is needed per
+         * sixteen batches plus four at the end.
+         */
+        template <class A, class F>
+        inline std::size_t bitmap_count(std::size_t words, F&& f) noexcept
+        {
+            using batch_type = batch<uint64_t, A>;
+            constexpr std::size_t size = batch_type::size;
+            std::size_t i = 0;
+            batch_type total(0);
+            if constexpr (!bitmap_direct_popcount<A>())
+            {
+                batch_type ones(0), twos(0), fours(0), eights(0);
+                for (; i + 16 * size <= words; i += 16 * size)
+                {
+                    batch_type twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+                    bitmap_csa(twos_a, ones, f(i, batch_type {}), f(i + size, batch_type {}));
+                    bitmap_csa(twos_b, ones, f(i + 2 * size, batch_type {}), f(i + 3 * size, batch_type {}));
+                    bitmap_csa(fours_a, twos, twos_a, twos_b);
+                    bitmap_csa(twos_a, ones, f(i + 4 * size, batch_type {}), f(i + 5 * size, batch_type {}));
+                    bitmap_csa(twos_b, ones, f(i + 6 * size, batch_type {}), f(i + 7 * size, batch_type {}));
+                    bitmap_csa(fours_b, twos, twos_a, twos_b);
+                    bitmap_csa(eights_a, fours, fours_a, fours_b);
+                    bitmap_csa(twos_a, ones, f(i + 8 * size, batch_type {}), f(i + 9 * size, batch_type {}));
+                    bitmap_csa(twos_b, ones, f(i + 10 * size, batch_type {}), f(i + 11 * size, batch_type {}));
+                    bitmap_csa(fours_a, twos, twos_a, twos_b);
+                    bitmap_csa(twos_a, ones, f(i + 12 * size, batch_type {}), f(i + 13 * size, batch_type {}));
+                    bitmap_csa(twos_b, ones, f(i + 14 * size, batch_type {}), f(i + 15 * size, batch_type {}));
+                    bitmap_csa(fours_b, twos, twos_a, twos_b);
+                    bitmap_csa(eights_b, fours, fours_a, fours_b);
+                    bitmap_csa(sixteens, eights, eights_a, eights_b);
+                    total += ::xsimd::popcount(sixteens);
+                }
+                total = (total << 4) + (::xsimd::popcount(eights) << 3) + (::xsimd::popcount(fours) << 2)
+                    + (::xsimd::popcount(twos) << 1) + ::xsimd::popcount(ones);
+            }
+
+            for (; i + size <= words; i += size)
+                total += ::xsimd::popcount(f(i, batch_type {}));
+            std::size_t count = static_cast<std::size_t>(reduce_add(total));
+            for (; i < words; ++i)
+                count += static_cast<std::size_t>(detail::popcount(f(i, uint64_t {})));
+            return count;
+        }
+
+        template <class A, bool Store, class Op>
+        inline std::size_t bitmap_binary(uint64_t const* a, uint64_t const* b, uint64_t* out, std::size_t words, Op op) noexcept
+        {
+            return bitmap_count<A>(words, [&](std::size_t i, auto tag)
+                                   {
+                using value_type = decltype(tag);
+                value_type const res = op(bitmap_load<value_type>(a + i), bitmap_load<value_type>(b + i));
+                if constexpr (Store)
+                    bitmap_store(res, out + i);
+                return res; });
+        }
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Stores <tt>a & b</tt> to \c out.
+     *
+     * @param a the first bitmap.
+     * @param b the second bitmap.
+     * @param out the result, which may be \c a or \c b.
+     * @param words the number of words of each bitmap.
+     * @return the number of bits set in the result.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_and(uint64_t const* a, uint64_t const* b, uint64_t* out, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, true>(a, b, out, words, detail::bitmap_and_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Stores <tt>a | b</tt> to \c out.
+     *
+     * @param a the first bitmap.
+     * @param b the second bitmap.
+     * @param out the result, which may be \c a or \c b.
+     * @param words the number of words of each bitmap.
+     * @return the number of bits set in the result.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_or(uint64_t const* a, uint64_t const* b, uint64_t* out, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, true>(a, b, out, words, detail::bitmap_or_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Stores <tt>a ^ b</tt> to \c out.
+     *
+     * @param a the first bitmap.
+     * @param b the second bitmap.
+     * @param out the result, which may be \c a or \c b.
+     * @param words the number of words of each bitmap.
+     * @return the number of bits set in the result.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_xor(uint64_t const* a, uint64_t const* b, uint64_t* out, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, true>(a, b, out, words, detail::bitmap_xor_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Stores <tt>a & ~b</tt>, the bits of \c a not in \c b, to \c out.
+     *
+     * @param a the first bitmap.
+     * @param b the second bitmap.
+     * @param out the result, which may be \c a or \c b.
+     * @param words the number of words of each bitmap.
+     * @return the number of bits set in the result.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_andnot(uint64_t const* a, uint64_t const* b, uint64_t* out, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, true>(a, b, out, words, detail::bitmap_andnot_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Counts the bits set in a bitmap.
+     *
+     * @param bits the bitmap.
+     * @param words the number of words of the bitmap.
+     * @return the number of bits set.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_cardinality(uint64_t const* bits, std::size_t words) noexcept
+    {
+        return detail::bitmap_count<A>(words, [&](std::size_t i, auto tag)
+                                       { return detail::bitmap_load<decltype(tag)>(bits + i); });
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Counts the bits set in <tt>a & b</tt>, without storing it.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_and_cardinality(uint64_t const* a, uint64_t const* b, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, false>(a, b, nullptr, words, detail::bitmap_and_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Counts the bits set in <tt>a | b</tt>, without storing it.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_or_cardinality(uint64_t const* a, uint64_t const* b, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, false>(a, b, nullptr, words, detail::bitmap_or_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Counts the bits set in <tt>a ^ b</tt>, i.e. the Hamming distance between
+     * the two bitmaps, without storing it.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_xor_cardinality(uint64_t const* a, uint64_t const* b, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, false>(a, b, nullptr, words, detail::bitmap_xor_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Counts the bits set in <tt>a & ~b</tt>, without storing it.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_andnot_cardinality(uint64_t const* a, uint64_t const* b, std::size_t words) noexcept
+    {
+        return detail::bitmap_binary<A, false>(a, b, nullptr, words, detail::bitmap_andnot_op {});
+    }
+
+    /**
+     * @ingroup algorithms_bitmap
+     *
+     * Writes the positions of the bits set in a bitmap to \c out, in
+     * increasing order. \c out must have room for bitmap_cardinality(bits,
+     * words) values; nothing is written past them.
+     *
+     * Architectures with a compress instruction and predicated stores expand
+     * 16 bits at a time with compress; elsewhere the bits of each word are
+     * extracted one by one with countr_zero.
+     *
+     * @param bits the bitmap.
+     * @param words the number of words of the bitmap.
+     * @param out the positions.
+     * @param base a value added to each position.
+     * @return the number of positions written.
+     */
+    template <class A = default_arch>
+    inline std::size_t bitmap_to_indices(uint64_t const* bits, std::size_t words, uint32_t* out, uint32_t base = 0) noexcept
+    {
+        uint32_t* const first = out;
+        using index_batch = batch<uint32_t, A>;
+        constexpr std::size_t size = index_batch::size;
+#if XSIMD_WITH_AVX512F
+        constexpr bool use_compress = std::is_base_of<avx512f, A>::value && has_mask_store_v<index_batch>;
+#else
+        constexpr bool use_compress = false;
+#endif
+        if constexpr (use_compress)
+        {
+            static_assert(64 % size == 0, "a word spans whole batches");
+            index_batch const lanes = detail::make_sequence_as_batch<index_batch>();
+            for (std::size_t i = 0; i < words; ++i)
+            {
+                uint64_t word = bits[i];
+                uint32_t position = base + static_cast<uint32_t>(64 * i);
+                for (; word != 0; word >>= size, position += size)
+                {
+                    uint64_t const chunk = word & ((uint64_t(1) << size) - 1);
+                    if (chunk == 0)
+                        continue;
+                    auto const count = static_cast<std::size_t>(detail::popcount(chunk));
+                    index_batch const indices = compress(lanes + position, batch_bool<uint32_t, A>::from_mask(chunk));
+                    indices.store(out, batch_bool<uint32_t, A>::first_n(count), unaligned_mode {});
+                    out += count;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < words; ++i)
+            {
+                uint32_t const position = base + static_cast<uint32_t>(64 * i);
+                for (uint64_t word = bits[i]; word != 0; word &= word - 1)
+                    *out++ = position + static_cast<uint32_t>(detail::countr_zero(word));
+            }
+        }
+        return static_cast<std::size_t>(out - first);
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,920 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_COLOR_HPP
+#define XSIMD_ALGORITHMS_COLOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_color Color conversion
+     */
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Byte order of packed 8-bit pixels.
+     */
+    enum class pixel_format
+    {
+        rgb,
+        bgr,
+        rgba,
+        bgra
+    };
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Color matrix of a YUV (Y'CbCr) conversion. Both matrices use the limited
+     * "studio" range, with luma in [16, 235] and chroma in [16, 240].
+     */
+    enum class yuv_standard
+    {
+        bt601,
+        bt709
+    };
+
+    namespace detail
+    {
+        template <pixel_format Format>
+        struct pixel_format_traits
+        {
+            static constexpr bool is_bgr = Format == pixel_format::bgr || Format == pixel_format::bgra;
+            static constexpr std::size_t bytes = Format == pixel_format::rgb || Format == pixel_format::bgr ? 3 : 4;
+            // byte offsets of red, green, blue and alpha
+            static constexpr std::size_t offset[4] = { is_bgr ? 2u : 0u, 1u, is_bgr ? 0u : 2u, 3u };
+        };
+
+        /*
+         * 8-bit fixed point matrices, in the integer form given by the
+         * standards: Y = ((66 R + 129 G + 25 B + 128) >> 8) + 16 for BT.601.
+         * The inverse coefficients k are split into 256 q + r with r in
+         * [-128, 128), so that 298 C + kd D + ke E + 128, which overflows 16
+         * bits, is evaluated as C + qd D + qe E + ((42 C + rd D + re E + 128) >> 8),
+         * an exact rewrite whose terms all fit in int16_t.
+         */
+        struct yuv_matrix
+        {
+            int y[3];
+            int u[3];
+            int v[3];
+            // red, green and blue from D = U - 128 and E = V - 128
+            int d[3];
+            int e[3];
+        };
+
+        inline constexpr yuv_matrix yuv_matrices[] = {
+            { { 66, 129, 25 }, { -38, -74, 112 }, { 112, -94, -18 }, { 0, -100, 516 }, { 409, -208, 0 } },
+            { { 47, 157, 16 }, { -26, -86, 112 }, { 112, -102, -10 }, { 0, -55, 541 }, { 459, -136, 0 } },
+        };
+
+        inline yuv_matrix const& yuv_coefficients(yuv_standard standard) noexcept
+        {
+            return yuv_matrices[static_cast<int>(standard)];
+        }
+
+        constexpr int yuv_split_high(int k) noexcept
+        {
+            return k + 128 >= 0 ? (k + 128) / 256 : -((255 - (k + 128)) / 256);
+        }
+
+        constexpr int yuv_split_low(int k) noexcept
+        {
+            return k - 256 * yuv_split_high(k);
+        }
+
+        inline uint8_t yuv_luma(yuv_matrix const& m, int r, int g, int b) noexcept
+        {
+            return static_cast<uint8_t>(((m.y[0] * r + m.y[1] * g + m.y[2] * b + 128) >> 8) + 16);
+        }
+
+        inline uint8_t yuv_chroma(int const* k, int r, int g, int b) noexcept
+        {
+            return static_cast<uint8_t>(((k[0] * r + k[1] * g + k[2] * b + 128) >> 8) + 128);
+        }
+
+        inline uint8_t yuv_channel(int c, int d, int e, int kd, int ke) noexcept
+        {
+            return static_cast<uint8_t>(std::min(std::max((298 * c + kd * d + ke * e + 128) >> 8, 0), 255));
+        }
+
+        template <pixel_format Format>
+        inline void yuv_pixel(yuv_matrix const& m, uint8_t y, uint8_t u, uint8_t v, uint8_t* dst) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            int const c = y - 16, d = u - 128, e = v - 128;
+            for (std::size_t k = 0; k < 3; ++k)
+                dst[traits::offset[k]] = yuv_channel(c, d, e, m.d[k], m.e[k]);
+            if constexpr (traits::bytes == 4)
+                dst[traits::offset[3]] = 255;
+        }
+
+        /*
+         * Lane shuffles. Packed pixels are split into their channels and
+         * merged back in 16-bit lanes, so that the arithmetic runs on
+         * batch<uint16_t> or batch<int16_t>; the only shuffles that cross
+         * lanes are the extraction of the even or odd lanes of two batches
+         * and narrow(), and zip_lo() / zip_hi() in the other direction.
+         */
+        struct color_even_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned n) noexcept { return (2 * i) % n; }
+        };
+
+        struct color_odd_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned n) noexcept { return (2 * i + 1) % n; }
+        };
+
+        struct color_low_half
+        {
+            static constexpr bool get(unsigned i, unsigned n) noexcept { return i < n / 2; }
+        };
+
+        // RGB triplets to 4-byte groups, the fourth byte being a copy of the third
+        struct color_expand_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned) noexcept { return (i / 4) * 3 + (i % 4 < 2 ? i % 4 : 2); }
+        };
+
+        // 4-byte groups to RGB triplets in the first three quarters
+        struct color_compress_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned n) noexcept { return i < 3 * n / 4 ? (i / 3) * 4 + i % 3 : i; }
+        };
+
+        // even lanes of x, then even lanes of y
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> color_even(batch<T, A> const& x, batch<T, A> const& y) noexcept
+        {
+            constexpr auto even = ::xsimd::make_batch_constant<T, color_even_lane, A>();
+            constexpr auto low = ::xsimd::make_batch_bool_constant<T, color_low_half, A>();
+            return select(low, swizzle(x, even), swizzle(y, even));
+        }
+
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> color_odd(batch<T, A> const& x, batch<T, A> const& y) noexcept
+        {
+            constexpr auto odd = ::xsimd::make_batch_constant<T, color_odd_lane, A>();
+            constexpr auto low = ::xsimd::make_batch_bool_constant<T, color_low_half, A>();
+            return select(low, swizzle(x, odd), swizzle(y, odd));
+        }
+
+        // bytes read or written past a group of pixels by color_unpack and color_pack
+        template <pixel_format Format, class A>
+        constexpr std::size_t color_overrun() noexcept
+        {
+            return pixel_format_traits<Format>::bytes == 3 ? batch<uint8_t, A>::size / 4 : 0;
+        }
+
+        template <std::size_t Byte, class A>
+        XSIMD_INLINE batch<uint16_t, A> color_byte(batch<uint16_t, A> const& lo, batch<uint16_t, A> const& hi) noexcept
+        {
+            auto const& word = Byte < 2 ? lo : hi;
+            if constexpr (Byte % 2 == 0)
+                return word & batch<uint16_t, A>(0xFF);
+            else
+                return word >> 8;
+        }
+
+        /*
+         * Loads the batch<uint16_t>::size pixels at src as one channel per
+         * batch, alpha being 255 for formats without it.
+         */
+        template <pixel_format Format, class A>
+        XSIMD_INLINE void color_unpack(uint8_t const* src, batch<uint16_t, A>& r, batch<uint16_t, A>& g,
+                                       batch<uint16_t, A>& b, batch<uint16_t, A>& a) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            using byte_batch = batch<uint8_t, A>;
+            constexpr std::size_t size = byte_batch::size;
+            byte_batch x0, x1;
+            if constexpr (traits::bytes == 4)
+            {
+                x0 = byte_batch::load_unaligned(src);
+                x1 = byte_batch::load_unaligned(src + size);
+            }
+            else
+            {
+                constexpr auto expand = ::xsimd::make_batch_constant<uint8_t, color_expand_lane, A>();
+                x0 = swizzle(byte_batch::load_unaligned(src), expand);
+                x1 = swizzle(byte_batch::load_unaligned(src + 3 * size / 4), expand);
+            }
+            auto const w0 = bitwise_cast<uint16_t>(x0);
+            auto const w1 = bitwise_cast<uint16_t>(x1);
+            auto const lo = color_even(w0, w1);
+            auto const hi = color_odd(w0, w1);
+            r = color_byte<traits::offset[0], A>(lo, hi);
+            g = color_byte<traits::offset[1], A>(lo, hi);
+            b = color_byte<traits::offset[2], A>(lo, hi);
+            if constexpr (traits::bytes == 4)
+                a = color_byte<3, A>(lo, hi);
+            else
+                a = batch<uint16_t, A>(255);
+        }
+
+        template <std::size_t Byte, pixel_format Format, class A>
+        XSIMD_INLINE batch<uint16_t, A> color_channel_at(batch<uint16_t, A> const& r, batch<uint16_t, A> const& g,
+                                                         batch<uint16_t, A> const& b, batch<uint16_t, A> const& a) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            if constexpr (traits::offset[0] == Byte)
+                return r;
+            else if constexpr (traits::offset[1] == Byte)
+                return g;
+            else if constexpr (traits::offset[2] == Byte)
+                return b;
+            else
+                return a;
+        }
+
+        /*
+         * Stores the batch<uint16_t>::size pixels whose channels, all in
+         * [0, 255], are given by r, g, b and a.
+         */
+        template <pixel_format Format, class A>
+        XSIMD_INLINE void color_pack(batch<uint16_t, A> const& r, batch<uint16_t, A> const& g, batch<uint16_t, A> const& b,
+                                     batch<uint16_t, A> const& a, uint8_t* dst) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            constexpr std::size_t size = batch<uint8_t, A>::size;
+            auto const lo = color_channel_at<0, Format>(r, g, b, a) | (color_channel_at<1, Format>(r, g, b, a) << 8);
+            auto const hi = color_channel_at<2, Format>(r, g, b, a) | (color_channel_at<3, Format>(r, g, b, a) << 8);
+            auto const p0 = bitwise_cast<uint8_t>(zip_lo(lo, hi));
+            auto const p1 = bitwise_cast<uint8_t>(zip_hi(lo, hi));
+            if constexpr (traits::bytes == 4)
+            {
+                p0.store_unaligned(dst);
+                p1.store_unaligned(dst + size);
+            }
+            else
+            {
+                // the last quarter of each store is overwritten by the next one
+                constexpr auto compress = ::xsimd::make_batch_constant<uint8_t, color_compress_lane, A>();
+                swizzle(p0, compress).store_unaligned(dst);
+                swizzle(p1, compress).store_unaligned(dst + 3 * size / 4);
+            }
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<uint16_t, A> yuv_luma(yuv_matrix const& m, batch<uint16_t, A> const& r, batch<uint16_t, A> const& g,
+                                                 batch<uint16_t, A> const& b) noexcept
+        {
+            // at most 220 * 255 + 128, which fits in 16 unsigned bits
+            using batch_type = batch<uint16_t, A>;
+            auto const sum = r * batch_type(uint16_t(m.y[0])) + g * batch_type(uint16_t(m.y[1])) + b * batch_type(uint16_t(m.y[2]));
+            return ((sum + batch_type(128)) >> 8) + batch_type(16);
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<uint16_t, A> yuv_chroma(int const* k, batch<uint16_t, A> const& r, batch<uint16_t, A> const& g,
+                                                   batch<uint16_t, A> const& b) noexcept
+        {
+            // within +-112 * 255 + 128
+            using batch_type = batch<int16_t, A>;
+            auto const sum = bitwise_cast<int16_t>(r) * batch_type(int16_t(k[0])) + bitwise_cast<int16_t>(g) * batch_type(int16_t(k[1]))
+                + bitwise_cast<int16_t>(b) * batch_type(int16_t(k[2]));
+            return bitwise_cast<uint16_t>(((sum + batch_type(128)) >> 8) + batch_type(128));
+        }
+
+        /*
+         * Chroma part of one output channel: high holds qd D + qe E and low
+         * holds rd D + re E + 128, see yuv_matrix.
+         */
+        template <class A>
+        struct yuv_chroma_terms
+        {
+            batch<int16_t, A> high;
+            batch<int16_t, A> low;
+        };
+
+        template <class A>
+        XSIMD_INLINE yuv_chroma_terms<A> yuv_terms(int kd, int ke, batch<int16_t, A> const& d, batch<int16_t, A> const& e) noexcept
+        {
+            using batch_type = batch<int16_t, A>;
+            auto const high = d * batch_type(int16_t(yuv_split_high(kd))) + e * batch_type(int16_t(yuv_split_high(ke)));
+            auto const low = d * batch_type(int16_t(yuv_split_low(kd))) + e * batch_type(int16_t(yuv_split_low(ke))) + batch_type(128);
+            return { high, low };
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<uint16_t, A> yuv_channel(batch<int16_t, A> const& c, batch<int16_t, A> const& high, batch<int16_t, A> const& low) noexcept
+        {
+            using batch_type = batch<int16_t, A>;
+            auto const x = c + high + ((c * batch_type(int16_t(yuv_split_low(298))) + low) >> 8);
+            return bitwise_cast<uint16_t>(clip(x, batch_type(0), batch_type(255)));
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<int16_t, A> yuv_centered(batch<uint16_t, A> const& x, int16_t offset) noexcept
+        {
+            return bitwise_cast<int16_t>(x) - batch<int16_t, A>(offset);
+        }
+
+        template <pixel_format Format, class A>
+        inline void rgb_to_yuv444_row(yuv_matrix const& m, uint8_t const* src, uint8_t* y, uint8_t* u, uint8_t* v, std::size_t n) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            using batch_type = batch<uint16_t, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t bytes = traits::bytes;
+
+            std::size_t i = 0;
+            for (; (i + 2 * size) * bytes + color_overrun<Format, A>() <= n * bytes; i += 2 * size)
+            {
+                batch_type r0, g0, b0, a0, r1, g1, b1, a1;
+                color_unpack<Format, A>(src + i * bytes, r0, g0, b0, a0);
+                color_unpack<Format, A>(src + (i + size) * bytes, r1, g1, b1, a1);
+                ::xsimd::narrow(yuv_luma(m, r0, g0, b0), yuv_luma(m, r1, g1, b1)).store_unaligned(y + i);
+                ::xsimd::narrow(yuv_chroma(m.u, r0, g0, b0), yuv_chroma(m.u, r1, g1, b1)).store_unaligned(u + i);
+                ::xsimd::narrow(yuv_chroma(m.v, r0, g0, b0), yuv_chroma(m.v, r1, g1, b1)).store_unaligned(v + i);
+            }
+            for (; i < n; ++i)
+            {
+                uint8_t const* p = src + i * bytes;
+                int const r = p[traits::offset[0]], g = p[traits::offset[1]], b = p[traits::offset[2]];
+                y[i] = yuv_luma(m, r, g, b);
+                u[i] = yuv_chroma(m.u, r, g, b);
+                v[i] = yuv_chroma(m.v, r, g, b);
+            }
+        }
+
+        template <pixel_format Format, class A>
+        inline void yuv444_to_rgb_row(yuv_matrix const& m, uint8_t const* y, uint8_t const* u, uint8_t const* v, uint8_t* dst, std::size_t n) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            using byte_batch = batch<uint8_t, A>;
+            using batch_type = batch<uint16_t, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t bytes = traits::bytes;
+            batch_type const alpha(255);
+
+            std::size_t i = 0;
+            for (; (i + 2 * size) * bytes + color_overrun<Format, A>() <= n * bytes; i += 2 * size)
+            {
+                auto const yw = widen(byte_batch::load_unaligned(y + i));
+                auto const uw = widen(byte_batch::load_unaligned(u + i));
+                auto const vw = widen(byte_batch::load_unaligned(v + i));
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    auto const c = yuv_centered(yw[h], 16);
+                    auto const d = yuv_centered(uw[h], 128);
+                    auto const e = yuv_centered(vw[h], 128);
+                    auto const tr = yuv_terms(m.d[0], m.e[0], d, e);
+                    auto const tg = yuv_terms(m.d[1], m.e[1], d, e);
+                    auto const tb = yuv_terms(m.d[2], m.e[2], d, e);
+                    color_pack<Format, A>(yuv_channel(c, tr.high, tr.low), yuv_channel(c, tg.high, tg.low),
+                                          yuv_channel(c, tb.high, tb.low), alpha, dst + (i + h * size) * bytes);
+                }
+            }
+            for (; i < n; ++i)
+                yuv_pixel<Format>(m, y[i], u[i], v[i], dst + i * bytes);
+        }
+
+        /*
+         * One row of chroma samples and the two rows of luma they cover. The
+         * chroma of a 2x2 block is computed from the rounded average of its
+         * pixels, the last column and row being replicated for odd sizes.
+         * Interleaved chroma goes to u as UV pairs (NV12), v being unused.
+         */
+        template <pixel_format Format, bool Interleaved, class A>
+        inline void rgb_to_yuv420_rows(yuv_matrix const& m, uint8_t const* top, uint8_t const* bottom, uint8_t* y_top, uint8_t* y_bottom,
+                                       uint8_t* u, uint8_t* v, std::size_t n) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            using batch_type = batch<uint16_t, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t bytes = traits::bytes;
+            batch_type const two(2);
+
+            std::size_t i = 0;
+            for (; (i + 4 * size) * bytes + color_overrun<Format, A>() <= n * bytes; i += 4 * size)
+            {
+                batch_type cu[2], cv[2];
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    std::size_t const x = i + 2 * h * size;
+                    batch_type rt0, gt0, bt0, at0, rt1, gt1, bt1, at1, rb0, gb0, bb0, ab0, rb1, gb1, bb1, ab1;
+                    color_unpack<Format, A>(top + x * bytes, rt0, gt0, bt0, at0);
+                    color_unpack<Format, A>(top + (x + size) * bytes, rt1, gt1, bt1, at1);
+                    color_unpack<Format, A>(bottom + x * bytes, rb0, gb0, bb0, ab0);
+                    color_unpack<Format, A>(bottom + (x + size) * bytes, rb1, gb1, bb1, ab1);
+                    ::xsimd::narrow(yuv_luma(m, rt0, gt0, bt0), yuv_luma(m, rt1, gt1, bt1)).store_unaligned(y_top + x);
+                    ::xsimd::narrow(yuv_luma(m, rb0, gb0, bb0), yuv_luma(m, rb1, gb1, bb1)).store_unaligned(y_bottom + x);
+
+                    auto const r0 = rt0 + rb0, r1 = rt1 + rb1;
+                    auto const g0 = gt0 + gb0, g1 = gt1 + gb1;
+                    auto const b0 = bt0 + bb0, b1 = bt1 + bb1;
+                    auto const r = (color_even(r0, r1) + color_odd(r0, r1) + two) >> 2;
+                    auto const g = (color_even(g0, g1) + color_odd(g0, g1) + two) >> 2;
+                    auto const b = (color_even(b0, b1) + color_odd(b0, b1) + two) >> 2;
+                    cu[h] = yuv_chroma(m.u, r, g, b);
+                    cv[h] = yuv_chroma(m.v, r, g, b);
+                }
+                if constexpr (Interleaved)
+                {
+                    constexpr std::size_t byte_size = batch<uint8_t, A>::size;
+                    bitwise_cast<uint8_t>(cu[0] | (cv[0] << 8)).store_unaligned(u + i);
+                    bitwise_cast<uint8_t>(cu[1] | (cv[1] << 8)).store_unaligned(u + i + byte_size);
+                }
+                else
+                {
+                    ::xsimd::narrow(cu[0], cu[1]).store_unaligned(u + i / 2);
+                    ::xsimd::narrow(cv[0], cv[1]).store_unaligned(v + i / 2);
+                }
+            }
+            for (; i < n; ++i)
+            {
+                uint8_t const* pt = top + i * bytes;
+                uint8_t const* pb = bottom + i * bytes;
+                y_top[i] = yuv_luma(m, pt[traits::offset[0]], pt[traits::offset[1]], pt[traits::offset[2]]);
+                y_bottom[i] = yuv_luma(m, pb[traits::offset[0]], pb[traits::offset[1]], pb[traits::offset[2]]);
+                if (i % 2 != 0)
+                    continue;
+                std::size_t const next = (i + 1 < n ? i + 1 : i) * bytes;
+                int avg[3];
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    std::size_t const o = traits::offset[k];
+                    avg[k] = (pt[o] + pb[o] + top[next + o] + bottom[next + o] + 2) >> 2;
+                }
+                uint8_t const cb = yuv_chroma(m.u, avg[0], avg[1], avg[2]);
+                uint8_t const cr = yuv_chroma(m.v, avg[0], avg[1], avg[2]);
+                if constexpr (Interleaved)
+                {
+                    u[i] = cb;
+                    u[i + 1] = cr;
+                }
+                else
+                {
+                    u[i / 2] = cb;
+                    v[i / 2] = cr;
+                }
+            }
+        }
+
+        // chroma samples are shared by the 2x2 pixels they cover (nearest neighbor)
+        template <pixel_format Format, bool Interleaved, class A>
+        inline void yuv420_to_rgb_rows(yuv_matrix const& m, uint8_t const* y_top, uint8_t const* y_bottom, uint8_t const* u, uint8_t const* v,
+                                       uint8_t* top, uint8_t* bottom, std::size_t n) noexcept
+        {
+            using traits = pixel_format_traits<Format>;
+            using byte_batch = batch<uint8_t, A>;
+            using batch_type = batch<uint16_t, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t bytes = traits::bytes;
+            batch_type const alpha(255), low_byte(0xFF);
+
+            std::size_t i = 0;
+            for (; (i + 4 * size) * bytes + color_overrun<Format, A>() <= n * bytes; i += 4 * size)
+            {
+                batch_type cb[2], cr[2];
+                if constexpr (Interleaved)
+                {
+                    for (std::size_t h = 0; h < 2; ++h)
+                    {
+                        auto const uv = bitwise_cast<uint16_t>(byte_batch::load_unaligned(u + i + 2 * h * size));
+                        cb[h] = uv & low_byte;
+                        cr[h] = uv >> 8;
+                    }
+                }
+                else
+                {
+                    auto const uw = widen(byte_batch::load_unaligned(u + i / 2));
+                    auto const vw = widen(byte_batch::load_unaligned(v + i / 2));
+                    cb[0] = uw[0];
+                    cb[1] = uw[1];
+                    cr[0] = vw[0];
+                    cr[1] = vw[1];
+                }
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    std::size_t const x = i + 2 * h * size;
+                    auto const d = yuv_centered(cb[h], 128);
+                    auto const e = yuv_centered(cr[h], 128);
+                    yuv_chroma_terms<A> const terms[3] = { yuv_terms(m.d[0], m.e[0], d, e), yuv_terms(m.d[1], m.e[1], d, e),
+                                                           yuv_terms(m.d[2], m.e[2], d, e) };
+                    for (std::size_t half = 0; half < 2; ++half)
+                    {
+                        batch<int16_t, A> high[3], low[3];
+                        for (std::size_t k = 0; k < 3; ++k)
+                        {
+                            high[k] = half == 0 ? zip_lo(terms[k].high, terms[k].high) : zip_hi(terms[k].high, terms[k].high);
+                            low[k] = half == 0 ? zip_lo(terms[k].low, terms[k].low) : zip_hi(terms[k].low, terms[k].low);
+                        }
+                        std::size_t const p = x + half * size;
+                        for (std::size_t row = 0; row < 2; ++row)
+                        {
+                            uint8_t const* luma = row == 0 ? y_top : y_bottom;
+                            uint8_t* dst = row == 0 ? top : bottom;
+                            auto const c = yuv_centered(widen(byte_batch::load_unaligned(luma + x))[half], 16);
+                            color_pack<Format, A>(yuv_channel(c, high[0], low[0]), yuv_channel(c, high[1], low[1]),
+                                                  yuv_channel(c, high[2], low[2]), alpha, dst + p * bytes);
+                        }
+                    }
+                }
+            }
+            for (; i < n; ++i)
+            {
+                std::size_t const c = i / 2;
+                uint8_t const cb_s = Interleaved ? u[2 * c] : u[c];
+                uint8_t const cr_s = Interleaved ? u[2 * c + 1] : v[c];
+                yuv_pixel<Format>(m, y_top[i], cb_s, cr_s, top + i * bytes);
+                yuv_pixel<Format>(m, y_bottom[i], cb_s, cr_s, bottom + i * bytes);
+            }
+        }
+
+        template <pixel_format Format, bool Interleaved, class A>
+        inline void rgb_to_yuv420(uint8_t const* src, std::size_t src_stride, uint8_t* y, std::size_t y_stride, uint8_t* u, std::size_t u_stride,
+                                  uint8_t* v, std::size_t v_stride, std::size_t width, std::size_t height, yuv_standard standard) noexcept
+        {
+            yuv_matrix const& m = yuv_coefficients(standard);
+            for (std::size_t row = 0; row < height; row += 2)
+            {
+                std::size_t const next = row + 1 < height ? row + 1 : row;
+                rgb_to_yuv420_rows<Format, Interleaved, A>(m, src + row * src_stride, src + next * src_stride, y + row * y_stride,
+                                                           y + next * y_stride, u + row / 2 * u_stride,
+                                                           Interleaved ? nullptr : v + row / 2 * v_stride, width);
+            }
+        }
+
+        template <pixel_format Format, bool Interleaved, class A>
+        inline void yuv420_to_rgb(uint8_t const* y, std::size_t y_stride, uint8_t const* u, std::size_t u_stride, uint8_t const* v,
+                                  std::size_t v_stride, uint8_t* dst, std::size_t dst_stride, std::size_t width, std::size_t height,
+                                  yuv_standard standard) noexcept
+        {
+            yuv_matrix const& m = yuv_coefficients(standard);
+            for (std::size_t row = 0; row < height; row += 2)
+            {
+                std::size_t const next = row + 1 < height ? row + 1 : row;
+                yuv420_to_rgb_rows<Format, Interleaved, A>(m, y + row * y_stride, y + next * y_stride, u + row / 2 * u_stride,
+                                                           Interleaved ? nullptr : v + row / 2 * v_stride, dst + row * dst_stride,
+                                                           dst + next * dst_stride, width);
+            }
+        }
+
+        struct color_reorder_base
+        {
+            template <pixel_format From, pixel_format To>
+            static constexpr unsigned source_byte(unsigned byte) noexcept
+            {
+                using from = pixel_format_traits<From>;
+                using to = pixel_format_traits<To>;
+                for (unsigned k = 0; k < 4; ++k)
+                    if (to::offset[k] == byte)
+                        return static_cast<unsigned>(from::offset[k]);
+                return byte;
+            }
+        };
+
+        template <pixel_format From, pixel_format To>
+        struct color_reorder_lane : color_reorder_base
+        {
+            static constexpr unsigned get(unsigned i, unsigned) noexcept { return (i / 4) * 4 + source_byte<From, To>(i % 4); }
+        };
+
+        struct color_alpha_lane
+        {
+            static constexpr bool get(unsigned i, unsigned) noexcept { return i % 2 != 0; }
+        };
+
+        // round(t / 255) for t in [0, 255 * 255], exactly
+        template <class A>
+        XSIMD_INLINE batch<uint16_t, A> color_div255(batch<uint16_t, A> const& t) noexcept
+        {
+            auto const x = t + batch<uint16_t, A>(128);
+            return (x + (x >> 8)) >> 8;
+        }
+
+        inline uint8_t color_unpremultiply(int c, int a) noexcept
+        {
+            if (a == 0)
+                return 0;
+            return static_cast<uint8_t>(std::min(std::floor(static_cast<float>(c * 255) / static_cast<float>(a) + 0.5f), 255.f));
+        }
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts packed pixels to full resolution (4:4:4) Y, U and V planes.
+     * Channels are combined with the 8-bit integer coefficients of the
+     * standard in 16-bit fixed point, rounding exactly as the scalar integer
+     * formula <tt>Y = ((66 R + 129 G + 25 B + 128) >> 8) + 16</tt> (BT.601).
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the source pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void rgb_to_yuv444(uint8_t const* src, std::size_t src_stride, uint8_t* y, std::size_t y_stride, uint8_t* u, std::size_t u_stride,
+                              uint8_t* v, std::size_t v_stride, std::size_t width, std::size_t height,
+                              yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::yuv_matrix const& m = detail::yuv_coefficients(standard);
+        for (std::size_t row = 0; row < height; ++row)
+            detail::rgb_to_yuv444_row<Format, A>(m, src + row * src_stride, y + row * y_stride, u + row * u_stride, v + row * v_stride, width);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts full resolution Y, U and V planes to packed pixels, alpha
+     * being set to 255. The 16-bit fixed point evaluation matches the scalar
+     * integer formula <tt>R = clamp((298 (Y - 16) + 409 (V - 128) + 128) >> 8)</tt>
+     * (BT.601) exactly.
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the destination pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void yuv444_to_rgb(uint8_t const* y, std::size_t y_stride, uint8_t const* u, std::size_t u_stride, uint8_t const* v,
+                              std::size_t v_stride, uint8_t* dst, std::size_t dst_stride, std::size_t width, std::size_t height,
+                              yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::yuv_matrix const& m = detail::yuv_coefficients(standard);
+        for (std::size_t row = 0; row < height; ++row)
+            detail::yuv444_to_rgb_row<Format, A>(m, y + row * y_stride, u + row * u_stride, v + row * v_stride, dst + row * dst_stride, width);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts packed pixels to I420: a full resolution Y plane and U and V
+     * planes subsampled by two in both directions. Each chroma sample is
+     * computed from the rounded average of the 2x2 pixels it covers, the last
+     * column and row being replicated when the size is odd. Rounding is
+     * exact, as in rgb_to_yuv444().
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the source pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void rgb_to_i420(uint8_t const* src, std::size_t src_stride, uint8_t* y, std::size_t y_stride, uint8_t* u, std::size_t u_stride,
+                            uint8_t* v, std::size_t v_stride, std::size_t width, std::size_t height,
+                            yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::rgb_to_yuv420<Format, false, A>(src, src_stride, y, y_stride, u, u_stride, v, v_stride, width, height, standard);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts I420 planes to packed pixels, each chroma sample being used
+     * for the 2x2 pixels it covers. Rounding is exact, as in yuv444_to_rgb().
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the destination pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void i420_to_rgb(uint8_t const* y, std::size_t y_stride, uint8_t const* u, std::size_t u_stride, uint8_t const* v,
+                            std::size_t v_stride, uint8_t* dst, std::size_t dst_stride, std::size_t width, std::size_t height,
+                            yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::yuv420_to_rgb<Format, false, A>(y, y_stride, u, u_stride, v, v_stride, dst, dst_stride, width, height, standard);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts packed pixels to NV12: a full resolution Y plane and a plane
+     * of interleaved U and V samples subsampled by two in both directions,
+     * computed as in rgb_to_i420().
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the source pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void rgb_to_nv12(uint8_t const* src, std::size_t src_stride, uint8_t* y, std::size_t y_stride, uint8_t* uv, std::size_t uv_stride,
+                            std::size_t width, std::size_t height, yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::rgb_to_yuv420<Format, true, A>(src, src_stride, y, y_stride, uv, uv_stride, nullptr, 0, width, height, standard);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts NV12 planes to packed pixels, as i420_to_rgb().
+     *
+     * Strides are in bytes.
+     *
+     * @tparam Format byte order of the destination pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void nv12_to_rgb(uint8_t const* y, std::size_t y_stride, uint8_t const* uv, std::size_t uv_stride, uint8_t* dst,
+                            std::size_t dst_stride, std::size_t width, std::size_t height,
+                            yuv_standard standard = yuv_standard::bt601) noexcept
+    {
+        detail::yuv420_to_rgb<Format, true, A>(y, y_stride, uv, uv_stride, nullptr, 0, dst, dst_stride, width, height, standard);
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts \c n packed pixels from one byte order to another, for
+     * instance RGBA to BGRA. Alpha is copied when both formats have it and
+     * set to 255 when only the destination has it. Pixels of four bytes are
+     * reordered with a single byte shuffle. \c src and \c dst may be the same
+     * array when both formats have four bytes per pixel.
+     *
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format From, pixel_format To, class A = default_arch>
+    inline void convert_pixels(uint8_t const* src, uint8_t* dst, std::size_t n) noexcept
+    {
+        using from = detail::pixel_format_traits<From>;
+        using to = detail::pixel_format_traits<To>;
+        using byte_batch = batch<uint8_t, A>;
+        constexpr std::size_t size = byte_batch::size;
+
+        std::size_t i = 0;
+        if constexpr (from::bytes == 4 && to::bytes == 4)
+        {
+            constexpr auto reorder = ::xsimd::make_batch_constant<uint8_t, detail::color_reorder_lane<From, To>, A>();
+            std::size_t const vec_size = n - n % (size / 4);
+            for (; i < vec_size; i += size / 4)
+                swizzle(byte_batch::load_unaligned(src + 4 * i), reorder).store_unaligned(dst + 4 * i);
+        }
+        else
+        {
+            using batch_type = batch<uint16_t, A>;
+            for (; (i + batch_type::size) * from::bytes + detail::color_overrun<From, A>() <= n * from::bytes
+                 && (i + batch_type::size) * to::bytes + detail::color_overrun<To, A>() <= n * to::bytes;
+                 i += batch_type::size)
+            {
+                batch_type r, g, b, a;
+                detail::color_unpack<From, A>(src + i * from::bytes, r, g, b, a);
+                detail::color_pack<To, A>(r, g, b, a, dst + i * to::bytes);
+            }
+        }
+        for (; i < n; ++i)
+        {
+            uint8_t const* p = src + i * from::bytes;
+            uint8_t* q = dst + i * to::bytes;
+            for (std::size_t k = 0; k < 3; ++k)
+                q[to::offset[k]] = p[from::offset[k]];
+            if constexpr (to::bytes == 4)
+                q[to::offset[3]] = from::bytes == 4 ? p[from::offset[3]] : uint8_t(255);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Multiplies the color channels of \c n RGBA or BGRA pixels by their
+     * alpha: <tt>c = round(c * a / 255)</tt>, computed exactly in 16-bit
+     * lanes. \c src and \c dst may be the same array.
+     *
+     * @tparam A architecture used for the kernels.
+     */
+    template <class A = default_arch>
+    inline void premultiply_alpha(uint8_t const* src, uint8_t* dst, std::size_t n) noexcept
+    {
+        using byte_batch = batch<uint8_t, A>;
+        using batch_type = batch<uint16_t, A>;
+        constexpr std::size_t size = byte_batch::size;
+        constexpr auto alpha_lane = ::xsimd::make_batch_bool_constant<uint16_t, detail::color_alpha_lane, A>();
+        batch_type const low_byte(0xFF);
+
+        std::size_t const vec_size = n - n % (size / 4);
+        std::size_t i = 0;
+        for (; i < vec_size; i += size / 4)
+        {
+            auto const pixels = bitwise_cast<uint32_t>(byte_batch::load_unaligned(src + 4 * i));
+            auto const alpha32 = pixels >> 24;
+            auto const alpha = bitwise_cast<uint16_t>(alpha32 | (alpha32 << 16));
+            // 16-bit lanes hold (c0, c1) and (c2, alpha)
+            auto const words = bitwise_cast<uint16_t>(pixels);
+            auto const even = detail::color_div255(alpha * (words & low_byte));
+            auto const odd = select(alpha_lane, words >> 8, detail::color_div255(alpha * (words >> 8)));
+            bitwise_cast<uint8_t>(even | (odd << 8)).store_unaligned(dst + 4 * i);
+        }
+        for (; i < n; ++i)
+        {
+            int const a = src[4 * i + 3];
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                int const x = src[4 * i + k] * a + 128;
+                dst[4 * i + k] = static_cast<uint8_t>((x + (x >> 8)) >> 8);
+            }
+            dst[4 * i + 3] = static_cast<uint8_t>(a);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Divides the color channels of \c n premultiplied RGBA or BGRA pixels by
+     * their alpha: <tt>c = min(255, floor(c * 255 / a + 0.5))</tt>, or 0 when
+     * alpha is 0. The quotient is computed with a correctly rounded single
+     * precision division, which makes the result exact. \c src and \c dst may
+     * be the same array.
+     *
+     * @tparam A architecture used for the kernels.
+     */
+    template <class A = default_arch>
+    inline void unpremultiply_alpha(uint8_t const* src, uint8_t* dst, std::size_t n) noexcept
+    {
+        using byte_batch = batch<uint8_t, A>;
+        using int_batch = batch<int32_t, A>;
+        using float_batch = batch<float, A>;
+        constexpr std::size_t size = byte_batch::size;
+        int_batch const low_byte(0xFF);
+        float_batch const zero(0.f), half(0.5f), max(255.f);
+
+        std::size_t const vec_size = n - n % (size / 4);
+        std::size_t i = 0;
+        for (; i < vec_size; i += size / 4)
+        {
+            auto const pixels = bitwise_cast<int32_t>(byte_batch::load_unaligned(src + 4 * i));
+            auto const alpha = bitwise_cast<int32_t>(bitwise_cast<uint32_t>(pixels) >> 24);
+            auto const alpha_f = to_float(alpha);
+            auto const opaque = alpha_f != zero;
+            auto const denominator = select(opaque, alpha_f, float_batch(1.f));
+            int_batch res = alpha << 24;
+            for (int k = 0; k < 3; ++k)
+            {
+                auto const c = to_float((pixels >> (8 * k)) & low_byte);
+                auto const q = min(floor(c * max / denominator + half), max);
+                res = res | (to_int(select(opaque, q, zero)) << (8 * k));
+            }
+            bitwise_cast<uint8_t>(res).store_unaligned(dst + 4 * i);
+        }
+        for (; i < n; ++i)
+        {
+            int const a = src[4 * i + 3];
+            for (std::size_t k = 0; k < 3; ++k)
+                dst[4 * i + k] = detail::color_unpremultiply(src[4 * i + k], a);
+            dst[4 * i + 3] = static_cast<uint8_t>(a);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_color
+     *
+     * Converts \c n packed pixels to full range gray levels with the BT.601
+     * luma weights: <tt>((77 R + 150 G + 29 B + 128) >> 8)</tt>, computed
+     * exactly in 16-bit lanes.
+     *
+     * @tparam Format byte order of the source pixels.
+     * @tparam A architecture used for the kernels.
+     */
+    template <pixel_format Format, class A = default_arch>
+    inline void rgb_to_gray(uint8_t const* src, uint8_t* dst, std::size_t n) noexcept
+    {
+        using traits = detail::pixel_format_traits<Format>;
+        using batch_type = batch<uint16_t, A>;
+        constexpr std::size_t size = batch_type::size;
+        constexpr std::size_t bytes = traits::bytes;
+        batch_type const wr(77), wg(150), wb(29), rounding(128);
+
+        std::size_t i = 0;
+        for (; (i + 2 * size) * bytes + detail::color_overrun<Format, A>() <= n * bytes; i += 2 * size)
+        {
+            batch_type r0, g0, b0, a0, r1, g1, b1, a1;
+            detail::color_unpack<Format, A>(src + i * bytes, r0, g0, b0, a0);
+            detail::color_unpack<Format, A>(src + (i + size) * bytes, r1, g1, b1, a1);
+            auto const y0 = (r0 * wr + g0 * wg + b0 * wb + rounding) >> 8;
+            auto const y1 = (r1 * wr + g1 * wg + b1 * wb + rounding) >> 8;
+            ::xsimd::narrow(y0, y1).store_unaligned(dst + i);
+        }
+        for (; i < n; ++i)
+        {
+            uint8_t const* p = src + i * bytes;
+            dst[i] = static_cast<uint8_t>((77 * p[traits::offset[0]] + 150 * p[traits::offset[1]] + 29 * p[traits::offset[2]] + 128) >> 8);
+        }
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_COMPLEX_MAC_HPP
+#define XSIMD_ALGORITHMS_COMPLEX_MAC_HPP
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_complex_mac Complex multiply-accumulate
+     */
+
+    namespace detail
+    {
+        struct complex_mac_odd_lane
+        {
+            static constexpr bool get(unsigned i, unsigned) noexcept { return (i & 1u) != 0; }
+        };
+
+        struct complex_mac_swap_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned) noexcept { return i ^ 1u; }
+        };
+
+        /*
+         * Sum of x[i] * y[i], or of conj(x[i]) * y[i] when Conj is set, over
+         * interleaved arrays of n complex values. Rather than forming each
+         * product, the loop accumulates x * y, which holds (xr * yr, xi * yi),
+         * and x * swap(y), which holds (xr * yi, xi * yr); the real and
+         * imaginary parts are recovered from the even and odd lanes once, at
+         * the end. This costs one shuffle per batch and keeps the accumulators
+         * independent of each other.
+         */
+        template <bool Conj, class A, class T>
+        inline std::complex<T> complex_dot(std::complex<T> const* x, std::complex<T> const* y, std::size_t n) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t unroll = 4;
+            constexpr auto swap = ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, complex_mac_swap_lane, A>();
+
+            T const* xr = reinterpret_cast<T const*>(x);
+            T const* yr = reinterpret_cast<T const*>(y);
+            std::size_t const count = 2 * n;
+
+            batch_type direct[unroll];
+            batch_type crossed[unroll];
+            for (std::size_t u = 0; u < unroll; ++u)
+            {
+                direct[u] = batch_type(T(0));
+                crossed[u] = batch_type(T(0));
+            }
+
+            std::size_t i = 0;
+            for (; i + unroll * size <= count; i += unroll * size)
+            {
+                for (std::size_t u = 0; u < unroll; ++u)
+                {
+                    auto const xb = batch_type::load_unaligned(xr + i + u * size);
+                    auto const yb = batch_type::load_unaligned(yr + i + u * size);
+                    direct[u] = fma(xb, yb, direct[u]);
+                    crossed[u] = fma(xb, swizzle(yb, swap), crossed[u]);
+                }
+            }
+            for (; i < count; i += size)
+            {
+                std::size_t const left = count - i;
+                auto const mask = batch_bool<T, A>::first_n(left < size ? left : size);
+                auto const xb = batch_type::load(xr + i, mask, unaligned_mode {});
+                auto const yb = batch_type::load(yr + i, mask, unaligned_mode {});
+                direct[0] = fma(xb, yb, direct[0]);
+                crossed[0] = fma(xb, swizzle(yb, swap), crossed[0]);
+            }
+
+            for (std::size_t u = 1; u < unroll; ++u)
+            {
+                direct[0] += direct[u];
+                crossed[0] += crossed[u];
+            }
+            constexpr auto odd = ::xsimd::make_batch_bool_constant<T, complex_mac_odd_lane, A>();
+            // x * y:       re = xr * yr - xi * yi, im = xr * yi + xi * yr
+            // conj(x) * y: re = xr * yr + xi * yi, im = xr * yi - xi * yr
+            if constexpr (Conj)
+                return { reduce_add(direct[0]), reduce_add(select(odd, -crossed[0], crossed[0])) };
+            else
+                return { reduce_add(select(odd, -direct[0], direct[0])), reduce_add(crossed[0]) };
+        }
+    }
+
+    /**
+     * @ingroup algorithms_complex_mac
+     *
+     * Computes the unconjugated dot product <tt>sum(x[i] * y[i])</tt> of two
+     * arrays of \c n complex values, working directly on their interleaved
+     * storage.
+     *
+     * @tparam A architecture used for the kernel.
+     */
+    template <class A = default_arch, class T>
+    inline std::complex<T> complex_dot(std::complex<T> const* x, std::complex<T> const* y, std::size_t n) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "complex_dot is only defined for floating point values");
+        return detail::complex_dot<false, A>(x, y, n);
+    }
+
+    /**
+     * @ingroup algorithms_complex_mac
+     *
+     * Computes the conjugated dot product <tt>sum(conj(x[i]) * y[i])</tt> of
+     * two arrays of \c n complex values, as applied by a beamformer with
+     * weights \c x to the channel samples \c y.
+     *
+     * @tparam A architecture used for the kernel.
+     */
+    template <class A = default_arch, class T>
+    inline std::complex<T> complex_dotc(std::complex<T> const* x, std::complex<T> const* y, std::size_t n) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "complex_dotc is only defined for floating point values");
+        return detail::complex_dot<true, A>(x, y, n);
+    }
+
+    /**
+     * @ingroup algorithms_complex_mac
+     *
+     * Element-wise complex multiply-accumulate <tt>acc[i] += x[i] * y[i]</tt>
+     * over arrays of \c n complex values, computed with interleaved_fma().
+     *
+     * @tparam A architecture used for the kernel.
+     */
+    template <class A = default_arch, class T>
+    inline void complex_mac(std::complex<T> const* x, std::complex<T> const* y, std::complex<T>* acc, std::size_t n) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "complex_mac is only defined for floating point values");
+        using batch_type = batch<T, A>;
+        constexpr std::size_t size = batch_type::size;
+
+        T const* xr = reinterpret_cast<T const*>(x);
+        T const* yr = reinterpret_cast<T const*>(y);
+        T* accr = reinterpret_cast<T*>(acc);
+        std::size_t const count = 2 * n;
+
+        std::size_t i = 0;
+        for (; i + size <= count; i += size)
+        {
+            auto const xb = batch_type::load_unaligned(xr + i);
+            auto const yb = batch_type::load_unaligned(yr + i);
+            interleaved_fma(xb, yb, batch_type::load_unaligned(accr + i)).store_unaligned(accr + i);
+        }
+        if (i < count)
+        {
+            auto const mask = batch_bool<T, A>::first_n(count - i);
+            auto const xb = batch_type::load(xr + i, mask, unaligned_mode {});
+            auto const yb = batch_type::load(yr + i, mask, unaligned_mode {});
+            auto const res = interleaved_fma(xb, yb, batch_type::load(accr + i, mask, unaligned_mode {}));
+            res.store(accr + i, mask, unaligned_mode {});
+        }
+    }
+
+    /**
+     * @ingroup algorithms_complex_mac
+     *
+     * Scales the array \c x of \c n complex values by \c a and accumulates it
+     * into \c y: <tt>y[i] += a * x[i]</tt>.
+     *
+     * @tparam A architecture used for the kernel.
+     */
+    template <class A = default_arch, class T>
+    inline void complex_axpy(std::complex<T> a, std::complex<T> const* x, std::complex<T>* y, std::size_t n) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "complex_axpy is only defined for floating point values");
+        using batch_type = batch<T, A>;
+        constexpr std::size_t size = batch_type::size;
+        constexpr auto swap = ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, detail::complex_mac_swap_lane, A>();
+        constexpr auto odd = ::xsimd::make_batch_bool_constant<T, detail::complex_mac_odd_lane, A>();
+
+        // a * x = (ar, ar) * (xr, xi) + (-ai, ai) * (xi, xr)
+        batch_type const a_re(a.real());
+        batch_type const a_im = select(odd, batch_type(a.imag()), batch_type(-a.imag()));
+
+        T const* xr = reinterpret_cast<T const*>(x);
+        T* yr = reinterpret_cast<T*>(y);
+        std::size_t const count = 2 * n;
+
+        std::size_t i = 0;
+        for (; i + size <= count; i += size)
+        {
+            auto const xb = batch_type::load_unaligned(xr + i);
+            auto const yb = fma(xb, a_re, batch_type::load_unaligned(yr + i));
+            fma(swizzle(xb, swap), a_im, yb).store_unaligned(yr + i);
+        }
+        if (i < count)
+        {
+            auto const mask = batch_bool<T, A>::first_n(count - i);
+            auto const xb = batch_type::load(xr + i, mask, unaligned_mode {});
+            auto const yb = fma(xb, a_re, batch_type::load(yr + i, mask, unaligned_mode {}));
+            fma(swizzle(xb, swap), a_im, yb).store(yr + i, mask, unaligned_mode {});
+        }
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,703 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_DISTANCE_HPP
+#define XSIMD_ALGORITHMS_DISTANCE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../xsimd.hpp"
+#include "./xsimd_selection.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_distance Distances
+     *
+     * Distances between vectors of \c dim elements of type \c float, \c fp16
+     * or \c int8_t, and Hamming distances between binary codes of \c words
+     * \c uint64_t words. Sets of vectors are stored row-major, one vector
+     * after the other.
+     *
+     * Each distance comes for a single pair of vectors, for one query against
+     * \c n points, and for a block of \c nq queries against \c np points, the
+     * latter writing \c nq rows of \c np distances. Points are loaded once for
+     * four queries in the block form, which is the one to use when several
+     * queries are known at once.
+     *
+     * Distances between \c float and \c fp16 vectors are computed in \c float,
+     * and those between \c int8_t vectors exactly, in \c int32_t.
+     */
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * An IEEE 754 half precision value, stored as its bit pattern. It is a
+     * storage type only: distances convert it to \c float on load.
+     */
+    struct fp16
+    {
+        uint16_t bits;
+    };
+
+    namespace detail
+    {
+        template <class T>
+        struct distance_traits;
+
+        template <>
+        struct distance_traits<float>
+        {
+            using scalar_type = float;
+            using result_type = float;
+        };
+
+        template <>
+        struct distance_traits<fp16>
+        {
+            using scalar_type = float;
+            using result_type = float;
+        };
+
+        template <>
+        struct distance_traits<int8_t>
+        {
+            using scalar_type = int32_t;
+            using result_type = int32_t;
+        };
+
+        template <>
+        struct distance_traits<uint64_t>
+        {
+            using scalar_type = uint64_t;
+            using result_type = uint32_t;
+        };
+
+        template <class T>
+        using distance_scalar_t = typename distance_traits<T>::scalar_type;
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Type of the distances between vectors of \c T: \c float for \c float
+     * and \c fp16, \c int32_t for \c int8_t.
+     */
+    template <class T>
+    using distance_t = typename detail::distance_traits<T>::result_type;
+
+    namespace detail
+    {
+        /*
+         * Half to float conversion on the bit patterns: the exponent is
+         * rebiased, infinities and NaNs get the maximal exponent, and
+         * subnormals are renormalized through a float subtraction.
+         */
+        template <class A>
+        inline batch<float, A> fp16_to_float(batch<uint32_t, A> const& h) noexcept
+        {
+            using ubatch = batch<uint32_t, A>;
+            ubatch const shifted_exp(0x7C00u << 13);
+            ubatch o = (h & ubatch(0x7FFFu)) << 13;
+            ubatch const exp = o & shifted_exp;
+            o += ubatch((127u - 15u) << 23);
+            o = select(exp == shifted_exp, o + ubatch((128u - 16u) << 23), o);
+            batch<float, A> const magic = ::xsimd::bitwise_cast<float>(ubatch(113u << 23));
+            batch<float, A> const subnormal = ::xsimd::bitwise_cast<float>(o + ubatch(1u << 23)) - magic;
+            o = select(exp == ubatch(0), ::xsimd::bitwise_cast<uint32_t>(subnormal), o);
+            return ::xsimd::bitwise_cast<float>(o | ((h & ubatch(0x8000u)) << 16));
+        }
+
+        inline float fp16_to_float(uint16_t h) noexcept
+        {
+            uint32_t const shifted_exp = 0x7C00u << 13;
+            uint32_t o = (h & 0x7FFFu) << 13;
+            uint32_t const exp = o & shifted_exp;
+            o += (127u - 15u) << 23;
+            float f;
+            if (exp == shifted_exp)
+            {
+                o += (128u - 16u) << 23;
+            }
+            else if (exp == 0)
+            {
+                o += 1u << 23;
+                std::memcpy(&f, &o, sizeof(f));
+                f -= 6.103515625e-05f; // 2^-14, the float of bit pattern 113 << 23
+                std::memcpy(&o, &f, sizeof(f));
+            }
+            o |= uint32_t(h & 0x8000u) << 16;
+            std::memcpy(&f, &o, sizeof(f));
+            return f;
+        }
+
+        // How a chunk of elements is loaded into the batches the distances
+        // accumulate, and the scalar used for the remaining elements.
+        template <class A, class T>
+        struct distance_chunk;
+
+        template <class A>
+        struct distance_chunk<A, float>
+        {
+            using value_batch = batch<float, A>;
+            using acc_batch = batch<float, A>;
+            static constexpr std::size_t parts = 1;
+            static constexpr std::size_t size = value_batch::size;
+
+            static std::array<value_batch, parts> load(float const* src) noexcept
+            {
+                return { value_batch::load_unaligned(src) };
+            }
+
+            static float load_scalar(float x) noexcept { return x; }
+        };
+
+        template <class A>
+        struct distance_chunk<A, fp16>
+        {
+            using value_batch = batch<float, A>;
+            using acc_batch = batch<float, A>;
+            static constexpr std::size_t parts = 2;
+            static constexpr std::size_t size = batch<uint16_t, A>::size;
+
+            static std::array<value_batch, parts> load(fp16 const* src) noexcept
+            {
+                auto const h = widen(batch<uint16_t, A>::load_unaligned(reinterpret_cast<uint16_t const*>(src)));
+                return { fp16_to_float(h[0]), fp16_to_float(h[1]) };
+            }
+
+            static float load_scalar(fp16 x) noexcept { return fp16_to_float(x.bits); }
+        };
+
+        // int8 products and differences are exact in int16
+        template <class A>
+        struct distance_chunk<A, int8_t>
+        {
+            using value_batch = batch<int16_t, A>;
+            using acc_batch = batch<int32_t, A>;
+            static constexpr std::size_t parts = 2;
+            static constexpr std::size_t size = batch<int8_t, A>::size;
+
+            static std::array<value_batch, parts> load(int8_t const* src) noexcept
+            {
+                return widen(batch<int8_t, A>::load_unaligned(src));
+            }
+
+            static int32_t load_scalar(int8_t x) noexcept { return x; }
+        };
+
+        template <class A>
+        struct distance_chunk<A, uint64_t>
+        {
+            using value_batch = batch<uint64_t, A>;
+            using acc_batch = batch<uint64_t, A>;
+            static constexpr std::size_t parts = 1;
+            static constexpr std::size_t size = value_batch::size;
+
+            static std::array<value_batch, parts> load(uint64_t const* src) noexcept
+            {
+                return { value_batch::load_unaligned(src) };
+            }
+
+            static uint64_t load_scalar(uint64_t x) noexcept { return x; }
+        };
+
+        // acc + x * y
+        template <class A>
+        inline batch<float, A> dot_acc(batch<float, A> const& acc, batch<float, A> const& x, batch<float, A> const& y) noexcept
+        {
+            return fma(x, y, acc);
+        }
+        template <class A>
+        inline batch<int32_t, A> dot_acc(batch<int32_t, A> const& acc, batch<int16_t, A> const& x, batch<int16_t, A> const& y) noexcept
+        {
+            auto const products = widen(x * y);
+            return acc + products[0] + products[1];
+        }
+        template <class T>
+        inline T dot_acc(T acc, T x, T y) noexcept
+        {
+            return acc + x * y;
+        }
+
+        // acc + (x - y)^2
+        template <class A>
+        inline batch<float, A> l2_acc(batch<float, A> const& acc, batch<float, A> const& x, batch<float, A> const& y) noexcept
+        {
+            auto const diff = x - y;
+            return fma(diff, diff, acc);
+        }
+        template <class A>
+        inline batch<int32_t, A> l2_acc(batch<int32_t, A> const& acc, batch<int16_t, A> const& x, batch<int16_t, A> const& y) noexcept
+        {
+            // squares of differences up to 255 only fit in uint16
+            auto const diff = x - y;
+            auto const squares = widen(::xsimd::bitwise_cast<uint16_t>(diff * diff));
+            return acc + ::xsimd::bitwise_cast<int32_t>(squares[0] + squares[1]);
+        }
+        template <class T>
+        inline T l2_acc(T acc, T x, T y) noexcept
+        {
+            return acc + (x - y) * (x - y);
+        }
+
+        // acc + popcount(x ^ y)
+        template <class A>
+        inline batch<uint64_t, A> hamming_acc(batch<uint64_t, A> const& acc, batch<uint64_t, A> const& x, batch<uint64_t, A> const& y) noexcept
+        {
+            return acc + ::xsimd::popcount(x ^ y);
+        }
+        inline uint64_t hamming_acc(uint64_t acc, uint64_t x, uint64_t y) noexcept
+        {
+            return acc + static_cast<uint64_t>(detail::popcount(x ^ y));
+        }
+
+        // The sums each metric accumulates, x being the query and y the point.
+        struct l2_metric
+        {
+            static constexpr std::size_t sums = 1;
+            template <class S, class V>
+            static void accumulate(S* acc, V const& x, V const& y) noexcept { acc[0] = l2_acc(acc[0], x, y); }
+        };
+
+        struct dot_metric
+        {
+            static constexpr std::size_t sums = 1;
+            template <class S, class V>
+            static void accumulate(S* acc, V const& x, V const& y) noexcept { acc[0] = dot_acc(acc[0], x, y); }
+        };
+
+        // x.y and y.y, the norm of the query being computed once
+        struct cosine_metric
+        {
+            static constexpr std::size_t sums = 2;
+            template <class S, class V>
+            static void accumulate(S* acc, V const& x, V const& y) noexcept
+            {
+                acc[0] = dot_acc(acc[0], x, y);
+                acc[1] = dot_acc(acc[1], y, y);
+            }
+        };
+
+        // x.y, y.y and x.x, for a single pair
+        struct cosine_pair_metric
+        {
+            static constexpr std::size_t sums = 3;
+            template <class S, class V>
+            static void accumulate(S* acc, V const& x, V const& y) noexcept
+            {
+                cosine_metric::accumulate(acc, x, y);
+                acc[2] = dot_acc(acc[2], x, x);
+            }
+        };
+
+        struct hamming_metric
+        {
+            static constexpr std::size_t sums = 1;
+            template <class S, class V>
+            static void accumulate(S* acc, V const& x, V const& y) noexcept { acc[0] = hamming_acc(acc[0], x, y); }
+        };
+
+        /*
+         * Accumulates the sums of metric M between Q queries and one point.
+         * Independent accumulators, four batches' worth when Q is small, hide
+         * the latency of the FMAs; the point is loaded once for all queries.
+         */
+        template <class A, class M, std::size_t Q, class T>
+        inline void distance_sums(T const* const* queries, T const* point, std::size_t dim, distance_scalar_t<T> (*sums)[M::sums]) noexcept
+        {
+            using chunk = distance_chunk<A, T>;
+            using acc_batch = typename chunk::acc_batch;
+            constexpr std::size_t size = chunk::size;
+            constexpr std::size_t parts = chunk::parts;
+            constexpr std::size_t unroll = Q * parts >= 4 ? 1 : 4 / (Q * parts);
+
+            // vectors shorter than a batch, e.g. binary codes, are summed
+            // as scalars
+            if (dim < size)
+            {
+                for (std::size_t q = 0; q < Q; ++q)
+                    for (std::size_t s = 0; s < M::sums; ++s)
+                        sums[q][s] = 0;
+                for (std::size_t i = 0; i < dim; ++i)
+                {
+                    auto const y = chunk::load_scalar(point[i]);
+                    for (std::size_t q = 0; q < Q; ++q)
+                        M::accumulate(sums[q], chunk::load_scalar(queries[q][i]), y);
+                }
+                return;
+            }
+
+            acc_batch acc[Q][unroll * parts][M::sums];
+            for (std::size_t q = 0; q < Q; ++q)
+                for (std::size_t j = 0; j < unroll * parts; ++j)
+                    for (std::size_t s = 0; s < M::sums; ++s)
+                        acc[q][j][s] = acc_batch(0);
+
+            std::size_t const unroll_end = dim - dim % (unroll * size);
+            std::size_t const vec_end = dim - dim % size;
+            std::size_t i = 0;
+            for (; i < unroll_end; i += unroll * size)
+            {
+                for (std::size_t u = 0; u < unroll; ++u)
+                {
+                    auto const y = chunk::load(point + i + u * size);
+                    for (std::size_t q = 0; q < Q; ++q)
+                    {
+                        auto const x = chunk::load(queries[q] + i + u * size);
+                        for (std::size_t p = 0; p < parts; ++p)
+                            M::accumulate(acc[q][u * parts + p], x[p], y[p]);
+                    }
+                }
+            }
+            for (; i < vec_end; i += size)
+            {
+                auto const y = chunk::load(point + i);
+                for (std::size_t q = 0; q < Q; ++q)
+                {
+                    auto const x = chunk::load(queries[q] + i);
+                    for (std::size_t p = 0; p < parts; ++p)
+                        M::accumulate(acc[q][p], x[p], y[p]);
+                }
+            }
+
+            for (std::size_t q = 0; q < Q; ++q)
+            {
+                for (std::size_t s = 0; s < M::sums; ++s)
+                {
+                    acc_batch total = acc[q][0][s];
+                    for (std::size_t j = 1; j < unroll * parts; ++j)
+                        total += acc[q][j][s];
+                    sums[q][s] = static_cast<distance_scalar_t<T>>(reduce_add(total));
+                }
+            }
+            for (i = vec_end; i < dim; ++i)
+            {
+                auto const y = chunk::load_scalar(point[i]);
+                for (std::size_t q = 0; q < Q; ++q)
+                    M::accumulate(sums[q], chunk::load_scalar(queries[q][i]), y);
+            }
+        }
+
+        // out[q * np + j] = finish(q, sums of query q and point j)
+        template <class A, class M, class T, class R, class F>
+        inline void distance_block(T const* queries, std::size_t nq, T const* points, std::size_t np, std::size_t dim, R* out, F const& finish) noexcept
+        {
+            using scalar_type = distance_scalar_t<T>;
+            constexpr std::size_t block = 4;
+            std::size_t q = 0;
+            for (; q + block <= nq; q += block)
+            {
+                T const* const rows[block] = { queries + q * dim, queries + (q + 1) * dim, queries + (q + 2) * dim, queries + (q + 3) * dim };
+                for (std::size_t j = 0; j < np; ++j)
+                {
+                    scalar_type sums[block][M::sums];
+                    distance_sums<A, M, block>(rows, points + j * dim, dim, sums);
+                    for (std::size_t b = 0; b < block; ++b)
+                        out[(q + b) * np + j] = finish(q + b, sums[b]);
+                }
+            }
+            for (; q < nq; ++q)
+            {
+                T const* const row = queries + q * dim;
+                for (std::size_t j = 0; j < np; ++j)
+                {
+                    scalar_type sums[1][M::sums];
+                    distance_sums<A, M, 1>(&row, points + j * dim, dim, sums);
+                    out[q * np + j] = finish(q, sums[0]);
+                }
+            }
+        }
+
+        // 1 - x.y / (|x| |y|), and 1 when either vector is zero
+        inline float cosine_from_sums(float xy, float xx, float yy) noexcept
+        {
+            float const norms = std::sqrt(xx * yy);
+            return norms > 0.f ? 1.f - xy / norms : 1.f;
+        }
+
+        template <class T>
+        struct distance_identity
+        {
+            template <class S>
+            distance_t<T> operator()(std::size_t, S const* sums) const noexcept
+            {
+                return static_cast<distance_t<T>>(sums[0]);
+            }
+        };
+
+        template <class A, class T>
+        inline void cosine_block(T const* queries, std::size_t nq, T const* points, std::size_t np, std::size_t dim, float* out)
+        {
+            std::vector<float> norms(nq);
+            for (std::size_t q = 0; q < nq; ++q)
+            {
+                distance_scalar_t<T> sums[1][1];
+                T const* const row = queries + q * dim;
+                distance_sums<A, dot_metric, 1>(&row, row, dim, sums);
+                norms[q] = static_cast<float>(sums[0][0]);
+            }
+            distance_block<A, cosine_metric>(queries, nq, points, np, dim, out, [&](std::size_t q, distance_scalar_t<T> const* sums)
+                                             { return cosine_from_sums(static_cast<float>(sums[0]), norms[q], static_cast<float>(sums[1])); });
+        }
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Squared Euclidean distance between two vectors.
+     *
+     * @param x the first vector.
+     * @param y the second vector.
+     * @param dim the number of elements of each vector.
+     * @return the sum of <tt>(x[i] - y[i])^2</tt>.
+     */
+    template <class A = default_arch, class T>
+    inline distance_t<T> squared_l2_distance(T const* x, T const* y, std::size_t dim) noexcept
+    {
+        detail::distance_scalar_t<T> sums[1][1];
+        detail::distance_sums<A, detail::l2_metric, 1>(&x, y, dim, sums);
+        return static_cast<distance_t<T>>(sums[0][0]);
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Inner product of two vectors.
+     *
+     * @param x the first vector.
+     * @param y the second vector.
+     * @param dim the number of elements of each vector.
+     * @return the sum of <tt>x[i] * y[i]</tt>.
+     */
+    template <class A = default_arch, class T>
+    inline distance_t<T> inner_product(T const* x, T const* y, std::size_t dim) noexcept
+    {
+        detail::distance_scalar_t<T> sums[1][1];
+        detail::distance_sums<A, detail::dot_metric, 1>(&x, y, dim, sums);
+        return static_cast<distance_t<T>>(sums[0][0]);
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Cosine distance between two vectors, one minus the cosine of their
+     * angle. It is 1 when either vector is zero.
+     *
+     * @param x the first vector.
+     * @param y the second vector.
+     * @param dim the number of elements of each vector.
+     * @return <tt>1 - x.y / (|x| |y|)</tt>.
+     */
+    template <class A = default_arch, class T>
+    inline float cosine_distance(T const* x, T const* y, std::size_t dim) noexcept
+    {
+        detail::distance_scalar_t<T> sums[1][3];
+        detail::distance_sums<A, detail::cosine_pair_metric, 1>(&x, y, dim, sums);
+        return detail::cosine_from_sums(static_cast<float>(sums[0][0]), static_cast<float>(sums[0][2]), static_cast<float>(sums[0][1]));
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Squared Euclidean distances between a query and \c n points.
+     *
+     * @param query the query vector.
+     * @param points the \c n points.
+     * @param n the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the \c n distances.
+     */
+    template <class A = default_arch, class T>
+    inline void squared_l2_distances(T const* query, T const* points, std::size_t n, std::size_t dim, distance_t<T>* out) noexcept
+    {
+        detail::distance_block<A, detail::l2_metric>(query, 1, points, n, dim, out, detail::distance_identity<T> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Squared Euclidean distances between \c nq queries and \c np points.
+     *
+     * @param queries the \c nq queries.
+     * @param nq the number of queries.
+     * @param points the \c np points.
+     * @param np the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the distances, \c np for each query.
+     */
+    template <class A = default_arch, class T>
+    inline void squared_l2_distances(T const* queries, std::size_t nq, T const* points, std::size_t np, std::size_t dim, distance_t<T>* out) noexcept
+    {
+        detail::distance_block<A, detail::l2_metric>(queries, nq, points, np, dim, out, detail::distance_identity<T> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Inner products between a query and \c n points.
+     *
+     * @param query the query vector.
+     * @param points the \c n points.
+     * @param n the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the \c n inner products.
+     */
+    template <class A = default_arch, class T>
+    inline void inner_products(T const* query, T const* points, std::size_t n, std::size_t dim, distance_t<T>* out) noexcept
+    {
+        detail::distance_block<A, detail::dot_metric>(query, 1, points, n, dim, out, detail::distance_identity<T> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Inner products between \c nq queries and \c np points.
+     *
+     * @param queries the \c nq queries.
+     * @param nq the number of queries.
+     * @param points the \c np points.
+     * @param np the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the inner products, \c np for each query.
+     */
+    template <class A = default_arch, class T>
+    inline void inner_products(T const* queries, std::size_t nq, T const* points, std::size_t np, std::size_t dim, distance_t<T>* out) noexcept
+    {
+        detail::distance_block<A, detail::dot_metric>(queries, nq, points, np, dim, out, detail::distance_identity<T> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Cosine distances between a query and \c n points.
+     *
+     * @param query the query vector.
+     * @param points the \c n points.
+     * @param n the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the \c n distances.
+     */
+    template <class A = default_arch, class T>
+    inline void cosine_distances(T const* query, T const* points, std::size_t n, std::size_t dim, float* out)
+    {
+        detail::cosine_block<A>(query, 1, points, n, dim, out);
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Cosine distances between \c nq queries and \c np points.
+     *
+     * @param queries the \c nq queries.
+     * @param nq the number of queries.
+     * @param points the \c np points.
+     * @param np the number of points.
+     * @param dim the number of elements of each vector.
+     * @param out the distances, \c np for each query.
+     */
+    template <class A = default_arch, class T>
+    inline void cosine_distances(T const* queries, std::size_t nq, T const* points, std::size_t np, std::size_t dim, float* out)
+    {
+        detail::cosine_block<A>(queries, nq, points, np, dim, out);
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Hamming distance between two binary codes, the number of bits in which
+     * they differ.
+     *
+     * @param x the first code.
+     * @param y the second code.
+     * @param words the number of words of each code.
+     * @return the number of bits set in <tt>x ^ y</tt>.
+     */
+    template <class A = default_arch>
+    inline uint32_t hamming_distance(uint64_t const* x, uint64_t const* y, std::size_t words) noexcept
+    {
+        uint64_t sums[1][1];
+        detail::distance_sums<A, detail::hamming_metric, 1>(&x, y, words, sums);
+        return static_cast<uint32_t>(sums[0][0]);
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Hamming distances between a query code and \c n codes.
+     *
+     * @param query the query code.
+     * @param codes the \c n codes.
+     * @param n the number of codes.
+     * @param words the number of words of each code.
+     * @param out the \c n distances.
+     */
+    template <class A = default_arch>
+    inline void hamming_distances(uint64_t const* query, uint64_t const* codes, std::size_t n, std::size_t words, uint32_t* out) noexcept
+    {
+        detail::distance_block<A, detail::hamming_metric>(query, 1, codes, n, words, out, detail::distance_identity<uint64_t> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Hamming distances between \c nq query codes and \c np codes.
+     *
+     * @param queries the \c nq query codes.
+     * @param nq the number of queries.
+     * @param codes the \c np codes.
+     * @param np the number of codes.
+     * @param words the number of words of each code.
+     * @param out the distances, \c np for each query.
+     */
+    template <class A = default_arch>
+    inline void hamming_distances(uint64_t const* queries, std::size_t nq, uint64_t const* codes, std::size_t np, std::size_t words, uint32_t* out) noexcept
+    {
+        detail::distance_block<A, detail::hamming_metric>(queries, nq, codes, np, words, out, detail::distance_identity<uint64_t> {});
+    }
+
+    /**
+     * @ingroup algorithms_distance
+     *
+     * Selects the \c k smallest of \c n distances, as computed by the
+     * functions above.
+     *
+     * This is top_k for the smallest values: ties are broken by index, and
+     * NaNs are never selected.
+     *
+     * @param distances the \c n distances.
+     * @param n the number of distances.
+     * @param k the number of distances to select.
+     * @param indices the indices of the selected distances, by increasing
+     * distance.
+     * @return the number of indices written, <tt>min(k, n)</tt> less the
+     * NaNs if any.
+     */
+    template <class A = default_arch, class T>
+    inline std::size_t nearest_k(T const* distances, std::size_t n, std::size_t k, uint32_t* indices)
+    {
+        return detail::select_k<A, false>(distances, n, k, indices, nan_policy::omit);
+    }
+}
+
+#endif
+
+#endif
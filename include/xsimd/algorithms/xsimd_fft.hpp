@@ -0,0 +1,836 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_FFT_HPP
+#define XSIMD_ALGORITHMS_FFT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_fft Fast Fourier transform
+     */
+
+    namespace detail
+    {
+        struct fft_swap_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned) noexcept { return i ^ 1u; }
+        };
+
+        struct fft_reverse_lane
+        {
+            static constexpr unsigned get(unsigned i, unsigned n) noexcept { return (n - 2 - (i & ~1u)) | (i & 1u); }
+        };
+
+        struct fft_odd_lane
+        {
+            static constexpr bool get(unsigned i, unsigned) noexcept { return (i & 1u) != 0; }
+        };
+
+        /*
+         * Arithmetic on batches holding interleaved complex values
+         * (re0, im0, re1, im1, ...). Inverse transforms conjugate every root of
+         * unity, which amounts to rotating by i instead of -i.
+         */
+        template <class T, class A, bool Inverse>
+        struct fft_ops
+        {
+            using batch_type = batch<T, A>;
+
+            batch_type rot_sign;
+
+            fft_ops() noexcept
+                : rot_sign(select(::xsimd::make_batch_bool_constant<T, fft_odd_lane, A>(),
+                                  batch_type(Inverse ? T(0) : T(-0.)), batch_type(Inverse ? T(-0.) : T(0))))
+            {
+            }
+
+            // (im, re)
+            static XSIMD_INLINE batch_type swap(batch_type const& x) noexcept
+            {
+                return swizzle(x, ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, fft_swap_lane, A>());
+            }
+
+            // multiplication by -i, or by i for the inverse transform
+            XSIMD_INLINE batch_type rot(batch_type const& x) const noexcept
+            {
+                return swap(x) ^ rot_sign;
+            }
+
+            // multiplication by the twiddle (wr, wi), both parts duplicated
+            // over the lanes of each complex value
+            static XSIMD_INLINE batch_type twiddle(batch_type const& x, batch_type const& wr, batch_type const& wi) noexcept
+            {
+                return fmas(x, wr, swap(x) * wi);
+            }
+        };
+
+        /*
+         * In-place DFT of size P of a[0], ..., a[P - 1], each batch holding the
+         * same element of several independent transforms.
+         */
+        template <class Ops, class B>
+        XSIMD_INLINE void fft_butterfly(std::integral_constant<std::size_t, 2>, Ops const&, B* a) noexcept
+        {
+            B const t = a[0];
+            a[0] = t + a[1];
+            a[1] = t - a[1];
+        }
+
+        template <class Ops, class B>
+        XSIMD_INLINE void fft_butterfly(std::integral_constant<std::size_t, 3>, Ops const& ops, B* a) noexcept
+        {
+            using T = typename B::value_type;
+            B const t1 = a[1] + a[2];
+            B const t2 = ops.rot(a[1] - a[2]) * B(T(0.866025403784438646763723170752936183L));
+            B const m = fma(t1, B(T(-0.5)), a[0]);
+            a[0] = a[0] + t1;
+            a[1] = m + t2;
+            a[2] = m - t2;
+        }
+
+        template <class Ops, class B>
+        XSIMD_INLINE void fft_butterfly(std::integral_constant<std::size_t, 4>, Ops const& ops, B* a) noexcept
+        {
+            B const t0 = a[0] + a[2];
+            B const t1 = a[0] - a[2];
+            B const t2 = a[1] + a[3];
+            B const t3 = ops.rot(a[1] - a[3]);
+            a[0] = t0 + t2;
+            a[1] = t1 + t3;
+            a[2] = t0 - t2;
+            a[3] = t1 - t3;
+        }
+
+        template <class Ops, class B>
+        XSIMD_INLINE void fft_butterfly(std::integral_constant<std::size_t, 5>, Ops const& ops, B* a) noexcept
+        {
+            using T = typename B::value_type;
+            B const c1(T(0.309016994374947424102293417182819059L));
+            B const c2(T(-0.809016994374947424102293417182819059L));
+            B const s1(T(0.951056516295153572116439333379382143L));
+            B const s2(T(0.587785252292473129168705954639072769L));
+            B const t1 = a[1] + a[4];
+            B const t2 = a[2] + a[3];
+            B const t3 = a[1] - a[4];
+            B const t4 = a[2] - a[3];
+            B const m1 = fma(c2, t2, fma(c1, t1, a[0]));
+            B const m2 = fma(c1, t2, fma(c2, t1, a[0]));
+            B const n1 = ops.rot(fma(s1, t3, s2 * t4));
+            B const n2 = ops.rot(fms(s2, t3, s1 * t4));
+            a[0] = a[0] + t1 + t2;
+            a[1] = m1 + n1;
+            a[2] = m2 + n2;
+            a[3] = m2 - n2;
+            a[4] = m1 - n1;
+        }
+
+        template <class Ops, class B>
+        XSIMD_INLINE void fft_butterfly(std::integral_constant<std::size_t, 8>, Ops const& ops, B* a) noexcept
+        {
+            using T = typename B::value_type;
+            B const sqrt1_2(T(0.707106781186547524400844362104849039L));
+            B u[4];
+            B v[4];
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                u[r] = a[r] + a[r + 4];
+                v[r] = a[r] - a[r + 4];
+            }
+            // multiply v[r] by the r-th eighth root of unity
+            v[1] = (v[1] + ops.rot(v[1])) * sqrt1_2;
+            v[2] = ops.rot(v[2]);
+            v[3] = (ops.rot(v[3]) - v[3]) * sqrt1_2;
+            fft_butterfly(std::integral_constant<std::size_t, 4>(), ops, u);
+            fft_butterfly(std::integral_constant<std::size_t, 4>(), ops, v);
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                a[2 * r] = u[r];
+                a[2 * r + 1] = v[r];
+            }
+        }
+
+        /*
+         * One pass of the Stockham autosort algorithm, for m * s groups of P
+         * complex values:
+         *
+         *   y[q + s * (P * j + k)] = w^(j * k) * sum_r x[q + s * (j + r * m)] * e^(-2i pi r k / P)
+         *
+         * with j < m, q < s and w = e^(-2i pi / (P * m)). This kernel handles
+         * strides of at least a batch of complex values and vectorizes over
+         * q, the twiddles being broadcast from a table of (P - 1) * m complex
+         * values.
+         */
+        template <std::size_t P, bool Inverse, class A, class T>
+        inline void fft_pass_strided(T const* x, T* y, std::size_t s, std::size_t m, T const* twiddles) noexcept
+        {
+            using batch_type = batch<T, A>;
+            using ops_type = fft_ops<T, A, Inverse>;
+            constexpr std::size_t csize = batch_type::size / 2;
+            ops_type const ops;
+            std::size_t const sm = s * m;
+            std::size_t const tail = s % csize;
+            auto const tail_mask = batch_bool<T, A>::first_n(2 * tail);
+
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                batch_type wr[P];
+                batch_type wi[P];
+                for (std::size_t k = 1; k < P; ++k)
+                {
+                    T const* w = twiddles + 2 * ((P - 1) * j + k - 1);
+                    wr[k] = batch_type(w[0]);
+                    wi[k] = batch_type(Inverse ? -w[1] : w[1]);
+                }
+                T const* src = x + 2 * s * j;
+                T* dst = y + 2 * s * P * j;
+                std::size_t q = 0;
+                for (; q + csize <= s; q += csize)
+                {
+                    batch_type a[P];
+                    for (std::size_t r = 0; r < P; ++r)
+                        a[r] = batch_type::load_unaligned(src + 2 * (q + r * sm));
+                    fft_butterfly(std::integral_constant<std::size_t, P>(), ops, a);
+                    a[0].store_unaligned(dst + 2 * q);
+                    for (std::size_t k = 1; k < P; ++k)
+                        ops_type::twiddle(a[k], wr[k], wi[k]).store_unaligned(dst + 2 * (q + s * k));
+                }
+                if (tail != 0)
+                {
+                    batch_type a[P];
+                    for (std::size_t r = 0; r < P; ++r)
+                        a[r] = batch_type::load(src + 2 * (q + r * sm), tail_mask, unaligned_mode {});
+                    fft_butterfly(std::integral_constant<std::size_t, P>(), ops, a);
+                    a[0].store(dst + 2 * q, tail_mask, unaligned_mode {});
+                    for (std::size_t k = 1; k < P; ++k)
+                        ops_type::twiddle(a[k], wr[k], wi[k]).store(dst + 2 * (q + s * k), tail_mask, unaligned_mode {});
+                }
+            }
+        }
+
+        /*
+         * Stores the outputs of a pass of unit stride for a full batch of
+         * complex values, where value l of a[k] goes to y[P * l + k]: the
+         * transpose of a P x csize matrix of complex values, done by square
+         * blocks. Complex float values are transposed as doubles; complex
+         * double values are transposed as two doubles and zipped back.
+         * Returns false when P is not a multiple of the block size.
+         */
+        template <std::size_t P, class A, class T>
+        XSIMD_INLINE bool fft_store_unit_stride(batch<T, A> const* a, T* y) noexcept
+        {
+            using double_batch = batch<double, A>;
+            constexpr std::size_t block = double_batch::size;
+            constexpr std::size_t csize = batch<T, A>::size / 2;
+            if constexpr (P % block != 0)
+            {
+                return false;
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                for (std::size_t b = 0; b < P; b += block)
+                {
+                    double_batch rows[block];
+                    for (std::size_t i = 0; i < block; ++i)
+                        rows[i] = bitwise_cast<double>(a[b + i]);
+                    ::xsimd::transpose(rows, rows + block);
+                    for (std::size_t l = 0; l < block; ++l)
+                        bitwise_cast<float>(rows[l]).store_unaligned(y + 2 * (P * l + b));
+                }
+                return true;
+            }
+            else
+            {
+                for (std::size_t b = 0; b < P; b += block)
+                {
+                    double_batch rows[block];
+                    for (std::size_t i = 0; i < block; ++i)
+                        rows[i] = a[b + i];
+                    ::xsimd::transpose(rows, rows + block);
+                    for (std::size_t l = 0; l < csize; ++l)
+                    {
+                        zip_lo(rows[2 * l], rows[2 * l + 1]).store_unaligned(y + 2 * (P * l + b));
+                        zip_hi(rows[2 * l], rows[2 * l + 1]).store_unaligned(y + 2 * (P * l + b + csize));
+                    }
+                }
+                return true;
+            }
+        }
+
+        template <bool Full, class T, class A>
+        XSIMD_INLINE batch<T, A> fft_load(T const* src, batch_bool<T, A> const& mask) noexcept
+        {
+            if constexpr (Full)
+                return batch<T, A>::load_unaligned(src);
+            else
+                return batch<T, A>::load(src, mask, unaligned_mode {});
+        }
+
+        /*
+         * Block of csize values of t, or of the lanes remaining at the end,
+         * of fft_pass_packed.
+         */
+        template <std::size_t P, bool Inverse, bool Full, class A, class T>
+        XSIMD_INLINE void fft_packed_block(fft_ops<T, A, Inverse> const& ops, T const* x, T* y, std::size_t s, std::size_t count,
+                                           std::size_t t0, std::size_t lanes, T const* twiddles_re, T const* twiddles_im) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            auto const mask = batch_bool<T, A>::first_n(Full ? 0 : 2 * lanes);
+
+            batch_type a[P];
+            for (std::size_t r = 0; r < P; ++r)
+                a[r] = fft_load<Full>(x + 2 * (t0 + r * count), mask);
+            fft_butterfly(std::integral_constant<std::size_t, P>(), ops, a);
+            for (std::size_t k = 1; k < P; ++k)
+            {
+                std::size_t const offset = 2 * ((k - 1) * count + t0);
+                batch_type const wi = fft_load<Full>(twiddles_im + offset, mask);
+                a[k] = fft_ops<T, A, Inverse>::twiddle(a[k], fft_load<Full>(twiddles_re + offset, mask), Inverse ? -wi : wi);
+            }
+            if (Full && s == 1 && fft_store_unit_stride<P>(a, y + 2 * P * t0))
+                return;
+
+            alignas(A::alignment()) T buffer[P * size];
+            for (std::size_t k = 0; k < P; ++k)
+                a[k].store_aligned(buffer + k * size);
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                std::size_t const t = t0 + l;
+                T* dst = y + 2 * (t + (P - 1) * s * (t / s));
+                for (std::size_t k = 0; k < P; ++k)
+                {
+                    dst[2 * s * k] = buffer[k * size + 2 * l];
+                    dst[2 * s * k + 1] = buffer[k * size + 2 * l + 1];
+                }
+            }
+        }
+
+        /*
+         * Same pass for strides smaller than a batch of complex values. The
+         * kernel vectorizes over t = j * s + q, for which the inputs are
+         * contiguous, with twiddles expanded to one per t and duplicated over
+         * the real and imaginary lanes (real parts for all k, then imaginary
+         * parts). Outputs are contiguous by runs of s values only: they are
+         * transposed in registers for unit strides, and otherwise staged in a
+         * buffer and copied one complex value at a time.
+         */
+        template <std::size_t P, bool Inverse, class A, class T>
+        inline void fft_pass_packed(T const* x, T* y, std::size_t s, std::size_t m, T const* twiddles) noexcept
+        {
+            constexpr std::size_t csize = batch<T, A>::size / 2;
+            fft_ops<T, A, Inverse> const ops;
+            std::size_t const count = s * m;
+            T const* const twiddles_re = twiddles;
+            T const* const twiddles_im = twiddles + 2 * (P - 1) * count;
+
+            std::size_t t0 = 0;
+            for (; t0 + csize <= count; t0 += csize)
+                fft_packed_block<P, Inverse, true>(ops, x, y, s, count, t0, csize, twiddles_re, twiddles_im);
+            if (t0 < count)
+                fft_packed_block<P, Inverse, false>(ops, x, y, s, count, t0, count - t0, twiddles_re, twiddles_im);
+        }
+
+        struct fft_pass
+        {
+            std::size_t radix;
+            std::size_t stride;
+            std::size_t count;
+            std::size_t twiddle_offset;
+        };
+
+        template <std::size_t P, bool Inverse, class A, class T>
+        inline void fft_run_pass(fft_pass const& pass, T const* x, T* y, T const* twiddles) noexcept
+        {
+            if (pass.stride >= batch<T, A>::size / 2)
+                fft_pass_strided<P, Inverse, A>(x, y, pass.stride, pass.count, twiddles + pass.twiddle_offset);
+            else
+                fft_pass_packed<P, Inverse, A>(x, y, pass.stride, pass.count, twiddles + pass.twiddle_offset);
+        }
+
+        /*
+         * Runs the passes of a plan from x to y, ping-ponging between y and
+         * scratch so that the last pass writes y. x may alias y.
+         */
+        template <bool Inverse, class A, class T>
+        inline void fft_execute(std::vector<fft_pass> const& passes, T const* twiddles, std::size_t n,
+                                T const* x, T* y, T* scratch) noexcept
+        {
+            std::size_t const count = passes.size();
+            if (count == 0)
+            {
+                if (x != y)
+                    std::copy(x, x + 2 * n, y);
+                return;
+            }
+            if (x == y && count % 2 == 1)
+            {
+                std::copy(x, x + 2 * n, scratch);
+                x = scratch;
+            }
+            T const* src = x;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                T* dst = (count - 1 - i) % 2 == 0 ? y : scratch;
+                fft_pass const& pass = passes[i];
+                switch (pass.radix)
+                {
+                case 2:
+                    fft_run_pass<2, Inverse, A>(pass, src, dst, twiddles);
+                    break;
+                case 3:
+                    fft_run_pass<3, Inverse, A>(pass, src, dst, twiddles);
+                    break;
+                case 4:
+                    fft_run_pass<4, Inverse, A>(pass, src, dst, twiddles);
+                    break;
+                case 5:
+                    fft_run_pass<5, Inverse, A>(pass, src, dst, twiddles);
+                    break;
+                default:
+                    fft_run_pass<8, Inverse, A>(pass, src, dst, twiddles);
+                    break;
+                }
+                src = dst;
+            }
+        }
+
+        // e^(-2i pi k / n)
+        template <class T>
+        inline std::complex<T> fft_root(std::size_t k, std::size_t n) noexcept
+        {
+            long double const angle = -2.L * 3.141592653589793238462643383279502884L * static_cast<long double>(k % n) / static_cast<long double>(n);
+            return { static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)) };
+        }
+
+        template <class T, class A>
+        using fft_buffer_type = std::vector<T, aligned_allocator<T, A::alignment()>>;
+
+        template <class T, class A>
+        inline T* fft_buffer(fft_buffer_type<T, A>& buffer, std::size_t size)
+        {
+            if (buffer.size() < size)
+                buffer.resize(size);
+            return buffer.data();
+        }
+    }
+
+    /**
+     * @ingroup algorithms_fft
+     *
+     * Returns whether \c n is a size supported by fft_plan, that is a
+     * positive number whose prime factors are 2, 3 and 5.
+     */
+    inline bool fft_supported_size(std::size_t n) noexcept
+    {
+        if (n == 0)
+            return false;
+        for (std::size_t p : { 2, 3, 5 })
+            while (n % p == 0)
+                n /= p;
+        return n == 1;
+    }
+
+    /**
+     * @ingroup algorithms_fft
+     *
+     * Plan of a one-dimensional complex-to-complex discrete Fourier transform
+     * of a given size, whose prime factors must be 2, 3 and 5. The plan
+     * factors the size into radix-8, 4, 2, 3 and 5 passes of the Stockham
+     * autosort algorithm and precomputes their twiddles into an aligned
+     * table; executing it is thread-safe.
+     *
+     * Neither direction is normalized: a forward transform followed by an
+     * inverse one scales the input by the size.
+     *
+     * @tparam T \c float or \c double.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class fft_plan
+    {
+    public:
+        static_assert(std::is_floating_point_v<T>, "fft_plan is only defined for floating point values");
+
+        using value_type = std::complex<T>;
+        using arch_type = A;
+
+        explicit fft_plan(std::size_t n);
+
+        std::size_t size() const noexcept;
+
+        void forward(std::complex<T> const* in, std::complex<T>* out) const;
+        void inverse(std::complex<T> const* in, std::complex<T>* out) const;
+
+        /// @cond
+        void forward_interleaved(T const* in, T* out) const;
+        void inverse_interleaved(T const* in, T* out) const;
+        /// @endcond
+
+    private:
+        std::size_t m_size;
+        std::vector<detail::fft_pass> m_passes;
+        detail::fft_buffer_type<T, A> m_twiddles;
+    };
+
+    /**
+     * @ingroup algorithms_fft
+     *
+     * Plan of a one-dimensional real-to-complex discrete Fourier transform,
+     * and of its complex-to-real inverse. The forward transform of \c n real
+     * values produces the <tt>n / 2 + 1</tt> first complex coefficients, the
+     * others following from Hermitian symmetry. Even sizes run as a complex
+     * transform of half the size followed by a split pass, which requires the
+     * prime factors of <tt>n / 2</tt> to be 2, 3 and 5; odd sizes run as a
+     * complex transform of size \c n.
+     *
+     * As for fft_plan, neither direction is normalized.
+     *
+     * @tparam T \c float or \c double.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class rfft_plan
+    {
+    public:
+        static_assert(std::is_floating_point_v<T>, "rfft_plan is only defined for floating point values");
+
+        using value_type = T;
+        using arch_type = A;
+
+        explicit rfft_plan(std::size_t n);
+
+        std::size_t size() const noexcept;
+        std::size_t spectrum_size() const noexcept;
+
+        void forward(T const* in, std::complex<T>* out) const;
+        void inverse(std::complex<T> const* in, T* out) const;
+
+    private:
+        template <bool Inverse>
+        void split(T const* in, T* out) const noexcept;
+
+        std::size_t m_size;
+        fft_plan<T, A> m_plan;
+        detail::fft_buffer_type<T, A> m_twiddles;
+    };
+
+    /***************************
+     * fft_plan implementation *
+     ***************************/
+
+    /**
+     * Builds the plan of the transforms of size \c n, which must be a
+     * supported size (see fft_supported_size()).
+     *
+     * @throw std::invalid_argument if \c n is not supported. Without
+     * exceptions, the program is aborted.
+     */
+    template <class T, class A>
+    inline fft_plan<T, A>::fft_plan(std::size_t n)
+        : m_size(n)
+    {
+        if (!fft_supported_size(n))
+        {
+#if defined(_CPPUNWIND) || defined(__cpp_exceptions)
+            throw std::invalid_argument("xsimd::fft_plan: size must be a positive product of 2, 3 and 5");
+#else
+            std::abort();
+#endif
+        }
+        constexpr std::size_t csize = batch<T, A>::size / 2;
+
+        std::vector<std::size_t> radices;
+        std::size_t twos = 0;
+        while (n % 2 == 0)
+        {
+            n /= 2;
+            ++twos;
+        }
+        for (; twos >= 3; twos -= 3)
+            radices.push_back(8);
+        if (twos != 0)
+            radices.push_back(std::size_t(1) << twos);
+        for (std::size_t p : { 3, 5 })
+        {
+            for (; n % p == 0; n /= p)
+                radices.push_back(p);
+        }
+
+        std::size_t stride = 1;
+        std::size_t offset = 0;
+        for (std::size_t p : radices)
+        {
+            std::size_t const count = m_size / (stride * p);
+            m_passes.push_back({ p, stride, count, offset });
+            offset += 2 * (p - 1) * count * (stride >= csize ? 1 : 2 * stride);
+            stride *= p;
+        }
+
+        m_twiddles.resize(offset);
+        for (detail::fft_pass const& pass : m_passes)
+        {
+            T* w = m_twiddles.data() + pass.twiddle_offset;
+            std::size_t const p = pass.radix;
+            std::size_t const s = pass.stride;
+            std::size_t const m = pass.count;
+            if (s >= csize)
+            {
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    for (std::size_t k = 1; k < p; ++k)
+                    {
+                        auto const root = detail::fft_root<T>(j * k, p * m);
+                        *w++ = root.real();
+                        *w++ = root.imag();
+                    }
+                }
+            }
+            else
+            {
+                T* w_im = w + 2 * (p - 1) * s * m;
+                for (std::size_t k = 1; k < p; ++k)
+                {
+                    for (std::size_t t = 0; t < s * m; ++t)
+                    {
+                        auto const root = detail::fft_root<T>((t / s) * k, p * m);
+                        *w++ = root.real();
+                        *w++ = root.real();
+                        *w_im++ = root.imag();
+                        *w_im++ = root.imag();
+                    }
+                }
+            }
+        }
+    }
+
+    /// Returns the number of complex values transformed by the plan.
+    template <class T, class A>
+    inline std::size_t fft_plan<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Computes <tt>out[k] = sum_j in[j] * e^(-2i pi j k / n)</tt>. \c in and
+     * \c out may be the same array.
+     */
+    template <class T, class A>
+    inline void fft_plan<T, A>::forward(std::complex<T> const* in, std::complex<T>* out) const
+    {
+        forward_interleaved(reinterpret_cast<T const*>(in), reinterpret_cast<T*>(out));
+    }
+
+    /**
+     * Computes <tt>out[k] = sum_j in[j] * e^(2i pi j k / n)</tt>. \c in and
+     * \c out may be the same array.
+     */
+    template <class T, class A>
+    inline void fft_plan<T, A>::inverse(std::complex<T> const* in, std::complex<T>* out) const
+    {
+        inverse_interleaved(reinterpret_cast<T const*>(in), reinterpret_cast<T*>(out));
+    }
+
+    template <class T, class A>
+    inline void fft_plan<T, A>::forward_interleaved(T const* in, T* out) const
+    {
+        static thread_local detail::fft_buffer_type<T, A> scratch;
+        detail::fft_execute<false, A>(m_passes, m_twiddles.data(), m_size, in, out, detail::fft_buffer<T, A>(scratch, 2 * m_size));
+    }
+
+    template <class T, class A>
+    inline void fft_plan<T, A>::inverse_interleaved(T const* in, T* out) const
+    {
+        static thread_local detail::fft_buffer_type<T, A> scratch;
+        detail::fft_execute<true, A>(m_passes, m_twiddles.data(), m_size, in, out, detail::fft_buffer<T, A>(scratch, 2 * m_size));
+    }
+
+    /****************************
+     * rfft_plan implementation *
+     ****************************/
+
+    /**
+     * Builds the plan of the transforms of \c n real values. Even sizes must
+     * have <tt>n / 2</tt> supported by fft_plan, odd sizes \c n.
+     *
+     * @throw std::invalid_argument if the size is not supported.
+     */
+    template <class T, class A>
+    inline rfft_plan<T, A>::rfft_plan(std::size_t n)
+        : m_size(n)
+        , m_plan(n % 2 == 0 ? n / 2 : n)
+    {
+        if (n % 2 != 0)
+            return;
+        // -i * e^(-2i pi k / n), duplicated over the real and imaginary lanes
+        std::size_t const half = n / 2;
+        m_twiddles.resize(4 * half);
+        for (std::size_t k = 0; k < half; ++k)
+        {
+            auto const root = detail::fft_root<T>(k, n);
+            m_twiddles[2 * k] = m_twiddles[2 * k + 1] = root.imag();
+            m_twiddles[2 * (half + k)] = m_twiddles[2 * (half + k) + 1] = -root.real();
+        }
+    }
+
+    /// Returns the number of real values transformed by the plan.
+    template <class T, class A>
+    inline std::size_t rfft_plan<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /// Returns the number of complex coefficients of the spectrum, <tt>size() / 2 + 1</tt>.
+    template <class T, class A>
+    inline std::size_t rfft_plan<T, A>::spectrum_size() const noexcept
+    {
+        return m_size / 2 + 1;
+    }
+
+    /*
+     * With h = n / 2 and Z the transform of the h complex values
+     * (x[2j], x[2j + 1]), the spectrum of x is, for k < h,
+     *
+     *   X[k] = (Z[k] + conj(Z[h - k])) / 2 - i w^k (Z[k] - conj(Z[h - k])) / 2
+     *
+     * where w = e^(-2i pi / n) and Z[h] = Z[0]. Conversely, the inverse
+     * computes h times Z from X as
+     *
+     *   Z[k] = (X[k] + conj(X[h - k])) + i conj(w^k) (X[k] - conj(X[h - k]))
+     *
+     * Both share this pass, vectorized over k with the h - k values loaded in
+     * reverse; the forward pass expects Z[h] to hold a copy of Z[0].
+     */
+    template <class T, class A>
+    template <bool Inverse>
+    inline void rfft_plan<T, A>::split(T const* in, T* out) const noexcept
+    {
+        using batch_type = batch<T, A>;
+        using ops_type = detail::fft_ops<T, A, Inverse>;
+        constexpr std::size_t csize = batch_type::size / 2;
+        constexpr auto reverse = ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, detail::fft_reverse_lane, A>();
+        constexpr auto odd = ::xsimd::make_batch_bool_constant<T, detail::fft_odd_lane, A>();
+        std::size_t const half = m_size / 2;
+        T const scale = Inverse ? T(1) : T(0.5);
+        batch_type const scale_batch(scale);
+        T const* const twiddles_re = m_twiddles.data();
+        T const* const twiddles_im = m_twiddles.data() + 2 * half;
+
+        std::size_t k = 0;
+        for (; k + csize <= half; k += csize)
+        {
+            auto const x = batch_type::load_unaligned(in + 2 * k);
+            auto const xr = swizzle(batch_type::load_unaligned(in + 2 * (half - k - csize + 1)), reverse);
+            auto const xr_conj = select(odd, -xr, xr);
+            auto const wr = batch_type::load_unaligned(twiddles_re + 2 * k);
+            auto wi = batch_type::load_unaligned(twiddles_im + 2 * k);
+            if (Inverse)
+                wi = -wi;
+            auto const sum = (x + xr_conj) * scale_batch;
+            auto const diff = (x - xr_conj) * scale_batch;
+            (sum + ops_type::twiddle(diff, wr, wi)).store_unaligned(out + 2 * k);
+        }
+        for (; k < half; ++k)
+        {
+            std::complex<T> const x(in[2 * k], in[2 * k + 1]);
+            std::complex<T> const xr_conj(in[2 * (half - k)], -in[2 * (half - k) + 1]);
+            std::complex<T> const w(twiddles_re[2 * k], Inverse ? -twiddles_im[2 * k] : twiddles_im[2 * k]);
+            std::complex<T> const res = (x + xr_conj) * scale + w * ((x - xr_conj) * scale);
+            out[2 * k] = res.real();
+            out[2 * k + 1] = res.imag();
+        }
+    }
+
+    /**
+     * Computes the <tt>size() / 2 + 1</tt> first coefficients of the
+     * transform <tt>out[k] = sum_j in[j] * e^(-2i pi j k / n)</tt>.
+     */
+    template <class T, class A>
+    inline void rfft_plan<T, A>::forward(T const* in, std::complex<T>* out) const
+    {
+        T* const out_values = reinterpret_cast<T*>(out);
+        static thread_local detail::fft_buffer_type<T, A> buffer;
+        if (m_size % 2 != 0)
+        {
+            T* const values = detail::fft_buffer<T, A>(buffer, 2 * m_size);
+            for (std::size_t j = 0; j < m_size; ++j)
+            {
+                values[2 * j] = in[j];
+                values[2 * j + 1] = T(0);
+            }
+            m_plan.forward_interleaved(values, values);
+            std::copy(values, values + 2 * spectrum_size(), out_values);
+            return;
+        }
+        std::size_t const half = m_size / 2;
+        T* const z = detail::fft_buffer<T, A>(buffer, 2 * (half + 1));
+        m_plan.forward_interleaved(in, z);
+        z[2 * half] = z[0];
+        z[2 * half + 1] = z[1];
+        split<false>(z, out_values);
+        out[half] = { z[0] - z[1], T(0) };
+    }
+
+    /**
+     * Computes the real values <tt>out[j] = sum_k in[k] * e^(2i pi j k / n)</tt>,
+     * the sum running over the whole spectrum whose <tt>size() / 2 + 1</tt>
+     * first coefficients are given by \c in. The imaginary parts of
+     * <tt>in[0]</tt> and, for even sizes, <tt>in[size() / 2]</tt> are ignored.
+     */
+    template <class T, class A>
+    inline void rfft_plan<T, A>::inverse(std::complex<T> const* in, T* out) const
+    {
+        T const* const in_values = reinterpret_cast<T const*>(in);
+        static thread_local detail::fft_buffer_type<T, A> buffer;
+        if (m_size % 2 != 0)
+        {
+            T* const values = detail::fft_buffer<T, A>(buffer, 2 * m_size);
+            values[0] = in_values[0];
+            values[1] = T(0);
+            for (std::size_t k = 1; k < spectrum_size(); ++k)
+            {
+                values[2 * k] = values[2 * (m_size - k)] = in_values[2 * k];
+                values[2 * k + 1] = in_values[2 * k + 1];
+                values[2 * (m_size - k) + 1] = -in_values[2 * k + 1];
+            }
+            m_plan.inverse_interleaved(values, values);
+            for (std::size_t j = 0; j < m_size; ++j)
+                out[j] = values[2 * j];
+            return;
+        }
+        std::size_t const half = m_size / 2;
+        T* const z = detail::fft_buffer<T, A>(buffer, 2 * half);
+        T const first_re = in_values[0];
+        T const last_re = in_values[2 * half];
+        split<true>(in_values, z);
+        z[0] = first_re + last_re;
+        z[1] = first_re - last_re;
+        m_plan.inverse_interleaved(z, out);
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,787 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_FILTER_HPP
+#define XSIMD_ALGORITHMS_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_filter Filtering
+     */
+
+    namespace detail
+    {
+        /*
+         * Floating point samples are filtered in their own type; int16 samples
+         * are Q15 fixed point values, filtered with Q15 taps into exact int32
+         * accumulators.
+         */
+        template <class T>
+        struct fir_traits
+        {
+            static_assert(std::is_floating_point_v<T>, "filters are defined for float, double and int16_t samples");
+            using acc_type = T;
+        };
+
+        template <>
+        struct fir_traits<int16_t>
+        {
+            using acc_type = int32_t;
+        };
+
+        template <class T>
+        using fir_acc_t = typename fir_traits<T>::acc_type;
+
+        template <class T, class A>
+        using fir_buffer_type = std::vector<T, aligned_allocator<T, A::alignment()>>;
+
+        template <class T, class A>
+        inline void fir_load(T const* in, fir_acc_t<T>* out, std::size_t n) noexcept
+        {
+            if constexpr (std::is_same_v<T, int16_t>)
+            {
+                using batch_type = batch<int16_t, A>;
+                constexpr std::size_t size = batch_type::size;
+                constexpr std::size_t half = size / 2;
+                std::size_t i = 0;
+                for (; i + size <= n; i += size)
+                {
+                    auto const wide = widen(batch_type::load_unaligned(in + i));
+                    wide[0].store_unaligned(out + i);
+                    wide[1].store_unaligned(out + i + half);
+                }
+                std::copy(in + i, in + n, out + i);
+            }
+            else
+            {
+                std::copy(in, in + n, out);
+            }
+        }
+
+        // Q30 accumulator to Q15, rounding half up and saturating
+        inline int32_t fir_requantize(int32_t acc) noexcept
+        {
+            return std::min(std::max((acc + (1 << 14)) >> 15, -32768), 32767);
+        }
+
+        template <class A, class T>
+        inline void fir_requantize(T* acc, std::size_t n) noexcept
+        {
+            if constexpr (std::is_same_v<T, int32_t>)
+            {
+                using batch_type = batch<int32_t, A>;
+                constexpr std::size_t size = batch_type::size;
+                batch_type const rounding(1 << 14), lo(-32768), hi(32767);
+                std::size_t const vec_size = n - n % size;
+                for (std::size_t i = 0; i < vec_size; i += size)
+                {
+                    auto const x = (batch_type::load_unaligned(acc + i) + rounding) >> 15;
+                    clip(x, lo, hi).store_unaligned(acc + i);
+                }
+                for (std::size_t i = vec_size; i < n; ++i)
+                    acc[i] = fir_requantize(acc[i]);
+            }
+        }
+
+        /*
+         * out[i] = sum_k taps[k] * line[i + k] for i in [0, n), taps being
+         * stored in reverse order. The loop is vectorized over the outputs:
+         * each tap is broadcast once and multiplied with an unaligned load of
+         * the line shifted by the tap index, which on current hardware is
+         * cheaper than rebuilding the shifted batches with slide_left() or
+         * extract_pair(). A non-zero Taps fixes the number of taps at compile
+         * time, so that the inner loop is fully unrolled.
+         */
+        template <std::size_t Taps, class A, class T>
+        inline void fir_kernel(T const* taps, std::size_t count, T const* line, T* out, std::size_t n) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr std::size_t unroll = 4;
+            std::size_t const tap_count = Taps != 0 ? Taps : count;
+
+            std::size_t i = 0;
+            for (; i + unroll * size <= n; i += unroll * size)
+            {
+                batch_type acc[unroll];
+                for (std::size_t u = 0; u < unroll; ++u)
+                    acc[u] = batch_type(T(0));
+                for (std::size_t k = 0; k < tap_count; ++k)
+                {
+                    batch_type const h(taps[k]);
+                    for (std::size_t u = 0; u < unroll; ++u)
+                        acc[u] = fma(h, batch_type::load_unaligned(line + i + k + u * size), acc[u]);
+                }
+                for (std::size_t u = 0; u < unroll; ++u)
+                    acc[u].store_unaligned(out + i + u * size);
+            }
+            for (; i + size <= n; i += size)
+            {
+                batch_type acc(T(0));
+                for (std::size_t k = 0; k < tap_count; ++k)
+                    acc = fma(batch_type(taps[k]), batch_type::load_unaligned(line + i + k), acc);
+                acc.store_unaligned(out + i);
+            }
+            for (; i < n; ++i)
+            {
+                T acc(0);
+                for (std::size_t k = 0; k < tap_count; ++k)
+                    acc += taps[k] * line[i + k];
+                out[i] = acc;
+            }
+        }
+
+        /*
+         * Delay line of a streaming filter: the last samples of the previous
+         * block, followed by the current block converted to the accumulator
+         * type and by a batch of zeros, so that kernels may read a full batch
+         * past the last sample.
+         */
+        template <class T, class A>
+        class fir_history
+        {
+        public:
+            using acc_type = fir_acc_t<T>;
+
+            explicit fir_history(std::size_t length);
+
+            acc_type* append(T const* in, std::size_t n);
+            void retire(std::size_t n) noexcept;
+            void reset() noexcept;
+
+        private:
+            std::size_t m_length;
+            fir_buffer_type<acc_type, A> m_line;
+        };
+
+        template <class T, class A>
+        inline fir_history<T, A>::fir_history(std::size_t length)
+            : m_length(length)
+            , m_line(length + batch<acc_type, A>::size, acc_type(0))
+        {
+        }
+
+        template <class T, class A>
+        inline auto fir_history<T, A>::append(T const* in, std::size_t n) -> acc_type*
+        {
+            constexpr std::size_t size = batch<acc_type, A>::size;
+            if (m_line.size() < m_length + n + size)
+                m_line.resize(m_length + n + size);
+            fir_load<T, A>(in, m_line.data() + m_length, n);
+            std::fill(m_line.data() + m_length + n, m_line.data() + m_length + n + size, acc_type(0));
+            return m_line.data();
+        }
+
+        // keeps the last samples of the n appended ones for the next block
+        template <class T, class A>
+        inline void fir_history<T, A>::retire(std::size_t n) noexcept
+        {
+            std::copy(m_line.data() + n, m_line.data() + n + m_length, m_line.data());
+        }
+
+        template <class T, class A>
+        inline void fir_history<T, A>::reset() noexcept
+        {
+            std::fill(m_line.begin(), m_line.end(), acc_type(0));
+        }
+
+        template <class T, class A, std::size_t Taps>
+        class fir_base
+        {
+        public:
+            using value_type = T;
+            using arch_type = A;
+
+            std::size_t size() const noexcept;
+
+            void process(T const* in, T* out, std::size_t n);
+            void reset() noexcept;
+
+        protected:
+            fir_base(T const* taps, std::size_t count);
+
+        private:
+            using acc_type = fir_acc_t<T>;
+
+            std::size_t m_size;
+            fir_buffer_type<acc_type, A> m_taps;
+            fir_history<T, A> m_history;
+            fir_buffer_type<acc_type, A> m_acc;
+        };
+
+        template <class T, class A, std::size_t Taps>
+        inline fir_base<T, A, Taps>::fir_base(T const* taps, std::size_t count)
+            : m_size(count)
+            , m_taps(count)
+            , m_history(count - 1)
+        {
+            assert(count > 0 && "a FIR filter needs at least one tap");
+            std::reverse_copy(taps, taps + count, m_taps.begin());
+        }
+
+        /**
+         * Returns the number of taps of the filter.
+         */
+        template <class T, class A, std::size_t Taps>
+        inline std::size_t fir_base<T, A, Taps>::size() const noexcept
+        {
+            return m_size;
+        }
+
+        /**
+         * Filters the block of \c n samples \c in into \c out, continuing
+         * from the state left by the previous blocks. \c in and \c out may
+         * be the same array.
+         */
+        template <class T, class A, std::size_t Taps>
+        inline void fir_base<T, A, Taps>::process(T const* in, T* out, std::size_t n)
+        {
+            if (n == 0)
+                return;
+            acc_type const* line = m_history.append(in, n);
+            if constexpr (std::is_same_v<T, acc_type>)
+            {
+                fir_kernel<Taps, A>(m_taps.data(), m_size, line, out, n);
+            }
+            else
+            {
+                if (m_acc.size() < n)
+                    m_acc.resize(n);
+                fir_kernel<Taps, A>(m_taps.data(), m_size, line, m_acc.data(), n);
+                fir_requantize<A>(m_acc.data(), n);
+                std::copy(m_acc.data(), m_acc.data() + n, out);
+            }
+            m_history.retire(n);
+        }
+
+        /**
+         * Clears the delay line, as if the filter had only seen zeros.
+         */
+        template <class T, class A, std::size_t Taps>
+        inline void fir_base<T, A, Taps>::reset() noexcept
+        {
+            m_history.reset();
+        }
+    }
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Streaming finite impulse response filter with a number of taps chosen
+     * at run time: <tt>y[i] = sum_k taps[k] * x[i - k]</tt>, where \c x runs
+     * across all the blocks passed to process() since construction or the
+     * last reset().
+     *
+     * With \c int16_t samples, both the samples and the taps are Q15 fixed
+     * point values. Products are accumulated exactly in 32 bits, then rounded
+     * back to Q15 with saturation; the accumulation cannot overflow as long
+     * as the sum of the absolute values of the taps is below 2.
+     *
+     * @tparam T \c float, \c double or \c int16_t.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class fir_filter : public detail::fir_base<T, A, 0>
+    {
+    public:
+        fir_filter(T const* taps, std::size_t count);
+    };
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Streaming finite impulse response filter with \c Taps taps, behaving as
+     * fir_filter but with the tap loop unrolled at compile time.
+     *
+     * @tparam T \c float, \c double or \c int16_t.
+     * @tparam Taps number of taps.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, std::size_t Taps, class A = default_arch>
+    class static_fir_filter : public detail::fir_base<T, A, Taps>
+    {
+    public:
+        static_assert(Taps > 0, "a FIR filter needs at least one tap");
+
+        explicit static_fir_filter(std::array<T, Taps> const& taps);
+    };
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Streaming FIR filter followed by a decimation by \c factor, keeping the
+     * outputs of the input samples whose index across the stream is a
+     * multiple of \c factor. Only the retained outputs are computed, each as
+     * a dot product vectorized over the taps, which amounts to the polyphase
+     * decomposition of the filter without reordering the samples.
+     *
+     * @tparam T \c float, \c double or \c int16_t, see fir_filter.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class fir_decimator
+    {
+    public:
+        using value_type = T;
+        using arch_type = A;
+
+        fir_decimator(T const* taps, std::size_t count, std::size_t factor);
+
+        std::size_t size() const noexcept;
+        std::size_t factor() const noexcept;
+
+        std::size_t process(T const* in, std::size_t n, T* out);
+        void reset() noexcept;
+
+    private:
+        using acc_type = detail::fir_acc_t<T>;
+
+        acc_type dot(acc_type const* line) const noexcept;
+
+        std::size_t m_size;
+        std::size_t m_factor;
+        std::size_t m_phase;
+        detail::fir_buffer_type<acc_type, A> m_taps;
+        detail::fir_history<T, A> m_history;
+    };
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Upsampling by \c factor followed by a streaming FIR filter, as if
+     * <tt>factor - 1</tt> zeros were inserted after each input sample. The
+     * filter is split into \c factor polyphase sub-filters, each computing
+     * one output phase from the input samples directly, so that no product
+     * with an inserted zero is ever evaluated. The taps are applied as given:
+     * a unity gain interpolator needs taps summing to \c factor.
+     *
+     * @tparam T \c float, \c double or \c int16_t, see fir_filter.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class fir_interpolator
+    {
+    public:
+        using value_type = T;
+        using arch_type = A;
+
+        fir_interpolator(T const* taps, std::size_t count, std::size_t factor);
+
+        std::size_t size() const noexcept;
+        std::size_t factor() const noexcept;
+
+        void process(T const* in, std::size_t n, T* out);
+        void reset() noexcept;
+
+    private:
+        using acc_type = detail::fir_acc_t<T>;
+
+        std::size_t m_size;
+        std::size_t m_factor;
+        std::size_t m_phase_size;
+        detail::fir_buffer_type<acc_type, A> m_taps;
+        detail::fir_history<T, A> m_history;
+        detail::fir_buffer_type<acc_type, A> m_acc;
+    };
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Coefficients of a second order section, normalized so that
+     * <tt>a0 = 1</tt>:
+     * <tt>y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]</tt>.
+     */
+    template <class T>
+    struct biquad_coefficients
+    {
+        T b0;
+        T b1;
+        T b2;
+        T a1;
+        T a2;
+    };
+
+    /**
+     * @ingroup algorithms_filter
+     *
+     * Cascade of biquad sections applied to several channels at once. Samples
+     * are interleaved frame by frame (<tt>x[frame * channels + channel]</tt>)
+     * and every channel goes through the same sections, each in transposed
+     * direct form II. As the recursion forbids vectorizing along time, the
+     * kernel is vectorized across channels instead, running up to four
+     * batches of channels side by side to hide the latency of the recursion.
+     *
+     * @tparam T \c float or \c double.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class biquad_cascade
+    {
+    public:
+        static_assert(std::is_floating_point_v<T>, "biquad_cascade is only defined for floating point values");
+
+        using value_type = T;
+        using arch_type = A;
+
+        biquad_cascade(biquad_coefficients<T> const* sections, std::size_t count, std::size_t channels);
+
+        std::size_t size() const noexcept;
+        std::size_t channels() const noexcept;
+
+        void process(T const* in, T* out, std::size_t frames) noexcept;
+        void reset() noexcept;
+
+    private:
+        std::vector<biquad_coefficients<T>> m_sections;
+        std::size_t m_channels;
+        std::size_t m_stride;
+        detail::fir_buffer_type<T, A> m_state;
+    };
+
+    /*****************************
+     * fir_filter implementation *
+     *****************************/
+
+    /**
+     * Builds a filter with the \c count taps \c taps, and a zero delay line.
+     */
+    template <class T, class A>
+    inline fir_filter<T, A>::fir_filter(T const* taps, std::size_t count)
+        : detail::fir_base<T, A, 0>(taps, count)
+    {
+    }
+
+    /************************************
+     * static_fir_filter implementation *
+     ************************************/
+
+    /**
+     * Builds a filter with the taps \c taps, and a zero delay line.
+     */
+    template <class T, std::size_t Taps, class A>
+    inline static_fir_filter<T, Taps, A>::static_fir_filter(std::array<T, Taps> const& taps)
+        : detail::fir_base<T, A, Taps>(taps.data(), Taps)
+    {
+    }
+
+    /********************************
+     * fir_decimator implementation *
+     ********************************/
+
+    /**
+     * Builds a decimator by \c factor with the \c count taps \c taps. The
+     * first output corresponds to the first input sample.
+     */
+    template <class T, class A>
+    inline fir_decimator<T, A>::fir_decimator(T const* taps, std::size_t count, std::size_t factor)
+        : m_size(count)
+        , m_factor(factor)
+        , m_phase(0)
+        , m_history(count - 1)
+    {
+        assert(count > 0 && "a FIR filter needs at least one tap");
+        assert(factor > 0 && "decimation factor must be positive");
+        constexpr std::size_t size = batch<acc_type, A>::size;
+        m_taps.resize((count + size - 1) / size * size, acc_type(0));
+        std::reverse_copy(taps, taps + count, m_taps.begin());
+    }
+
+    /**
+     * Returns the number of taps of the filter.
+     */
+    template <class T, class A>
+    inline std::size_t fir_decimator<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns the decimation factor.
+     */
+    template <class T, class A>
+    inline std::size_t fir_decimator<T, A>::factor() const noexcept
+    {
+        return m_factor;
+    }
+
+    /**
+     * Filters and decimates the block of \c n samples \c in, continuing from
+     * the state left by the previous blocks, and writes the outputs to
+     * \c out. Returns the number of outputs written, which is
+     * <tt>n / factor()</tt> rounded up or down depending on the position of
+     * the block in the stream.
+     */
+    template <class T, class A>
+    inline std::size_t fir_decimator<T, A>::process(T const* in, std::size_t n, T* out)
+    {
+        if (n == 0)
+            return 0;
+        acc_type const* line = m_history.append(in, n);
+        std::size_t const count = m_phase < n ? (n - 1 - m_phase) / m_factor + 1 : 0;
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            acc_type const acc = dot(line + m_phase + j * m_factor);
+            if constexpr (std::is_same_v<T, acc_type>)
+                out[j] = acc;
+            else
+                out[j] = static_cast<T>(detail::fir_requantize(acc));
+        }
+        m_phase = m_phase + count * m_factor - n;
+        m_history.retire(n);
+        return count;
+    }
+
+    template <class T, class A>
+    inline auto fir_decimator<T, A>::dot(acc_type const* line) const noexcept -> acc_type
+    {
+        using batch_type = batch<acc_type, A>;
+        constexpr std::size_t size = batch_type::size;
+        constexpr std::size_t unroll = 2;
+        std::size_t const count = m_taps.size();
+
+        // the taps are padded with zeros to a multiple of the batch size
+        batch_type acc[unroll] = { batch_type(acc_type(0)), batch_type(acc_type(0)) };
+        std::size_t k = 0;
+        for (; k + unroll * size <= count; k += unroll * size)
+            for (std::size_t u = 0; u < unroll; ++u)
+                acc[u] = fma(batch_type::load_aligned(m_taps.data() + k + u * size), batch_type::load_unaligned(line + k + u * size), acc[u]);
+        if (k < count)
+            acc[0] = fma(batch_type::load_aligned(m_taps.data() + k), batch_type::load_unaligned(line + k), acc[0]);
+        return reduce_add(acc[0] + acc[1]);
+    }
+
+    /**
+     * Clears the delay line and restarts the decimation phase, as if the
+     * decimator had just been built.
+     */
+    template <class T, class A>
+    inline void fir_decimator<T, A>::reset() noexcept
+    {
+        m_phase = 0;
+        m_history.reset();
+    }
+
+    /***********************************
+     * fir_interpolator implementation *
+     ***********************************/
+
+    /**
+     * Builds an interpolator by \c factor with the \c count taps \c taps.
+     */
+    template <class T, class A>
+    inline fir_interpolator<T, A>::fir_interpolator(T const* taps, std::size_t count, std::size_t factor)
+        : m_size(count)
+        , m_factor(factor)
+        , m_phase_size((count + factor - 1) / factor)
+        , m_taps(factor * m_phase_size, acc_type(0))
+        , m_history(m_phase_size - 1)
+    {
+        assert(count > 0 && "a FIR filter needs at least one tap");
+        assert(factor > 0 && "interpolation factor must be positive");
+        // phase p applies taps[p], taps[p + factor], ..., stored reversed
+        for (std::size_t p = 0; p < factor; ++p)
+            for (std::size_t j = 0; j < m_phase_size; ++j)
+            {
+                std::size_t const k = j * factor + p;
+                if (k < count)
+                    m_taps[p * m_phase_size + m_phase_size - 1 - j] = taps[k];
+            }
+    }
+
+    /**
+     * Returns the number of taps of the filter.
+     */
+    template <class T, class A>
+    inline std::size_t fir_interpolator<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns the interpolation factor.
+     */
+    template <class T, class A>
+    inline std::size_t fir_interpolator<T, A>::factor() const noexcept
+    {
+        return m_factor;
+    }
+
+    /**
+     * Upsamples and filters the block of \c n samples \c in, continuing from
+     * the state left by the previous blocks, and writes the
+     * <tt>n * factor()</tt> outputs to \c out.
+     */
+    template <class T, class A>
+    inline void fir_interpolator<T, A>::process(T const* in, std::size_t n, T* out)
+    {
+        if (n == 0)
+            return;
+        acc_type const* line = m_history.append(in, n);
+        if (m_acc.size() < m_factor * n)
+            m_acc.resize(m_factor * n);
+        for (std::size_t p = 0; p < m_factor; ++p)
+            detail::fir_kernel<0, A>(m_taps.data() + p * m_phase_size, m_phase_size, line, m_acc.data() + p * n, n);
+        detail::fir_requantize<A>(m_acc.data(), m_factor * n);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t p = 0; p < m_factor; ++p)
+                out[i * m_factor + p] = static_cast<T>(m_acc[p * n + i]);
+        m_history.retire(n);
+    }
+
+    /**
+     * Clears the delay line, as if the interpolator had only seen zeros.
+     */
+    template <class T, class A>
+    inline void fir_interpolator<T, A>::reset() noexcept
+    {
+        m_history.reset();
+    }
+
+    /*********************************
+     * biquad_cascade implementation *
+     *********************************/
+
+    namespace detail
+    {
+        /*
+         * Runs one section over Blocks consecutive batches of channels, the
+         * state of each batch staying in registers across the frames. Masked
+         * runs handle the last, partial batch of channels.
+         */
+        template <std::size_t Blocks, bool Masked, class A, class T>
+        inline void biquad_section(biquad_coefficients<T> const& c, T* state1, T* state2, T const* in, T* out,
+                                   std::size_t frames, std::size_t channels, batch_bool<T, A> const& mask) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            batch_type const b0(c.b0), b1(c.b1), b2(c.b2), a1(c.a1), a2(c.a2);
+
+            batch_type s1[Blocks], s2[Blocks];
+            for (std::size_t u = 0; u < Blocks; ++u)
+            {
+                s1[u] = batch_type::load_aligned(state1 + u * size);
+                s2[u] = batch_type::load_aligned(state2 + u * size);
+            }
+            for (std::size_t f = 0; f < frames; ++f)
+            {
+                T const* src = in + f * channels;
+                T* dst = out + f * channels;
+                for (std::size_t u = 0; u < Blocks; ++u)
+                {
+                    batch_type x;
+                    if constexpr (Masked)
+                        x = batch_type::load(src + u * size, mask, unaligned_mode {});
+                    else
+                        x = batch_type::load_unaligned(src + u * size);
+                    auto const y = fma(b0, x, s1[u]);
+                    s1[u] = fma(b1, x, fnma(a1, y, s2[u]));
+                    s2[u] = fnma(a2, y, b2 * x);
+                    if constexpr (Masked)
+                        y.store(dst + u * size, mask, unaligned_mode {});
+                    else
+                        y.store_unaligned(dst + u * size);
+                }
+            }
+            for (std::size_t u = 0; u < Blocks; ++u)
+            {
+                s1[u].store_aligned(state1 + u * size);
+                s2[u].store_aligned(state2 + u * size);
+            }
+        }
+    }
+
+    /**
+     * Builds a cascade of the \c count sections \c sections, applied in
+     * order, to \c channels channels, with a zero state.
+     */
+    template <class T, class A>
+    inline biquad_cascade<T, A>::biquad_cascade(biquad_coefficients<T> const* sections, std::size_t count, std::size_t channels)
+        : m_sections(sections, sections + count)
+        , m_channels(channels)
+        , m_stride((channels + batch<T, A>::size - 1) / batch<T, A>::size * batch<T, A>::size)
+        , m_state(2 * count * m_stride, T(0))
+    {
+        assert(channels > 0 && "a biquad cascade needs at least one channel");
+    }
+
+    /**
+     * Returns the number of sections of the cascade.
+     */
+    template <class T, class A>
+    inline std::size_t biquad_cascade<T, A>::size() const noexcept
+    {
+        return m_sections.size();
+    }
+
+    /**
+     * Returns the number of channels of the cascade.
+     */
+    template <class T, class A>
+    inline std::size_t biquad_cascade<T, A>::channels() const noexcept
+    {
+        return m_channels;
+    }
+
+    /**
+     * Filters \c frames frames of interleaved samples \c in into \c out,
+     * continuing from the state left by the previous blocks. \c in and
+     * \c out may be the same array.
+     */
+    template <class T, class A>
+    inline void biquad_cascade<T, A>::process(T const* in, T* out, std::size_t frames) noexcept
+    {
+        using batch_type = batch<T, A>;
+        constexpr std::size_t size = batch_type::size;
+        constexpr std::size_t blocks = 4;
+        auto const mask = batch_bool<T, A>::first_n(m_channels % size);
+
+        for (std::size_t s = 0; s < m_sections.size(); ++s)
+        {
+            T const* src = s == 0 ? in : out;
+            T* state1 = m_state.data() + 2 * s * m_stride;
+            T* state2 = state1 + m_stride;
+            std::size_t c = 0;
+            for (; c + blocks * size <= m_channels; c += blocks * size)
+                detail::biquad_section<blocks, false, A>(m_sections[s], state1 + c, state2 + c, src + c, out + c, frames, m_channels, mask);
+            for (; c + size <= m_channels; c += size)
+                detail::biquad_section<1, false, A>(m_sections[s], state1 + c, state2 + c, src + c, out + c, frames, m_channels, mask);
+            if (c < m_channels)
+                detail::biquad_section<1, true, A>(m_sections[s], state1 + c, state2 + c, src + c, out + c, frames, m_channels, mask);
+        }
+    }
+
+    /**
+     * Clears the state of every section, as if the cascade had only seen
+     * zeros.
+     */
+    template <class T, class A>
+    inline void biquad_cascade<T, A>::reset() noexcept
+    {
+        std::fill(m_state.begin(), m_state.end(), T(0));
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_FOR_EACH_HPP
+#define XSIMD_ALGORITHMS_FOR_EACH_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_for_each Batch loops
+     */
+
+    namespace detail
+    {
+        template <class T, class A, class F>
+        inline void for_each_batch_impl(T const* src, T* dst, std::size_t n, F& f)
+        {
+            using batch_type = batch<T, A>;
+            using result_type = std::decay_t<decltype(f(std::declval<batch_type>()))>;
+            static_assert(std::is_same<result_type, batch_type>::value, "the function must return a batch of the same type");
+            constexpr std::size_t size = batch_type::size;
+
+            // an empty range may come with null pointers, which not even a
+            // zero sized memcpy accepts
+            if (n == 0)
+                return;
+            if (n < size)
+            {
+                if constexpr (has_mask_load_v<batch_type> && has_mask_store_v<batch_type>)
+                {
+                    auto const mask = batch_bool<T, A>::first_n(n);
+                    f(batch_type::load(src, mask, unaligned_mode {})).store(dst, mask, unaligned_mode {});
+                }
+                else
+                {
+                    // no predication: go through a zero padded copy
+                    alignas(A::alignment()) T buffer[size] = {};
+                    std::memcpy(buffer, src, n * sizeof(T));
+                    f(batch_type::load_aligned(buffer)).store_aligned(buffer);
+                    std::memcpy(dst, buffer, n * sizeof(T));
+                }
+                return;
+            }
+
+            // The last batch overlaps the previous one rather than being
+            // masked: a masked store blocks store forwarding to any load of
+            // its whole width, which stalls loops over adjacent short arrays.
+            // It is loaded first so that an in-place loop reads the original
+            // values.
+            std::size_t const vec_size = n - n % size;
+            batch_type const last = batch_type::load_unaligned(src + (n - size));
+            for (std::size_t i = 0; i < vec_size; i += size)
+                f(batch_type::load_unaligned(src + i)).store_unaligned(dst + i);
+            if (vec_size != n)
+                f(last).store_unaligned(dst + (n - size));
+        }
+    }
+
+    /**
+     * @ingroup algorithms_for_each
+     *
+     * Replaces each batch \c x of the \c n elements at \c data by \c f(x).
+     *
+     * No scalar remainder loop is run. When \c n is at least a batch, the
+     * last, partial batch is computed as a full batch that overlaps the
+     * previous one. Shorter arrays go through a masked load and store where
+     * the architecture predicates them in hardware (see has_mask_load), and
+     * through a zero padded copy elsewhere.
+     *
+     * \c f must therefore be elementwise and free of side effects: it may be
+     * called on lanes past \c n, which hold zeros, and on some elements twice.
+     * Only the first \c n elements are written.
+     *
+     * @param data the elements to transform, in place.
+     * @param n the number of elements.
+     * @param f a function taking and returning a \c batch<T, A>.
+     */
+    template <class A = default_arch, class T, class F>
+    inline void for_each_batch(T* data, std::size_t n, F&& f)
+    {
+        detail::for_each_batch_impl<T, A>(data, data, n, f);
+    }
+
+    /**
+     * @ingroup algorithms_for_each
+     *
+     * Stores \c f(x) for each batch \c x of the \c n elements at \c src to
+     * the same position in \c dst. The tail is handled as in the in place
+     * overload, with the same requirements on \c f.
+     *
+     * @param src the elements to transform.
+     * @param dst the destination, either equal to \c src or not overlapping it.
+     * @param n the number of elements.
+     * @param f a function taking and returning a \c batch<T, A>.
+     */
+    template <class A = default_arch, class T, class F>
+    inline void for_each_batch(T const* src, T* dst, std::size_t n, F&& f)
+    {
+        assert((src == dst || src + n <= dst || dst + n <= src) && "source and destination overlap");
+        detail::for_each_batch_impl<T, A>(src, dst, n, f);
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,523 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_GEMM_HPP
+#define XSIMD_ALGORITHMS_GEMM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../config/xsimd_cpu_topology.hpp"
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_gemm Matrix multiplication
+     */
+
+    /**
+     * @ingroup algorithms_gemm
+     *
+     * Storage order of the matrices passed to gemm().
+     */
+    enum class matrix_layout
+    {
+        row_major,
+        column_major
+    };
+
+    namespace detail
+    {
+        template <class A>
+        struct is_sve_arch : std::false_type
+        {
+        };
+
+        template <std::size_t N>
+        struct is_sve_arch<sve<N>> : std::true_type
+        {
+        };
+
+        template <class A>
+        struct is_rvv_arch : std::false_type
+        {
+        };
+
+        template <std::size_t N>
+        struct is_rvv_arch<rvv<N>> : std::true_type
+        {
+        };
+
+        // Number of architectural vector registers available to a kernel.
+        template <class A>
+        constexpr std::size_t vector_register_count() noexcept
+        {
+            if constexpr (std::is_base_of_v<avx512f, A> || std::is_base_of_v<neon64, A>
+                          || std::is_base_of_v<vsx, A> || std::is_base_of_v<vxe, A>
+                          || is_sve_arch<A>::value || is_rvv_arch<A>::value)
+                return 32;
+            else
+                return 16;
+        }
+
+        /*
+         * Shape of the register tile of the micro-kernel: mr rows of C by nv
+         * batches of columns. The mr * nv accumulators, the nv rows of B and the
+         * broadcast element of A fill the vector register file.
+         */
+        template <class T, class A>
+        struct gemm_traits
+        {
+            static constexpr std::size_t simd_size = batch<T, A>::size;
+            static constexpr std::size_t nv = 2;
+            static constexpr std::size_t mr = (vector_register_count<A>() - nv - 1) / nv;
+            static constexpr std::size_t nr = nv * simd_size;
+        };
+
+        struct gemm_blocking
+        {
+            std::size_t kc;
+            std::size_t mc;
+            std::size_t nc;
+            // largest k * n for which B is read in place
+            std::size_t small_kn;
+        };
+
+        /*
+         * Cache blocking parameters: a kc x nr panel of B stays in L1, a
+         * mc x kc block of A in L2 and a kc x nc block of B in L3. B is not
+         * packed at all when it fits in half of L1.
+         */
+        template <class T, class A>
+        inline gemm_blocking gemm_block_sizes() noexcept
+        {
+            static gemm_blocking const blocking = []() noexcept
+            {
+                using traits = gemm_traits<T, A>;
+                auto const& topo = available_topology();
+                std::size_t const l1 = topo.l1d.size != 0 ? topo.l1d.size : 32 * 1024;
+                std::size_t const l2 = topo.l2.size != 0 ? topo.l2.size : 256 * 1024;
+                std::size_t const l3 = topo.l3.size != 0 ? topo.l3.size : 2 * 1024 * 1024;
+                gemm_blocking res;
+                res.kc = std::clamp<std::size_t>(l1 / 2 / (traits::nr * sizeof(T)) / 8 * 8, 64, 512);
+                res.mc = std::clamp<std::size_t>(l2 / 2 / (res.kc * sizeof(T)) / traits::mr, 1, 64) * traits::mr;
+                res.nc = std::clamp<std::size_t>(l3 / 4 / (res.kc * sizeof(T)) / traits::nr, 1, 128) * traits::nr;
+                res.small_kn = l1 / 2 / sizeof(T);
+                return res;
+            }();
+            return blocking;
+        }
+
+        /*
+         * Packs the mc x kc block of A into row panels of mr rows: for each k,
+         * the mr elements of the panel column are contiguous. Rows past mc are
+         * zero-filled.
+         */
+        template <class T, class A>
+        inline void gemm_pack_a(std::size_t mc, std::size_t kc, T const* a, std::size_t rs_a, std::size_t cs_a, T* packed) noexcept
+        {
+            constexpr std::size_t mr = gemm_traits<T, A>::mr;
+            for (std::size_t i = 0; i < mc; i += mr)
+            {
+                std::size_t const rows = std::min(mr, mc - i);
+                if (cs_a == 1)
+                {
+                    // read the rows of A sequentially
+                    for (std::size_t r = 0; r < rows; ++r)
+                    {
+                        T const* src = a + (i + r) * rs_a;
+                        for (std::size_t p = 0; p < kc; ++p)
+                            packed[p * mr + r] = src[p];
+                    }
+                    for (std::size_t r = rows; r < mr; ++r)
+                    {
+                        for (std::size_t p = 0; p < kc; ++p)
+                            packed[p * mr + r] = T(0);
+                    }
+                    packed += kc * mr;
+                    continue;
+                }
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    T const* src = a + i * rs_a + p * cs_a;
+                    for (std::size_t r = 0; r < rows; ++r)
+                        packed[r] = src[r * rs_a];
+                    for (std::size_t r = rows; r < mr; ++r)
+                        packed[r] = T(0);
+                    packed += mr;
+                }
+            }
+        }
+
+        /*
+         * Packs the kc x nc block of B into column panels of nr columns: for
+         * each k, the nr elements of the panel row are contiguous and aligned.
+         * Columns past nc are zero-filled.
+         */
+        template <class T, class A>
+        inline void gemm_pack_b(std::size_t kc, std::size_t nc, T const* b, std::size_t rs_b, std::size_t cs_b, T* packed) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t nr = gemm_traits<T, A>::nr;
+            constexpr std::size_t simd_size = batch_type::size;
+            for (std::size_t j = 0; j < nc; j += nr)
+            {
+                std::size_t const cols = std::min(nr, nc - j);
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    T const* src = b + p * rs_b + j * cs_b;
+                    if (cs_b == 1)
+                    {
+                        // the micro-kernel reloads the panel with vector loads,
+                        // which cannot be forwarded from scalar stores
+                        for (std::size_t v = 0; v < nr; v += simd_size)
+                        {
+                            batch_type row(T(0));
+                            if (v + simd_size <= cols)
+                                row = batch_type::load_unaligned(src + v);
+                            else if (v < cols)
+                                row = batch_type::load(src + v, batch_bool<T, A>::first_n(cols - v), unaligned_mode {});
+                            row.store_aligned(packed + v);
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t c = 0; c < cols; ++c)
+                            packed[c] = src[c * cs_b];
+                        for (std::size_t c = cols; c < nr; ++c)
+                            packed[c] = T(0);
+                    }
+                    packed += nr;
+                }
+            }
+        }
+
+        /*
+         * Writes alpha * acc + beta * C to the first rows x cols elements of
+         * the mr x nr tile of C at c, whose rows are rs_c elements apart.
+         */
+        template <class T, class A, std::size_t N>
+        XSIMD_INLINE void gemm_store_tile(std::array<batch<T, A>, N> const& acc,
+                                          T* c, std::size_t rs_c,
+                                          T alpha, T beta, std::size_t rows, std::size_t cols) noexcept
+        {
+            using batch_type = batch<T, A>;
+            using traits = gemm_traits<T, A>;
+            constexpr std::size_t mr = traits::mr;
+            constexpr std::size_t nv = traits::nv;
+            constexpr std::size_t nr = traits::nr;
+            constexpr std::size_t simd_size = traits::simd_size;
+
+            batch_type const valpha(alpha);
+            batch_type const vbeta(beta);
+            if (rows == mr && cols == nr)
+            {
+                for (std::size_t r = 0; r < mr; ++r)
+                {
+                    for (std::size_t v = 0; v < nv; ++v)
+                    {
+                        T* dst = c + r * rs_c + v * simd_size;
+                        batch_type res = valpha * acc[r * nv + v];
+                        if (beta != T(0))
+                            res = fma(vbeta, batch_type::load_unaligned(dst), res);
+                        res.store_unaligned(dst);
+                    }
+                }
+            }
+            else
+            {
+                alignas(A::alignment()) T buffer[mr * nr];
+                for (std::size_t i = 0; i < N; ++i)
+                    (valpha * acc[i]).store_aligned(buffer + i * simd_size);
+                for (std::size_t j = 0; j < cols; j += simd_size)
+                {
+                    std::size_t const count = std::min(simd_size, cols - j);
+                    auto const mask = batch_bool<T, A>::first_n(count);
+                    for (std::size_t r = 0; r < rows; ++r)
+                    {
+                        T* dst = c + r * rs_c + j;
+                        batch_type res = batch_type::load_aligned(buffer + r * nr + j);
+                        if (beta != T(0))
+                            res = fma(vbeta, batch_type::load(dst, mask, unaligned_mode {}), res);
+                        res.store(dst, mask, unaligned_mode {});
+                    }
+                }
+            }
+        }
+
+        /*
+         * Computes the mr x nr tile alpha * Ap * Bp + beta * C from a packed
+         * panel of A and a panel of B whose rows are rs_bp elements apart,
+         * packed and aligned if PackedB is set. Only the first rows x cols
+         * elements of the tile are written back to C.
+         */
+        template <class T, class A, bool PackedB>
+        XSIMD_INLINE void gemm_micro_kernel(std::size_t kc, T const* ap, T const* bp, std::size_t rs_bp,
+                                            T* c, std::size_t rs_c,
+                                            T alpha, T beta, std::size_t rows, std::size_t cols) noexcept
+        {
+            using batch_type = batch<T, A>;
+            using traits = gemm_traits<T, A>;
+            constexpr std::size_t mr = traits::mr;
+            constexpr std::size_t nv = traits::nv;
+            constexpr std::size_t simd_size = traits::simd_size;
+
+            // the loops below have constant trip counts and are fully
+            // unrolled, which keeps acc in registers
+            std::array<batch_type, mr * nv> acc;
+            for (std::size_t i = 0; i < mr * nv; ++i)
+                acc[i] = batch_type(T(0));
+
+            for (std::size_t p = 0; p < kc; ++p)
+            {
+                std::array<batch_type, nv> bv;
+                for (std::size_t v = 0; v < nv; ++v)
+                {
+                    if constexpr (PackedB)
+                        bv[v] = batch_type::load_aligned(bp + v * simd_size);
+                    else
+                        bv[v] = batch_type::load_unaligned(bp + v * simd_size);
+                }
+                for (std::size_t r = 0; r < mr; ++r)
+                {
+                    batch_type const av(ap[r]);
+                    for (std::size_t v = 0; v < nv; ++v)
+                        acc[r * nv + v] = fma(av, bv[v], acc[r * nv + v]);
+                }
+                ap += mr;
+                bp += rs_bp;
+            }
+            gemm_store_tile<T, A>(acc, c, rs_c, alpha, beta, rows, cols);
+        }
+
+        template <class T, class A>
+        inline T* gemm_buffer(std::vector<T, aligned_allocator<T, A::alignment()>>& buffer, std::size_t size)
+        {
+            if (buffer.size() < size)
+                buffer.resize(size);
+            return buffer.data();
+        }
+
+        /*
+         * C = alpha * A * B + beta * C for m x k A and k x n B given by their
+         * row and column strides, and m x n C given by its row stride.
+         */
+        template <class A, class T>
+        inline void gemm_strided(std::size_t m, std::size_t n, std::size_t k, T alpha,
+                                 T const* a, std::size_t rs_a, std::size_t cs_a,
+                                 T const* b, std::size_t rs_b, std::size_t cs_b,
+                                 T beta, T* c, std::size_t rs_c)
+        {
+            using traits = gemm_traits<T, A>;
+            constexpr std::size_t mr = traits::mr;
+            constexpr std::size_t nr = traits::nr;
+
+            if (m == 0 || n == 0)
+                return;
+            if (k == 0 || alpha == T(0))
+            {
+                for (std::size_t i = 0; i < m; ++i)
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        T& dst = c[i * rs_c + j];
+                        dst = beta == T(0) ? T(0) : beta * dst;
+                    }
+                return;
+            }
+
+            auto const blocks = gemm_block_sizes<T, A>();
+            // a B small enough to stay in L1 is read in place, except for
+            // its last, partial, column panel
+            bool const in_place_b = cs_b == 1 && k * n <= blocks.small_kn;
+            thread_local std::vector<T, aligned_allocator<T, A::alignment()>> a_buffer;
+            thread_local std::vector<T, aligned_allocator<T, A::alignment()>> b_buffer;
+            std::size_t const mc_max = std::min(blocks.mc, (m + mr - 1) / mr * mr);
+            std::size_t const nc_max = in_place_b ? nr : std::min(blocks.nc, (n + nr - 1) / nr * nr);
+            std::size_t const kc_max = std::min(blocks.kc, k);
+            T* const a_packed = gemm_buffer<T, A>(a_buffer, mc_max * kc_max);
+            T* const b_packed = gemm_buffer<T, A>(b_buffer, nc_max * kc_max);
+
+            for (std::size_t jc = 0; jc < n; jc += blocks.nc)
+            {
+                std::size_t const nc = std::min(blocks.nc, n - jc);
+                std::size_t const nc_full = nc / nr * nr;
+                for (std::size_t pc = 0; pc < k; pc += blocks.kc)
+                {
+                    std::size_t const kc = std::min(blocks.kc, k - pc);
+                    T const beta_block = pc == 0 ? beta : T(1);
+                    T const* const b_block = b + pc * rs_b + jc * cs_b;
+                    if (!in_place_b)
+                        gemm_pack_b<T, A>(kc, nc, b_block, rs_b, cs_b, b_packed);
+                    else if (nc_full != nc)
+                        gemm_pack_b<T, A>(kc, nc - nc_full, b_block + nc_full, rs_b, cs_b, b_packed);
+                    for (std::size_t ic = 0; ic < m; ic += blocks.mc)
+                    {
+                        std::size_t const mc = std::min(blocks.mc, m - ic);
+                        gemm_pack_a<T, A>(mc, kc, a + ic * rs_a + pc * cs_a, rs_a, cs_a, a_packed);
+                        for (std::size_t jr = 0; jr < nc; jr += nr)
+                        {
+                            T* const c_panel = c + ic * rs_c + jc + jr;
+                            std::size_t const cols = std::min(nr, nc - jr);
+                            for (std::size_t ir = 0; ir < mc; ir += mr)
+                            {
+                                std::size_t const rows = std::min(mr, mc - ir);
+                                if (!in_place_b)
+                                    gemm_micro_kernel<T, A, true>(kc, a_packed + ir * kc, b_packed + jr * kc, nr,
+                                                                  c_panel + ir * rs_c, rs_c, alpha, beta_block, rows, cols);
+                                else if (jr < nc_full)
+                                    gemm_micro_kernel<T, A, false>(kc, a_packed + ir * kc, b_block + jr, rs_b,
+                                                                   c_panel + ir * rs_c, rs_c, alpha, beta_block, rows, cols);
+                                else
+                                    gemm_micro_kernel<T, A, true>(kc, a_packed + ir * kc, b_packed, nr,
+                                                                  c_panel + ir * rs_c, rs_c, alpha, beta_block, rows, cols);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template <std::size_t N>
+        struct gemm_first_lanes
+        {
+            static constexpr bool get(std::size_t i, std::size_t) noexcept { return i < N; }
+        };
+
+        /*
+         * Tile of rows [I, I + R) and of the batch of columns starting at J of
+         * the fixed size product: the columns of B are loaded once per k and
+         * reused across the R rows. The last, partial, batch of columns is
+         * accessed through a constant mask when Tail is set.
+         */
+        template <std::size_t R, std::size_t I, std::size_t N, std::size_t K, class A, bool Tail, class T>
+        XSIMD_INLINE void matmul_tile(T const* a, T const* b, T* c, std::size_t j) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr auto tail_mask = ::xsimd::make_batch_bool_constant<T, gemm_first_lanes<N % batch_type::size>, A>();
+
+            std::array<batch_type, R> acc;
+            for (std::size_t r = 0; r < R; ++r)
+                acc[r] = batch_type(T(0));
+            for (std::size_t p = 0; p < K; ++p)
+            {
+                batch_type bv;
+                if constexpr (Tail)
+                    bv = batch_type::load(b + p * N + j, tail_mask, unaligned_mode {});
+                else
+                    bv = batch_type::load_unaligned(b + p * N + j);
+                for (std::size_t r = 0; r < R; ++r)
+                    acc[r] = fma(batch_type(a[(I + r) * K + p]), bv, acc[r]);
+            }
+            for (std::size_t r = 0; r < R; ++r)
+            {
+                if constexpr (Tail)
+                    acc[r].store(c + (I + r) * N + j, tail_mask, unaligned_mode {});
+                else
+                    acc[r].store_unaligned(c + (I + r) * N + j);
+            }
+        }
+
+        template <std::size_t R, std::size_t I, std::size_t N, std::size_t K, class A, class T>
+        XSIMD_INLINE void matmul_rows(T const* a, T const* b, T* c) noexcept
+        {
+            constexpr std::size_t simd_size = batch<T, A>::size;
+            constexpr std::size_t full = N / simd_size * simd_size;
+            for (std::size_t j = 0; j < full; j += simd_size)
+                matmul_tile<R, I, N, K, A, false>(a, b, c, j);
+            if constexpr (full != N)
+                matmul_tile<R, I, N, K, A, true>(a, b, c, full);
+        }
+
+        template <std::size_t M, std::size_t N, std::size_t K, class A, class T, std::size_t... Blocks>
+        XSIMD_INLINE void matmul_blocks(T const* a, T const* b, T* c, std::index_sequence<Blocks...>) noexcept
+        {
+            constexpr std::size_t mr = gemm_traits<T, A>::mr;
+            (matmul_rows<std::min(mr, M - Blocks * mr), Blocks * mr, N, K, A>(a, b, c), ...);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_gemm
+     *
+     * General matrix multiply <tt>C = alpha * A * B + beta * C</tt>, with \c A
+     * of size \c m x \c k, \c B of size \c k x \c n and \c C of size \c m x \c n.
+     *
+     * The operands are packed into panels sized after the caches reported by
+     * available_topology() and multiplied by a register-blocked micro-kernel,
+     * whose tile is \c mr rows by two batches of columns, \c mr being chosen
+     * so that the accumulators fill the vector registers of \c A. As in BLAS,
+     * \c C is not read when \c beta is zero.
+     *
+     * @tparam A architecture used for the kernel.
+     * @param layout storage order of the three matrices.
+     * @param lda, ldb, ldc leading dimensions of \c a, \c b and \c c, that is
+     * the distance between two rows (row-major) or two columns (column-major).
+     */
+    template <class A = default_arch, class T>
+    inline void gemm(matrix_layout layout, std::size_t m, std::size_t n, std::size_t k,
+                     T alpha, T const* a, std::size_t lda, T const* b, std::size_t ldb,
+                     T beta, T* c, std::size_t ldc)
+    {
+        static_assert(std::is_floating_point_v<T>, "gemm is only defined for floating point values");
+        if (layout == matrix_layout::row_major)
+        {
+            detail::gemm_strided<A>(m, n, k, alpha, a, lda, 1, b, ldb, 1, beta, c, ldc);
+        }
+        else
+        {
+            // C^T = B^T * A^T, where the transposes are row-major views of
+            // the column-major operands.
+            detail::gemm_strided<A>(n, m, k, alpha, b, ldb, 1, a, lda, 1, beta, c, ldc);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_gemm
+     *
+     * Multiplies the contiguous row-major matrices \c a (\c m x \c k) and \c b
+     * (\c k x \c n) into \c c (\c m x \c n).
+     */
+    template <class A = default_arch, class T>
+    inline void gemm(std::size_t m, std::size_t n, std::size_t k, T const* a, T const* b, T* c)
+    {
+        gemm<A>(matrix_layout::row_major, m, n, k, T(1), a, k, b, n, T(0), c, n);
+    }
+
+    /**
+     * @ingroup algorithms_gemm
+     *
+     * Multiplies the contiguous row-major matrices \c a (\c M x \c K) and \c b
+     * (\c K x \c N) into \c c (\c M x \c N), with sizes known at compile time.
+     * The product is fully unrolled over register tiles, without packing, which
+     * suits the small sizes for which the setup of gemm() dominates. Columns
+     * that do not fill a batch are accessed with constant masks.
+     */
+    template <std::size_t M, std::size_t N, std::size_t K, class A = default_arch, class T>
+    XSIMD_INLINE void matmul(T const* a, T const* b, T* c) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "matmul is only defined for floating point values");
+        static_assert(M > 0 && N > 0 && K > 0, "matrix sizes must be positive");
+        constexpr std::size_t mr = detail::gemm_traits<T, A>::mr;
+        detail::matmul_blocks<M, N, K, A>(a, b, c, std::make_index_sequence<(M + mr - 1) / mr> {});
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,253 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_HISTOGRAM_HPP
+#define XSIMD_ALGORITHMS_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+#include "./xsimd_search.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_histogram Histograms
+     *
+     * Bucket of each element of an array among sorted boundaries, and
+     * histograms over bins of fixed width or between sorted boundaries.
+     */
+
+    namespace detail
+    {
+        // bins of width (hi - lo) / bins, values out of [lo, hi) clipped into
+        // the first or last one, NaNs to the extra bin
+        template <class A, class T>
+        struct fixed_width_bins
+        {
+            using batch_type = batch<T, A>;
+            using index_type = as_integer_t<T>;
+
+            fixed_width_bins(T lo, T hi, std::size_t bins) noexcept
+                : lo(lo)
+                , scale(T(bins) / (hi - lo))
+                , last(T(bins - 1))
+                , bins(bins)
+            {
+                assert(lo < hi && "histogram range must not be empty");
+            }
+
+            template <std::size_t N>
+            void operator()(batch_type const (&x)[N], batch<index_type, A> (&bin)[N]) const noexcept
+            {
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    batch_type const t = clip((x[k] - batch_type(lo)) * batch_type(scale), batch_type(T(0)), batch_type(last));
+                    bin[k] = nearbyint_as_int(floor(select(isnan(x[k]), batch_type(T(bins)), t)));
+                }
+            }
+
+            std::size_t operator()(T x) const noexcept
+            {
+                if (x != x)
+                    return bins;
+                return static_cast<std::size_t>(std::floor(std::min(std::max((x - lo) * scale, T(0)), last)));
+            }
+
+            T lo, scale, last;
+            std::size_t bins;
+        };
+
+        // buckets between sorted boundaries, NaNs to the extra bucket
+        template <class A, class T>
+        struct boundary_bins
+        {
+            using batch_type = batch<T, A>;
+            using index_type = as_integer_t<T>;
+
+            boundary_bins(T const* boundaries, std::size_t count) noexcept
+                : search(boundaries, count)
+                , bins(count + 1)
+            {
+            }
+
+            template <std::size_t N>
+            void operator()(batch_type const (&x)[N], batch<index_type, A> (&bin)[N]) const noexcept
+            {
+                search(x, bin);
+                for (std::size_t k = 0; k < N; ++k)
+                    bin[k] = select(batch_bool_cast<index_type>(isnan(x[k])), batch<index_type, A>(static_cast<index_type>(bins)), bin[k]);
+            }
+
+            std::size_t operator()(T x) const noexcept
+            {
+                return x != x ? bins : search(x);
+            }
+
+            sorted_search<A, T, true> search;
+            std::size_t bins;
+        };
+
+        /*
+         * Counts in sub, which holds copies of stride counters, the bins of
+         * the elements from i on, N batches at a time; returns where it
+         * stopped. Lane j counts into copy j modulo copies.
+         */
+        template <std::size_t N, class A, class T, class Bins>
+        inline std::size_t histogram_groups(Bins const& bin_of, T const* values, std::size_t i, std::size_t n, uint32_t* sub, std::size_t stride, std::size_t copies) noexcept
+        {
+            using batch_type = batch<T, A>;
+            using index_type = as_integer_t<T>;
+            constexpr std::size_t size = batch_type::size;
+            alignas(A::alignment()) index_type lanes[N * size];
+            uint32_t* copy_of[size];
+            for (std::size_t j = 0; j < size; ++j)
+                copy_of[j] = sub + (j & (copies - 1)) * stride;
+            for (; i + N * size <= n; i += N * size)
+            {
+                batch_type x[N];
+                batch<index_type, A> bin[N];
+                for (std::size_t k = 0; k < N; ++k)
+                    x[k] = batch_type::load_unaligned(values + i + k * size);
+                bin_of(x, bin);
+                for (std::size_t k = 0; k < N; ++k)
+                    bin[k].store_aligned(lanes + k * size);
+                for (std::size_t k = 0; k < N; ++k)
+                    for (std::size_t j = 0; j < size; ++j)
+                        ++copy_of[j][lanes[k * size + j]];
+            }
+            return i;
+        }
+
+        /*
+         * Adds to counts how many elements fall in each of the bins, those
+         * mapped to index bins being left out. Each lane counts into its own
+         * copy of the bins so that runs of equal values do not wait on the
+         * same counter, at least while the copies fit in a few hundred kB;
+         * the copies are summed at the end.
+         */
+        template <class A, class T, class Bins>
+        inline void histogram_count(T const* values, std::size_t n, std::size_t bins, uint32_t* counts, Bins const& bin_of)
+        {
+            using count_batch = batch<uint32_t, A>;
+
+            std::size_t const stride = bins + 1;
+            std::size_t copies = batch<T, A>::size;
+            while (copies > 1 && copies * stride > (std::size_t(1) << 16))
+                copies /= 2;
+            std::vector<uint32_t> sub(copies * stride, 0);
+
+            std::size_t i = histogram_groups<4, A>(bin_of, values, 0, n, sub.data(), stride, copies);
+            i = histogram_groups<1, A>(bin_of, values, i, n, sub.data(), stride, copies);
+            for (; i < n; ++i)
+                ++sub[bin_of(values[i])];
+
+            for (std::size_t c = 1; c < copies; ++c)
+            {
+                uint32_t const* const copy = sub.data() + c * stride;
+                std::size_t b = 0;
+                for (; b + count_batch::size <= bins; b += count_batch::size)
+                    (count_batch::load_unaligned(sub.data() + b) + count_batch::load_unaligned(copy + b)).store_unaligned(sub.data() + b);
+                for (; b < bins; ++b)
+                    sub[b] += copy[b];
+            }
+            std::size_t b = 0;
+            for (; b + count_batch::size <= bins; b += count_batch::size)
+                (count_batch::load_unaligned(counts + b) + count_batch::load_unaligned(sub.data() + b)).store_unaligned(counts + b);
+            for (; b < bins; ++b)
+                counts[b] += sub[b];
+        }
+    }
+
+    /**
+     * @ingroup algorithms_histogram
+     *
+     * Bucket of each element among sorted boundaries: the number of
+     * boundaries not greater than the element, as \c std::upper_bound, so
+     * that bucket \c i holds the elements in
+     * <tt>[boundaries[i - 1], boundaries[i])</tt>. NaNs are sorted after
+     * every boundary, in bucket \c nb.
+     *
+     * This is upper_bounds() with the boundaries as the sorted array: each
+     * lane runs a binary search without branches, looking boundaries up with
+     * \c swizzle when they fit in a register and with \c gather otherwise.
+     *
+     * @param values the elements.
+     * @param n the number of elements.
+     * @param boundaries the boundaries, sorted in increasing order.
+     * @param nb the number of boundaries, less than 2^31.
+     * @param buckets the bucket of each element, between 0 and \c nb.
+     */
+    template <class A = default_arch, class T>
+    inline void bucketize(T const* values, std::size_t n, T const* boundaries, std::size_t nb, uint32_t* buckets) noexcept
+    {
+        detail::sorted_bounds<A, true>(boundaries, nb, values, n, buckets);
+    }
+
+    /**
+     * @ingroup algorithms_histogram
+     *
+     * Counts the elements in \c bins bins of equal width over
+     * <tt>[lo, hi)</tt>. Elements below \c lo are counted in the first bin,
+     * those not below \c hi in the last one; NaNs are not counted.
+     *
+     * Bins are computed a batch at a time. Each lane then counts into its
+     * own copy of the histogram, so that equal neighbours do not serialize
+     * on one counter.
+     *
+     * @param values the elements.
+     * @param n the number of elements.
+     * @param lo the lower bound of the first bin.
+     * @param hi the upper bound of the last bin, greater than \c lo.
+     * @param bins the number of bins, at least 1.
+     * @param counts the counts of each bin, to which the counts of these
+     * elements are added.
+     */
+    template <class A = default_arch, class T>
+    inline void histogram(T const* values, std::size_t n, T lo, T hi, std::size_t bins, uint32_t* counts)
+    {
+        static_assert(std::is_floating_point<T>::value, "histogram is only defined for floating point elements");
+        assert(bins > 0 && "histogram must have bins");
+        detail::histogram_count<A>(values, n, bins, counts, detail::fixed_width_bins<A, T>(lo, hi, bins));
+    }
+
+    /**
+     * @ingroup algorithms_histogram
+     *
+     * Counts the elements in the <tt>nb + 1</tt> buckets delimited by sorted
+     * boundaries, as numbered by bucketize(). NaNs are not counted.
+     *
+     * @param values the elements.
+     * @param n the number of elements.
+     * @param boundaries the boundaries, sorted in increasing order.
+     * @param nb the number of boundaries, less than 2^31.
+     * @param counts the counts of each of the <tt>nb + 1</tt> buckets, to
+     * which the counts of these elements are added.
+     */
+    template <class A = default_arch, class T>
+    inline void histogram(T const* values, std::size_t n, T const* boundaries, std::size_t nb, uint32_t* counts)
+    {
+        static_assert(std::is_floating_point<T>::value, "histogram is only defined for floating point elements");
+        detail::histogram_count<A>(values, n, nb + 1, counts, detail::boundary_bins<A, T>(boundaries, nb));
+    }
+}
+
+#endif
+
+#endif
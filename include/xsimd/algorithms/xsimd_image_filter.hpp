@@ -0,0 +1,710 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_IMAGE_FILTER_HPP
+#define XSIMD_ALGORITHMS_IMAGE_FILTER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../config/xsimd_cpu_topology.hpp"
+#include "../xsimd.hpp"
+#include "./xsimd_filter.hpp"
+#include "./xsimd_parallel.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_image_filter Image filtering
+     */
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Extension of an image plane beyond its borders, as seen by the filters.
+     */
+    enum class border_mode
+    {
+        /// Repeats the pixels of the border: <tt>aaa|abcd|ddd</tt>.
+        replicate,
+        /// Mirrors the plane around the pixels of the border: <tt>cb|abcd|cb</tt>.
+        reflect,
+        /// Reads zeros outside of the plane: <tt>00|abcd|00</tt>.
+        zero
+    };
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Type of the gradients computed by sobel() on a plane of \c T: \c int16_t
+     * for \c uint8_t planes, \c int32_t for \c uint16_t planes and \c float
+     * for \c float planes, so that no gradient ever saturates.
+     */
+    template <class T>
+    using sobel_value_t = std::conditional_t<std::is_same_v<T, uint8_t>, int16_t,
+                                             std::conditional_t<std::is_same_v<T, uint16_t>, int32_t, T>>;
+
+    namespace detail
+    {
+        template <class T>
+        constexpr bool is_image_value_v = std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, float>;
+
+        template <class T, class A>
+        using image_buffer_type = std::vector<T, aligned_allocator<T, A::alignment()>>;
+
+        // index of the row or column i of a plane of size n, -1 for a zero
+        inline std::ptrdiff_t image_border_index(std::ptrdiff_t i, std::size_t n, border_mode border) noexcept
+        {
+            std::ptrdiff_t const size = static_cast<std::ptrdiff_t>(n);
+            if (i >= 0 && i < size)
+                return i;
+            switch (border)
+            {
+            case border_mode::replicate:
+                return i < 0 ? 0 : size - 1;
+            case border_mode::reflect:
+            {
+                if (size == 1)
+                    return 0;
+                std::ptrdiff_t const period = 2 * (size - 1);
+                i = (i < 0 ? -i : i) % period;
+                return i < size ? i : period - i;
+            }
+            default:
+                return -1;
+            }
+        }
+
+        inline std::size_t image_slot(std::ptrdiff_t v, std::size_t count) noexcept
+        {
+            std::ptrdiff_t const n = static_cast<std::ptrdiff_t>(count);
+            return static_cast<std::size_t>(((v % n) + n) % n);
+        }
+
+        template <class A, class U>
+        XSIMD_INLINE void image_store_wide(batch<uint32_t, A> const& x, U* dst) noexcept
+        {
+            if constexpr (std::is_same_v<U, float>)
+                to_float(bitwise_cast<int32_t>(x)).store_unaligned(dst);
+            else
+                x.store_unaligned(dst);
+        }
+
+        /*
+         * Converts n pixels to float, or to uint32_t for the exact integer
+         * sums of box_blur(). 8 and 16-bit pixels are widened in registers.
+         */
+        template <class A, class T, class U>
+        inline void image_load(T const* src, U* dst, std::size_t n) noexcept
+        {
+            if constexpr (std::is_same_v<T, U>)
+            {
+                std::copy(src, src + n, dst);
+            }
+            else
+            {
+                constexpr std::size_t wide_size = batch<uint32_t, A>::size;
+                std::size_t i = 0;
+                if constexpr (std::is_same_v<T, uint8_t>)
+                {
+                    for (; i + 4 * wide_size <= n; i += 4 * wide_size)
+                    {
+                        auto const half = widen(batch<uint8_t, A>::load_unaligned(src + i));
+                        for (std::size_t h = 0; h < 2; ++h)
+                        {
+                            auto const quarter = widen(half[h]);
+                            image_store_wide(quarter[0], dst + i + 2 * h * wide_size);
+                            image_store_wide(quarter[1], dst + i + (2 * h + 1) * wide_size);
+                        }
+                    }
+                }
+                else
+                {
+                    for (; i + 2 * wide_size <= n; i += 2 * wide_size)
+                    {
+                        auto const half = widen(batch<uint16_t, A>::load_unaligned(src + i));
+                        image_store_wide(half[0], dst + i);
+                        image_store_wide(half[1], dst + i + wide_size);
+                    }
+                }
+                for (; i < n; ++i)
+                    dst[i] = static_cast<U>(src[i]);
+            }
+        }
+
+        /*
+         * Fills line[j] with column c0 + j of the row, for j in [0, n),
+         * columns outside of the plane being resolved through the border
+         * mode. A null row stands for a row of zeros.
+         */
+        template <class A, class T, class U>
+        inline void image_load_line(T const* row, std::size_t width, std::ptrdiff_t c0, std::size_t n,
+                                    border_mode border, U* line) noexcept
+        {
+            if (row == nullptr)
+            {
+                std::fill(line, line + n, U(0));
+                return;
+            }
+            std::ptrdiff_t const c1 = c0 + static_cast<std::ptrdiff_t>(n);
+            std::ptrdiff_t const begin = std::max<std::ptrdiff_t>(c0, 0);
+            std::ptrdiff_t const end = std::min<std::ptrdiff_t>(c1, static_cast<std::ptrdiff_t>(width));
+            for (std::ptrdiff_t c = c0; c < std::min(begin, c1); ++c)
+            {
+                std::ptrdiff_t const k = image_border_index(c, width, border);
+                line[c - c0] = k < 0 ? U(0) : static_cast<U>(row[k]);
+            }
+            if (begin < end)
+                image_load<A>(row + begin, line + (begin - c0), static_cast<std::size_t>(end - begin));
+            for (std::ptrdiff_t c = std::max(end, c0); c < c1; ++c)
+            {
+                std::ptrdiff_t const k = image_border_index(c, width, border);
+                line[c - c0] = k < 0 ? U(0) : static_cast<U>(row[k]);
+            }
+        }
+
+        template <class T>
+        inline T const* image_row(T const* src, std::size_t stride, std::size_t height, std::ptrdiff_t v, border_mode border) noexcept
+        {
+            std::ptrdiff_t const k = image_border_index(v, height, border);
+            return k < 0 ? nullptr : src + static_cast<std::size_t>(k) * stride;
+        }
+
+        // stores rounded and saturated integers, through a buffer for the narrow types
+        template <class A, class T>
+        XSIMD_INLINE void image_store_int(batch<int32_t, A> const& x, T* dst) noexcept
+        {
+            if constexpr (std::is_same_v<T, int32_t>)
+            {
+                x.store_unaligned(dst);
+            }
+            else
+            {
+                constexpr std::size_t size = batch<int32_t, A>::size;
+                alignas(A::alignment()) int32_t buffer[size];
+                x.store_aligned(buffer);
+                for (std::size_t i = 0; i < size; ++i)
+                    dst[i] = static_cast<T>(buffer[i]);
+            }
+        }
+
+        template <class T>
+        inline T image_round(float x) noexcept
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return x;
+            else
+            {
+                float const lo = static_cast<float>(std::numeric_limits<T>::min());
+                float const hi = static_cast<float>(std::numeric_limits<T>::max());
+                return static_cast<T>(std::nearbyint(std::min(std::max(x, lo), hi)));
+            }
+        }
+
+        // float results to pixels, rounded to nearest and saturated for integers
+        template <class A, class T>
+        inline void image_store(float const* src, T* dst, std::size_t n) noexcept
+        {
+            if constexpr (std::is_same_v<T, float>)
+            {
+                std::copy(src, src + n, dst);
+            }
+            else
+            {
+                using batch_type = batch<float, A>;
+                constexpr std::size_t size = batch_type::size;
+                batch_type const lo(static_cast<float>(std::numeric_limits<T>::min()));
+                batch_type const hi(static_cast<float>(std::numeric_limits<T>::max()));
+                std::size_t i = 0;
+                for (; i + size <= n; i += size)
+                    image_store_int<A>(nearbyint_as_int(clip(batch_type::load_unaligned(src + i), lo, hi)), dst + i);
+                for (; i < n; ++i)
+                    dst[i] = image_round<T>(src[i]);
+            }
+        }
+
+        /*
+         * Width of the column tiles, so that the rows kept in flight by a
+         * filter stay in half of the L2 cache.
+         */
+        template <class A>
+        inline std::size_t image_tile_width(std::size_t width, std::size_t rows) noexcept
+        {
+            constexpr std::size_t granularity = 4 * batch<float, A>::size;
+            std::size_t cache = available_topology().l2.size;
+            if (cache == 0)
+                cache = 256 * 1024;
+            std::size_t const tile = cache / 2 / (rows * sizeof(float)) / granularity * granularity;
+            return std::min(std::max(tile, 16 * granularity), std::max<std::size_t>(width, 1));
+        }
+
+        // out[x] = sum_j weights[j] * rows[j][x]
+        template <class A>
+        inline void image_vertical(float const* const* rows, float const* weights, std::size_t count, float* out, std::size_t n) noexcept
+        {
+            using batch_type = batch<float, A>;
+            constexpr std::size_t size = batch_type::size;
+            std::size_t x = 0;
+            for (; x + 2 * size <= n; x += 2 * size)
+            {
+                batch_type acc0(0.f), acc1(0.f);
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    batch_type const w(weights[j]);
+                    acc0 = fma(w, batch_type::load_unaligned(rows[j] + x), acc0);
+                    acc1 = fma(w, batch_type::load_unaligned(rows[j] + x + size), acc1);
+                }
+                acc0.store_unaligned(out + x);
+                acc1.store_unaligned(out + x + size);
+            }
+            for (; x < n; ++x)
+            {
+                float acc = 0.f;
+                for (std::size_t j = 0; j < count; ++j)
+                    acc += weights[j] * rows[j][x];
+                out[x] = acc;
+            }
+        }
+
+        /*
+         * out[x] = sum_j sum_i weights[j * size + i] * lines[j][x + i], the
+         * kernel size being fixed at compile time when Size is not zero.
+         */
+        template <std::size_t Size, class A>
+        inline void image_convolve_row(float const* const* lines, float const* weights, std::size_t count, float* out, std::size_t n) noexcept
+        {
+            using batch_type = batch<float, A>;
+            constexpr std::size_t size = batch_type::size;
+            std::size_t const ksize = Size != 0 ? Size : count;
+            std::size_t x = 0;
+            for (; x + 2 * size <= n; x += 2 * size)
+            {
+                batch_type acc0(0.f), acc1(0.f);
+                for (std::size_t j = 0; j < ksize; ++j)
+                    for (std::size_t i = 0; i < ksize; ++i)
+                    {
+                        batch_type const w(weights[j * ksize + i]);
+                        acc0 = fma(w, batch_type::load_unaligned(lines[j] + x + i), acc0);
+                        acc1 = fma(w, batch_type::load_unaligned(lines[j] + x + i + size), acc1);
+                    }
+                acc0.store_unaligned(out + x);
+                acc1.store_unaligned(out + x + size);
+            }
+            for (; x < n; ++x)
+            {
+                float acc = 0.f;
+                for (std::size_t j = 0; j < ksize; ++j)
+                    for (std::size_t i = 0; i < ksize; ++i)
+                        acc += weights[j * ksize + i] * lines[j][x + i];
+                out[x] = acc;
+            }
+        }
+
+        struct image_scan_last
+        {
+            static constexpr unsigned get(unsigned, unsigned n) noexcept { return n - 1; }
+        };
+
+        // moves the lanes N places up, shifting zeros in
+        template <std::size_t N, class A, class U>
+        XSIMD_INLINE batch<U, A> image_shift(batch<U, A> const& x) noexcept
+        {
+            return bitwise_cast<U>(slide_left<N * sizeof(U)>(bitwise_cast<uint32_t>(x)));
+        }
+
+        // prefix[0] = 0, prefix[i + 1] = prefix[i] + x[i], with wrapping integer sums
+        template <class A, class U>
+        inline void image_prefix_sum(U const* x, U* prefix, std::size_t n) noexcept
+        {
+            using batch_type = batch<U, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr auto last = ::xsimd::make_batch_constant<as_unsigned_integer_t<U>, image_scan_last, A>();
+            prefix[0] = U(0);
+            batch_type carry(U(0));
+            std::size_t i = 0;
+            for (; i + size <= n; i += size)
+            {
+                auto v = batch_type::load_unaligned(x + i);
+                v += image_shift<1>(v);
+                if constexpr (size > 2)
+                    v += image_shift<2>(v);
+                if constexpr (size > 4)
+                    v += image_shift<4>(v);
+                if constexpr (size > 8)
+                    v += image_shift<8>(v);
+                v += carry;
+                v.store_unaligned(prefix + i + 1);
+                carry = swizzle(v, last);
+            }
+            for (; i < n; ++i)
+                prefix[i + 1] = prefix[i] + x[i];
+        }
+
+        template <class A, class T>
+        inline void separable_filter_band(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                          std::size_t width, std::size_t height, float const* kernel_x, std::size_t size_x,
+                                          float const* kernel_y, std::size_t size_y, border_mode border,
+                                          std::size_t row_begin, std::size_t row_end)
+        {
+            std::ptrdiff_t const rx = static_cast<std::ptrdiff_t>(size_x / 2);
+            std::ptrdiff_t const ry = static_cast<std::ptrdiff_t>(size_y / 2);
+            std::size_t const tile = image_tile_width<A>(width, size_y + 2);
+
+            image_buffer_type<float, A> line(tile + size_x);
+            image_buffer_type<float, A> ring(tile * size_y);
+            image_buffer_type<float, A> out(tile);
+            std::vector<float const*> rows(size_y);
+
+            for (std::size_t x0 = 0; x0 < width; x0 += tile)
+            {
+                std::size_t const n = std::min(tile, width - x0);
+                std::ptrdiff_t const y0 = static_cast<std::ptrdiff_t>(row_begin);
+                for (std::ptrdiff_t v = y0 - ry; v < static_cast<std::ptrdiff_t>(row_end) + ry; ++v)
+                {
+                    // horizontal pass of row v into its slot of the ring
+                    image_load_line<A>(image_row(src, src_stride, height, v, border), width,
+                                       static_cast<std::ptrdiff_t>(x0) - rx, n + size_x - 1, border, line.data());
+                    fir_kernel<0, A>(kernel_x, size_x, line.data(), ring.data() + image_slot(v, size_y) * tile, n);
+
+                    // vertical pass once the rows around y are ready
+                    std::ptrdiff_t const y = v - ry;
+                    if (y < y0)
+                        continue;
+                    for (std::size_t j = 0; j < size_y; ++j)
+                        rows[j] = ring.data() + image_slot(y - ry + static_cast<std::ptrdiff_t>(j), size_y) * tile;
+                    image_vertical<A>(rows.data(), kernel_y, size_y, out.data(), n);
+                    image_store<A>(out.data(), dst + static_cast<std::size_t>(y) * dst_stride + x0, n);
+                }
+            }
+        }
+
+        template <std::size_t Size, class A, class T>
+        inline void convolve_2d_band(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                     std::size_t width, std::size_t height, float const* kernel, std::size_t ksize,
+                                     border_mode border, std::size_t row_begin, std::size_t row_end)
+        {
+            std::ptrdiff_t const r = static_cast<std::ptrdiff_t>(ksize / 2);
+            std::size_t const tile = image_tile_width<A>(width, ksize + 1);
+            std::size_t const stride = tile + ksize;
+
+            image_buffer_type<float, A> ring(stride * ksize);
+            image_buffer_type<float, A> out(tile);
+            std::vector<float const*> lines(ksize);
+
+            for (std::size_t x0 = 0; x0 < width; x0 += tile)
+            {
+                std::size_t const n = std::min(tile, width - x0);
+                std::ptrdiff_t const y0 = static_cast<std::ptrdiff_t>(row_begin);
+                for (std::ptrdiff_t v = y0 - r; v < static_cast<std::ptrdiff_t>(row_end) + r; ++v)
+                {
+                    image_load_line<A>(image_row(src, src_stride, height, v, border), width,
+                                       static_cast<std::ptrdiff_t>(x0) - r, n + ksize - 1, border,
+                                       ring.data() + image_slot(v, ksize) * stride);
+                    std::ptrdiff_t const y = v - r;
+                    if (y < y0)
+                        continue;
+                    for (std::size_t j = 0; j < ksize; ++j)
+                        lines[j] = ring.data() + image_slot(y - r + static_cast<std::ptrdiff_t>(j), ksize) * stride;
+                    image_convolve_row<Size, A>(lines.data(), kernel, ksize, out.data(), n);
+                    image_store<A>(out.data(), dst + static_cast<std::size_t>(y) * dst_stride + x0, n);
+                }
+            }
+        }
+
+        /*
+         * Box sums of the columns of a tile, averaged into dst: sums of
+         * integer pixels are exact in wrapping uint32_t arithmetic and
+         * divided by the area with an exact rounding to nearest (the area is
+         * odd, so there are no ties).
+         */
+        template <class A, class T, class U>
+        inline void box_blur_row(U const* column_sums, U* prefix, std::size_t n, std::size_t ksize, T* dst) noexcept
+        {
+            image_prefix_sum<A>(column_sums, prefix, n + ksize - 1);
+            std::size_t const area = ksize * ksize;
+            float const scale = 1.f / static_cast<float>(area);
+            using float_batch = batch<float, A>;
+            constexpr std::size_t size = float_batch::size;
+            std::size_t x = 0;
+            if constexpr (std::is_same_v<U, float>)
+            {
+                for (; x + size <= n; x += size)
+                {
+                    auto const sum = float_batch::load_unaligned(prefix + x + ksize) - float_batch::load_unaligned(prefix + x);
+                    (sum * scale).store_unaligned(dst + x);
+                }
+                for (; x < n; ++x)
+                    dst[x] = (prefix[x + ksize] - prefix[x]) * scale;
+            }
+            else
+            {
+                using int_batch = batch<int32_t, A>;
+                using uint_batch = batch<uint32_t, A>;
+                int_batch const area_b(static_cast<int32_t>(area)), half(static_cast<int32_t>(area / 2)), one(1);
+                for (; x + size <= n; x += size)
+                {
+                    auto const sum = uint_batch::load_unaligned(prefix + x + ksize) - uint_batch::load_unaligned(prefix + x);
+                    auto const t = bitwise_cast<int32_t>(sum) + half;
+                    // the float quotient is within one of the exact one
+                    auto q = to_int(to_float(t) * float_batch(scale));
+                    q = select(q * area_b > t, q - one, q);
+                    q = select(t - q * area_b >= area_b, q + one, q);
+                    image_store_int<A>(q, dst + x);
+                }
+                for (; x < n; ++x)
+                    dst[x] = static_cast<T>((uint32_t(prefix[x + ksize] - prefix[x]) + area / 2) / area);
+            }
+        }
+
+        template <class A, class T>
+        inline void box_blur_band(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                  std::size_t width, std::size_t height, std::size_t radius, border_mode border,
+                                  std::size_t row_begin, std::size_t row_end)
+        {
+            using acc_type = std::conditional_t<std::is_same_v<T, float>, float, uint32_t>;
+            using batch_type = batch<acc_type, A>;
+            constexpr std::size_t size = batch_type::size;
+            std::size_t const ksize = 2 * radius + 1;
+            std::ptrdiff_t const r = static_cast<std::ptrdiff_t>(radius);
+            std::size_t const tile = image_tile_width<A>(width, ksize + 2);
+            std::size_t const stride = tile + ksize;
+
+            image_buffer_type<acc_type, A> ring(stride * ksize);
+            image_buffer_type<acc_type, A> sums(stride);
+            image_buffer_type<acc_type, A> prefix(stride + 1);
+
+            for (std::size_t x0 = 0; x0 < width; x0 += tile)
+            {
+                std::size_t const n = std::min(tile, width - x0);
+                std::size_t const count = n + ksize - 1;
+                std::ptrdiff_t const y0 = static_cast<std::ptrdiff_t>(row_begin);
+                auto load = [&](std::ptrdiff_t v) noexcept
+                {
+                    acc_type* line = ring.data() + image_slot(v, ksize) * stride;
+                    image_load_line<A>(image_row(src, src_stride, height, v, border), width,
+                                       static_cast<std::ptrdiff_t>(x0) - r, count, border, line);
+                    return line;
+                };
+
+                std::fill(sums.begin(), sums.end(), acc_type(0));
+                for (std::ptrdiff_t v = y0 - r; v <= y0 + r; ++v)
+                {
+                    acc_type const* line = load(v);
+                    std::size_t i = 0;
+                    for (; i + size <= count; i += size)
+                        (batch_type::load_aligned(sums.data() + i) + batch_type::load_unaligned(line + i)).store_aligned(sums.data() + i);
+                    for (; i < count; ++i)
+                        sums[i] += line[i];
+                }
+                for (std::ptrdiff_t y = y0; y < static_cast<std::ptrdiff_t>(row_end); ++y)
+                {
+                    box_blur_row<A>(sums.data(), prefix.data(), n, ksize, dst + static_cast<std::size_t>(y) * dst_stride + x0);
+                    if (y + 1 == static_cast<std::ptrdiff_t>(row_end))
+                        break;
+                    // the row leaving the window and the one entering it share a slot
+                    acc_type* line = ring.data() + image_slot(y - r, ksize) * stride;
+                    std::size_t i = 0;
+                    for (; i + size <= count; i += size)
+                        (batch_type::load_aligned(sums.data() + i) - batch_type::load_unaligned(line + i)).store_aligned(sums.data() + i);
+                    for (; i < count; ++i)
+                        sums[i] -= line[i];
+                    line = load(y + r + 1);
+                    i = 0;
+                    for (; i + size <= count; i += size)
+                        (batch_type::load_aligned(sums.data() + i) + batch_type::load_unaligned(line + i)).store_aligned(sums.data() + i);
+                    for (; i < count; ++i)
+                        sums[i] += line[i];
+                }
+            }
+        }
+
+        template <class A, class T, class G>
+        inline void sobel_band(T const* src, std::size_t src_stride, G* dx, std::size_t dx_stride, G* dy, std::size_t dy_stride,
+                               std::size_t width, std::size_t height, border_mode border, std::size_t row_begin, std::size_t row_end)
+        {
+            using batch_type = batch<float, A>;
+            constexpr std::size_t size = batch_type::size;
+            std::size_t const tile = image_tile_width<A>(width, 5);
+            std::size_t const stride = tile + 2;
+
+            image_buffer_type<float, A> ring(3 * stride);
+            image_buffer_type<float, A> gx(tile), gy(tile);
+
+            for (std::size_t x0 = 0; x0 < width; x0 += tile)
+            {
+                std::size_t const n = std::min(tile, width - x0);
+                std::ptrdiff_t const y0 = static_cast<std::ptrdiff_t>(row_begin);
+                for (std::ptrdiff_t v = y0 - 1; v < static_cast<std::ptrdiff_t>(row_end) + 1; ++v)
+                {
+                    image_load_line<A>(image_row(src, src_stride, height, v, border), width,
+                                       static_cast<std::ptrdiff_t>(x0) - 1, n + 2, border, ring.data() + image_slot(v, 3) * stride);
+                    std::ptrdiff_t const y = v - 1;
+                    if (y < y0)
+                        continue;
+                    float const* l0 = ring.data() + image_slot(y - 1, 3) * stride;
+                    float const* l1 = ring.data() + image_slot(y, 3) * stride;
+                    float const* l2 = ring.data() + image_slot(y + 1, 3) * stride;
+                    // gx = [1 2 1]^T x [-1 0 1], gy = [-1 0 1]^T x [1 2 1]
+                    std::size_t x = 0;
+                    for (; x + size <= n; x += size)
+                    {
+                        auto const a0 = batch_type::load_unaligned(l0 + x), a2 = batch_type::load_unaligned(l0 + x + 2);
+                        auto const b0 = batch_type::load_unaligned(l1 + x), b2 = batch_type::load_unaligned(l1 + x + 2);
+                        auto const c0 = batch_type::load_unaligned(l2 + x), c2 = batch_type::load_unaligned(l2 + x + 2);
+                        auto const top = batch_type::load_unaligned(l0 + x + 1), bottom = batch_type::load_unaligned(l2 + x + 1);
+                        ((a2 - a0) + (c2 - c0) + 2.f * (b2 - b0)).store_unaligned(gx.data() + x);
+                        ((c0 - a0) + (c2 - a2) + 2.f * (bottom - top)).store_unaligned(gy.data() + x);
+                    }
+                    for (; x < n; ++x)
+                    {
+                        gx[x] = (l0[x + 2] - l0[x]) + (l2[x + 2] - l2[x]) + 2.f * (l1[x + 2] - l1[x]);
+                        gy[x] = (l2[x] - l0[x]) + (l2[x + 2] - l0[x + 2]) + 2.f * (l2[x + 1] - l0[x + 1]);
+                    }
+                    if (dx != nullptr)
+                        image_store<A>(gx.data(), dx + static_cast<std::size_t>(y) * dx_stride + x0, n);
+                    if (dy != nullptr)
+                        image_store<A>(gy.data(), dy + static_cast<std::size_t>(y) * dy_stride + x0, n);
+                }
+            }
+        }
+    }
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Filters a plane with the separable kernel <tt>kernel_y^T x kernel_x</tt>,
+     * applied as a correlation centered on each pixel:
+     * <tt>dst(y, x) = sum_j sum_i kernel_y[j] * kernel_x[i] * src(y + j - size_y / 2, x + i - size_x / 2)</tt>.
+     * Each source row is filtered horizontally once, into a ring of rows
+     * that the vertical pass combines; both passes work in \c float and the
+     * results are rounded to nearest and saturated for integer planes.
+     *
+     * Strides are in pixels and \c src and \c dst must not overlap.
+     *
+     * @param size_x number of horizontal taps, odd.
+     * @param size_y number of vertical taps, odd.
+     * @param num_threads number of threads filtering bands of rows, including
+     * the calling thread. Zero means one per physical core, as reported by
+     * available_topology().
+     * @tparam A architecture used for the kernels.
+     * @tparam T \c uint8_t, \c uint16_t or \c float.
+     * @throw std::bad_alloc if the line buffers of a band cannot be
+     * allocated, once every thread is done.
+     */
+    template <class A = default_arch, class T>
+    inline void separable_filter(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                 std::size_t width, std::size_t height,
+                                 float const* kernel_x, std::size_t size_x, float const* kernel_y, std::size_t size_y,
+                                 border_mode border = border_mode::replicate, std::size_t num_threads = 1)
+    {
+        static_assert(detail::is_image_value_v<T>, "planes must hold uint8_t, uint16_t or float pixels");
+        assert(size_x % 2 == 1 && size_y % 2 == 1 && "kernel sizes must be odd");
+        detail::parallel_bands(height, num_threads, [&](std::size_t row_begin, std::size_t row_end)
+                               { detail::separable_filter_band<A>(src, src_stride, dst, dst_stride, width, height, kernel_x, size_x,
+                                                                  kernel_y, size_y, border, row_begin, row_end); });
+    }
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Filters a plane with the square \c size x \c size kernel \c kernel,
+     * stored row by row and applied as a correlation centered on each pixel:
+     * <tt>dst(y, x) = sum_j sum_i kernel[j * size + i] * src(y + j - size / 2, x + i - size / 2)</tt>.
+     * The 3x3 and 5x5 kernels are fully unrolled. Results are computed in
+     * \c float, then rounded to nearest and saturated for integer planes.
+     *
+     * Strides are in pixels and \c src and \c dst must not overlap.
+     *
+     * @param size kernel size, odd.
+     * @param num_threads see separable_filter().
+     * @tparam A architecture used for the kernels.
+     * @tparam T \c uint8_t, \c uint16_t or \c float.
+     */
+    template <class A = default_arch, class T>
+    inline void convolve_2d(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                            std::size_t width, std::size_t height, float const* kernel, std::size_t size,
+                            border_mode border = border_mode::replicate, std::size_t num_threads = 1)
+    {
+        static_assert(detail::is_image_value_v<T>, "planes must hold uint8_t, uint16_t or float pixels");
+        assert(size % 2 == 1 && "kernel size must be odd");
+        detail::parallel_bands(height, num_threads, [&](std::size_t row_begin, std::size_t row_end)
+                               {
+            if (size == 3)
+                detail::convolve_2d_band<3, A>(src, src_stride, dst, dst_stride, width, height, kernel, size, border, row_begin, row_end);
+            else if (size == 5)
+                detail::convolve_2d_band<5, A>(src, src_stride, dst, dst_stride, width, height, kernel, size, border, row_begin, row_end);
+            else
+                detail::convolve_2d_band<0, A>(src, src_stride, dst, dst_stride, width, height, kernel, size, border, row_begin, row_end); });
+    }
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Averages each pixel over the square of side <tt>2 * radius + 1</tt>
+     * centered on it. The window is updated with running sums: column sums
+     * follow the rows by adding the entering row and subtracting the leaving
+     * one, and the horizontal sums are differences of prefix sums, so that
+     * the cost does not depend on the radius. Integer planes are summed and
+     * rounded exactly, as long as the sum of a window fits in 31 bits; float
+     * planes are summed in \c float.
+     *
+     * Strides are in pixels and \c src and \c dst must not overlap.
+     *
+     * @param num_threads see separable_filter().
+     * @tparam A architecture used for the kernels.
+     * @tparam T \c uint8_t, \c uint16_t or \c float.
+     */
+    template <class A = default_arch, class T>
+    inline void box_blur(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                         std::size_t width, std::size_t height, std::size_t radius,
+                         border_mode border = border_mode::replicate, std::size_t num_threads = 1)
+    {
+        static_assert(detail::is_image_value_v<T>, "planes must hold uint8_t, uint16_t or float pixels");
+        assert((std::is_same_v<T, float> || (2 * radius + 1) * (2 * radius + 1) * double(std::numeric_limits<T>::max()) < 2147483648.) && "box sums must fit in 31 bits");
+        detail::parallel_bands(height, num_threads, [&](std::size_t row_begin, std::size_t row_end)
+                               { detail::box_blur_band<A>(src, src_stride, dst, dst_stride, width, height, radius, border, row_begin, row_end); });
+    }
+
+    /**
+     * @ingroup algorithms_image_filter
+     *
+     * Computes the horizontal and vertical Sobel gradients of a plane,
+     * <tt>[1 2 1]^T x [-1 0 1]</tt> into \c dx and <tt>[-1 0 1]^T x [1 2 1]</tt>
+     * into \c dy. Gradients are stored in a type wide enough for their range,
+     * see sobel_value_t; either output may be null to skip it.
+     *
+     * Strides are in pixels and \c src must not overlap the outputs.
+     *
+     * @param num_threads see separable_filter().
+     * @tparam A architecture used for the kernels.
+     * @tparam T \c uint8_t, \c uint16_t or \c float.
+     */
+    template <class A = default_arch, class T>
+    inline void sobel(T const* src, std::size_t src_stride, sobel_value_t<T>* dx, std::size_t dx_stride,
+                      sobel_value_t<T>* dy, std::size_t dy_stride, std::size_t width, std::size_t height,
+                      border_mode border = border_mode::replicate, std::size_t num_threads = 1)
+    {
+        static_assert(detail::is_image_value_v<T>, "planes must hold uint8_t, uint16_t or float pixels");
+        detail::parallel_bands(height, num_threads, [&](std::size_t row_begin, std::size_t row_end)
+                               { detail::sobel_band<A>(src, src_stride, dx, dx_stride, dy, dy_stride, width, height, border, row_begin, row_end); });
+    }
+}
+
+#endif
+
+#endif
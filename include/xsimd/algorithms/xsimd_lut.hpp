@@ -0,0 +1,276 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_LUT_HPP
+#define XSIMD_ALGORITHMS_LUT_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_lut Lookup tables
+     *
+     * Functions tabulated over a uniform grid, interpolated between the
+     * grid points.
+     */
+
+    /**
+     * @ingroup algorithms_lut
+     *
+     * How a lookup table is interpolated between its grid points.
+     */
+    enum class lut_interpolation
+    {
+        /** Linearly between the two surrounding points. */
+        linear,
+        /** With the Catmull-Rom cubic spline through the four surrounding
+         * points, which goes through every point with a continuous slope. */
+        catmull_rom
+    };
+
+    /**
+     * @ingroup algorithms_lut
+     *
+     * Function tabulated at \c n points evenly spaced from \c lo to \c hi,
+     * interpolated between them. Arguments below \c lo or above \c hi are
+     * clamped to the first or last point, and NaN arguments give NaN.
+     *
+     * Tables of up to four batches, including a point of padding at each
+     * end, are held in registers and read with \c swizzle; larger ones are
+     * read with \c gather.
+     *
+     * @tparam T \c float or \c double.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class uniform_lut
+    {
+    public:
+        static_assert(std::is_floating_point<T>::value, "lookup tables are only defined for floating point values");
+
+        using value_type = T;
+        using arch_type = A;
+        using batch_type = batch<T, A>;
+
+        uniform_lut(T const* values, std::size_t n, T lo, T hi, lut_interpolation method = lut_interpolation::linear);
+
+        std::size_t size() const noexcept;
+
+        batch_type operator()(batch_type const& x) const noexcept;
+        T operator()(T x) const noexcept;
+        void operator()(T const* x, std::size_t count, T* out) const noexcept;
+
+    private:
+        using index_type = as_integer_t<T>;
+        using index_batch = batch<index_type, A>;
+
+        static constexpr std::size_t max_registers = 4;
+
+        template <std::size_t R>
+        batch_type lookup(index_batch const& i) const noexcept;
+        template <std::size_t R>
+        batch_type evaluate(batch_type const& x) const noexcept;
+
+        T m_lo;
+        T m_scale;
+        T m_last;
+        std::size_t m_size;
+        lut_interpolation m_method;
+        std::size_t m_registers;
+        std::vector<T, aligned_allocator<T, A::alignment()>> m_table;
+        batch_type m_in_registers[max_registers];
+    };
+
+    /**
+     * Tabulates the \c n values of \c values, at least one, sampled from
+     * \c lo to \c hi, with \c lo less than \c hi.
+     */
+    template <class T, class A>
+    inline uniform_lut<T, A>::uniform_lut(T const* values, std::size_t n, T lo, T hi, lut_interpolation method)
+        : m_lo(lo)
+        , m_scale(n > 1 ? T(n - 1) / (hi - lo) : T(0))
+        , m_last(T(n - 1))
+        , m_size(n)
+        , m_method(method)
+        , m_registers(0)
+        , m_table(n + 3)
+    {
+        assert(n > 0 && "a lookup table needs at least one value");
+        assert(lo < hi && "lookup table range must not be empty");
+        // the point before the first one and the two after the last one
+        // repeat them, so that the interpolation needs no bound check
+        m_table[0] = values[0];
+        std::copy(values, values + n, m_table.begin() + 1);
+        m_table[n + 1] = m_table[n + 2] = values[n - 1];
+
+        constexpr std::size_t size = batch_type::size;
+        if (m_table.size() <= max_registers * size)
+        {
+            m_registers = (m_table.size() + size - 1) / size;
+            m_table.resize(m_registers * size, values[n - 1]);
+            for (std::size_t r = 0; r < m_registers; ++r)
+                m_in_registers[r] = batch_type::load_aligned(m_table.data() + r * size);
+        }
+    }
+
+    /**
+     * Returns the number of tabulated values.
+     */
+    template <class T, class A>
+    inline std::size_t uniform_lut<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    // entry i of the padded table, held in R registers or gathered if R is 0
+    template <class T, class A>
+    template <std::size_t R>
+    inline auto uniform_lut<T, A>::lookup(index_batch const& i) const noexcept -> batch_type
+    {
+        if constexpr (R == 0)
+        {
+            return batch_type::gather(m_table.data(), i);
+        }
+        else
+        {
+            using mask_type = as_unsigned_integer_t<T>;
+            constexpr std::size_t size = batch_type::size;
+            batch<mask_type, A> const lane = bitwise_cast<mask_type>(i) & mask_type(size - 1);
+            batch_type res = swizzle(m_in_registers[0], lane);
+            for (std::size_t r = 1; r < R; ++r)
+            {
+                auto const in_register = batch_bool_cast<T>(i > index_batch(static_cast<index_type>(r * size - 1)));
+                res = select(in_register, swizzle(m_in_registers[r], lane), res);
+            }
+            return res;
+        }
+    }
+
+    template <class T, class A>
+    template <std::size_t R>
+    inline auto uniform_lut<T, A>::evaluate(batch_type const& x) const noexcept -> batch_type
+    {
+        auto const nan = isnan(x);
+        batch_type const t = select(nan, batch_type(T(0)), clip((x - batch_type(m_lo)) * batch_type(m_scale), batch_type(T(0)), batch_type(m_last)));
+        batch_type const whole = floor(t);
+        batch_type const f = t - whole;
+        index_batch const i = nearbyint_as_int(whole);
+
+        batch_type res;
+        if (m_method == lut_interpolation::linear)
+        {
+            batch_type const y0 = lookup<R>(i + index_type(1));
+            batch_type const y1 = lookup<R>(i + index_type(2));
+            res = fma(f, y1 - y0, y0);
+        }
+        else
+        {
+            batch_type const p0 = lookup<R>(i);
+            batch_type const p1 = lookup<R>(i + index_type(1));
+            batch_type const p2 = lookup<R>(i + index_type(2));
+            batch_type const p3 = lookup<R>(i + index_type(3));
+            // 0.5 * (2 p1 + (p2 - p0) f + (2 p0 - 5 p1 + 4 p2 - p3) f^2 + (3 (p1 - p2) + p3 - p0) f^3)
+            batch_type const c1 = p2 - p0;
+            batch_type const c2 = fma(batch_type(T(2)), p0, fms(batch_type(T(4)), p2, fma(batch_type(T(5)), p1, p3)));
+            batch_type const c3 = fma(batch_type(T(3)), p1 - p2, p3 - p0);
+            res = fma(batch_type(T(0.5)) * f, fma(fma(c3, f, c2), f, c1), p1);
+        }
+        return select(nan, x, res);
+    }
+
+    /**
+     * Interpolates the table at each lane of \c x.
+     */
+    template <class T, class A>
+    inline auto uniform_lut<T, A>::operator()(batch_type const& x) const noexcept -> batch_type
+    {
+        static_assert(max_registers == 4, "one case per number of registers");
+        switch (m_registers)
+        {
+        case 1:
+            return evaluate<1>(x);
+        case 2:
+            return evaluate<2>(x);
+        case 3:
+            return evaluate<3>(x);
+        case 4:
+            return evaluate<4>(x);
+        default:
+            return evaluate<0>(x);
+        }
+    }
+
+    /**
+     * Interpolates the table at \c x.
+     */
+    template <class T, class A>
+    inline T uniform_lut<T, A>::operator()(T x) const noexcept
+    {
+        return (*this)(batch_type(x)).first();
+    }
+
+    /**
+     * Interpolates the table at the \c count arguments of \c x into \c out.
+     */
+    template <class T, class A>
+    inline void uniform_lut<T, A>::operator()(T const* x, std::size_t count, T* out) const noexcept
+    {
+        constexpr std::size_t size = batch_type::size;
+        std::size_t i = 0;
+        for (; i + size <= count; i += size)
+            (*this)(batch_type::load_unaligned(x + i)).store_unaligned(out + i);
+        if (i < count)
+        {
+            alignas(A::alignment()) T buffer[size];
+            std::fill(std::copy(x + i, x + count, buffer), buffer + size, m_lo);
+            (*this)(batch_type::load_aligned(buffer)).store_aligned(buffer);
+            std::copy(buffer, buffer + (count - i), out + i);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_lut
+     *
+     * Interpolates a function tabulated at \c n points evenly spaced from
+     * \c lo to \c hi at the \c count arguments of \c x, as a uniform_lut
+     * built for this call.
+     *
+     * @param table the tabulated values, at least one.
+     * @param n the number of values.
+     * @param lo the argument of the first value.
+     * @param hi the argument of the last value, greater than \c lo.
+     * @param x the arguments.
+     * @param count the number of arguments.
+     * @param out the interpolated values.
+     * @param method how values are interpolated.
+     */
+    template <class A = default_arch, class T>
+    inline void lut_lookup(T const* table, std::size_t n, T lo, T hi, T const* x, std::size_t count, T* out,
+                           lut_interpolation method = lut_interpolation::linear)
+    {
+        uniform_lut<T, A> const lut(table, n, lo, hi, method);
+        lut(x, count, out);
+    }
+}
+
+#endif
+
+#endif
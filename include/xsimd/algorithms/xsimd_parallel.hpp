@@ -0,0 +1,109 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_PARALLEL_HPP
+#define XSIMD_ALGORITHMS_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../config/xsimd_cpu_topology.hpp"
+
+namespace xsimd
+{
+    namespace detail
+    {
+        // joins every started thread on all exits, so that a thread failing
+        // to start or a band throwing on the calling thread does not destroy
+        // joinable threads
+        class band_workers
+        {
+        public:
+            band_workers() = default;
+            band_workers(band_workers const&) = delete;
+            band_workers& operator=(band_workers const&) = delete;
+
+            ~band_workers()
+            {
+                for (auto& thread : m_threads)
+                    thread.join();
+            }
+
+            void reserve(std::size_t n) { m_threads.reserve(n); }
+
+            template <class F>
+            void start(F&& f) { m_threads.emplace_back(std::forward<F>(f)); }
+
+        private:
+            std::vector<std::thread> m_threads;
+        };
+
+        /*
+         * Calls f(begin, end) on num_threads consecutive bands of [0, count),
+         * the last one on the calling thread, and returns once all of them
+         * are done. Zero threads means one per physical core, as reported by
+         * available_topology(). An exception thrown by a band on another
+         * thread is rethrown on the calling one once every band is done.
+         */
+        template <class F>
+        inline void parallel_bands(std::size_t count, std::size_t num_threads, F&& f)
+        {
+            if (num_threads == 0)
+                num_threads = std::max<std::size_t>(available_topology().physical_cores, 1);
+            num_threads = std::min(num_threads, count);
+            if (num_threads <= 1)
+            {
+                f(std::size_t(0), count);
+                return;
+            }
+
+            std::vector<std::exception_ptr> errors(num_threads - 1);
+            {
+                band_workers workers;
+                workers.reserve(num_threads - 1);
+                std::size_t begin = 0;
+                for (std::size_t t = 0; t < num_threads; ++t)
+                {
+                    std::size_t const end = count * (t + 1) / num_threads;
+                    if (t + 1 == num_threads)
+                        f(begin, end);
+                    else
+                        workers.start([&f, &error = errors[t], begin, end]() noexcept
+                                      {
+#if defined(_CPPUNWIND) || defined(__cpp_exceptions)
+                            try
+                            {
+                                f(begin, end);
+                            }
+                            catch (...)
+                            {
+                                error = std::current_exception();
+                            }
+#else
+                            (void)error;
+                            f(begin, end);
+#endif
+                        });
+                    begin = end;
+                }
+            }
+            for (auto const& error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif
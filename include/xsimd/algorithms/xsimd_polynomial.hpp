@@ -0,0 +1,264 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_POLYNOMIAL_HPP
+#define XSIMD_ALGORITHMS_POLYNOMIAL_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../xsimd.hpp"
+#include "./xsimd_for_each.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_polynomial Polynomials
+     *
+     * Polynomials, rational functions and Chebyshev series with coefficients
+     * known at run time. Coefficients are given from the constant term up,
+     * as for \c detail::horner, which takes them at compile time.
+     */
+
+    namespace detail
+    {
+        // Estrin's scheme on n coefficients, at most 8, given x, x^2 and x^4
+        template <class T, class A>
+        inline batch<T, A> estrin_block(batch<T, A> const& x, batch<T, A> const& x2, batch<T, A> const& x4,
+                                        T const* coeffs, std::size_t n) noexcept
+        {
+            using batch_type = batch<T, A>;
+            auto const pair = [&](std::size_t i)
+            { return i + 1 < n ? fma(x, batch_type(coeffs[i + 1]), batch_type(coeffs[i])) : batch_type(coeffs[i]); };
+            batch_type const low = n > 2 ? fma(x2, pair(2), pair(0)) : pair(0);
+            if (n <= 4)
+                return low;
+            batch_type const high = n > 6 ? fma(x2, pair(6), pair(4)) : pair(4);
+            return fma(x4, high, low);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the polynomial of the \c n coefficients at \c coeffs at each
+     * lane of \c x with Horner's rule: one \c fma per coefficient, each one
+     * waiting for the previous one.
+     *
+     * @param x the arguments.
+     * @param coeffs the coefficients, from the constant term up.
+     * @param n the number of coefficients, the degree plus one; the
+     * polynomial is zero if there are none.
+     * @return the values of the polynomial.
+     */
+    template <class T, class A>
+    inline batch<T, A> polyval_horner(batch<T, A> const& x, T const* coeffs, std::size_t n) noexcept
+    {
+        using batch_type = batch<T, A>;
+        if (n == 0)
+            return batch_type(T(0));
+        batch_type res(coeffs[n - 1]);
+        for (std::size_t i = n - 1; i > 0; --i)
+            res = fma(x, res, batch_type(coeffs[i - 1]));
+        return res;
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the polynomial of the \c n coefficients at \c coeffs at each
+     * lane of \c x with Estrin's scheme. Blocks of eight coefficients are
+     * evaluated as trees of \c fma in \c x, \c x^2 and \c x^4, independent of
+     * each other, and then combined with Horner's rule in \c x^8. The chain
+     * of dependent operations is several times shorter than with Horner's
+     * rule, at the cost of a few more multiplications; results differ from
+     * it in rounding.
+     *
+     * @param x the arguments.
+     * @param coeffs the coefficients, from the constant term up.
+     * @param n the number of coefficients, the degree plus one; the
+     * polynomial is zero if there are none.
+     * @return the values of the polynomial.
+     */
+    template <class T, class A>
+    inline batch<T, A> polyval_estrin(batch<T, A> const& x, T const* coeffs, std::size_t n) noexcept
+    {
+        using batch_type = batch<T, A>;
+        if (n == 0)
+            return batch_type(T(0));
+        batch_type const x2 = x * x;
+        batch_type const x4 = x2 * x2;
+        std::size_t i = (n - 1) / 8 * 8;
+        batch_type res = detail::estrin_block(x, x2, x4, coeffs + i, n - i);
+        if (i > 0)
+        {
+            batch_type const x8 = x4 * x4;
+            while (i > 0)
+            {
+                i -= 8;
+                res = fma(x8, res, detail::estrin_block(x, x2, x4, coeffs + i, std::size_t(8)));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Lowest degree at which \c polyval switches from Horner's rule to
+     * Estrin's scheme.
+     */
+    constexpr std::size_t polyval_estrin_degree = 3;
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the polynomial of the \c n coefficients at \c coeffs at each
+     * lane of \c x, with Horner's rule below degree \c polyval_estrin_degree
+     * and with Estrin's scheme from it.
+     *
+     * Horner's rule does the fewest operations, which only pays off for the
+     * lowest degrees: its chain, as long as the degree, keeps the
+     * evaluations of consecutive batches from overlapping, and Estrin's
+     * scheme is faster from a cubic on, increasingly so with the degree.
+     *
+     * @param x the arguments.
+     * @param coeffs the coefficients, from the constant term up.
+     * @param n the number of coefficients, the degree plus one.
+     * @return the values of the polynomial.
+     */
+    template <class T, class A>
+    inline batch<T, A> polyval(batch<T, A> const& x, T const* coeffs, std::size_t n) noexcept
+    {
+        return n > polyval_estrin_degree ? polyval_estrin(x, coeffs, n) : polyval_horner(x, coeffs, n);
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the rational function \c p(x)/q(x) at each lane of \c x,
+     * both polynomials with \c polyval. Lanes where \c q vanishes follow
+     * IEEE division.
+     *
+     * @param x the arguments.
+     * @param p the coefficients of the numerator, from the constant term up.
+     * @param np the number of coefficients of the numerator.
+     * @param q the coefficients of the denominator, from the constant term up.
+     * @param nq the number of coefficients of the denominator.
+     * @return the values of the rational function.
+     */
+    template <class T, class A>
+    inline batch<T, A> ratval(batch<T, A> const& x, T const* p, std::size_t np, T const* q, std::size_t nq) noexcept
+    {
+        return polyval(x, p, np) / polyval(x, q, nq);
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the Chebyshev series \c sum(coeffs[k] * T_k(x)) at each
+     * lane of \c x with Clenshaw's recurrence, one \c fma per coefficient.
+     * Series are meant to be evaluated on [-1, 1]; arguments from another
+     * interval are mapped to it by the caller.
+     *
+     * @param x the arguments.
+     * @param coeffs the coefficients, of \c T_0 up.
+     * @param n the number of coefficients; the series is zero if there are
+     * none.
+     * @return the values of the series.
+     */
+    template <class T, class A>
+    inline batch<T, A> chebval(batch<T, A> const& x, T const* coeffs, std::size_t n) noexcept
+    {
+        using batch_type = batch<T, A>;
+        if (n == 0)
+            return batch_type(T(0));
+        // b_k = c_k + 2 x b_{k+1} - b_{k+2}, then c_0 + x b_1 - b_2
+        batch_type const x2 = x + x;
+        batch_type b1(T(0)), b2(T(0));
+        for (std::size_t k = n - 1; k > 0; --k)
+        {
+            batch_type const b = fma(x2, b1, batch_type(coeffs[k]) - b2);
+            b2 = b1;
+            b1 = b;
+        }
+        return fma(x, b1, batch_type(coeffs[0]) - b2);
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the polynomial of the \c n coefficients at \c coeffs at the
+     * \c count arguments of \c x into \c out, as the batch \c polyval.
+     *
+     * @param coeffs the coefficients, from the constant term up.
+     * @param n the number of coefficients.
+     * @param x the arguments.
+     * @param count the number of arguments.
+     * @param out the values, either equal to \c x or not overlapping it.
+     */
+    template <class A = default_arch, class T>
+    inline void polyval(T const* coeffs, std::size_t n, T const* x, std::size_t count, T* out)
+    {
+        if (n > polyval_estrin_degree)
+            for_each_batch<A>(x, out, count, [=](batch<T, A> const& b)
+                              { return polyval_estrin(b, coeffs, n); });
+        else
+            for_each_batch<A>(x, out, count, [=](batch<T, A> const& b)
+                              { return polyval_horner(b, coeffs, n); });
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the rational function \c p(x)/q(x) at the \c count
+     * arguments of \c x into \c out, as the batch \c ratval.
+     *
+     * @param p the coefficients of the numerator, from the constant term up.
+     * @param np the number of coefficients of the numerator.
+     * @param q the coefficients of the denominator, from the constant term up.
+     * @param nq the number of coefficients of the denominator.
+     * @param x the arguments.
+     * @param count the number of arguments.
+     * @param out the values, either equal to \c x or not overlapping it.
+     */
+    template <class A = default_arch, class T>
+    inline void ratval(T const* p, std::size_t np, T const* q, std::size_t nq, T const* x, std::size_t count, T* out)
+    {
+        for_each_batch<A>(x, out, count, [=](batch<T, A> const& b)
+                          { return ratval(b, p, np, q, nq); });
+    }
+
+    /**
+     * @ingroup algorithms_polynomial
+     *
+     * Evaluates the Chebyshev series of the \c n coefficients at \c coeffs
+     * at the \c count arguments of \c x into \c out, as the batch \c chebval.
+     *
+     * @param coeffs the coefficients, of \c T_0 up.
+     * @param n the number of coefficients.
+     * @param x the arguments, in [-1, 1].
+     * @param count the number of arguments.
+     * @param out the values, either equal to \c x or not overlapping it.
+     */
+    template <class A = default_arch, class T>
+    inline void chebval(T const* coeffs, std::size_t n, T const* x, std::size_t count, T* out)
+    {
+        for_each_batch<A>(x, out, count, [=](batch<T, A> const& b)
+                          { return chebval(b, coeffs, n); });
+    }
+}
+
+#endif
+
+#endif
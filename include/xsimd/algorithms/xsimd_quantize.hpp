@@ -0,0 +1,485 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_QUANTIZE_HPP
+#define XSIMD_ALGORITHMS_QUANTIZE_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_quantize Quantization
+     */
+
+    namespace detail
+    {
+        template <class T>
+        constexpr bool is_quantized_v = std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>;
+
+        // keeps a zero point from taking part in the deduction of T, so that
+        // it may be given as a plain integer
+        template <class T>
+        struct type_identity
+        {
+            using type = T;
+        };
+
+        template <class T>
+        using type_identity_t = typename type_identity<T>::type;
+
+        // range of a Bits wide integer of the signedness of T
+        template <class T, int Bits>
+        struct quantize_limits
+        {
+            static constexpr int min = std::is_signed_v<T> ? -(1 << (Bits - 1)) : 0;
+            static constexpr int max = std::is_signed_v<T> ? (1 << (Bits - 1)) - 1 : (1 << Bits) - 1;
+        };
+
+        /*
+         * q = clamp(nearbyint(x * (1 / scale)) + zero_point, min, max). The
+         * clamp is applied before rounding, to bounds shifted by the zero
+         * point, so that the rounding sees x * (1 / scale) alone and converted
+         * values never overflow.
+         */
+        struct quantize_params
+        {
+            float inv_scale;
+            float lo;
+            float hi;
+            int32_t zero_point;
+        };
+
+        template <class T, int Bits>
+        inline quantize_params make_quantize_params(float scale, T zero_point) noexcept
+        {
+            using limits = quantize_limits<T, Bits>;
+            assert(scale > 0.f && "scale must be positive");
+            assert(zero_point >= limits::min && zero_point <= limits::max && "zero point out of range");
+            return { 1.f / scale, float(limits::min - zero_point), float(limits::max - zero_point), int32_t(zero_point) };
+        }
+
+        inline int32_t quantize_scalar(float x, quantize_params const& p) noexcept
+        {
+            // same operand order as the vector min and max, NaN maps to lo
+            float v = x * p.inv_scale;
+            v = v > p.lo ? v : p.lo;
+            v = v < p.hi ? v : p.hi;
+            return int32_t(std::nearbyint(v)) + p.zero_point;
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<int32_t, A> quantize_batch(batch<float, A> const& x, quantize_params const& p) noexcept
+        {
+            return nearbyint_as_int(clip(x * batch<float, A>(p.inv_scale), batch<float, A>(p.lo), batch<float, A>(p.hi)))
+                + batch<int32_t, A>(p.zero_point);
+        }
+
+        // the 4 * batch<float, A>::size values at src, as 8-bit integers
+        template <class T, class A>
+        XSIMD_INLINE batch<T, A> quantize_block(float const* src, quantize_params const& p) noexcept
+        {
+            constexpr std::size_t size = batch<float, A>::size;
+            auto const q0 = quantize_batch(batch<float, A>::load_unaligned(src), p);
+            auto const q1 = quantize_batch(batch<float, A>::load_unaligned(src + size), p);
+            auto const q2 = quantize_batch(batch<float, A>::load_unaligned(src + 2 * size), p);
+            auto const q3 = quantize_batch(batch<float, A>::load_unaligned(src + 3 * size), p);
+            // the values are in range, so that truncating is exact
+            return bitwise_cast<T>(narrow(narrow(q0, q1), narrow(q2, q3)));
+        }
+
+        // (q - zero_point) * scale for the lanes of q, stored to dst
+        template <class T, class A>
+        XSIMD_INLINE void dequantize_block(batch<T, A> const& q, float* dst, float scale, int32_t zero_point) noexcept
+        {
+            constexpr std::size_t size = batch<float, A>::size;
+            batch<int32_t, A> const zp(zero_point);
+            batch<float, A> const s(scale);
+            auto const q16 = widen(q);
+            std::size_t k = 0;
+            for (auto const& h : q16)
+                for (auto const& w : widen(h))
+                {
+                    (to_float(bitwise_cast<int32_t>(w) - zp) * s).store_unaligned(dst + k);
+                    k += size;
+                }
+        }
+
+        template <class T, class A>
+        inline void quantize_row(float const* src, T* dst, std::size_t n, quantize_params const& p) noexcept
+        {
+            constexpr std::size_t step = batch<T, A>::size;
+            std::size_t const vec_size = n - n % step;
+            for (std::size_t i = 0; i < vec_size; i += step)
+                quantize_block<T, A>(src + i, p).store_unaligned(dst + i);
+            for (std::size_t i = vec_size; i < n; ++i)
+                dst[i] = static_cast<T>(quantize_scalar(src[i], p));
+        }
+
+        template <class T, class A>
+        inline void dequantize_row(T const* src, float* dst, std::size_t n, float scale, int32_t zero_point) noexcept
+        {
+            constexpr std::size_t step = batch<T, A>::size;
+            std::size_t const vec_size = n - n % step;
+            for (std::size_t i = 0; i < vec_size; i += step)
+                dequantize_block(batch<T, A>::load_unaligned(src + i), dst + i, scale, zero_point);
+            for (std::size_t i = vec_size; i < n; ++i)
+                dst[i] = float(int32_t(src[i]) - zero_point) * scale;
+        }
+
+        /*
+         * Nibbles: element 2 * i goes to the low half of byte i, element
+         * 2 * i + 1 to its high half.
+         */
+        template <class A>
+        XSIMD_INLINE batch<uint8_t, A> int4_pack(batch<uint8_t, A> const& x, batch<uint8_t, A> const& y) noexcept
+        {
+            auto pairs = [](batch<uint8_t, A> const& v)
+            {
+                auto const w = bitwise_cast<uint16_t>(v);
+                return (w & batch<uint16_t, A>(0x000F)) | ((w >> 4) & batch<uint16_t, A>(0x00F0));
+            };
+            return narrow(pairs(x), pairs(y));
+        }
+
+        template <class T, class A>
+        XSIMD_INLINE void int4_unpack(batch<uint8_t, A> const& b, batch<T, A>& lo, batch<T, A>& hi) noexcept
+        {
+            batch<uint8_t, A> const mask(0x0F);
+            auto const even = b & mask;
+            auto const odd = b >> 4;
+            auto extend = [](batch<uint8_t, A> const& v)
+            {
+                if constexpr (std::is_signed_v<T>)
+                    return bitwise_cast<T>(v ^ batch<uint8_t, A>(8)) - batch<T, A>(8);
+                else
+                    return v;
+            };
+            lo = extend(zip_lo(even, odd));
+            hi = extend(zip_hi(even, odd));
+        }
+
+        inline uint8_t int4_pack_scalar(int32_t lo, int32_t hi) noexcept
+        {
+            return static_cast<uint8_t>((lo & 0x0F) | ((hi & 0x0F) << 4));
+        }
+
+        template <class T>
+        inline T int4_unpack_scalar(uint8_t nibble) noexcept
+        {
+            if constexpr (std::is_signed_v<T>)
+                return static_cast<T>((nibble ^ 8) - 8);
+            else
+                return static_cast<T>(nibble);
+        }
+
+        template <class T, class A>
+        inline void quantize_int4_row(float const* src, uint8_t* dst, std::size_t n, quantize_params const& p) noexcept
+        {
+            constexpr std::size_t step = 2 * batch<uint8_t, A>::size;
+            std::size_t const vec_size = n - n % step;
+            for (std::size_t i = 0; i < vec_size; i += step)
+            {
+                auto const q0 = quantize_block<uint8_t, A>(src + i, p);
+                auto const q1 = quantize_block<uint8_t, A>(src + i + step / 2, p);
+                int4_pack(q0, q1).store_unaligned(dst + i / 2);
+            }
+            for (std::size_t i = vec_size; i < n; i += 2)
+            {
+                int32_t const hi = i + 1 < n ? quantize_scalar(src[i + 1], p) : 0;
+                dst[i / 2] = int4_pack_scalar(quantize_scalar(src[i], p), hi);
+            }
+        }
+
+        template <class T, class A>
+        inline void dequantize_int4_row(uint8_t const* src, float* dst, std::size_t n, float scale, int32_t zero_point) noexcept
+        {
+            constexpr std::size_t step = 2 * batch<uint8_t, A>::size;
+            std::size_t const vec_size = n - n % step;
+            for (std::size_t i = 0; i < vec_size; i += step)
+            {
+                batch<T, A> lo, hi;
+                int4_unpack(batch<uint8_t, A>::load_unaligned(src + i / 2), lo, hi);
+                dequantize_block(lo, dst + i, scale, zero_point);
+                dequantize_block(hi, dst + i + step / 2, scale, zero_point);
+            }
+            for (std::size_t i = vec_size; i < n; ++i)
+            {
+                uint8_t const byte = src[i / 2];
+                T const q = int4_unpack_scalar<T>(i % 2 == 0 ? byte & 0x0F : byte >> 4);
+                dst[i] = float(int32_t(q) - zero_point) * scale;
+            }
+        }
+
+        template <class T>
+        inline T channel_zero_point(T const* zero_points, std::size_t c) noexcept
+        {
+            return zero_points ? zero_points[c] : T(0);
+        }
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Quantizes \c n floats to 8-bit integers with a single scale and zero
+     * point:
+     * \code
+     * dst[i] = clamp(nearbyint(src[i] * (1 / scale)) + zero_point, min(T), max(T))
+     * \endcode
+     * Rounding is to nearest even in the default rounding mode, and values
+     * out of range saturate. NaN gives an unspecified value.
+     *
+     * @tparam T \c int8_t or \c uint8_t.
+     * @param src the values to quantize.
+     * @param dst the \c n quantized values.
+     * @param n the number of values.
+     * @param scale the quantization step, positive.
+     * @param zero_point the quantized value of zero.
+     */
+    template <class A = default_arch, class T>
+    inline void quantize(float const* src, T* dst, std::size_t n, float scale, detail::type_identity_t<T> zero_point = 0) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "quantization targets int8_t or uint8_t");
+        detail::quantize_row<T, A>(src, dst, n, detail::make_quantize_params<T, 8>(scale, zero_point));
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Quantizes \c channels contiguous channels of \c channel_size floats,
+     * each with its own scale and zero point, as quantize().
+     *
+     * @tparam T \c int8_t or \c uint8_t.
+     * @param src the \c channels * \c channel_size values to quantize.
+     * @param dst the quantized values, with the same layout.
+     * @param channels the number of channels.
+     * @param channel_size the number of values of each channel.
+     * @param scales the \c channels scales.
+     * @param zero_points the \c channels zero points, or \c nullptr for zeros.
+     */
+    template <class A = default_arch, class T>
+    inline void quantize_per_channel(float const* src, T* dst, std::size_t channels, std::size_t channel_size,
+                                     float const* scales, T const* zero_points = nullptr) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "quantization targets int8_t or uint8_t");
+        for (std::size_t c = 0; c < channels; ++c)
+            detail::quantize_row<T, A>(src + c * channel_size, dst + c * channel_size, channel_size,
+                                       detail::make_quantize_params<T, 8>(scales[c], detail::channel_zero_point(zero_points, c)));
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Dequantizes \c n 8-bit integers: <tt>dst[i] = (src[i] - zero_point) * scale</tt>.
+     * The difference is exact, so that the result is the correctly rounded product.
+     *
+     * @tparam T \c int8_t or \c uint8_t.
+     * @param src the quantized values.
+     * @param dst the \c n dequantized values.
+     * @param n the number of values.
+     * @param scale the quantization step.
+     * @param zero_point the quantized value of zero.
+     */
+    template <class A = default_arch, class T>
+    inline void dequantize(T const* src, float* dst, std::size_t n, float scale, detail::type_identity_t<T> zero_point = 0) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "quantization targets int8_t or uint8_t");
+        detail::dequantize_row<T, A>(src, dst, n, scale, zero_point);
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Dequantizes \c channels contiguous channels of \c channel_size 8-bit
+     * integers, each with its own scale and zero point, as dequantize().
+     *
+     * @tparam T \c int8_t or \c uint8_t.
+     * @param src the \c channels * \c channel_size quantized values.
+     * @param dst the dequantized values, with the same layout.
+     * @param channels the number of channels.
+     * @param channel_size the number of values of each channel.
+     * @param scales the \c channels scales.
+     * @param zero_points the \c channels zero points, or \c nullptr for zeros.
+     */
+    template <class A = default_arch, class T>
+    inline void dequantize_per_channel(T const* src, float* dst, std::size_t channels, std::size_t channel_size,
+                                       float const* scales, T const* zero_points = nullptr) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "quantization targets int8_t or uint8_t");
+        for (std::size_t c = 0; c < channels; ++c)
+            detail::dequantize_row<T, A>(src + c * channel_size, dst + c * channel_size, channel_size,
+                                         scales[c], detail::channel_zero_point(zero_points, c));
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Packs \c n 4-bit integers, held in the low nibbles of \c src, two per
+     * byte: element <tt>2 * i</tt> in the low nibble of <tt>dst[i]</tt> and
+     * element <tt>2 * i + 1</tt> in its high nibble. For odd \c n, the high
+     * nibble of the last byte is zero.
+     *
+     * @tparam T \c int8_t for values in [-8, 7], \c uint8_t for values in [0, 15].
+     * @param src the \c n values.
+     * @param dst the <tt>(n + 1) / 2</tt> packed bytes.
+     * @param n the number of values.
+     */
+    template <class A = default_arch, class T>
+    inline void pack_int4(T const* src, uint8_t* dst, std::size_t n) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        constexpr std::size_t step = 2 * batch<uint8_t, A>::size;
+        std::size_t const vec_size = n - n % step;
+        for (std::size_t i = 0; i < vec_size; i += step)
+        {
+            auto const x = batch<uint8_t, A>::load_unaligned(reinterpret_cast<uint8_t const*>(src + i));
+            auto const y = batch<uint8_t, A>::load_unaligned(reinterpret_cast<uint8_t const*>(src + i + step / 2));
+            detail::int4_pack(x, y).store_unaligned(dst + i / 2);
+        }
+        for (std::size_t i = vec_size; i < n; i += 2)
+            dst[i / 2] = detail::int4_pack_scalar(src[i], i + 1 < n ? src[i + 1] : 0);
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Unpacks \c n 4-bit integers packed by pack_int4(), sign extended for
+     * \c int8_t and zero extended for \c uint8_t.
+     *
+     * @param src the <tt>(n + 1) / 2</tt> packed bytes.
+     * @param dst the \c n values.
+     * @param n the number of values.
+     */
+    template <class A = default_arch, class T>
+    inline void unpack_int4(uint8_t const* src, T* dst, std::size_t n) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        constexpr std::size_t step = 2 * batch<uint8_t, A>::size;
+        std::size_t const vec_size = n - n % step;
+        for (std::size_t i = 0; i < vec_size; i += step)
+        {
+            batch<T, A> lo, hi;
+            detail::int4_unpack(batch<uint8_t, A>::load_unaligned(src + i / 2), lo, hi);
+            lo.store_unaligned(dst + i);
+            hi.store_unaligned(dst + i + step / 2);
+        }
+        for (std::size_t i = vec_size; i < n; ++i)
+            dst[i] = detail::int4_unpack_scalar<T>(i % 2 == 0 ? src[i / 2] & 0x0F : src[i / 2] >> 4);
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Quantizes \c n floats to 4-bit integers, as quantize() but saturating
+     * to [-8, 7] for \c int8_t and to [0, 15] for \c uint8_t, and packs them
+     * as pack_int4().
+     *
+     * @tparam T \c int8_t or \c uint8_t, the signedness of the 4-bit values,
+     * not deduced from \c zero_point: <tt>quantize_int4<A, uint8_t></tt>
+     * quantizes to [0, 15].
+     * @param src the values to quantize.
+     * @param dst the <tt>(n + 1) / 2</tt> packed bytes.
+     * @param n the number of values.
+     * @param scale the quantization step, positive.
+     * @param zero_point the quantized value of zero, in the 4-bit range.
+     */
+    template <class A = default_arch, class T = int8_t>
+    inline void quantize_int4(float const* src, uint8_t* dst, std::size_t n, float scale, detail::type_identity_t<T> zero_point = 0) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        detail::quantize_int4_row<T, A>(src, dst, n, detail::make_quantize_params<T, 4>(scale, zero_point));
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Quantizes \c channels contiguous channels of \c channel_size floats to
+     * packed 4-bit integers, each with its own scale and zero point. Each
+     * channel starts on a byte boundary, that is every
+     * <tt>(channel_size + 1) / 2</tt> bytes of \c dst.
+     *
+     * @tparam T \c int8_t or \c uint8_t, the signedness of the 4-bit values.
+     * @param src the \c channels * \c channel_size values to quantize.
+     * @param dst the packed channels.
+     * @param channels the number of channels.
+     * @param channel_size the number of values of each channel.
+     * @param scales the \c channels scales.
+     * @param zero_points the \c channels zero points, or \c nullptr for zeros.
+     */
+    template <class A = default_arch, class T = int8_t>
+    inline void quantize_int4_per_channel(float const* src, uint8_t* dst, std::size_t channels, std::size_t channel_size,
+                                          float const* scales, T const* zero_points = nullptr) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        std::size_t const channel_bytes = (channel_size + 1) / 2;
+        for (std::size_t c = 0; c < channels; ++c)
+            detail::quantize_int4_row<T, A>(src + c * channel_size, dst + c * channel_bytes, channel_size,
+                                            detail::make_quantize_params<T, 4>(scales[c], detail::channel_zero_point(zero_points, c)));
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Dequantizes \c n packed 4-bit integers: <tt>dst[i] = (q[i] - zero_point) * scale</tt>.
+     *
+     * @tparam T \c int8_t or \c uint8_t, the signedness of the 4-bit values,
+     * not deduced from \c zero_point.
+     * @param src the <tt>(n + 1) / 2</tt> packed bytes.
+     * @param dst the \c n dequantized values.
+     * @param n the number of values.
+     * @param scale the quantization step.
+     * @param zero_point the quantized value of zero.
+     */
+    template <class A = default_arch, class T = int8_t>
+    inline void dequantize_int4(uint8_t const* src, float* dst, std::size_t n, float scale, detail::type_identity_t<T> zero_point = 0) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        detail::dequantize_int4_row<T, A>(src, dst, n, scale, zero_point);
+    }
+
+    /**
+     * @ingroup algorithms_quantize
+     *
+     * Dequantizes \c channels channels of \c channel_size packed 4-bit
+     * integers, laid out as by quantize_int4_per_channel(), each with its
+     * own scale and zero point.
+     *
+     * @tparam T \c int8_t or \c uint8_t, the signedness of the 4-bit values.
+     * @param src the packed channels.
+     * @param dst the \c channels * \c channel_size dequantized values.
+     * @param channels the number of channels.
+     * @param channel_size the number of values of each channel.
+     * @param scales the \c channels scales.
+     * @param zero_points the \c channels zero points, or \c nullptr for zeros.
+     */
+    template <class A = default_arch, class T = int8_t>
+    inline void dequantize_int4_per_channel(uint8_t const* src, float* dst, std::size_t channels, std::size_t channel_size,
+                                            float const* scales, T const* zero_points = nullptr) noexcept
+    {
+        static_assert(detail::is_quantized_v<T>, "int4 values are held in int8_t or uint8_t");
+        std::size_t const channel_bytes = (channel_size + 1) / 2;
+        for (std::size_t c = 0; c < channels; ++c)
+            detail::dequantize_int4_row<T, A>(src + c * channel_bytes, dst + c * channel_size, channel_size,
+                                              scales[c], detail::channel_zero_point(zero_points, c));
+    }
+}
+
+#endif
+
+#endif
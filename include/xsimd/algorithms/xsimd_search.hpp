@@ -0,0 +1,417 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_SEARCH_HPP
+#define XSIMD_ALGORITHMS_SEARCH_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_search Search
+     *
+     * Positions of many keys in a sorted array, searched a batch of keys at
+     * a time, and a B-tree layout of a sorted array whose nodes are searched
+     * a batch of elements at a time.
+     */
+
+    namespace detail
+    {
+        /*
+         * Position of each lane among sorted elements: the number of elements
+         * less than it, as std::lower_bound, or not greater than it, as
+         * std::upper_bound. A NaN is less than no element, so its lower bound
+         * is the first position and its upper bound the last one.
+         *
+         * A handful of elements are compared one after the other. Up to a
+         * batch of them are held in a register and looked up with swizzle,
+         * more are gathered from memory; either way each lane binary-searches
+         * its own value without branching.
+         */
+        template <class A, class T, bool Upper>
+        class sorted_search
+        {
+        public:
+            using batch_type = batch<T, A>;
+            using index_type = as_integer_t<T>;
+            using index_batch = batch<index_type, A>;
+
+            static constexpr std::size_t linear_max = 4;
+
+            sorted_search(T const* sorted, std::size_t count) noexcept
+                : m_sorted(sorted)
+                , m_count(count)
+                , m_top(1)
+            {
+                assert(std::is_sorted(sorted, sorted + count) && "elements must be sorted");
+                assert(count < (std::size_t(1) << (8 * sizeof(index_type) - 1)) && "too many elements for the lane indices");
+                while (2 * m_top <= count)
+                    m_top *= 2;
+                if (count > linear_max && count <= batch_type::size)
+                {
+                    alignas(A::alignment()) T table[batch_type::size];
+                    std::copy(sorted, sorted + count, table);
+                    std::fill(table + count, table + batch_type::size, sorted[count - 1]);
+                    m_table = batch_type::load_aligned(table);
+                }
+            }
+
+            // N batches searched in lockstep, so that the lookups of each
+            // step overlap instead of waiting on one another
+            template <std::size_t N>
+            void operator()(batch_type const (&x)[N], index_batch (&pos)[N]) const noexcept
+            {
+                if (m_count <= linear_max)
+                {
+                    for (std::size_t k = 0; k < N; ++k)
+                        pos[k] = linear(x[k]);
+                }
+                else if (m_count <= batch_type::size)
+                    search(x, pos, [this](index_batch const& i) noexcept
+                           { return swizzle(m_table, bitwise_cast<as_unsigned_integer_t<T>>(i)); });
+                else
+                    search(x, pos, [this](index_batch const& i) noexcept
+                           { return batch_type::gather(m_sorted, i); });
+            }
+
+            std::size_t operator()(T x) const noexcept
+            {
+                T const* const end = m_sorted + m_count;
+                return static_cast<std::size_t>((Upper ? std::upper_bound(m_sorted, end, x) : std::lower_bound(m_sorted, end, x)) - m_sorted);
+            }
+
+        private:
+            // whether a lane with value x is past element e
+            static batch_bool<index_type, A> past(batch_type const& x, batch_type const& e) noexcept
+            {
+                if constexpr (Upper)
+                    return batch_bool_cast<index_type>(!(x < e));
+                else
+                    return batch_bool_cast<index_type>(e < x);
+            }
+
+            index_batch linear(batch_type const& x) const noexcept
+            {
+                index_batch pos(index_type(0));
+                for (std::size_t j = 0; j < m_count; ++j)
+                    pos += select(past(x, batch_type(m_sorted[j])), index_batch(index_type(1)), index_batch(index_type(0)));
+                return pos;
+            }
+
+            // Steps by decreasing powers of two: a lane moves to the next
+            // position if it is past the element before it. The position is
+            // clamped to the count, which a lane reaching past the last
+            // element is bound to end on anyway.
+            template <std::size_t N, class Lookup>
+            void search(batch_type const (&x)[N], index_batch (&pos)[N], Lookup const& lookup) const noexcept
+            {
+                index_batch const count(static_cast<index_type>(m_count));
+                index_batch const one(index_type(1));
+                for (std::size_t k = 0; k < N; ++k)
+                    pos[k] = index_batch(index_type(0));
+                for (std::size_t step = m_top; step != 0; step /= 2)
+                {
+                    index_batch const stride(static_cast<index_type>(step));
+                    for (std::size_t k = 0; k < N; ++k)
+                    {
+                        index_batch const next = min(pos[k] + stride, count);
+                        pos[k] = select(past(x[k], lookup(next - one)), next, pos[k]);
+                    }
+                }
+            }
+
+            T const* m_sorted;
+            std::size_t m_count;
+            std::size_t m_top;
+            batch_type m_table;
+        };
+
+        // positions of the keys from i on, N batches at a time, up to the
+        // last whole group; returns where it stopped
+        template <std::size_t N, class A, class T, bool Upper>
+        inline std::size_t search_groups(sorted_search<A, T, Upper> const& search, T const* keys, std::size_t i, std::size_t n, uint32_t* positions) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            for (; i + N * size <= n; i += N * size)
+            {
+                batch_type x[N];
+                typename sorted_search<A, T, Upper>::index_batch pos[N];
+                for (std::size_t k = 0; k < N; ++k)
+                    x[k] = batch_type::load_unaligned(keys + i + k * size);
+                search(x, pos);
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    if constexpr (sizeof(T) == 4)
+                        bitwise_cast<uint32_t>(pos[k]).store_unaligned(positions + i + k * size);
+                    else if (k % 2 == 1)
+                        bitwise_cast<uint32_t>(narrow(pos[k - 1], pos[k])).store_unaligned(positions + i + (k - 1) * size);
+                }
+            }
+            return i;
+        }
+
+        template <class A, bool Upper, class T>
+        inline void sorted_bounds(T const* sorted, std::size_t n, T const* keys, std::size_t count, uint32_t* positions) noexcept
+        {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8, "sorted searches are only defined for 32 and 64-bit elements");
+            sorted_search<A, T, Upper> const search(sorted, n);
+            std::size_t i = search_groups<4>(search, keys, 0, count, positions);
+            i = search_groups<sizeof(T) == 4 ? 1 : 2>(search, keys, i, count, positions);
+            for (; i < count; ++i)
+                positions[i] = static_cast<uint32_t>(search(keys[i]));
+        }
+    }
+
+    /**
+     * @ingroup algorithms_search
+     *
+     * Position of each key in a sorted array, as \c std::lower_bound: the
+     * number of elements less than the key.
+     *
+     * Keys are searched a batch at a time, each lane running its own binary
+     * search without branches, and four batches in lockstep so that their
+     * memory accesses overlap. Elements are looked up with \c swizzle when
+     * they fit in a register and with \c gather otherwise.
+     *
+     * @param sorted the elements, sorted in increasing order.
+     * @param n the number of elements, less than 2^31.
+     * @param keys the keys to search.
+     * @param count the number of keys.
+     * @param positions the position of each key, between 0 and \c n.
+     */
+    template <class A = default_arch, class T>
+    inline void lower_bounds(T const* sorted, std::size_t n, T const* keys, std::size_t count, uint32_t* positions) noexcept
+    {
+        detail::sorted_bounds<A, false>(sorted, n, keys, count, positions);
+    }
+
+    /**
+     * @ingroup algorithms_search
+     *
+     * Position of each key in a sorted array, as \c std::upper_bound: the
+     * number of elements not greater than the key. See lower_bounds().
+     *
+     * @param sorted the elements, sorted in increasing order.
+     * @param n the number of elements, less than 2^31.
+     * @param keys the keys to search.
+     * @param count the number of keys.
+     * @param positions the position of each key, between 0 and \c n.
+     */
+    template <class A = default_arch, class T>
+    inline void upper_bounds(T const* sorted, std::size_t n, T const* keys, std::size_t count, uint32_t* positions) noexcept
+    {
+        detail::sorted_bounds<A, true>(sorted, n, keys, count, positions);
+    }
+
+    /**
+     * @ingroup algorithms_search
+     *
+     * Sorted array laid out as an implicit B-tree for repeated searches.
+     *
+     * Each node holds a cache line of elements, and the children of node
+     * \c k are nodes <tt>k * (B + 1) + 1</tt> to <tt>k * (B + 1) + B +
+     * 1</tt>, as in an Eytzinger layout with \c B elements per node. A
+     * search reads one node per level: the elements of the node are compared
+     * to the key a batch at a time, and \c countr_zero of the comparison
+     * mask gives the child to descend into. A lookup thus touches
+     * <tt>log(n) / log(B + 1)</tt> cache lines in an order known in advance,
+     * where a binary search over the sorted array touches about \c log2(n)
+     * of them.
+     *
+     * @tparam T a 32 or 64-bit arithmetic type.
+     * @tparam A architecture used for the kernels.
+     */
+    template <class T, class A = default_arch>
+    class btree_index
+    {
+    public:
+        using value_type = T;
+        using arch_type = A;
+
+        btree_index(T const* sorted, std::size_t n);
+
+        std::size_t size() const noexcept;
+
+        std::size_t lower_bound(T key) const noexcept;
+        std::size_t find(T key) const noexcept;
+        void lower_bounds(T const* keys, std::size_t count, uint32_t* positions) const noexcept;
+
+    private:
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "btree_index is only defined for 32 and 64-bit elements");
+
+        using batch_type = batch<T, A>;
+        static constexpr std::size_t node_batches = 64 / sizeof(T) > batch_type::size ? 64 / sizeof(T) / batch_type::size : 1;
+        static constexpr std::size_t node_size = node_batches * batch_type::size;
+
+        static constexpr std::size_t child(std::size_t node, std::size_t i) noexcept;
+
+        void fill(T const* sorted, std::size_t node, std::size_t& next);
+        std::size_t rank(std::size_t node, T key) const noexcept;
+        std::size_t lower_slot(T key) const noexcept;
+
+        std::size_t m_size;
+        std::size_t m_nodes;
+        std::vector<T, aligned_allocator<T, 64>> m_keys;
+        std::vector<uint32_t> m_positions;
+    };
+
+    /**
+     * Lays out the \c n elements of \c sorted, sorted in increasing order
+     * and fewer than 2^32.
+     */
+    template <class T, class A>
+    inline btree_index<T, A>::btree_index(T const* sorted, std::size_t n)
+        : m_size(n)
+        , m_nodes((n + node_size - 1) / node_size)
+        , m_keys(m_nodes * node_size)
+        , m_positions(m_nodes * node_size)
+    {
+        assert(std::is_sorted(sorted, sorted + n) && "elements must be sorted");
+        std::size_t next = 0;
+        fill(sorted, 0, next);
+    }
+
+    /**
+     * Returns the number of elements.
+     */
+    template <class T, class A>
+    inline std::size_t btree_index<T, A>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Position of \c key in the sorted elements, as \c std::lower_bound: the
+     * number of elements less than \c key.
+     */
+    template <class T, class A>
+    inline std::size_t btree_index<T, A>::lower_bound(T key) const noexcept
+    {
+        std::size_t const slot = lower_slot(key);
+        return slot == m_keys.size() ? m_size : m_positions[slot];
+    }
+
+    /**
+     * Position of the first element equal to \c key, or size() if there is
+     * none.
+     */
+    template <class T, class A>
+    inline std::size_t btree_index<T, A>::find(T key) const noexcept
+    {
+        std::size_t const slot = lower_slot(key);
+        return slot == m_keys.size() || !(m_keys[slot] == key) ? m_size : m_positions[slot];
+    }
+
+    /**
+     * Positions of \c count keys, as lower_bound(). Groups of keys descend
+     * the tree in lockstep, a level at a time, so that their cache misses
+     * overlap.
+     */
+    template <class T, class A>
+    inline void btree_index<T, A>::lower_bounds(T const* keys, std::size_t count, uint32_t* positions) const noexcept
+    {
+        constexpr std::size_t group = 8;
+        std::size_t i = 0;
+        for (; i + group <= count; i += group)
+        {
+            std::size_t node[group], slot[group];
+            std::fill(node, node + group, std::size_t(0));
+            std::fill(slot, slot + group, m_keys.size());
+            for (bool descending = m_nodes > 0; descending;)
+            {
+                descending = false;
+                for (std::size_t k = 0; k < group; ++k)
+                {
+                    if (node[k] < m_nodes)
+                    {
+                        std::size_t const r = rank(node[k], keys[i + k]);
+                        slot[k] = r < node_size ? node[k] * node_size + r : slot[k];
+                        node[k] = child(node[k], r);
+                        descending |= node[k] < m_nodes;
+                    }
+                }
+            }
+            for (std::size_t k = 0; k < group; ++k)
+                positions[i + k] = static_cast<uint32_t>(slot[k] == m_keys.size() ? m_size : m_positions[slot[k]]);
+        }
+        for (; i < count; ++i)
+            positions[i] = static_cast<uint32_t>(lower_bound(keys[i]));
+    }
+
+    template <class T, class A>
+    constexpr std::size_t btree_index<T, A>::child(std::size_t node, std::size_t i) noexcept
+    {
+        return node * (node_size + 1) + i + 1;
+    }
+
+    // In-order traversal, handing out the elements in increasing order; the
+    // slots left over at the end are padded with the largest value, past
+    // every element.
+    template <class T, class A>
+    inline void btree_index<T, A>::fill(T const* sorted, std::size_t node, std::size_t& next)
+    {
+        if (node >= m_nodes)
+            return;
+        T const pad = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        for (std::size_t i = 0; i < node_size; ++i)
+        {
+            fill(sorted, child(node, i), next);
+            std::size_t const slot = node * node_size + i;
+            m_keys[slot] = next < m_size ? sorted[next] : pad;
+            m_positions[slot] = static_cast<uint32_t>(next);
+            next += next < m_size;
+        }
+        fill(sorted, child(node, node_size), next);
+    }
+
+    // number of elements of the node less than key
+    template <class T, class A>
+    inline std::size_t btree_index<T, A>::rank(std::size_t node, T key) const noexcept
+    {
+        T const* const keys = m_keys.data() + node * node_size;
+        batch_type const k(key);
+        uint64_t less = 0;
+        for (std::size_t b = 0; b < node_batches; ++b)
+            less |= (batch_type::load_aligned(keys + b * batch_type::size) < k).mask() << (b * batch_type::size);
+        return static_cast<std::size_t>(detail::countr_zero(~less));
+    }
+
+    // slot of the first element not less than key, the number of slots if
+    // there is none
+    template <class T, class A>
+    inline std::size_t btree_index<T, A>::lower_slot(T key) const noexcept
+    {
+        std::size_t slot = m_keys.size();
+        for (std::size_t node = 0; node < m_nodes;)
+        {
+            std::size_t const i = rank(node, key);
+            slot = i < node_size ? node * node_size + i : slot;
+            node = child(node, i);
+        }
+        return slot;
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,373 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_SELECTION_HPP
+#define XSIMD_ALGORITHMS_SELECTION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_selection Selection
+     *
+     * Index of the smallest or largest element of an array, and selection of
+     * its \c k largest elements. Ties are broken by index, the first
+     * occurrence winning.
+     */
+
+    /**
+     * @ingroup algorithms_selection
+     *
+     * How selections treat floating point NaNs.
+     */
+    enum class nan_policy
+    {
+        /** A NaN ranks before any number, so that the first NaN is both the
+         * minimum and the maximum, as for numpy's argmin and argmax. */
+        propagate,
+        /** NaNs are ignored, as for numpy's nanargmin and nanargmax. */
+        omit
+    };
+
+    namespace detail
+    {
+        template <bool Largest>
+        struct selection_order
+        {
+            template <class T>
+            static auto better(T const& a, T const& b) noexcept -> decltype(a > b)
+            {
+                if constexpr (Largest)
+                    return a > b;
+                else
+                    return a < b;
+            }
+
+            // the value no element is better than
+            template <class T>
+            static constexpr T worst() noexcept
+            {
+                if constexpr (std::numeric_limits<T>::has_infinity)
+                    return Largest ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+                else
+                    return Largest ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+            }
+        };
+
+        template <class T>
+        inline bool selection_is_nan(T x) noexcept
+        {
+            if constexpr (std::is_floating_point<T>::value)
+                return x != x;
+            else
+                return false;
+        }
+
+        /*
+         * Each lane keeps its best value and the batch it was found in. Batch
+         * numbers are stored in lanes of the element width, so that arrays of
+         * 8 and 16-bit elements are processed in chunks of as many batches as
+         * these lanes can count, each chunk being reduced on its own.
+         */
+        template <class A, bool Largest, class T>
+        inline std::size_t arg_extremum(T const* values, std::size_t n, nan_policy policy) noexcept
+        {
+            using order = selection_order<Largest>;
+            using batch_type = batch<T, A>;
+            using counter_type = as_unsigned_integer_t<T>;
+            using counter_batch = batch<counter_type, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr bool check_nan = std::is_floating_point<T>::value;
+            constexpr std::size_t max_chunk = std::size_t(std::numeric_limits<counter_type>::max()) < std::numeric_limits<std::size_t>::max() / size
+                ? std::size_t(std::numeric_limits<counter_type>::max())
+                : std::numeric_limits<std::size_t>::max() / size;
+            bool const propagate = check_nan && policy == nan_policy::propagate;
+            T const worst = order::template worst<T>();
+
+            T best = worst;
+            std::size_t best_index = n;
+            std::size_t const vec_size = n - n % size;
+            for (std::size_t start = 0; start < vec_size;)
+            {
+                std::size_t const batches = std::min((vec_size - start) / size, max_chunk);
+                batch_type lane_best(worst);
+                counter_batch lane_counter(0);
+                counter_batch counter(0);
+                for (std::size_t b = 0; b < batches; ++b, counter += counter_batch(1))
+                {
+                    batch_type const x = batch_type::load_unaligned(values + start + b * size);
+                    if constexpr (check_nan)
+                    {
+                        // no NaN before this batch: the first one wins
+                        if (propagate && any(x != x))
+                            return start + b * size + static_cast<std::size_t>(countr_zero((x != x).mask()));
+                    }
+                    auto const better = order::better(x, lane_best);
+                    lane_best = select(better, x, lane_best);
+                    lane_counter = select(batch_bool_cast<counter_type>(better), counter, lane_counter);
+                }
+
+                alignas(A::alignment()) T lane_values[size];
+                alignas(A::alignment()) counter_type lane_batches[size];
+                lane_best.store_aligned(lane_values);
+                lane_counter.store_aligned(lane_batches);
+                T chunk_best = worst;
+                std::size_t chunk_index = n;
+                for (std::size_t l = 0; l < size; ++l)
+                {
+                    std::size_t const index = start + static_cast<std::size_t>(lane_batches[l]) * size + l;
+                    if (order::better(lane_values[l], chunk_best) || (lane_values[l] == chunk_best && index < chunk_index))
+                    {
+                        chunk_best = lane_values[l];
+                        chunk_index = index;
+                    }
+                }
+                if (order::better(chunk_best, best))
+                {
+                    best = chunk_best;
+                    best_index = chunk_index;
+                }
+                start += batches * size;
+            }
+
+            for (std::size_t i = vec_size; i < n; ++i)
+            {
+                if (propagate && selection_is_nan(values[i]))
+                    return i;
+                if (order::better(values[i], best))
+                {
+                    best = values[i];
+                    best_index = i;
+                }
+            }
+
+            // every number equals worst, or there is none: lanes never
+            // updated do not know where they saw it
+            if (best_index == n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    if (values[i] == worst)
+                        return i;
+            }
+            return best_index;
+        }
+
+        /*
+         * Candidates better than the k-th best found so far are appended to a
+         * buffer, compressed a batch at a time, and the buffer is cut back to
+         * the k best whenever it fills up, which tightens the threshold.
+         */
+        template <class A, bool Largest, class T>
+        inline std::size_t select_k(T const* values, std::size_t n, std::size_t k, uint32_t* indices, nan_policy policy)
+        {
+            using order = selection_order<Largest>;
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            constexpr bool check_nan = std::is_floating_point<T>::value;
+            constexpr bool use_compress = sizeof(T) == sizeof(uint32_t);
+            bool const propagate = check_nan && policy == nan_policy::propagate;
+            assert(n <= std::numeric_limits<uint32_t>::max() && "indices fit in 32 bits");
+            if (k == 0)
+                return 0;
+
+            std::size_t const capacity = std::max<std::size_t>(2 * k, 256);
+            std::vector<T> candidate_values(capacity + size);
+            std::vector<uint32_t> candidate_indices(capacity + size);
+            std::vector<uint32_t> nan_indices;
+            std::size_t count = 0;
+            bool filling = true;
+            T threshold = order::template worst<T>();
+
+            auto const ranks_before = [&](std::size_t a, std::size_t b)
+            {
+                return order::better(candidate_values[a], candidate_values[b])
+                    || (candidate_values[a] == candidate_values[b] && candidate_indices[a] < candidate_indices[b]);
+            };
+            // keeps the k best candidates, in no particular order
+            auto const shrink = [&]()
+            {
+                if (count > k)
+                {
+                    std::vector<std::size_t> ranking(count);
+                    for (std::size_t j = 0; j < count; ++j)
+                        ranking[j] = j;
+                    std::nth_element(ranking.begin(), ranking.begin() + (k - 1), ranking.end(), ranks_before);
+                    std::vector<T> kept_values(k);
+                    std::vector<uint32_t> kept_indices(k);
+                    for (std::size_t j = 0; j < k; ++j)
+                    {
+                        kept_values[j] = candidate_values[ranking[j]];
+                        kept_indices[j] = candidate_indices[ranking[j]];
+                    }
+                    std::copy(kept_values.begin(), kept_values.end(), candidate_values.begin());
+                    std::copy(kept_indices.begin(), kept_indices.end(), candidate_indices.begin());
+                    count = k;
+                }
+                threshold = candidate_values[0];
+                for (std::size_t j = 1; j < count; ++j)
+                    if (order::better(threshold, candidate_values[j]))
+                        threshold = candidate_values[j];
+                filling = false;
+            };
+            auto const push = [&](std::size_t i)
+            {
+                candidate_values[count] = values[i];
+                candidate_indices[count] = static_cast<uint32_t>(i);
+                ++count;
+            };
+            auto const after_push = [&]()
+            {
+                if (count >= capacity || (filling && count >= k))
+                    shrink();
+            };
+
+            std::size_t const vec_size = n - n % size;
+            std::size_t i = 0;
+            for (; i < vec_size && nan_indices.size() < k; i += size)
+            {
+                batch_type const x = batch_type::load_unaligned(values + i);
+                if constexpr (check_nan)
+                {
+                    if (propagate && any(x != x))
+                    {
+                        for (uint64_t bits = (x != x).mask(); bits != 0; bits &= bits - 1)
+                            nan_indices.push_back(static_cast<uint32_t>(i + countr_zero(bits)));
+                    }
+                }
+                auto const selected = filling ? (x == x) : order::better(x, batch_type(threshold));
+                uint64_t const bits = selected.mask();
+                if (bits == 0)
+                    continue;
+                if constexpr (use_compress)
+                {
+                    using index_batch = batch<uint32_t, A>;
+                    auto const index_mask = batch_bool_cast<uint32_t>(selected);
+                    index_batch const lanes = detail::make_sequence_as_batch<index_batch>() + index_batch(static_cast<uint32_t>(i));
+                    compress(x, selected).store_unaligned(candidate_values.data() + count);
+                    compress(lanes, index_mask).store_unaligned(candidate_indices.data() + count);
+                    count += static_cast<std::size_t>(popcount(bits));
+                }
+                else
+                {
+                    for (uint64_t b = bits; b != 0; b &= b - 1)
+                        push(i + static_cast<std::size_t>(countr_zero(b)));
+                }
+                after_push();
+            }
+            for (; i < n && nan_indices.size() < k; ++i)
+            {
+                if (selection_is_nan(values[i]))
+                {
+                    if (propagate)
+                        nan_indices.push_back(static_cast<uint32_t>(i));
+                    continue;
+                }
+                if (filling || order::better(values[i], threshold))
+                {
+                    push(i);
+                    after_push();
+                }
+            }
+
+            // NaNs first, then the best numbers
+            std::size_t const nans = std::min(nan_indices.size(), k);
+            std::copy(nan_indices.begin(), nan_indices.begin() + nans, indices);
+            std::size_t const numbers = std::min(count, k - nans);
+            std::vector<std::size_t> ranking(count);
+            for (std::size_t j = 0; j < count; ++j)
+                ranking[j] = j;
+            std::partial_sort(ranking.begin(), ranking.begin() + numbers, ranking.end(), ranks_before);
+            for (std::size_t j = 0; j < numbers; ++j)
+                indices[nans + j] = candidate_indices[ranking[j]];
+            return nans + numbers;
+        }
+    }
+
+    /**
+     * @ingroup algorithms_selection
+     *
+     * Index of the smallest element of an array, the first one if several
+     * are equal.
+     *
+     * Each lane tracks its minimum and where it was found with \c select, so
+     * that the array is read once and reduced at the end.
+     *
+     * @param values the elements.
+     * @param n the number of elements.
+     * @param policy how NaNs are treated.
+     * @return the index of the minimum, or \c n if the array is empty or,
+     * when NaNs are omitted, only holds NaNs.
+     */
+    template <class A = default_arch, class T>
+    inline std::size_t argmin(T const* values, std::size_t n, nan_policy policy = nan_policy::propagate) noexcept
+    {
+        return detail::arg_extremum<A, false>(values, n, policy);
+    }
+
+    /**
+     * @ingroup algorithms_selection
+     *
+     * Index of the largest element of an array, the first one if several
+     * are equal.
+     *
+     * @param values the elements.
+     * @param n the number of elements.
+     * @param policy how NaNs are treated.
+     * @return the index of the maximum, or \c n if the array is empty or,
+     * when NaNs are omitted, only holds NaNs.
+     */
+    template <class A = default_arch, class T>
+    inline std::size_t argmax(T const* values, std::size_t n, nan_policy policy = nan_policy::propagate) noexcept
+    {
+        return detail::arg_extremum<A, true>(values, n, policy);
+    }
+
+    /**
+     * @ingroup algorithms_selection
+     *
+     * Selects the \c k largest elements of an array.
+     *
+     * Elements are compared a batch at a time against the k-th largest found
+     * so far, and those above it are appended to a candidate buffer with
+     * \c compress, 32-bit elements at least; once good candidates are
+     * found, most batches are discarded by one comparison. The buffer is
+     * sorted at the end.
+     *
+     * @param values the elements.
+     * @param n the number of elements, less than 2^32.
+     * @param k the number of elements to select.
+     * @param indices the indices of the selected elements, by decreasing
+     * value: NaNs first, by index, when they are propagated.
+     * @param policy how NaNs are treated.
+     * @return the number of indices written, <tt>min(k, n)</tt> less the
+     * omitted NaNs.
+     */
+    template <class A = default_arch, class T>
+    inline std::size_t top_k(T const* values, std::size_t n, std::size_t k, uint32_t* indices, nan_policy policy = nan_policy::propagate)
+    {
+        return detail::select_k<A, true>(values, n, k, indices, policy);
+    }
+}
+
+#endif
+
+#endif
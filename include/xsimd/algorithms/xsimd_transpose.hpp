@@ -0,0 +1,382 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ALGORITHMS_TRANSPOSE_HPP
+#define XSIMD_ALGORITHMS_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../config/xsimd_cpu_topology.hpp"
+#include "../xsimd.hpp"
+#include "./xsimd_parallel.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @defgroup algorithms_transpose Matrix transpose
+     */
+
+    namespace detail
+    {
+        template <std::size_t Size>
+        struct transpose_bits_impl
+        {
+            using type = void;
+        };
+
+        template <>
+        struct transpose_bits_impl<1>
+        {
+            using type = uint8_t;
+        };
+
+        template <>
+        struct transpose_bits_impl<2>
+        {
+            using type = uint16_t;
+        };
+
+        template <>
+        struct transpose_bits_impl<4>
+        {
+            using type = uint32_t;
+        };
+
+        template <>
+        struct transpose_bits_impl<8>
+        {
+            using type = uint64_t;
+        };
+
+        // Floating point elements are transposed as batches of their own
+        // type, integers as batches of the unsigned integer of the same size
+        // and other types element by element.
+        template <class T>
+        using transpose_value_t = std::conditional_t<std::is_same_v<T, float> || std::is_same_v<T, double>, T,
+                                                     std::conditional_t<std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                                                                        typename transpose_bits_impl<sizeof(T)>::type,
+                                                                        void>>;
+
+        /*
+         * Transposes the rows x cols tile at src into dst, with rows and cols
+         * not greater than the batch size. Partial tiles are read and written
+         * with masked loads and stores.
+         */
+        template <class A, class T>
+        XSIMD_INLINE void transpose_tile(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                         std::size_t rows, std::size_t cols) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            batch_type tile[size];
+            if (rows == size && cols == size)
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                    tile[i] = batch_type::load_unaligned(src + i * src_stride);
+                ::xsimd::transpose(tile, tile + size);
+                for (std::size_t i = 0; i < size; ++i)
+                    tile[i].store_unaligned(dst + i * dst_stride);
+            }
+            else
+            {
+                auto const load_mask = batch_bool<T, A>::first_n(cols);
+                for (std::size_t i = 0; i < rows; ++i)
+                    tile[i] = batch_type::load(src + i * src_stride, load_mask, unaligned_mode {});
+                for (std::size_t i = rows; i < size; ++i)
+                    tile[i] = batch_type(T(0));
+                ::xsimd::transpose(tile, tile + size);
+                auto const store_mask = batch_bool<T, A>::first_n(rows);
+                for (std::size_t i = 0; i < cols; ++i)
+                    tile[i].store(dst + i * dst_stride, store_mask, unaligned_mode {});
+            }
+        }
+
+        /*
+         * Swaps the transposes of the tiles at (i, j) and (j, i) of a square
+         * matrix, or transposes the tile in place when they coincide.
+         */
+        template <class A, class T>
+        XSIMD_INLINE void transpose_tile_pair(T* data, std::size_t stride, std::size_t i, std::size_t j,
+                                              std::size_t rows, std::size_t cols) noexcept
+        {
+            using batch_type = batch<T, A>;
+            constexpr std::size_t size = batch_type::size;
+            T* upper = data + i * stride + j;
+            T* lower = data + j * stride + i;
+            if (i == j)
+            {
+                alignas(A::alignment()) T buffer[size * size];
+                transpose_tile<A>(upper, stride, buffer, size, rows, cols);
+                for (std::size_t k = 0; k < cols; ++k)
+                    std::copy(buffer + k * size, buffer + k * size + rows, upper + k * stride);
+                return;
+            }
+            batch_type first[size];
+            batch_type second[size];
+            auto const upper_mask = batch_bool<T, A>::first_n(cols);
+            auto const lower_mask = batch_bool<T, A>::first_n(rows);
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                first[k] = k < rows ? batch_type::load(upper + k * stride, upper_mask, unaligned_mode {}) : batch_type(T(0));
+                second[k] = k < cols ? batch_type::load(lower + k * stride, lower_mask, unaligned_mode {}) : batch_type(T(0));
+            }
+            ::xsimd::transpose(first, first + size);
+            ::xsimd::transpose(second, second + size);
+            for (std::size_t k = 0; k < cols; ++k)
+                first[k].store(lower + k * stride, lower_mask, unaligned_mode {});
+            for (std::size_t k = 0; k < rows; ++k)
+                second[k].store(upper + k * stride, upper_mask, unaligned_mode {});
+        }
+
+        /*
+         * Side lengths, in elements, of the square blocks that keep the source
+         * and destination lines touched by a block in the L1 and L2 caches.
+         * Both are multiples of the batch size, the L2 block being a multiple
+         * of the L1 block.
+         */
+        struct transpose_blocking
+        {
+            std::size_t l1;
+            std::size_t l2;
+        };
+
+        template <class T, class A>
+        inline transpose_blocking transpose_block_sizes() noexcept
+        {
+            static transpose_blocking const blocking = []() noexcept
+            {
+                constexpr std::size_t size = batch<T, A>::size;
+                auto const& topo = available_topology();
+                auto side = [](std::size_t cache, std::size_t fallback, std::size_t step) noexcept
+                {
+                    std::size_t const bytes = cache != 0 ? cache : fallback;
+                    auto const n = static_cast<std::size_t>(std::sqrt(double(bytes) / (2 * sizeof(T))));
+                    return std::max(step, n / step * step);
+                };
+                transpose_blocking res;
+                res.l1 = side(topo.l1d.size, 32 * 1024, size);
+                res.l2 = side(topo.l2.size, 256 * 1024, res.l1);
+                return res;
+            }();
+            return blocking;
+        }
+
+        template <class A, class T>
+        inline void transpose_rows(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                   std::size_t row_begin, std::size_t row_end, std::size_t cols) noexcept
+        {
+            constexpr std::size_t size = batch<T, A>::size;
+            auto const blocks = transpose_block_sizes<T, A>();
+            for (std::size_t i2 = row_begin; i2 < row_end; i2 += blocks.l2)
+            {
+                std::size_t const i2_end = std::min(i2 + blocks.l2, row_end);
+                for (std::size_t j2 = 0; j2 < cols; j2 += blocks.l2)
+                {
+                    std::size_t const j2_end = std::min(j2 + blocks.l2, cols);
+                    for (std::size_t i1 = i2; i1 < i2_end; i1 += blocks.l1)
+                    {
+                        std::size_t const i1_end = std::min(i1 + blocks.l1, i2_end);
+                        for (std::size_t j1 = j2; j1 < j2_end; j1 += blocks.l1)
+                        {
+                            std::size_t const j1_end = std::min(j1 + blocks.l1, j2_end);
+                            for (std::size_t i = i1; i < i1_end; i += size)
+                            {
+                                for (std::size_t j = j1; j < j1_end; j += size)
+                                {
+                                    transpose_tile<A>(src + i * src_stride + j, src_stride,
+                                                      dst + j * dst_stride + i, dst_stride,
+                                                      std::min(size, i1_end - i), std::min(size, j1_end - j));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template <class T>
+        inline void transpose_rows_scalar(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                          std::size_t row_begin, std::size_t row_end, std::size_t cols) noexcept
+        {
+            constexpr std::size_t block = 32;
+            for (std::size_t i1 = row_begin; i1 < row_end; i1 += block)
+            {
+                std::size_t const i1_end = std::min(i1 + block, row_end);
+                for (std::size_t j1 = 0; j1 < cols; j1 += block)
+                {
+                    std::size_t const j1_end = std::min(j1 + block, cols);
+                    for (std::size_t i = i1; i < i1_end; ++i)
+                        for (std::size_t j = j1; j < j1_end; ++j)
+                            dst[j * dst_stride + i] = src[i * src_stride + j];
+                }
+            }
+        }
+
+        template <class A, class T>
+        inline void transpose_matrix_rows(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                          std::size_t row_begin, std::size_t row_end, std::size_t cols) noexcept
+        {
+            using value_type = transpose_value_t<T>;
+            if constexpr (std::is_void_v<value_type>)
+            {
+                transpose_rows_scalar(src, src_stride, dst, dst_stride, row_begin, row_end, cols);
+            }
+            else
+            {
+                transpose_rows<A>(reinterpret_cast<value_type const*>(src), src_stride,
+                                  reinterpret_cast<value_type*>(dst), dst_stride,
+                                  row_begin, row_end, cols);
+            }
+        }
+
+        // Number of rows handled together by a tile.
+        template <class T, class A>
+        constexpr std::size_t transpose_granularity() noexcept
+        {
+            if constexpr (std::is_void_v<transpose_value_t<T>>)
+                return 32;
+            else
+                return batch<transpose_value_t<T>, A>::size;
+        }
+
+        template <class A, class T>
+        inline void transpose_square_inplace(T* data, std::size_t n) noexcept
+        {
+            constexpr std::size_t size = batch<T, A>::size;
+            auto const blocks = transpose_block_sizes<T, A>();
+            for (std::size_t i1 = 0; i1 < n; i1 += blocks.l1)
+            {
+                std::size_t const i1_end = std::min(i1 + blocks.l1, n);
+                for (std::size_t j1 = i1; j1 < n; j1 += blocks.l1)
+                {
+                    std::size_t const j1_end = std::min(j1 + blocks.l1, n);
+                    for (std::size_t i = i1; i < i1_end; i += size)
+                    {
+                        for (std::size_t j = (i1 == j1 ? i : j1); j < j1_end; j += size)
+                        {
+                            transpose_tile_pair<A>(data, n, i, j, std::min(size, i1_end - i), std::min(size, j1_end - j));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @ingroup algorithms_transpose
+     *
+     * Transposes the row-major \c rows x \c cols matrix \c src into the row-major
+     * \c cols x \c rows matrix \c dst. The matrices are traversed in square
+     * blocks sized after the L1 and L2 caches reported by available_topology(),
+     * each block being transposed one batch-sized tile at a time with
+     * xsimd::transpose; tiles on the right and bottom edges are accessed with
+     * masked loads and stores. Integer and floating point elements are
+     * vectorized, other trivially copyable types are copied element by element.
+     *
+     * @tparam A architecture used for the tiles.
+     * @param src pointer to the source matrix.
+     * @param src_stride distance, in elements, between two rows of \c src.
+     * @param dst pointer to the destination matrix, which must not overlap \c src.
+     * @param dst_stride distance, in elements, between two rows of \c dst.
+     * @param rows number of rows of \c src.
+     * @param cols number of columns of \c src.
+     */
+    template <class A = default_arch, class T>
+    inline void transpose_matrix(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "transposed elements must be trivially copyable");
+        detail::transpose_matrix_rows<A>(src, src_stride, dst, dst_stride, 0, rows, cols);
+    }
+
+    /**
+     * @ingroup algorithms_transpose
+     *
+     * Transposes the contiguous row-major \c rows x \c cols matrix \c src into
+     * the contiguous \c cols x \c rows matrix \c dst.
+     */
+    template <class A = default_arch, class T>
+    inline void transpose_matrix(T const* src, T* dst, std::size_t rows, std::size_t cols) noexcept
+    {
+        transpose_matrix<A>(src, cols, dst, rows, rows, cols);
+    }
+
+    /**
+     * @ingroup algorithms_transpose
+     *
+     * Transposes the contiguous row-major \c rows x \c cols matrix \c data in
+     * place; on return \c data holds the \c cols x \c rows transpose. Square
+     * matrices are transposed by swapping tiles across the diagonal, without
+     * extra memory. Other shapes go through a temporary matrix of the same size.
+     */
+    template <class A = default_arch, class T>
+    inline void transpose_matrix(T* data, std::size_t rows, std::size_t cols)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "transposed elements must be trivially copyable");
+        using value_type = detail::transpose_value_t<T>;
+        if constexpr (!std::is_void_v<value_type>)
+        {
+            if (rows == cols)
+            {
+                detail::transpose_square_inplace<A>(reinterpret_cast<value_type*>(data), rows);
+                return;
+            }
+        }
+        std::vector<T, aligned_allocator<T, A::alignment()>> tmp(data, data + rows * cols);
+        transpose_matrix<A>(tmp.data(), data, rows, cols);
+    }
+
+    /**
+     * @ingroup algorithms_transpose
+     *
+     * Multi-threaded version of transpose_matrix(). The rows of \c src are split
+     * in bands of whole tiles, each one transposed by its own thread into the
+     * matching columns of \c dst.
+     *
+     * @param num_threads number of threads to use, including the calling
+     * thread. Zero means one per physical core, as reported by
+     * available_topology().
+     */
+    template <class A = default_arch, class T>
+    inline void parallel_transpose_matrix(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride,
+                                          std::size_t rows, std::size_t cols, std::size_t num_threads = 0)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "transposed elements must be trivially copyable");
+        constexpr std::size_t granularity = detail::transpose_granularity<T, A>();
+        std::size_t const tiles = (rows + granularity - 1) / granularity;
+        detail::parallel_bands(tiles, num_threads, [=](std::size_t tile_begin, std::size_t tile_end)
+                               { detail::transpose_matrix_rows<A>(src, src_stride, dst, dst_stride, tile_begin * granularity,
+                                                                  std::min(tile_end * granularity, rows), cols); });
+    }
+
+    /**
+     * @ingroup algorithms_transpose
+     *
+     * Multi-threaded version of transpose_matrix() for contiguous matrices.
+     */
+    template <class A = default_arch, class T>
+    inline void parallel_transpose_matrix(T const* src, T* dst, std::size_t rows, std::size_t cols,
+                                          std::size_t num_threads = 0)
+    {
+        parallel_transpose_matrix<A>(src, cols, dst, rows, rows, cols, num_threads);
+    }
+}
+
+#endif
+
+#endif
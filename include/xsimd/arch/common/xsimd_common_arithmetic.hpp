@@ -60,6 +60,35 @@ namespace xsimd
             return bitwise_rshift(self, shift, A {});
         }
 
+        // countl_zero
+        template <class A, class T, class /*=std::enable_if_t<std::is_integral_v<T>>*/>
+        XSIMD_INLINE batch<T, A> countl_zero(batch<T, A> const& self, requires_arch<common>) noexcept
+        {
+            // set every bit below the leading one, then count the others
+            using unsigned_type = as_unsigned_integer_t<T>;
+            auto x = ::xsimd::bitwise_cast<unsigned_type>(self);
+            x |= x >> 1;
+            x |= x >> 2;
+            x |= x >> 4;
+            if constexpr (sizeof(T) > 1)
+                x |= x >> 8;
+            if constexpr (sizeof(T) > 2)
+                x |= x >> 16;
+            if constexpr (sizeof(T) > 4)
+                x |= x >> 32;
+            return ::xsimd::bitwise_cast<T>(popcount(~x));
+        }
+
+        // countr_zero
+        template <class A, class T, class /*=std::enable_if_t<std::is_integral_v<T>>*/>
+        XSIMD_INLINE batch<T, A> countr_zero(batch<T, A> const& self, requires_arch<common>) noexcept
+        {
+            // the trailing zeros of x are the bits set in ~x & (x - 1)
+            using unsigned_type = as_unsigned_integer_t<T>;
+            auto const x = ::xsimd::bitwise_cast<unsigned_type>(self);
+            return ::xsimd::bitwise_cast<T>(popcount(~x & (x - 1)));
+        }
+
         // decr
         template <class A, class T>
         XSIMD_INLINE batch<T, A> decr(batch<T, A> const& self, requires_arch<common>) noexcept
@@ -329,6 +358,29 @@ namespace xsimd
                      ::xsimd::bitwise_cast<int64_t>(hilo.second) };
         }
 
+        // popcount
+        template <class A, class T, class /*=std::enable_if_t<std::is_integral_v<T>>*/>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<common>) noexcept
+        {
+            // https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
+            // with the bytes summed by shifts, as 64-bit multiplications are
+            // emulated on most architectures
+            using unsigned_type = as_unsigned_integer_t<T>;
+            using unsigned_batch = batch<unsigned_type, A>;
+            auto x = ::xsimd::bitwise_cast<unsigned_type>(self);
+            x = x - ((x >> 1) & unsigned_batch(static_cast<unsigned_type>(0x5555555555555555ull)));
+            x = (x & unsigned_batch(static_cast<unsigned_type>(0x3333333333333333ull)))
+                + ((x >> 2) & unsigned_batch(static_cast<unsigned_type>(0x3333333333333333ull)));
+            x = (x + (x >> 4)) & unsigned_batch(static_cast<unsigned_type>(0x0F0F0F0F0F0F0F0Full));
+            if constexpr (sizeof(T) > 1)
+                x = x + (x >> 8);
+            if constexpr (sizeof(T) > 2)
+                x = x + (x >> 16);
+            if constexpr (sizeof(T) > 4)
+                x = x + (x >> 32);
+            return ::xsimd::bitwise_cast<T>(x & unsigned_batch(static_cast<unsigned_type>(0xFF)));
+        }
+
         // rotl
         template <class A, class T, class STy>
         XSIMD_INLINE batch<T, A> rotl(batch<T, A> const& self, STy other, requires_arch<common>) noexcept
@@ -16,6 +16,7 @@
 #include "../../utils/xsimd_type_traits.hpp"
 
 #include <array>
+#include <limits>
 
 namespace xsimd
 {
@@ -36,6 +37,65 @@ namespace xsimd
                      batch<T_out, A>::load_aligned(&out_buffer[batch<T_out, A>::size]) };
         }
 
+        // narrow
+        template <class A, class T>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<common>) noexcept
+        {
+            constexpr std::size_t size = batch<T, A>::size;
+            alignas(A::alignment()) T buffer[2 * size];
+            lo.store_aligned(&buffer[0]);
+            hi.store_aligned(&buffer[size]);
+
+            using T_out = narrow_t<T>;
+            alignas(A::alignment()) T_out out_buffer[2 * size];
+            for (size_t i = 0; i < 2 * size; ++i)
+                out_buffer[i] = static_cast<T_out>(buffer[i]);
+            return batch<T_out, A>::load_aligned(&out_buffer[0]);
+        }
+
+        // narrow_saturate
+        namespace detail
+        {
+            // the range of T_out, as values of T
+            template <class T_out, class T>
+            constexpr T narrow_saturate_min() noexcept
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                    return T(std::numeric_limits<T_out>::lowest());
+                else
+                    return std::is_signed_v<T> ? T(std::numeric_limits<T_out>::min()) : T(0);
+            }
+
+            template <class T_out, class T>
+            constexpr T narrow_saturate_max() noexcept
+            {
+                return T(std::numeric_limits<T_out>::max());
+            }
+        }
+
+        template <class A, class T, class T_out>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<common>) noexcept
+        {
+            batch<T, A> const vmax(detail::narrow_saturate_max<T_out, T>());
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // finite values only, infinities and NaN go through
+                batch<T, A> const inf(std::numeric_limits<T>::infinity());
+                auto clamp = [&](batch<T, A> const& x)
+                {
+                    auto const a = abs(x);
+                    return select((a > vmax) & (a < inf), copysign(vmax, x), x);
+                };
+                return narrow(clamp(lo), clamp(hi));
+            }
+            else
+            {
+                // once clamped, the truncating narrow is exact
+                batch<T, A> const vmin(detail::narrow_saturate_min<T_out, T>());
+                return bitwise_cast<T_out>(narrow(min(max(lo, vmin), vmax), min(max(hi, vmin), vmax)));
+            }
+        }
+
     }
 
 }
@@ -106,6 +106,87 @@ namespace xsimd
         {
             return batch_bool<T, A>(isfinite(self.real()) && isfinite(self.imag()));
         }
+
+        // interleaved complex arithmetic, lanes hold (re0, im0, re1, im1, ...)
+        namespace detail
+        {
+            struct interleaved_real_lane
+            {
+                static constexpr unsigned get(unsigned i, unsigned) noexcept { return i & ~1u; }
+            };
+            struct interleaved_imag_lane
+            {
+                static constexpr unsigned get(unsigned i, unsigned) noexcept { return i | 1u; }
+            };
+            struct interleaved_swap_lane
+            {
+                static constexpr unsigned get(unsigned i, unsigned) noexcept { return i ^ 1u; }
+            };
+            struct interleaved_odd_lane
+            {
+                static constexpr bool get(unsigned i, unsigned) noexcept { return (i & 1u) != 0; }
+            };
+
+            // (re, re) pairs
+            template <class A, class T>
+            XSIMD_INLINE batch<T, A> interleaved_real(batch<T, A> const& self) noexcept
+            {
+                return swizzle(self, ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, interleaved_real_lane, A>());
+            }
+
+            // (im, im) pairs
+            template <class A, class T>
+            XSIMD_INLINE batch<T, A> interleaved_imag(batch<T, A> const& self) noexcept
+            {
+                return swizzle(self, ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, interleaved_imag_lane, A>());
+            }
+
+            // (im, re) pairs
+            template <class A, class T>
+            XSIMD_INLINE batch<T, A> interleaved_swap(batch<T, A> const& self) noexcept
+            {
+                return swizzle(self, ::xsimd::make_batch_constant<as_unsigned_integer_t<T>, interleaved_swap_lane, A>());
+            }
+
+            // (re, -im) pairs
+            template <class A, class T>
+            XSIMD_INLINE batch<T, A> interleaved_conj(batch<T, A> const& self) noexcept
+            {
+                return select(::xsimd::make_batch_bool_constant<T, interleaved_odd_lane, A>(), -self, self);
+            }
+        }
+
+        // interleaved_mul
+        template <class A, class T>
+        XSIMD_INLINE batch<T, A> interleaved_mul(batch<T, A> const& x, batch<T, A> const& y, requires_arch<common>) noexcept
+        {
+            // (xr * yr - xi * yi, xi * yr + xr * yi), fmas maps to fmaddsub / addsub
+            return fmas(x, detail::interleaved_real(y), detail::interleaved_swap(x) * detail::interleaved_imag(y));
+        }
+
+        // interleaved_fma
+        template <class A, class T>
+        XSIMD_INLINE batch<T, A> interleaved_fma(batch<T, A> const& x, batch<T, A> const& y, batch<T, A> const& z, requires_arch<common>) noexcept
+        {
+            // the inner fmas yields (xi * yi - zr, xr * yi + zi), which the
+            // outer one subtracts from / adds to (xr * yr, xi * yr)
+            return fmas(x, detail::interleaved_real(y), fmas(detail::interleaved_swap(x), detail::interleaved_imag(y), z));
+        }
+
+        // interleaved_div
+        template <class A, class T>
+        XSIMD_INLINE batch<T, A> interleaved_div(batch<T, A> const& x, batch<T, A> const& y, requires_arch<common>) noexcept
+        {
+            // Scale y by the inverse of max(|yr|, |yi|) so that |y|^2 neither
+            // overflows nor underflows, then multiply x * conj(y) by the
+            // reciprocal of the scaled norm.
+            auto const ay = abs(y);
+            auto const scale = T(1) / max(ay, detail::interleaved_swap(ay));
+            auto const ys = y * scale;
+            auto const ys2 = ys * ys;
+            auto const rcp = scale / (ys2 + detail::interleaved_swap(ys2));
+            return interleaved_mul(x, detail::interleaved_conj(ys)) * rcp;
+        }
     }
 }
 
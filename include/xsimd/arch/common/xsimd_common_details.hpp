@@ -55,6 +55,8 @@ namespace xsimd
     template <class T, class A>
     XSIMD_INLINE batch<T, A> hypot(const batch<T, A>& self) noexcept;
     template <class T, class A>
+    XSIMD_INLINE batch<T, A> interleaved_mul(batch<T, A> const& x, batch<T, A> const& y) noexcept;
+    template <class T, class A>
     XSIMD_INLINE batch_bool<T, A> is_even(batch<T, A> const& self) noexcept;
     template <class T, class A>
     XSIMD_INLINE batch_bool<T, A> is_flint(batch<T, A> const& self) noexcept;
@@ -73,6 +73,16 @@ namespace xsimd
             return batch_bool<T, A>::load_aligned(buffer);
         }
 
+        // first_n
+        template <class A, class T>
+        XSIMD_INLINE batch_bool<T, A> first_n(batch_bool<T, A> const&, std::size_t n, requires_arch<common>) noexcept
+        {
+            using index_type = as_unsigned_integer_t<T>;
+            constexpr std::size_t size = batch_bool<T, A>::size;
+            auto const index = ::xsimd::make_batch_constant<index_type, ::xsimd::generator::iota<index_type>, A>().as_batch();
+            return batch_bool_cast<T>(index < batch<index_type, A>(static_cast<index_type>(n < size ? n : size)));
+        }
+
         // ge
         template <class A, class T>
         XSIMD_INLINE batch_bool<T, A> ge(batch<T, A> const& self, batch<T, A> const& other, requires_arch<common>) noexcept
@@ -933,7 +933,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint16_t, A>* matrix_begin, batch<uint16_t, A>* matrix_end, requires_arch<common>) noexcept
         {
-            transpose(reinterpret_cast<batch<int16_t, A>*>(matrix_begin), reinterpret_cast<batch<int16_t, A>*>(matrix_end), A {});
+            detail::transpose_as<int16_t>(matrix_begin, matrix_end, A {});
         }
 
         template <class A, class = std::enable_if_t<batch<int8_t, A>::size == 16>>
@@ -1023,9 +1023,31 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint8_t, A>* matrix_begin, batch<uint8_t, A>* matrix_end, requires_arch<common>) noexcept
         {
-            transpose(reinterpret_cast<batch<int8_t, A>*>(matrix_begin), reinterpret_cast<batch<int8_t, A>*>(matrix_end), A {});
+            detail::transpose_as<int8_t>(matrix_begin, matrix_end, A {});
         }
 
+        namespace detail
+        {
+            // Transposes a matrix of batches as batches of U, of the same bit
+            // width. Going through a copy, rather than reinterpreting the row
+            // pointers, prevents the optimizer from reordering the accesses.
+            // Defined last, after every architecture and the common integer
+            // transposes, so that the transpose of U is looked up among all
+            // of them.
+            template <class U, class A, class T>
+            XSIMD_INLINE void transpose_as(batch<T, A>* matrix_begin, batch<T, A>* matrix_end, A const& arch) noexcept
+            {
+                assert((matrix_end - matrix_begin == batch<T, A>::size) && "correctly sized matrix");
+                (void)matrix_end;
+                constexpr std::size_t size = batch<U, A>::size;
+                batch<U, A> tmp[size];
+                for (std::size_t i = 0; i < size; ++i)
+                    tmp[i] = ::xsimd::bitwise_cast<U>(matrix_begin[i]);
+                ::xsimd::kernel::transpose(tmp, tmp + size, arch);
+                for (std::size_t i = 0; i < size; ++i)
+                    matrix_begin[i] = ::xsimd::bitwise_cast<T>(tmp[i]);
+            }
+        }
     }
 
 }
@@ -601,6 +601,18 @@ namespace xsimd
             return _mm256_floor_pd(self);
         }
 
+        // fmas
+        template <class A>
+        XSIMD_INLINE batch<float, A> fmas(batch<float, A> const& x, batch<float, A> const& y, batch<float, A> const& z, requires_arch<avx>) noexcept
+        {
+            return _mm256_addsub_ps(_mm256_mul_ps(x, y), z);
+        }
+        template <class A>
+        XSIMD_INLINE batch<double, A> fmas(batch<double, A> const& x, batch<double, A> const& y, batch<double, A> const& z, requires_arch<avx>) noexcept
+        {
+            return _mm256_addsub_pd(_mm256_mul_pd(x, y), z);
+        }
+
         // from_mask
         template <class A>
         XSIMD_INLINE batch_bool<float, A> from_mask(batch_bool<float, A> const&, uint64_t mask, requires_arch<avx>) noexcept
@@ -1361,6 +1373,31 @@ namespace xsimd
             return _mm256_cvtps_epi32(self);
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<avx>) noexcept
+        {
+            using half_batch = batch<T, sse4_2>;
+            batch<narrow_t<T>, sse4_2> const res_low = narrow(half_batch(detail::lower_half(lo)), half_batch(detail::upper_half(lo)));
+            batch<narrow_t<T>, sse4_2> const res_high = narrow(half_batch(detail::lower_half(hi)), half_batch(detail::upper_half(hi)));
+            return detail::merge_sse(res_low.data, res_high.data);
+        }
+        template <class A>
+        XSIMD_INLINE batch<float, A> narrow(batch<double, A> const& lo, batch<double, A> const& hi, requires_arch<avx>) noexcept
+        {
+            return detail::merge_sse(_mm256_cvtpd_ps(lo), _mm256_cvtpd_ps(hi));
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<avx>) noexcept
+        {
+            using half_batch = batch<T, sse4_2>;
+            batch<T_out, sse4_2> const res_low = narrow_saturate<T_out>(half_batch(detail::lower_half(lo)), half_batch(detail::upper_half(lo)));
+            batch<T_out, sse4_2> const res_high = narrow_saturate<T_out>(half_batch(detail::lower_half(hi)), half_batch(detail::upper_half(hi)));
+            return detail::merge_sse(res_low.data, res_high.data);
+        }
+
         // neg
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> neg(batch<T, A> const& self, requires_arch<avx>) noexcept
@@ -1411,6 +1448,16 @@ namespace xsimd
             return _mm256_castps_si256(_mm256_xor_ps(_mm256_castsi256_ps(self.data), _mm256_castsi256_ps(other.data)));
         }
 
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<avx>) noexcept
+        {
+            using half_batch = batch<T, sse4_2>;
+            half_batch const res_low = popcount(half_batch(detail::lower_half(self)));
+            half_batch const res_high = popcount(half_batch(detail::upper_half(self)));
+            return detail::merge_sse(res_low.data, res_high.data);
+        }
+
         // reciprocal
         template <class A>
         XSIMD_INLINE batch<float, A> reciprocal(batch<float, A> const& self,
@@ -2035,12 +2082,12 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint32_t, A>* matrix_begin, batch<uint32_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int32_t, A>* matrix_begin, batch<int32_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2065,12 +2112,12 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint64_t, A>* matrix_begin, batch<uint64_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int64_t, A>* matrix_begin, batch<int64_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2106,7 +2153,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<int16_t, A>* matrix_begin, batch<int16_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<uint16_t, A>*>(matrix_begin), reinterpret_cast<batch<uint16_t, A>*>(matrix_end), A {});
+            detail::transpose_as<uint16_t>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2142,7 +2189,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<int8_t, A>* matrix_begin, batch<int8_t, A>* matrix_end, requires_arch<avx>) noexcept
         {
-            return transpose(reinterpret_cast<batch<uint8_t, A>*>(matrix_begin), reinterpret_cast<batch<uint8_t, A>*>(matrix_end), A {});
+            detail::transpose_as<uint8_t>(matrix_begin, matrix_end, A {});
         }
 
         // trunc
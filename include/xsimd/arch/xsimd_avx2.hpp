@@ -962,6 +962,92 @@ namespace xsimd
                                                { return batch<uint64_t, A>(_mm256_mul_epu32(a, b)); });
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<avx2>) noexcept
+        {
+            // packs work within 128-bit lanes, the permutation restores the order
+            __m256i packed;
+            if constexpr (sizeof(T) == 2)
+            {
+                __m256i const mask = _mm256_set1_epi16(0x00FF);
+                packed = _mm256_packus_epi16(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask));
+            }
+            else if constexpr (sizeof(T) == 4)
+            {
+                __m256i const mask = _mm256_set1_epi32(0xFFFF);
+                packed = _mm256_packus_epi32(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask));
+            }
+            else
+            {
+                packed = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(lo), _mm256_castsi256_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+            return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<avx2>) noexcept
+        {
+            if constexpr (sizeof(T) == 8)
+            {
+                using half_batch = batch<T, sse4_2>;
+                batch<T_out, sse4_2> const res_low = narrow_saturate<T_out>(half_batch(detail::lower_half(lo)), half_batch(detail::upper_half(lo)));
+                batch<T_out, sse4_2> const res_high = narrow_saturate<T_out>(half_batch(detail::lower_half(hi)), half_batch(detail::upper_half(hi)));
+                return detail::merge_sse(res_low.data, res_high.data);
+            }
+            else
+            {
+                __m256i packed;
+                if constexpr (sizeof(T) == 2)
+                {
+                    if constexpr (std::is_signed_v<T> && std::is_signed_v<T_out>)
+                        packed = _mm256_packs_epi16(lo, hi);
+                    else if constexpr (std::is_signed_v<T>)
+                        packed = _mm256_packus_epi16(lo, hi);
+                    else
+                    {
+                        __m256i const vmax = _mm256_set1_epi16(std::numeric_limits<T_out>::max());
+                        packed = _mm256_packus_epi16(_mm256_min_epu16(lo, vmax), _mm256_min_epu16(hi, vmax));
+                    }
+                }
+                else
+                {
+                    if constexpr (std::is_signed_v<T> && std::is_signed_v<T_out>)
+                        packed = _mm256_packs_epi32(lo, hi);
+                    else if constexpr (std::is_signed_v<T>)
+                        packed = _mm256_packus_epi32(lo, hi);
+                    else
+                    {
+                        __m256i const vmax = _mm256_set1_epi32(std::numeric_limits<T_out>::max());
+                        packed = _mm256_packus_epi32(_mm256_min_epu32(lo, vmax), _mm256_min_epu32(hi, vmax));
+                    }
+                }
+                return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+            }
+        }
+
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<avx2>) noexcept
+        {
+            // same nibble lookup as ssse3, within each 128-bit lane
+            __m256i const lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            __m256i const low_mask = _mm256_set1_epi8(0x0F);
+            __m256i const lo = _mm256_and_si256(self, low_mask);
+            __m256i const hi = _mm256_and_si256(_mm256_srli_epi16(self, 4), low_mask);
+            __m256i const bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+            if constexpr (sizeof(T) == 1)
+                return bytes;
+            else if constexpr (sizeof(T) == 2)
+                return _mm256_maddubs_epi16(bytes, _mm256_set1_epi8(1));
+            else if constexpr (sizeof(T) == 4)
+                return _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, _mm256_set1_epi8(1)), _mm256_set1_epi16(1));
+            else
+                return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+        }
+
         // reduce_add
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE T reduce_add(batch<T, A> const& self, requires_arch<avx2>) noexcept
@@ -1074,6 +1160,10 @@ namespace xsimd
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> select(batch_bool<T, A> const& cond, batch<T, A> const& true_br, batch<T, A> const& false_br, requires_arch<avx2>) noexcept
         {
+#if defined(XSIMD_BLENDV_EPI8_DROPS_NOT)
+            // a single vpternlog on these targets
+            return _mm256_or_si256(_mm256_and_si256(cond, true_br), _mm256_andnot_si256(cond, false_br));
+#else
             if constexpr (sizeof(T) == 1)
             {
                 return _mm256_blendv_epi8(false_br, true_br, cond);
@@ -1094,6 +1184,7 @@ namespace xsimd
             {
                 return select(cond, true_br, false_br, avx {});
             }
+#endif
         }
         template <class A, class T, bool... Values, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> select(batch_bool_constant<T, A, Values...> const&, batch<T, A> const& true_br, batch<T, A> const& false_br, requires_arch<avx2>) noexcept
@@ -1298,7 +1389,7 @@ namespace xsimd
             }
         }
 
-        // swizzle (dynamic mask) on 8 and 16 bits; see avx for 32 and 64 bits versions
+        // swizzle (dynamic mask)
         template <class A>
         XSIMD_INLINE batch<uint8_t, A> swizzle(batch<uint8_t, A> const& self, batch<uint8_t, A> mask, requires_arch<avx2>) noexcept
         {
@@ -1342,6 +1433,34 @@ namespace xsimd
             return bitwise_cast<T>(swizzle(bitwise_cast<uint16_t>(self), mask, req));
         }
 
+        // 32 and 64 bits cross the 128-bit lanes in a single permute, where
+        // avx needs two in-lane permutes and a blend
+        template <class A>
+        XSIMD_INLINE batch<float, A> swizzle(batch<float, A> const& self, batch<uint32_t, A> mask, requires_arch<avx2>) noexcept
+        {
+            return _mm256_permutevar8x32_ps(self, mask);
+        }
+
+        template <class A, typename T, detail::enable_sized_integral_t<T, 4> = 0>
+        XSIMD_INLINE batch<T, A> swizzle(batch<T, A> const& self, batch<uint32_t, A> const& mask, requires_arch<avx2>) noexcept
+        {
+            return _mm256_permutevar8x32_epi32(self, mask);
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<double, A> swizzle(batch<double, A> const& self, batch<uint64_t, A> mask, requires_arch<avx2>) noexcept
+        {
+            // a 64-bit index k selects the 32-bit elements 2k and 2k + 1
+            batch<uint64_t, A> const pairs = (mask << 1) | (mask << 33) | (uint64_t(1) << 32);
+            return _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(self), pairs));
+        }
+
+        template <class A, typename T, detail::enable_sized_integral_t<T, 8> = 0>
+        XSIMD_INLINE batch<T, A> swizzle(batch<T, A> const& self, batch<uint64_t, A> const& mask, requires_arch<avx2>) noexcept
+        {
+            return bitwise_cast<T>(swizzle(bitwise_cast<double>(self), mask, avx2 {}));
+        }
+
         namespace detail
         {
             template <bool cross_batch, typename T, T... Vals>
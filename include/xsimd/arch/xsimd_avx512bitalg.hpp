@@ -0,0 +1,40 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_AVX512BITALG_HPP
+#define XSIMD_AVX512BITALG_HPP
+
+#include <type_traits>
+
+#include "../types/xsimd_avx512bitalg_register.hpp"
+
+namespace xsimd
+{
+
+    namespace kernel
+    {
+        using namespace types;
+
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<avx512bitalg>) noexcept
+        {
+            if constexpr (sizeof(T) == 1)
+                return _mm512_popcnt_epi8(self);
+            else if constexpr (sizeof(T) == 2)
+                return _mm512_popcnt_epi16(self);
+            else
+                return popcount(self, avx512vpopcntdq {});
+        }
+    }
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include "../types/xsimd_avx512bw_register.hpp"
 
 #include <array>
+#include <limits>
 #include <type_traits>
 
 namespace xsimd
@@ -554,6 +555,65 @@ namespace xsimd
             return _mm512_mulhi_epu16(self, other);
         }
 
+        // narrow
+        namespace detail
+        {
+            // packs work within 128-bit lanes, this restores the order
+            XSIMD_INLINE __m512i narrow_permute(__m512i packed) noexcept
+            {
+                return _mm512_permutexvar_epi64(_mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0), packed);
+            }
+        }
+
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) == 2 || sizeof(T) == 4)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<avx512bw>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+            {
+                __m512i const mask = _mm512_set1_epi16(0x00FF);
+                return detail::narrow_permute(_mm512_packus_epi16(_mm512_and_si512(lo, mask), _mm512_and_si512(hi, mask)));
+            }
+            else
+            {
+                __m512i const mask = _mm512_set1_epi32(0xFFFF);
+                return detail::narrow_permute(_mm512_packus_epi32(_mm512_and_si512(lo, mask), _mm512_and_si512(hi, mask)));
+            }
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<avx512bw>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+            {
+                if constexpr (std::is_signed_v<T> && std::is_signed_v<T_out>)
+                    return detail::narrow_permute(_mm512_packs_epi16(lo, hi));
+                else if constexpr (std::is_signed_v<T>)
+                    return detail::narrow_permute(_mm512_packus_epi16(lo, hi));
+                else
+                {
+                    __m512i const vmax = _mm512_set1_epi16(std::numeric_limits<T_out>::max());
+                    return detail::narrow_permute(_mm512_packus_epi16(_mm512_min_epu16(lo, vmax), _mm512_min_epu16(hi, vmax)));
+                }
+            }
+            else if constexpr (sizeof(T) == 4)
+            {
+                if constexpr (std::is_signed_v<T> && std::is_signed_v<T_out>)
+                    return detail::narrow_permute(_mm512_packs_epi32(lo, hi));
+                else if constexpr (std::is_signed_v<T>)
+                    return detail::narrow_permute(_mm512_packus_epi32(lo, hi));
+                else
+                {
+                    __m512i const vmax = _mm512_set1_epi32(std::numeric_limits<T_out>::max());
+                    return detail::narrow_permute(_mm512_packus_epi32(_mm512_min_epu32(lo, vmax), _mm512_min_epu32(hi, vmax)));
+                }
+            }
+            else
+            {
+                return narrow_saturate(lo, hi, convert<T_out> {}, avx512f {});
+            }
+        }
+
         // neq
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch_bool<T, A> neq(batch<T, A> const& self, batch<T, A> const& other, requires_arch<avx512bw>) noexcept
@@ -561,6 +621,26 @@ namespace xsimd
             return detail::compare_int_avx512bw<A, T, _MM_CMPINT_NE>(self, other);
         }
 
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<avx512bw>) noexcept
+        {
+            // nibble lookup, as for avx2
+            __m512i const lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+            __m512i const low_mask = _mm512_set1_epi8(0x0F);
+            __m512i const lo = _mm512_and_si512(self, low_mask);
+            __m512i const hi = _mm512_and_si512(_mm512_srli_epi16(self, 4), low_mask);
+            __m512i const bytes = _mm512_add_epi8(_mm512_shuffle_epi8(lut, lo), _mm512_shuffle_epi8(lut, hi));
+            if constexpr (sizeof(T) == 1)
+                return bytes;
+            else if constexpr (sizeof(T) == 2)
+                return _mm512_maddubs_epi16(bytes, _mm512_set1_epi8(1));
+            else if constexpr (sizeof(T) == 4)
+                return _mm512_madd_epi16(_mm512_maddubs_epi16(bytes, _mm512_set1_epi8(1)), _mm512_set1_epi16(1));
+            else
+                return _mm512_sad_epu8(bytes, _mm512_setzero_si512());
+        }
+
         // sadd
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> sadd(batch<T, A> const& self, batch<T, A> const& other, requires_arch<avx512bw>) noexcept
@@ -615,6 +695,12 @@ namespace xsimd
             }
         }
 
+        template <class A, class T, bool... Values, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> select(batch_bool_constant<T, A, Values...> const&, batch<T, A> const& true_br, batch<T, A> const& false_br, requires_arch<avx512bw>) noexcept
+        {
+            return select(batch_bool<T, A> { Values... }, true_br, false_br, avx512bw {});
+        }
+
         // slide_left
         template <size_t N, class A, class T, class = std::enable_if_t<(N & 3) == 2 && (N < 64)>>
         XSIMD_INLINE batch<T, A> slide_left(batch<T, A> const& x, requires_arch<avx512bw>) noexcept
@@ -19,8 +19,35 @@ namespace xsimd
 
     namespace kernel
     {
-        // Nothing there yet.
+        using namespace types;
 
+        // countl_zero
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> countl_zero(batch<T, A> const& self, requires_arch<avx512cd>) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_lzcnt_epi32(self);
+            else if constexpr (sizeof(T) == 8)
+                return _mm512_lzcnt_epi64(self);
+            else
+                return countl_zero(self, common {});
+        }
+
+        // countr_zero
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> countr_zero(batch<T, A> const& self, requires_arch<avx512cd>) noexcept
+        {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                // the trailing zeros are the only set bits of ~x & (x - 1)
+                constexpr T bits = static_cast<T>(8 * sizeof(T));
+                return bits - countl_zero(~self & (self - 1), avx512cd {});
+            }
+            else
+            {
+                return countr_zero(self, common {});
+            }
+        }
     }
 
 }
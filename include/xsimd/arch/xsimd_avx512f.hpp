@@ -1884,6 +1884,72 @@ namespace xsimd
             return _mm512_cvtps_epi32(self);
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<avx512f>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+            {
+                using half_batch = batch<T, avx2>;
+                batch<narrow_t<T>, avx2> const res_low = narrow(half_batch(detail::lower_half(lo)), half_batch(detail::upper_half(lo)));
+                batch<narrow_t<T>, avx2> const res_high = narrow(half_batch(detail::lower_half(hi)), half_batch(detail::upper_half(hi)));
+                return detail::merge_avx(res_low.data, res_high.data);
+            }
+            else if constexpr (sizeof(T) == 4)
+            {
+                return detail::merge_avx(_mm512_cvtepi32_epi16(lo), _mm512_cvtepi32_epi16(hi));
+            }
+            else
+            {
+                return detail::merge_avx(_mm512_cvtepi64_epi32(lo), _mm512_cvtepi64_epi32(hi));
+            }
+        }
+        template <class A>
+        XSIMD_INLINE batch<float, A> narrow(batch<double, A> const& lo, batch<double, A> const& hi, requires_arch<avx512f>) noexcept
+        {
+            return detail::merge_avx(_mm512_cvtpd_ps(lo), _mm512_cvtpd_ps(hi));
+        }
+
+        // narrow_saturate
+        namespace detail
+        {
+            template <class T, class T_out>
+            XSIMD_INLINE __m256i narrow_saturate_avx512(__m512i x) noexcept
+            {
+                constexpr bool out_signed = std::is_signed_v<T_out>;
+                if constexpr (sizeof(T) == 4)
+                {
+                    if constexpr (std::is_signed_v<T>)
+                        return out_signed ? _mm512_cvtsepi32_epi16(x) : _mm512_cvtusepi32_epi16(_mm512_max_epi32(x, _mm512_setzero_si512()));
+                    else
+                        return out_signed ? _mm512_cvtepi32_epi16(_mm512_min_epu32(x, _mm512_set1_epi32(std::numeric_limits<T_out>::max()))) : _mm512_cvtusepi32_epi16(x);
+                }
+                else
+                {
+                    if constexpr (std::is_signed_v<T>)
+                        return out_signed ? _mm512_cvtsepi64_epi32(x) : _mm512_cvtusepi64_epi32(_mm512_max_epi64(x, _mm512_setzero_si512()));
+                    else
+                        return out_signed ? _mm512_cvtepi64_epi32(_mm512_min_epu64(x, _mm512_set1_epi64(std::numeric_limits<T_out>::max()))) : _mm512_cvtusepi64_epi32(x);
+                }
+            }
+        }
+
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<avx512f>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+            {
+                using half_batch = batch<T, avx2>;
+                batch<T_out, avx2> const res_low = narrow_saturate<T_out>(half_batch(detail::lower_half(lo)), half_batch(detail::upper_half(lo)));
+                batch<T_out, avx2> const res_high = narrow_saturate<T_out>(half_batch(detail::lower_half(hi)), half_batch(detail::upper_half(hi)));
+                return detail::merge_avx(res_low.data, res_high.data);
+            }
+            else
+            {
+                return detail::merge_avx(detail::narrow_saturate_avx512<T, T_out>(lo), detail::narrow_saturate_avx512<T, T_out>(hi));
+            }
+        }
+
         // neg
         template <class A, class T>
         XSIMD_INLINE batch<T, A> neg(batch<T, A> const& self, requires_arch<avx512f>) noexcept
@@ -1932,6 +1998,16 @@ namespace xsimd
             return _mm512_rcp14_pd(self);
         }
 
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<avx512f>) noexcept
+        {
+            using half_batch = batch<T, avx2>;
+            half_batch const res_low = popcount(half_batch(detail::lower_half(self)));
+            half_batch const res_high = popcount(half_batch(detail::upper_half(self)));
+            return detail::merge_avx(res_low.data, res_high.data);
+        }
+
         // reduce_add
         template <class A>
         XSIMD_INLINE float reduce_add(batch<float, A> const& rhs, requires_arch<avx512f>) noexcept
@@ -2776,7 +2852,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<int16_t, A>* matrix_begin, batch<int16_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<uint16_t, A>*>(matrix_begin), reinterpret_cast<batch<uint16_t, A>*>(matrix_end), A {});
+            detail::transpose_as<uint16_t>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2812,7 +2888,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<int8_t, A>* matrix_begin, batch<int8_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<uint8_t, A>*>(matrix_begin), reinterpret_cast<batch<uint8_t, A>*>(matrix_end), A {});
+            detail::transpose_as<uint8_t>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2849,12 +2925,12 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint32_t, A>* matrix_begin, batch<uint32_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int32_t, A>* matrix_begin, batch<int32_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2884,12 +2960,12 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint64_t, A>* matrix_begin, batch<uint64_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int64_t, A>* matrix_begin, batch<int64_t, A>* matrix_end, requires_arch<avx512f>) noexcept
         {
-            return transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
         }
 
         // trunc
@@ -2911,15 +2987,11 @@ namespace xsimd
         XSIMD_INLINE batch<T, A>
         zip_hi(batch<T, A> const& self, batch<T, A> const& other, requires_arch<avx512f>) noexcept
         {
-            if constexpr (sizeof(T) == 1)
-            {
-                assert(false && "not implemented yet");
-                return {};
-            }
-            else if constexpr (sizeof(T) == 2)
+            if constexpr (sizeof(T) == 1 || sizeof(T) == 2)
             {
-                assert(false && "not implemented yet");
-                return {};
+                // no 8 and 16-bit permutes before AVX512BW: interleave the upper halves with AVX2
+                batch<T, avx2> const x(detail::upper_half(self)), y(detail::upper_half(other));
+                return detail::merge_avx(zip_lo(x, y), zip_hi(x, y));
             }
             else if constexpr (sizeof(T) == 4)
             {
@@ -2960,15 +3032,11 @@ namespace xsimd
         XSIMD_INLINE batch<T, A>
         zip_lo(batch<T, A> const& self, batch<T, A> const& other, requires_arch<avx512f>) noexcept
         {
-            if constexpr (sizeof(T) == 1)
-            {
-                assert(false && "not implemented yet");
-                return {};
-            }
-            else if constexpr (sizeof(T) == 2)
+            if constexpr (sizeof(T) == 1 || sizeof(T) == 2)
             {
-                assert(false && "not implemented yet");
-                return {};
+                // no 8 and 16-bit permutes before AVX512BW: interleave the lower halves with AVX2
+                batch<T, avx2> const x(detail::lower_half(self)), y(detail::lower_half(other));
+                return detail::merge_avx(zip_lo(x, y), zip_hi(x, y));
             }
             else if constexpr (sizeof(T) == 4)
             {
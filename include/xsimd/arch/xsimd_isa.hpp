@@ -134,6 +134,14 @@
 #include "./xsimd_avx512vnni_avx512vbmi2.hpp"
 #endif
 
+#if XSIMD_WITH_AVX512VPOPCNTDQ
+#include "./xsimd_avx512vpopcntdq.hpp"
+#endif
+
+#if XSIMD_WITH_AVX512BITALG
+#include "./xsimd_avx512bitalg.hpp"
+#endif
+
 #if XSIMD_WITH_NEON
 #include "./xsimd_neon.hpp"
 #endif
@@ -24,6 +24,7 @@
 #include <array>
 #include <cassert>
 #include <complex>
+#include <limits>
 #include <type_traits>
 
 namespace xsimd
@@ -3454,38 +3455,171 @@ namespace xsimd
             return vreinterpretq_f32_u32(swizzle(batch<uint32_t, A>(vreinterpretq_u32_f32(self)), mask, A {}));
         }
 
+        /************
+         * popcount *
+         ************/
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<neon>) noexcept
+        {
+            // count per byte, then add adjacent bytes up to the lane width
+            uint8x16_t const bytes = vcntq_u8(::xsimd::bitwise_cast<uint8_t>(self));
+            if constexpr (sizeof(T) == 1)
+                return ::xsimd::bitwise_cast<T>(batch<uint8_t, A>(bytes));
+            else if constexpr (sizeof(T) == 2)
+                return ::xsimd::bitwise_cast<T>(batch<uint16_t, A>(vpaddlq_u8(bytes)));
+            else if constexpr (sizeof(T) == 4)
+                return ::xsimd::bitwise_cast<T>(batch<uint32_t, A>(vpaddlq_u16(vpaddlq_u8(bytes))));
+            else
+                return ::xsimd::bitwise_cast<T>(batch<uint64_t, A>(vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(bytes)))));
+        }
+
+        /***************
+         * countl_zero *
+         ***************/
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> countl_zero(batch<T, A> const& self, requires_arch<neon>) noexcept
+        {
+            using unsigned_type = as_unsigned_integer_t<T>;
+            if constexpr (sizeof(T) == 1)
+                return ::xsimd::bitwise_cast<T>(batch<unsigned_type, A>(vclzq_u8(::xsimd::bitwise_cast<unsigned_type>(self))));
+            else if constexpr (sizeof(T) == 2)
+                return ::xsimd::bitwise_cast<T>(batch<unsigned_type, A>(vclzq_u16(::xsimd::bitwise_cast<unsigned_type>(self))));
+            else if constexpr (sizeof(T) == 4)
+                return ::xsimd::bitwise_cast<T>(batch<unsigned_type, A>(vclzq_u32(::xsimd::bitwise_cast<unsigned_type>(self))));
+            else
+                return countl_zero(self, common {});
+        }
+
         /*********
          * widen *
          *********/
         template <class A, class T, detail::enable_sized_signed_t<T, 1> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_s8(vget_low_s8(x), vdup_n_s8(0))), batch<widen_t<T>, A>(vaddl_s8(vget_high_s8(x), vdup_n_s8(0))) };
+            return { batch<widen_t<T>, A>(vmovl_s8(vget_low_s8(x))), batch<widen_t<T>, A>(vmovl_s8(vget_high_s8(x))) };
         }
         template <class A, class T, detail::enable_sized_unsigned_t<T, 1> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_u8(vget_low_u8(x), vdup_n_u8(0))), batch<widen_t<T>, A>(vaddl_u8(vget_high_u8(x), vdup_n_u8(0))) };
+            return { batch<widen_t<T>, A>(vmovl_u8(vget_low_u8(x))), batch<widen_t<T>, A>(vmovl_u8(vget_high_u8(x))) };
         }
         template <class A, class T, detail::enable_sized_signed_t<T, 2> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_s16(vget_low_s16(x), vdup_n_s16(0))), batch<widen_t<T>, A>(vaddl_s16(vget_high_s16(x), vdup_n_s16(0))) };
+            return { batch<widen_t<T>, A>(vmovl_s16(vget_low_s16(x))), batch<widen_t<T>, A>(vmovl_s16(vget_high_s16(x))) };
         }
         template <class A, class T, detail::enable_sized_unsigned_t<T, 2> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_u16(vget_low_u16(x), vdup_n_u16(0))), batch<widen_t<T>, A>(vaddl_u16(vget_high_u16(x), vdup_n_u16(0))) };
+            return { batch<widen_t<T>, A>(vmovl_u16(vget_low_u16(x))), batch<widen_t<T>, A>(vmovl_u16(vget_high_u16(x))) };
         }
         template <class A, class T, detail::enable_sized_signed_t<T, 4> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_s32(vget_low_s32(x), vdup_n_s32(0))), batch<widen_t<T>, A>(vaddl_s32(vget_high_s32(x), vdup_n_s32(0))) };
+            return { batch<widen_t<T>, A>(vmovl_s32(vget_low_s32(x))), batch<widen_t<T>, A>(vmovl_s32(vget_high_s32(x))) };
         }
         template <class A, class T, detail::enable_sized_unsigned_t<T, 4> = 0>
         XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<neon>) noexcept
         {
-            return { batch<widen_t<T>, A>(vaddl_u32(vget_low_u32(x), vdup_n_u32(0))), batch<widen_t<T>, A>(vaddl_u32(vget_high_u32(x), vdup_n_u32(0))) };
+            return { batch<widen_t<T>, A>(vmovl_u32(vget_low_u32(x))), batch<widen_t<T>, A>(vmovl_u32(vget_high_u32(x))) };
+        }
+
+        /**********
+         * narrow *
+         **********/
+        template <class A, class T, detail::enable_sized_signed_t<T, 2> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_s8(vmovn_s16(lo), vmovn_s16(hi));
+        }
+        template <class A, class T, detail::enable_sized_unsigned_t<T, 2> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        }
+        template <class A, class T, detail::enable_sized_signed_t<T, 4> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+        }
+        template <class A, class T, detail::enable_sized_unsigned_t<T, 4> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+        }
+        template <class A, class T, detail::enable_sized_signed_t<T, 8> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_s32(vmovn_s64(lo), vmovn_s64(hi));
+        }
+        template <class A, class T, detail::enable_sized_unsigned_t<T, 8> = 0>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<neon>) noexcept
+        {
+            return vcombine_u32(vmovn_u64(lo), vmovn_u64(hi));
+        }
+
+        /*******************
+         * narrow_saturate *
+         *******************/
+        template <class A, class T, class T_out, detail::enable_sized_signed_t<T, 2> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_signed_v<T_out>)
+                return vcombine_s8(vqmovn_s16(lo), vqmovn_s16(hi));
+            else
+                return vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+        }
+        template <class A, class T, class T_out, detail::enable_sized_unsigned_t<T, 2> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_unsigned_v<T_out>)
+                return vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi));
+            else
+            {
+                // saturate to the unsigned range, then clamp to the signed one
+                auto const vmax = vdup_n_u8(std::numeric_limits<T_out>::max());
+                return vreinterpretq_s8_u8(vcombine_u8(vmin_u8(vqmovn_u16(lo), vmax), vmin_u8(vqmovn_u16(hi), vmax)));
+            }
+        }
+        template <class A, class T, class T_out, detail::enable_sized_signed_t<T, 4> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_signed_v<T_out>)
+                return vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+            else
+                return vcombine_u16(vqmovun_s32(lo), vqmovun_s32(hi));
+        }
+        template <class A, class T, class T_out, detail::enable_sized_unsigned_t<T, 4> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_unsigned_v<T_out>)
+                return vcombine_u16(vqmovn_u32(lo), vqmovn_u32(hi));
+            else
+            {
+                // saturate to the unsigned range, then clamp to the signed one
+                auto const vmax = vdup_n_u16(std::numeric_limits<T_out>::max());
+                return vreinterpretq_s16_u16(vcombine_u16(vmin_u16(vqmovn_u32(lo), vmax), vmin_u16(vqmovn_u32(hi), vmax)));
+            }
+        }
+        template <class A, class T, class T_out, detail::enable_sized_signed_t<T, 8> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_signed_v<T_out>)
+                return vcombine_s32(vqmovn_s64(lo), vqmovn_s64(hi));
+            else
+                return vcombine_u32(vqmovun_s64(lo), vqmovun_s64(hi));
+        }
+        template <class A, class T, class T_out, detail::enable_sized_unsigned_t<T, 8> = 0>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<neon>) noexcept
+        {
+            if constexpr (std::is_unsigned_v<T_out>)
+                return vcombine_u32(vqmovn_u64(lo), vqmovn_u64(hi));
+            else
+            {
+                // saturate to the unsigned range, then clamp to the signed one
+                auto const vmax = vdup_n_u32(std::numeric_limits<T_out>::max());
+                return vreinterpretq_s32_u32(vcombine_u32(vmin_u32(vqmovn_u64(lo), vmax), vmin_u32(vqmovn_u64(hi), vmax)));
+            }
         }
 
         /********
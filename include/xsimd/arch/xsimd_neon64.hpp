@@ -868,6 +868,36 @@ namespace xsimd
         }
 #endif
 
+#ifdef __ARM_FEATURE_COMPLEX
+        /*****************************************
+         * interleaved complex mul / fma (FCMLA) *
+         *****************************************/
+
+        template <class A>
+        XSIMD_INLINE batch<float, A> interleaved_fma(batch<float, A> const& x, batch<float, A> const& y, batch<float, A> const& z, requires_arch<neon64>) noexcept
+        {
+            return vcmlaq_rot90_f32(vcmlaq_f32(z, x, y), x, y);
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<double, A> interleaved_fma(batch<double, A> const& x, batch<double, A> const& y, batch<double, A> const& z, requires_arch<neon64>) noexcept
+        {
+            return vcmlaq_rot90_f64(vcmlaq_f64(z, x, y), x, y);
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<float, A> interleaved_mul(batch<float, A> const& x, batch<float, A> const& y, requires_arch<neon64>) noexcept
+        {
+            return interleaved_fma(x, y, batch<float, A>(0.f), A {});
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<double, A> interleaved_mul(batch<double, A> const& x, batch<double, A> const& y, requires_arch<neon64>) noexcept
+        {
+            return interleaved_fma(x, y, batch<double, A>(0.), A {});
+        }
+#endif
+
         /*********
          * haddp *
          *********/
@@ -1599,6 +1629,25 @@ namespace xsimd
             return batch<std::complex<double>>(swizzle(self.real(), idx, A()), swizzle(self.imag(), idx, A()));
         }
 
+        /***************
+         * countr_zero *
+         ***************/
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> countr_zero(batch<T, A> const& self, requires_arch<neon64>) noexcept
+        {
+            // reversing the bits of each byte then the bytes of each lane
+            // turns trailing zeros into leading ones
+            batch<T, A> const reversed = ::xsimd::bitwise_cast<T>(batch<uint8_t, A>(vrbitq_u8(::xsimd::bitwise_cast<uint8_t>(self))));
+            if constexpr (sizeof(T) == 1)
+                return countl_zero(reversed);
+            else if constexpr (sizeof(T) == 2)
+                return countl_zero(::xsimd::bitwise_cast<T>(batch<uint8_t, A>(vrev16q_u8(::xsimd::bitwise_cast<uint8_t>(reversed)))));
+            else if constexpr (sizeof(T) == 4)
+                return countl_zero(::xsimd::bitwise_cast<T>(batch<uint8_t, A>(vrev32q_u8(::xsimd::bitwise_cast<uint8_t>(reversed)))));
+            else
+                return countr_zero(self, common {});
+        }
+
         /*********
          * widen *
          *********/
@@ -1607,6 +1656,15 @@ namespace xsimd
         {
             return { batch<double, A>(vcvt_f64_f32(vget_low_f32(x))), batch<double, A>(vcvt_high_f64_f32(x)) };
         }
+
+        /**********
+         * narrow *
+         **********/
+        template <class A>
+        XSIMD_INLINE batch<float, A> narrow(batch<double, A> const& lo, batch<double, A> const& hi, requires_arch<neon64>) noexcept
+        {
+            return vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+        }
     }
 }
 
@@ -17,6 +17,7 @@
 #include "../utils/xsimd_type_traits.hpp"
 #include "./xsimd_constants.hpp"
 
+#include <array>
 #include <complex>
 #include <type_traits>
 
@@ -1267,6 +1268,30 @@ namespace xsimd
             }
         }
 
+        // widen
+        namespace detail_rvv
+        {
+            // extends to a register group of twice the width
+            template <class T, size_t W>
+            XSIMD_INLINE rvv_reg_t<widen_t<T>, W * 2> rvvwiden(rvv_reg_t<T, W> const& arg) noexcept
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                    return __riscv_vfwcvt_f(arg, arg.vl);
+                else if constexpr (std::is_signed_v<T>)
+                    return __riscv_vwcvt_x(arg, arg.vl);
+                else
+                    return __riscv_vwcvtu_x(arg, arg.vl);
+            }
+        }
+
+        template <class A, class T, std::enable_if_t<(std::is_integral_v<T> && sizeof(T) <= 4) || std::is_same_v<T, float>, int> = 0>
+        XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& arg, requires_arch<rvv>) noexcept
+        {
+            using wide_type = widen_t<T>;
+            detail_rvv::rvv_reg_t<wide_type, A::width * 2> const wide = detail_rvv::rvvwiden<T, A::width>(arg.data);
+            return { detail_rvv::rvvget_lo<wide_type, A::width>(wide), detail_rvv::rvvget_hi<wide_type, A::width>(wide) };
+        }
+
         /*********
          * Miscs *
          *********/
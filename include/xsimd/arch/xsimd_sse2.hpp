@@ -16,6 +16,7 @@
 #include "../types/xsimd_sse2_register.hpp"
 #include "./utils/shifts.hpp"
 
+#include <array>
 #include <complex>
 #include <limits>
 #include <type_traits>
@@ -1525,6 +1526,90 @@ namespace xsimd
             return _mm_cvtps_epi32(self);
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<sse2>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+            {
+                __m128i const mask = _mm_set1_epi16(0x00FF);
+                return _mm_packus_epi16(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+            }
+            else if constexpr (sizeof(T) == 4)
+            {
+                // sign extend the low halves, which packs then keeps as is
+                __m128i const lo_ext = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+                __m128i const hi_ext = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+                return _mm_packs_epi32(lo_ext, hi_ext);
+            }
+            else
+            {
+                return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+        }
+        template <class A>
+        XSIMD_INLINE batch<float, A> narrow(batch<double, A> const& lo, batch<double, A> const& hi, requires_arch<sse2>) noexcept
+        {
+            return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<sse2>) noexcept
+        {
+            if constexpr (sizeof(T) == 2 && std::is_signed_v<T>)
+            {
+                if constexpr (std::is_signed_v<T_out>)
+                    return _mm_packs_epi16(lo, hi);
+                else
+                    return _mm_packus_epi16(lo, hi);
+            }
+            else if constexpr (sizeof(T) == 2)
+            {
+                // x - (x -sat max) is min(x, max), which packus keeps as is
+                __m128i const vmax = _mm_set1_epi16(std::numeric_limits<T_out>::max());
+                return _mm_packus_epi16(_mm_sub_epi16(lo, _mm_subs_epu16(lo, vmax)), _mm_sub_epi16(hi, _mm_subs_epu16(hi, vmax)));
+            }
+            else if constexpr (sizeof(T) == 4 && std::is_signed_v<T> && std::is_signed_v<T_out>)
+            {
+                return _mm_packs_epi32(lo, hi);
+            }
+            else if constexpr (sizeof(T) == 8)
+            {
+                // no 64-bit comparisons: a lane is in range when its high
+                // half is the extension of its low half, as T_out
+                __m128i const low = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+                __m128i const high = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+                __m128i const low_sign = _mm_srai_epi32(low, 31);
+                __m128i in_range, saturated;
+                if constexpr (std::is_signed_v<T> && std::is_signed_v<T_out>)
+                {
+                    in_range = _mm_cmpeq_epi32(high, low_sign);
+                    saturated = _mm_xor_si128(_mm_srai_epi32(high, 31), _mm_set1_epi32(0x7FFFFFFF));
+                }
+                else if constexpr (std::is_signed_v<T>)
+                {
+                    in_range = _mm_cmpeq_epi32(high, _mm_setzero_si128());
+                    saturated = _mm_xor_si128(_mm_srai_epi32(high, 31), _mm_set1_epi32(-1));
+                }
+                else if constexpr (std::is_signed_v<T_out>)
+                {
+                    in_range = _mm_cmpeq_epi32(_mm_or_si128(high, low_sign), _mm_setzero_si128());
+                    saturated = _mm_set1_epi32(0x7FFFFFFF);
+                }
+                else
+                {
+                    in_range = _mm_cmpeq_epi32(high, _mm_setzero_si128());
+                    saturated = _mm_set1_epi32(-1);
+                }
+                return _mm_or_si128(_mm_and_si128(in_range, low), _mm_andnot_si128(in_range, saturated));
+            }
+            else
+            {
+                return narrow_saturate(lo, hi, convert<T_out> {}, common {});
+            }
+        }
+
         // neg
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> neg(batch<T, A> const& self, requires_arch<sse2>) noexcept
@@ -2231,12 +2316,12 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint32_t, A>* matrix_begin, batch<uint32_t, A>* matrix_end, requires_arch<sse2>) noexcept
         {
-            transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int32_t, A>* matrix_begin, batch<int32_t, A>* matrix_end, requires_arch<sse2>) noexcept
         {
-            transpose(reinterpret_cast<batch<float, A>*>(matrix_begin), reinterpret_cast<batch<float, A>*>(matrix_end), A {});
+            detail::transpose_as<float>(matrix_begin, matrix_end, A {});
         }
 
         template <class A>
@@ -2251,12 +2336,40 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE void transpose(batch<uint64_t, A>* matrix_begin, batch<uint64_t, A>* matrix_end, requires_arch<sse2>) noexcept
         {
-            transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
         }
         template <class A>
         XSIMD_INLINE void transpose(batch<int64_t, A>* matrix_begin, batch<int64_t, A>* matrix_end, requires_arch<sse2>) noexcept
         {
-            transpose(reinterpret_cast<batch<double, A>*>(matrix_begin), reinterpret_cast<batch<double, A>*>(matrix_end), A {});
+            detail::transpose_as<double>(matrix_begin, matrix_end, A {});
+        }
+
+        // widen
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) <= 4)>>
+        XSIMD_INLINE std::array<batch<widen_t<T>, A>, 2> widen(batch<T, A> const& x, requires_arch<sse2>) noexcept
+        {
+            // interleave each lane with its extension: its sign or zero
+            __m128i ext = _mm_setzero_si128();
+            if constexpr (std::is_signed_v<T>)
+            {
+                if constexpr (sizeof(T) == 1)
+                    ext = _mm_cmplt_epi8(x, ext);
+                else if constexpr (sizeof(T) == 2)
+                    ext = _mm_srai_epi16(x, 15);
+                else
+                    ext = _mm_srai_epi32(x, 31);
+            }
+            if constexpr (sizeof(T) == 1)
+                return { _mm_unpacklo_epi8(x, ext), _mm_unpackhi_epi8(x, ext) };
+            else if constexpr (sizeof(T) == 2)
+                return { _mm_unpacklo_epi16(x, ext), _mm_unpackhi_epi16(x, ext) };
+            else
+                return { _mm_unpacklo_epi32(x, ext), _mm_unpackhi_epi32(x, ext) };
+        }
+        template <class A>
+        XSIMD_INLINE std::array<batch<double, A>, 2> widen(batch<float, A> const& x, requires_arch<sse2>) noexcept
+        {
+            return { _mm_cvtps_pd(x), _mm_cvtps_pd(_mm_movehl_ps(x, x)) };
         }
 
         // zip_hi
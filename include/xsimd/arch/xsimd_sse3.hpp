@@ -23,6 +23,19 @@ namespace xsimd
     {
         using namespace types;
 
+        // fmas
+        template <class A>
+        XSIMD_INLINE batch<float, A> fmas(batch<float, A> const& x, batch<float, A> const& y, batch<float, A> const& z, requires_arch<sse3>) noexcept
+        {
+            return _mm_addsub_ps(_mm_mul_ps(x, y), z);
+        }
+
+        template <class A>
+        XSIMD_INLINE batch<double, A> fmas(batch<double, A> const& x, batch<double, A> const& y, batch<double, A> const& z, requires_arch<sse3>) noexcept
+        {
+            return _mm_addsub_pd(_mm_mul_pd(x, y), z);
+        }
+
         // haddp
         template <class A>
         XSIMD_INLINE batch<float, A> haddp(batch<float, A> const* row, requires_arch<sse3>) noexcept
@@ -15,6 +15,7 @@
 #include "../types/xsimd_sse4_1_register.hpp"
 #include "./common/xsimd_common_cast.hpp"
 
+#include <limits>
 #include <type_traits>
 
 namespace xsimd
@@ -416,6 +417,33 @@ namespace xsimd
             return _mm_round_pd(self, _MM_FROUND_TO_NEAREST_INT);
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 4>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<sse4_1>) noexcept
+        {
+            __m128i const mask = _mm_set1_epi32(0xFFFF);
+            return _mm_packus_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<sse4_1>) noexcept
+        {
+            if constexpr (sizeof(T) == 4 && std::is_signed_v<T> && std::is_unsigned_v<T_out>)
+            {
+                return _mm_packus_epi32(lo, hi);
+            }
+            else if constexpr (sizeof(T) == 4 && std::is_unsigned_v<T>)
+            {
+                __m128i const vmax = _mm_set1_epi32(std::numeric_limits<T_out>::max());
+                return _mm_packus_epi32(_mm_min_epu32(lo, vmax), _mm_min_epu32(hi, vmax));
+            }
+            else
+            {
+                return narrow_saturate(lo, hi, convert<T_out> {}, sse2 {});
+            }
+        }
+
         // select
         namespace detail
         {
@@ -429,7 +457,12 @@ namespace xsimd
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> select(batch_bool<T, A> const& cond, batch<T, A> const& true_br, batch<T, A> const& false_br, requires_arch<sse4_1>) noexcept
         {
+#if defined(XSIMD_BLENDV_EPI8_DROPS_NOT)
+            // a single vpternlog on these targets
+            return _mm_or_si128(_mm_and_si128(cond, true_br), _mm_andnot_si128(cond, false_br));
+#else
             return _mm_blendv_epi8(false_br, true_br, cond);
+#endif
         }
         template <class A>
         XSIMD_INLINE batch<float, A> select(batch_bool<float, A> const& cond, batch<float, A> const& true_br, batch<float, A> const& false_br, requires_arch<sse4_1>) noexcept
@@ -542,7 +575,7 @@ namespace xsimd
         template <class A>
         XSIMD_INLINE std::array<batch<double, A>, 2> widen(batch<float, A> const& x, requires_arch<sse4_1>) noexcept
         {
-            __m128 x_shuf = _mm_unpackhi_ps(x, x);
+            __m128 x_shuf = _mm_movehl_ps(x, x);
             __m128d lo = _mm_cvtps_pd(x);
             __m128d hi = _mm_cvtps_pd(x_shuf);
             return { lo, hi };
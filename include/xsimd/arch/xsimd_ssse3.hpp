@@ -82,6 +82,26 @@ namespace xsimd
             return detail::extract_pair(self, other, i, std::make_index_sequence<size>());
         }
 
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<ssse3>) noexcept
+        {
+            // count the bits of each nibble with a lookup, then sum the bytes
+            __m128i const lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            __m128i const low_mask = _mm_set1_epi8(0x0F);
+            __m128i const lo = _mm_and_si128(self, low_mask);
+            __m128i const hi = _mm_and_si128(_mm_srli_epi16(self, 4), low_mask);
+            __m128i const bytes = _mm_add_epi8(_mm_shuffle_epi8(lut, lo), _mm_shuffle_epi8(lut, hi));
+            if constexpr (sizeof(T) == 1)
+                return bytes;
+            else if constexpr (sizeof(T) == 2)
+                return _mm_maddubs_epi16(bytes, _mm_set1_epi8(1));
+            else if constexpr (sizeof(T) == 4)
+                return _mm_madd_epi16(_mm_maddubs_epi16(bytes, _mm_set1_epi8(1)), _mm_set1_epi16(1));
+            else
+                return _mm_sad_epu8(bytes, _mm_setzero_si128());
+        }
+
         // reduce_add
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE T reduce_add(batch<T, A> const& self, requires_arch<ssse3>) noexcept
@@ -49,6 +49,15 @@ namespace xsimd
                 template <class T>
                 XSIMD_INLINE svbool_t ptrue() noexcept { return ptrue_impl(index<sizeof(T)> {}); }
 
+                // predicate of the first n lanes
+                XSIMD_INLINE svbool_t whilelt_impl(uint64_t n, index<1>) noexcept { return svwhilelt_b8(uint64_t(0), n); }
+                XSIMD_INLINE svbool_t whilelt_impl(uint64_t n, index<2>) noexcept { return svwhilelt_b16(uint64_t(0), n); }
+                XSIMD_INLINE svbool_t whilelt_impl(uint64_t n, index<4>) noexcept { return svwhilelt_b32(uint64_t(0), n); }
+                XSIMD_INLINE svbool_t whilelt_impl(uint64_t n, index<8>) noexcept { return svwhilelt_b64(uint64_t(0), n); }
+
+                template <class T>
+                XSIMD_INLINE svbool_t whilelt(uint64_t n) noexcept { return whilelt_impl(n, index<sizeof(T)> {}); }
+
                 // count active lanes in a predicate
                 XSIMD_INLINE uint64_t pcount_impl(svbool_t p, index<1>) noexcept { return svcntp_b8(p, p); }
                 XSIMD_INLINE uint64_t pcount_impl(svbool_t p, index<2>) noexcept { return svcntp_b16(p, p); }
@@ -653,6 +662,30 @@ namespace xsimd
             return svasr_x(detail_sve::ptrue<T>(), lhs, detail_sve::to_unsigned_batch<A, T>(rhs));
         }
 
+        // popcount
+        template <class A, class T, detail::enable_integral_t<T> = 0>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& arg, requires_arch<sve>) noexcept
+        {
+            using unsigned_batch = batch<as_unsigned_integer_t<T>, A>;
+            return ::xsimd::bitwise_cast<T>(unsigned_batch(svcnt_x(detail_sve::ptrue<T>(), arg)));
+        }
+
+        // countl_zero
+        template <class A, class T, detail::enable_integral_t<T> = 0>
+        XSIMD_INLINE batch<T, A> countl_zero(batch<T, A> const& arg, requires_arch<sve>) noexcept
+        {
+            using unsigned_batch = batch<as_unsigned_integer_t<T>, A>;
+            return ::xsimd::bitwise_cast<T>(unsigned_batch(svclz_x(detail_sve::ptrue<T>(), arg)));
+        }
+
+        // countr_zero
+        template <class A, class T, detail::enable_integral_t<T> = 0>
+        XSIMD_INLINE batch<T, A> countr_zero(batch<T, A> const& arg, requires_arch<sve>) noexcept
+        {
+            using unsigned_batch = batch<as_unsigned_integer_t<T>, A>;
+            return ::xsimd::bitwise_cast<T>(unsigned_batch(svclz_x(detail_sve::ptrue<T>(), svrbit_x(detail_sve::ptrue<T>(), arg))));
+        }
+
         /**************
          * Reductions *
          **************/
@@ -975,6 +1008,13 @@ namespace xsimd
             return svcmpne(detail_sve::ptrue<T>(), values, zero);
         }
 
+        // first_n
+        template <class A, class T>
+        XSIMD_INLINE batch_bool<T, A> first_n(batch_bool<T, A> const&, std::size_t n, requires_arch<sve>) noexcept
+        {
+            return detail_sve::whilelt<T>(static_cast<uint64_t>(n));
+        }
+
         // insert
         namespace detail_sve
         {
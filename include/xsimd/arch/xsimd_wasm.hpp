@@ -16,6 +16,7 @@
 #include "../types/xsimd_wasm_register.hpp"
 #include "./common/xsimd_common_cast.hpp"
 
+#include <limits>
 #include <type_traits>
 
 namespace xsimd
@@ -1092,6 +1093,49 @@ namespace xsimd
             return wasm_f64x2_mul(self, other);
         }
 
+        // narrow
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>>
+        XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi, requires_arch<wasm>) noexcept
+        {
+            if constexpr (sizeof(T) == 2)
+                return wasm_i8x16_shuffle(lo, hi, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            else if constexpr (sizeof(T) == 4)
+                return wasm_i16x8_shuffle(lo, hi, 0, 2, 4, 6, 8, 10, 12, 14);
+            else
+                return wasm_i32x4_shuffle(lo, hi, 0, 2, 4, 6);
+        }
+        template <class A>
+        XSIMD_INLINE batch<float, A> narrow(batch<double, A> const& lo, batch<double, A> const& hi, requires_arch<wasm>) noexcept
+        {
+            return wasm_i64x2_shuffle(wasm_f32x4_demote_f64x2_zero(lo), wasm_f32x4_demote_f64x2_zero(hi), 0, 2);
+        }
+
+        // narrow_saturate
+        template <class A, class T, class T_out, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi, convert<T_out>, requires_arch<wasm>) noexcept
+        {
+            if constexpr (sizeof(T) == 8)
+            {
+                return narrow_saturate(lo, hi, convert<T_out> {}, common {});
+            }
+            else
+            {
+                // the narrowing instructions read signed inputs: clamp
+                // unsigned ones to the signed maximum first
+                v128_t x = lo, y = hi;
+                if constexpr (std::is_unsigned_v<T>)
+                {
+                    v128_t const vmax = sizeof(T) == 2 ? wasm_u16x8_splat(std::numeric_limits<T_out>::max()) : wasm_u32x4_splat(std::numeric_limits<T_out>::max());
+                    x = sizeof(T) == 2 ? wasm_u16x8_min(x, vmax) : wasm_u32x4_min(x, vmax);
+                    y = sizeof(T) == 2 ? wasm_u16x8_min(y, vmax) : wasm_u32x4_min(y, vmax);
+                }
+                if constexpr (sizeof(T) == 2)
+                    return std::is_signed_v<T_out> ? wasm_i8x16_narrow_i16x8(x, y) : wasm_u8x16_narrow_i16x8(x, y);
+                else
+                    return std::is_signed_v<T_out> ? wasm_i16x8_narrow_i32x4(x, y) : wasm_u16x8_narrow_i32x4(x, y);
+            }
+        }
+
         // neg
         template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
         XSIMD_INLINE batch<T, A> neg(batch<T, A> const& self, requires_arch<wasm>) noexcept
@@ -1164,6 +1208,25 @@ namespace xsimd
             return wasm_v128_xor(self, other);
         }
 
+        // popcount
+        template <class A, class T, class = std::enable_if_t<std::is_integral_v<T>>>
+        XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& self, requires_arch<wasm>) noexcept
+        {
+            v128_t const bytes = wasm_i8x16_popcnt(self);
+            if constexpr (sizeof(T) == 1)
+                return bytes;
+            else if constexpr (sizeof(T) == 2)
+                return wasm_u16x8_extadd_pairwise_u8x16(bytes);
+            else
+            {
+                v128_t const words = wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(bytes));
+                if constexpr (sizeof(T) == 4)
+                    return words;
+                else
+                    return wasm_v128_and(wasm_i64x2_add(words, wasm_u64x2_shr(words, 32)), wasm_i64x2_splat(0xFF));
+            }
+        }
+
         // reciprocal
         template <class A>
         XSIMD_INLINE batch<float, A> reciprocal(batch<float, A> const& self, requires_arch<wasm>) noexcept
@@ -145,7 +145,7 @@ namespace xsimd
     } // namespace detail
 
     using all_x86_architectures = arch_list<
-        avx512vnni<avx512vbmi2>, avx512vbmi2, avx512vbmi, avx512ifma, avx512pf, avx512vnni<avx512bw>, avx512bw, avx512er, avx512dq, avx512vl, avx512cd, avx512f,
+        avx512bitalg, avx512vpopcntdq, avx512vnni<avx512vbmi2>, avx512vbmi2, avx512vbmi, avx512ifma, avx512pf, avx512vnni<avx512bw>, avx512bw, avx512er, avx512dq, avx512vl, avx512cd, avx512f,
         avx512vl_256, avxvnni, fma3<avx2>, avx2, fma3<avx>, avx, avx512vl_128, avx2_128, avx_128, fma4, fma3<sse4_2>,
         sse4_2, sse4_1, /*sse4a,*/ ssse3, sse3, sse2>;
 
@@ -220,6 +220,81 @@ namespace xsimd
         return { std::forward<F>(f) };
     }
 
+    template <class Signature, class ArchList = supported_architectures>
+    class dispatch_table;
+
+    /**
+     * @ingroup architectures
+     *
+     * Function pointer resolved once, at construction, to the implementation
+     * of a stateless kernel functor for the best architecture from \c ArchList
+     * available at runtime. Unlike xsimd::dispatch, calls do not walk the
+     * architecture list, which makes a \c static dispatch_table suitable as a
+     * registry for kernels compiled per architecture with
+     * \c xsimd_add_multiversion.
+     *
+     * @tparam R return type of the kernel.
+     * @tparam Args argument types of the kernel, the architecture tag excluded.
+     * @tparam Archs architectures to pick from, most capable first.
+     */
+    template <class R, class... Args, class... Archs>
+    class dispatch_table<R(Args...), arch_list<Archs...>>
+    {
+    public:
+        using function_type = R (*)(Args...);
+
+        template <class F>
+        explicit dispatch_table(F) noexcept
+        {
+            static_assert(std::is_empty_v<F> && std::is_default_constructible_v<F>,
+                          "dispatch_table requires a stateless functor");
+            resolve<F>(available_architectures(), arch_list<Archs...> {});
+        }
+
+        XSIMD_INLINE R operator()(Args... args) const
+        {
+            return m_function(std::forward<Args>(args)...);
+        }
+
+        /// Returns the resolved implementation.
+        function_type function() const noexcept { return m_function; }
+
+        /// Returns the name of the architecture the table resolved to.
+        char const* arch_name() const noexcept { return m_arch_name; }
+
+    private:
+        template <class F, class Arch>
+        static R call(Args... args)
+        {
+            return F {}(Arch {}, std::forward<Args>(args)...);
+        }
+
+        template <class F, class Arch>
+        void resolve(detail::supported_arch const&, arch_list<Arch>) noexcept
+        {
+            assert(Arch::available() && "At least one arch must be supported during dispatch");
+            m_function = &call<F, Arch>;
+            m_arch_name = Arch::name();
+        }
+
+        template <class F, class Arch, class ArchNext, class... Rest>
+        void resolve(detail::supported_arch const& availables_archs, arch_list<Arch, ArchNext, Rest...>) noexcept
+        {
+            if (availables_archs.has(Arch {}))
+            {
+                m_function = &call<F, Arch>;
+                m_arch_name = Arch::name();
+            }
+            else
+            {
+                resolve<F>(availables_archs, arch_list<ArchNext, Rest...> {});
+            }
+        }
+
+        function_type m_function = nullptr;
+        char const* m_arch_name = nullptr;
+    };
+
 } // namespace xsimd
 
 #endif
@@ -340,6 +340,13 @@
 #define XSIMD_WITH_AVX512BW 0
 #endif
 
+// With AVX512BW and AVX512VL enabled, GCC (seen with 12.2) folds a byte
+// blend on the complement of a mask, _mm_blendv_epi8(a, b, m ^ ones), into
+// the blend on m itself, and picks the wrong operand in every lane
+#if XSIMD_WITH_AVX512BW && XSIMD_WITH_AVX512VL && defined(__GNUC__) && !defined(__clang__)
+#define XSIMD_BLENDV_EPI8_DROPS_NOT 1
+#endif
+
 /**
  * @ingroup xsimd_config_macro
  *
@@ -417,6 +424,28 @@
 
 #endif
 
+/**
+ * @ingroup xsimd_config_macro
+ *
+ * Set to 1 if AVX512VPOPCNTDQ is available at compile-time, to 0 otherwise.
+ */
+#ifdef __AVX512VPOPCNTDQ__
+#define XSIMD_WITH_AVX512VPOPCNTDQ XSIMD_WITH_AVX512VNNI_AVX512VBMI2
+#else
+#define XSIMD_WITH_AVX512VPOPCNTDQ 0
+#endif
+
+/**
+ * @ingroup xsimd_config_macro
+ *
+ * Set to 1 if AVX512BITALG is available at compile-time, to 0 otherwise.
+ */
+#ifdef __AVX512BITALG__
+#define XSIMD_WITH_AVX512BITALG XSIMD_WITH_AVX512VPOPCNTDQ
+#else
+#define XSIMD_WITH_AVX512BITALG 0
+#endif
+
 /**
  * @ingroup xsimd_config_macro
  *
@@ -626,7 +655,7 @@
 
 #endif
 
-#if !XSIMD_WITH_SSE2 && !XSIMD_WITH_SSE3 && !XSIMD_WITH_SSSE3 && !XSIMD_WITH_SSE4_1 && !XSIMD_WITH_SSE4_2 && !XSIMD_WITH_AVX && !XSIMD_WITH_AVX2 && !XSIMD_WITH_AVXVNNI && !XSIMD_WITH_FMA3_SSE && !XSIMD_WITH_FMA4 && !XSIMD_WITH_FMA3_AVX && !XSIMD_WITH_FMA3_AVX2 && !XSIMD_WITH_AVX512F && !XSIMD_WITH_AVX512CD && !XSIMD_WITH_AVX512VL && !XSIMD_WITH_AVX512DQ && !XSIMD_WITH_AVX512BW && !XSIMD_WITH_AVX512ER && !XSIMD_WITH_AVX512PF && !XSIMD_WITH_AVX512IFMA && !XSIMD_WITH_AVX512VBMI && !XSIMD_WITH_AVX512VBMI2 && !XSIMD_WITH_NEON && !XSIMD_WITH_NEON64 && !XSIMD_WITH_SVE && !XSIMD_WITH_RVV && !XSIMD_WITH_WASM && !XSIMD_WITH_VSX && !XSIMD_WITH_EMULATED && !XSIMD_WITH_VXE
+#if !XSIMD_WITH_SSE2 && !XSIMD_WITH_SSE3 && !XSIMD_WITH_SSSE3 && !XSIMD_WITH_SSE4_1 && !XSIMD_WITH_SSE4_2 && !XSIMD_WITH_AVX && !XSIMD_WITH_AVX2 && !XSIMD_WITH_AVXVNNI && !XSIMD_WITH_FMA3_SSE && !XSIMD_WITH_FMA4 && !XSIMD_WITH_FMA3_AVX && !XSIMD_WITH_FMA3_AVX2 && !XSIMD_WITH_AVX512F && !XSIMD_WITH_AVX512CD && !XSIMD_WITH_AVX512VL && !XSIMD_WITH_AVX512DQ && !XSIMD_WITH_AVX512BW && !XSIMD_WITH_AVX512ER && !XSIMD_WITH_AVX512PF && !XSIMD_WITH_AVX512IFMA && !XSIMD_WITH_AVX512VBMI && !XSIMD_WITH_AVX512VBMI2 && !XSIMD_WITH_AVX512VPOPCNTDQ && !XSIMD_WITH_AVX512BITALG && !XSIMD_WITH_NEON && !XSIMD_WITH_NEON64 && !XSIMD_WITH_SVE && !XSIMD_WITH_RVV && !XSIMD_WITH_WASM && !XSIMD_WITH_VSX && !XSIMD_WITH_EMULATED && !XSIMD_WITH_VXE
 #define XSIMD_NO_SUPPORTED_ARCHITECTURE
 #endif
 
@@ -0,0 +1,393 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_CPU_TOPOLOGY_HPP
+#define XSIMD_CPU_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "./xsimd_config.hpp"
+#include "./xsimd_cpu_features_x86.hpp"
+
+#if defined(__linux__)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <sys/types.h>
+#endif
+
+namespace xsimd
+{
+    /**
+     * @ingroup architectures
+     *
+     * Description of one level of data cache. A field equal to zero means the
+     * corresponding property could not be detected.
+     */
+    struct cache_info
+    {
+        /// Total size of the cache, in bytes.
+        std::size_t size = 0;
+        /// Size of a cache line, in bytes.
+        std::size_t line_size = 0;
+        /// Number of ways, zero for unknown or fully associative caches.
+        std::size_t associativity = 0;
+        /// Number of logical processors sharing this cache, an upper bound on x86.
+        std::size_t shared_by = 0;
+    };
+
+    /**
+     * @ingroup architectures
+     *
+     * Cache hierarchy and core counts of the running processor, meant to size
+     * the tiles and blocks of cache-aware kernels.
+     *
+     * @see xsimd::available_topology
+     */
+    struct cpu_topology
+    {
+        /// Level 1 data cache.
+        cache_info l1d;
+        /// Level 2 unified (or data) cache.
+        cache_info l2;
+        /// Level 3 unified (or data) cache.
+        cache_info l3;
+        /// Number of logical processors online.
+        std::size_t logical_cores = 0;
+        /// Number of physical cores, logical processors sharing a core counted once.
+        std::size_t physical_cores = 0;
+        /// Number of logical processors per physical core.
+        std::size_t threads_per_core = 0;
+
+        /// Returns the cache line size, 64 when it could not be detected.
+        constexpr std::size_t cache_line_size() const noexcept
+        {
+            return l1d.line_size != 0 ? l1d.line_size : 64;
+        }
+
+        /// Returns the size in bytes of the data cache at \c level (1 to 3), 0 if unknown.
+        constexpr std::size_t cache_size(int level) const noexcept
+        {
+            switch (level)
+            {
+            case 1:
+                return l1d.size;
+            case 2:
+                return l2.size;
+            case 3:
+                return l3.size;
+            default:
+                return 0;
+            }
+        }
+    };
+
+    namespace detail
+    {
+        inline cache_info* topology_level(cpu_topology& topo, unsigned level) noexcept
+        {
+            switch (level)
+            {
+            case 1:
+                return &topo.l1d;
+            case 2:
+                return &topo.l2;
+            case 3:
+                return &topo.l3;
+            default:
+                return nullptr;
+            }
+        }
+
+#if XSIMD_TARGET_X86
+        // Ways encoded in the L2 and L3 associativity fields of cpuid leaf
+        // 0x80000006; 0 for disabled, reserved or fully associative.
+        inline std::size_t amd_legacy_ways(unsigned code) noexcept
+        {
+            constexpr unsigned char ways[16] = { 0, 1, 2, 0, 4, 6, 8, 0, 16, 0, 32, 48, 64, 96, 128, 0 };
+            return ways[code & 0xF];
+        }
+
+        /**
+         * Reads the L1 data, L2 and L3 caches from the legacy AMD leaves
+         * 0x80000005 and 0x80000006, for processors without the topology
+         * extensions. They do not tell how many processors share a cache.
+         */
+        inline bool amd_legacy_cache_topology(cpu_topology& topo) noexcept
+        {
+            auto const ext_max = x86_cpuid(static_cast<int>(0x80000000))[0];
+            if (ext_max >= 0x80000005u)
+            {
+                auto const l1 = x86_cpuid(static_cast<int>(0x80000005))[2];
+                unsigned const ways = (l1 >> 16) & 0xFF;
+                topo.l1d.size = std::size_t((l1 >> 24) & 0xFF) * 1024;
+                topo.l1d.line_size = l1 & 0xFF;
+                topo.l1d.associativity = ways == 0xFF ? 0 : ways;
+            }
+            if (ext_max >= 0x80000006u)
+            {
+                auto const regs = x86_cpuid(static_cast<int>(0x80000006));
+                unsigned const l2 = regs[2], l3 = regs[3];
+                if (((l2 >> 12) & 0xF) != 0)
+                {
+                    topo.l2.size = std::size_t((l2 >> 16) & 0xFFFF) * 1024;
+                    topo.l2.line_size = l2 & 0xFF;
+                    topo.l2.associativity = amd_legacy_ways((l2 >> 12) & 0xF);
+                }
+                if (((l3 >> 12) & 0xF) != 0)
+                {
+                    topo.l3.size = std::size_t((l3 >> 18) & 0x3FFF) * 512 * 1024;
+                    topo.l3.line_size = l3 & 0xFF;
+                    topo.l3.associativity = amd_legacy_ways((l3 >> 12) & 0xF);
+                }
+            }
+            return topo.l1d.size != 0;
+        }
+#endif
+
+        /**
+         * Reads the deterministic cache parameters from cpuid leaf 4 (Intel) or
+         * 0x8000001D (AMD). Both leaves share the same layout and enumerate one
+         * cache per subleaf until a null cache type is returned. AMD processors
+         * without that leaf fall back to the legacy cache leaves.
+         */
+        inline bool x86_cache_topology(cpu_topology& topo) noexcept
+        {
+#if XSIMD_TARGET_X86
+            auto const leaf0 = x86_cpuid_leaf0::read();
+            auto const max_leaf = leaf0.highest_leaf();
+            auto const manufacturer = x86_parse_manufacturer(leaf0.manufacturer_id_raw());
+            bool const amd = manufacturer == x86_manufacturer::amd || manufacturer == x86_manufacturer::hygon;
+
+            int leaf = 0;
+            if (amd)
+            {
+                auto const ext_max = x86_cpuid(static_cast<int>(0x80000000))[0];
+                // topology extensions bit
+                if (ext_max >= 0x8000001Du && ((x86_cpuid(static_cast<int>(0x80000001))[2] >> 22) & 1))
+                    leaf = static_cast<int>(0x8000001D);
+            }
+            else if (max_leaf >= 4)
+            {
+                leaf = 4;
+            }
+            if (leaf == 0)
+                return amd && amd_legacy_cache_topology(topo);
+
+            bool found = false;
+            for (int subleaf = 0; subleaf < 16; ++subleaf)
+            {
+                auto const regs = x86_cpuid(leaf, subleaf);
+                unsigned const type = regs[0] & 0x1F;
+                if (type == 0)
+                    break;
+                // 1 is data, 2 is instruction and 3 is unified
+                if (type == 2)
+                    continue;
+                cache_info* info = topology_level(topo, (regs[0] >> 5) & 0x7);
+                if (info == nullptr)
+                    continue;
+                std::size_t const line = (regs[1] & 0xFFF) + 1;
+                std::size_t const partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+                std::size_t const ways = ((regs[1] >> 22) & 0x3FF) + 1;
+                std::size_t const sets = std::size_t(regs[2]) + 1;
+                bool const fully_associative = (regs[0] >> 9) & 1;
+                info->size = ways * partitions * line * sets;
+                info->line_size = line;
+                info->associativity = fully_associative ? 0 : ways;
+                info->shared_by = ((regs[0] >> 14) & 0xFFF) + 1;
+                found = true;
+            }
+
+            // SMT level of the extended topology leaf
+            if (max_leaf >= 0xB)
+            {
+                auto const regs = x86_cpuid(0xB, 0);
+                if (((regs[2] >> 8) & 0xFF) == 1)
+                    topo.threads_per_core = regs[1] & 0xFFFF;
+            }
+            return found;
+#else
+            (void)topo;
+            return false;
+#endif
+        }
+
+#if defined(__linux__)
+        inline bool read_sysfs_line(char const* path, char* buffer, std::size_t size) noexcept
+        {
+            std::FILE* file = std::fopen(path, "r");
+            if (file == nullptr)
+                return false;
+            bool const ok = std::fgets(buffer, static_cast<int>(size), file) != nullptr;
+            std::fclose(file);
+            return ok;
+        }
+
+        // Parses sizes such as "32K", "2048K" or "8M".
+        inline std::size_t parse_sysfs_size(char const* str) noexcept
+        {
+            char* end = nullptr;
+            std::size_t value = std::strtoull(str, &end, 10);
+            if (end != nullptr && (*end == 'K' || *end == 'k'))
+                value *= 1024;
+            else if (end != nullptr && (*end == 'M' || *end == 'm'))
+                value *= 1024 * 1024;
+            return value;
+        }
+
+        // Counts the CPUs in a list such as "0-3,8-11".
+        inline std::size_t count_sysfs_cpu_list(char const* str) noexcept
+        {
+            std::size_t count = 0;
+            char* end = nullptr;
+            while (*str != '\0' && *str != '\n')
+            {
+                unsigned long first = std::strtoul(str, &end, 10);
+                if (end == str)
+                    break;
+                unsigned long last = first;
+                if (*end == '-')
+                {
+                    str = end + 1;
+                    last = std::strtoul(str, &end, 10);
+                }
+                count += last >= first ? last - first + 1 : 0;
+                str = *end == ',' ? end + 1 : end;
+            }
+            return count;
+        }
+
+        /**
+         * Reads the cache hierarchy of cpu0 and the online CPU count from
+         * /sys/devices/system/cpu, which covers ARM, RISC-V and the other
+         * targets without a cpuid equivalent.
+         */
+        inline bool sysfs_cache_topology(cpu_topology& topo) noexcept
+        {
+            char path[128];
+            char buffer[256];
+            bool found = false;
+            for (int index = 0; index < 16; ++index)
+            {
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+                if (!read_sysfs_line(path, buffer, sizeof(buffer)))
+                    break;
+                cache_info* info = topology_level(topo, static_cast<unsigned>(std::atoi(buffer)));
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+                if (info == nullptr || !read_sysfs_line(path, buffer, sizeof(buffer)) || std::strncmp(buffer, "Instruction", 11) == 0)
+                    continue;
+
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+                if (read_sysfs_line(path, buffer, sizeof(buffer)))
+                    info->size = parse_sysfs_size(buffer);
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", index);
+                if (read_sysfs_line(path, buffer, sizeof(buffer)))
+                    info->line_size = std::strtoull(buffer, nullptr, 10);
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/ways_of_associativity", index);
+                if (read_sysfs_line(path, buffer, sizeof(buffer)))
+                    info->associativity = std::strtoull(buffer, nullptr, 10);
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/shared_cpu_list", index);
+                if (read_sysfs_line(path, buffer, sizeof(buffer)))
+                    info->shared_by = count_sysfs_cpu_list(buffer);
+                found = found || info->size != 0;
+            }
+
+            if (read_sysfs_line("/sys/devices/system/cpu/online", buffer, sizeof(buffer)))
+                topo.logical_cores = count_sysfs_cpu_list(buffer);
+            if (topo.threads_per_core == 0 && read_sysfs_line("/sys/devices/system/cpu/cpu0/topology/thread_siblings_list", buffer, sizeof(buffer)))
+                topo.threads_per_core = count_sysfs_cpu_list(buffer);
+            return found;
+        }
+#elif defined(__APPLE__)
+        inline std::size_t apple_sysctl(char const* name) noexcept
+        {
+            std::int64_t value = 0;
+            std::size_t size = sizeof(value);
+            if (sysctlbyname(name, &value, &size, nullptr, 0) != 0)
+                return 0;
+            return static_cast<std::size_t>(value);
+        }
+
+        inline bool apple_cache_topology(cpu_topology& topo) noexcept
+        {
+            std::size_t const line = apple_sysctl("hw.cachelinesize");
+            topo.l1d.size = apple_sysctl("hw.l1dcachesize");
+            topo.l2.size = apple_sysctl("hw.l2cachesize");
+            topo.l3.size = apple_sysctl("hw.l3cachesize");
+            for (cache_info* info : { &topo.l1d, &topo.l2, &topo.l3 })
+            {
+                if (info->size != 0)
+                    info->line_size = line;
+            }
+            topo.logical_cores = apple_sysctl("hw.logicalcpu");
+            topo.physical_cores = apple_sysctl("hw.physicalcpu");
+            return topo.l1d.size != 0;
+        }
+#endif
+
+        inline cpu_topology detect_topology() noexcept
+        {
+            cpu_topology topo;
+            bool found = x86_cache_topology(topo);
+#if defined(__linux__)
+            if (!found)
+            {
+                sysfs_cache_topology(topo);
+            }
+            else
+            {
+                cpu_topology from_sysfs;
+                sysfs_cache_topology(from_sysfs);
+                topo.logical_cores = from_sysfs.logical_cores;
+                if (topo.threads_per_core == 0)
+                    topo.threads_per_core = from_sysfs.threads_per_core;
+            }
+#elif defined(__APPLE__)
+            if (!found)
+                apple_cache_topology(topo);
+#endif
+            (void)found;
+
+            if (topo.logical_cores == 0)
+                topo.logical_cores = std::thread::hardware_concurrency();
+            if (topo.threads_per_core == 0 && topo.physical_cores != 0 && topo.logical_cores != 0)
+                topo.threads_per_core = topo.logical_cores / topo.physical_cores;
+            if (topo.threads_per_core == 0)
+                topo.threads_per_core = 1;
+            if (topo.physical_cores == 0)
+                topo.physical_cores = topo.logical_cores / topo.threads_per_core;
+            return topo;
+        }
+    } // namespace detail
+
+    /**
+     * @ingroup architectures
+     *
+     * Returns the cache hierarchy and core counts of the running processor.
+     * The detection runs once, on first call, from cpuid on x86 and from
+     * the operating system elsewhere (/sys/devices/system/cpu on Linux,
+     * sysctl on macOS). Properties that could not be detected are zero.
+     *
+     * @see xsimd::available_architectures
+     */
+    inline cpu_topology const& available_topology() noexcept
+    {
+        static cpu_topology const topology = detail::detect_topology();
+        return topology;
+    }
+}
+
+#endif
@@ -59,6 +59,8 @@ namespace xsimd
             ARCH_FIELD(avx512vbmi2)
             ARCH_FIELD_EX(avx512vnni<::xsimd::avx512bw>, avx512vnni_bw)
             ARCH_FIELD_EX(avx512vnni<::xsimd::avx512vbmi2>, avx512vnni_vbmi2)
+            ARCH_FIELD(avx512vpopcntdq)
+            ARCH_FIELD(avx512bitalg)
             ARCH_FIELD(neon)
             ARCH_FIELD(neon64)
             ARCH_FIELD_EX(i8mm<::xsimd::neon64>, i8mm_neon64)
@@ -132,6 +134,8 @@ namespace xsimd
                 avx512vbmi2 = cpu.avx512vbmi2();
                 avx512vnni_bw = cpu.avx512vnni_bw();
                 avx512vnni_vbmi2 = avx512vbmi2 && avx512vnni_bw;
+                avx512vpopcntdq = avx512vnni_vbmi2 && cpu.avx512_vpopcntdq();
+                avx512bitalg = avx512vpopcntdq && cpu.avx512_bitalg();
             }
         };
     } // namespace detail
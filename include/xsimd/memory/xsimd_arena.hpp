@@ -0,0 +1,382 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_ARENA_HPP
+#define XSIMD_ARENA_HPP
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "./xsimd_alignment.hpp"
+
+namespace xsimd
+{
+    namespace detail
+    {
+        using arena_default_arch = std::conditional_t<std::is_same_v<unsupported, default_arch>, common, default_arch>;
+    }
+
+    /**
+     * @class arena_resource
+     * @brief Monotonic memory resource handing out batch-aligned blocks.
+     *
+     * The arena_resource class template is a <tt>std::pmr::memory_resource</tt>
+     * that carves allocations out of large chunks obtained from an upstream
+     * resource. Every block is aligned on at least <tt>A::alignment()</tt>, so
+     * that it can be accessed with aligned batch loads and stores.
+     * Deallocation is a no-op: memory is reclaimed all at once by reset(),
+     * which keeps the chunks for reuse and runs in constant time, or by
+     * release(), which returns the chunks to the upstream resource.
+     *
+     * @tparam A architecture whose alignment is used as the minimal alignment.
+     */
+    template <class A = detail::arena_default_arch>
+    class arena_resource : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @struct marker
+         * @brief Position in an arena, obtained by mark() and restored by rewind().
+         */
+        struct marker
+        {
+            void* chunk;
+            char* cursor;
+        };
+
+        static constexpr std::size_t min_alignment = A::alignment() < alignof(std::max_align_t) ? alignof(std::max_align_t) : A::alignment();
+
+        explicit arena_resource(std::size_t initial_size = 64 * 1024,
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+        arena_resource(arena_resource const&) = delete;
+        arena_resource& operator=(arena_resource const&) = delete;
+        ~arena_resource() override;
+
+        void reset() noexcept;
+        void release() noexcept;
+
+        marker mark() const noexcept;
+        void rewind(marker const& m) noexcept;
+
+        std::size_t capacity() const noexcept;
+        std::pmr::memory_resource* upstream_resource() const noexcept;
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+    private:
+        struct chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+        static constexpr std::size_t header_size = (sizeof(chunk) + min_alignment - 1) / min_alignment * min_alignment;
+
+        static char* chunk_begin(chunk* c) noexcept;
+        static char* chunk_end(chunk* c) noexcept;
+        void enter(chunk* c) noexcept;
+
+        std::pmr::memory_resource* m_upstream;
+        std::size_t m_next_size;
+        chunk* m_head = nullptr;
+        chunk* m_current = nullptr;
+        char* m_cursor = nullptr;
+        char* m_end = nullptr;
+    };
+
+    /**
+     * @class pmr_aligned_allocator
+     * @brief Polymorphic allocator requesting aligned memory.
+     *
+     * The pmr_aligned_allocator class template behaves like
+     * <tt>std::pmr::polymorphic_allocator</tt> but requests blocks aligned on
+     * \c Align from its memory resource, so that containers using it are
+     * recognized as aligned by container_alignment.
+     *
+     * @tparam T type of objects to allocate.
+     * @tparam Align alignment in bytes.
+     */
+    template <class T, std::size_t Align = detail::arena_default_arch::alignment()>
+    class pmr_aligned_allocator : public std::pmr::polymorphic_allocator<T>
+    {
+        using base_type = std::pmr::polymorphic_allocator<T>;
+
+    public:
+        using value_type = T;
+
+        static constexpr std::size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+        template <class U>
+        struct rebind
+        {
+            using other = pmr_aligned_allocator<U, Align>;
+        };
+
+        pmr_aligned_allocator() noexcept = default;
+
+        pmr_aligned_allocator(std::pmr::memory_resource* resource) noexcept
+            : base_type(resource)
+        {
+        }
+
+        template <class U>
+        pmr_aligned_allocator(pmr_aligned_allocator<U, Align> const& other) noexcept
+            : base_type(other.resource())
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(this->resource()->allocate(n * sizeof(T), alignment));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            this->resource()->deallocate(p, n * sizeof(T), alignment);
+        }
+
+        pmr_aligned_allocator select_on_container_copy_construction() const noexcept
+        {
+            return pmr_aligned_allocator();
+        }
+    };
+
+    template <class T, std::size_t N>
+    struct allocator_alignment<pmr_aligned_allocator<T, N>>
+    {
+        using type = aligned_mode;
+    };
+
+    namespace pmr
+    {
+        /**
+         * Vector using pmr_aligned_allocator, the aligned counterpart of
+         * <tt>std::pmr::vector</tt>.
+         */
+        template <class T, std::size_t Align = detail::arena_default_arch::alignment()>
+        using aligned_vector = std::vector<T, pmr_aligned_allocator<T, Align>>;
+    }
+
+    /**
+     * Returns the calling thread's scratch arena, intended for temporary
+     * batch-aligned buffers that are dropped all at once with
+     * <tt>scratch_arena().reset()</tt> or with a scratch_scope.
+     */
+    inline arena_resource<>& scratch_arena() noexcept
+    {
+        thread_local arena_resource<> arena;
+        return arena;
+    }
+
+    /**
+     * @class scratch_scope
+     * @brief Rewinds an arena to its state at construction on destruction.
+     */
+    template <class A = detail::arena_default_arch>
+    class scratch_scope
+    {
+    public:
+        explicit scratch_scope(arena_resource<A>& arena = scratch_arena()) noexcept
+            : m_arena(arena)
+            , m_marker(arena.mark())
+        {
+        }
+
+        scratch_scope(scratch_scope const&) = delete;
+        scratch_scope& operator=(scratch_scope const&) = delete;
+
+        ~scratch_scope()
+        {
+            m_arena.rewind(m_marker);
+        }
+
+        arena_resource<A>& arena() const noexcept
+        {
+            return m_arena;
+        }
+
+    private:
+        arena_resource<A>& m_arena;
+        typename arena_resource<A>::marker m_marker;
+    };
+
+    /*********************************
+     * arena_resource implementation *
+     *********************************/
+
+    /**
+     * Creates an empty arena.
+     * @param initial_size the size of the first chunk obtained from \c upstream.
+     * @param upstream the resource chunks are obtained from.
+     */
+    template <class A>
+    arena_resource<A>::arena_resource(std::size_t initial_size, std::pmr::memory_resource* upstream) noexcept
+        : m_upstream(upstream)
+        , m_next_size(initial_size < 2 * header_size ? 2 * header_size : initial_size)
+    {
+    }
+
+    template <class A>
+    arena_resource<A>::~arena_resource()
+    {
+        release();
+    }
+
+    /**
+     * Makes all the memory of the arena available again, without returning
+     * it to the upstream resource. Previously allocated blocks become invalid.
+     */
+    template <class A>
+    void arena_resource<A>::reset() noexcept
+    {
+        enter(m_head);
+    }
+
+    /**
+     * Returns all the chunks to the upstream resource.
+     */
+    template <class A>
+    void arena_resource<A>::release() noexcept
+    {
+        chunk* c = m_head;
+        while (c != nullptr)
+        {
+            chunk* next = c->next;
+            m_upstream->deallocate(c, c->size, min_alignment);
+            c = next;
+        }
+        m_head = nullptr;
+        enter(nullptr);
+    }
+
+    /**
+     * Returns the current position of the arena.
+     */
+    template <class A>
+    auto arena_resource<A>::mark() const noexcept -> marker
+    {
+        return { m_current, m_cursor };
+    }
+
+    /**
+     * Frees every block allocated since \c m was obtained from mark().
+     */
+    template <class A>
+    void arena_resource<A>::rewind(marker const& m) noexcept
+    {
+        if (m.chunk == nullptr)
+        {
+            reset();
+        }
+        else
+        {
+            enter(static_cast<chunk*>(m.chunk));
+            m_cursor = m.cursor;
+        }
+    }
+
+    /**
+     * Returns the number of bytes obtained from the upstream resource.
+     */
+    template <class A>
+    std::size_t arena_resource<A>::capacity() const noexcept
+    {
+        std::size_t res = 0;
+        for (chunk* c = m_head; c != nullptr; c = c->next)
+            res += c->size;
+        return res;
+    }
+
+    template <class A>
+    std::pmr::memory_resource* arena_resource<A>::upstream_resource() const noexcept
+    {
+        return m_upstream;
+    }
+
+    template <class A>
+    void* arena_resource<A>::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        alignment = alignment < min_alignment ? min_alignment : alignment;
+        while (m_current != nullptr)
+        {
+            std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+            std::uintptr_t aligned = (cursor + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+            if (aligned + bytes <= reinterpret_cast<std::uintptr_t>(m_end))
+            {
+                m_cursor = reinterpret_cast<char*>(aligned + bytes);
+                return reinterpret_cast<void*>(aligned);
+            }
+            if (m_current->next == nullptr)
+                break;
+            enter(m_current->next);
+        }
+
+        std::size_t needed = header_size + bytes + alignment - min_alignment;
+        while (m_next_size < needed)
+            m_next_size *= 2;
+        chunk* c = static_cast<chunk*>(m_upstream->allocate(m_next_size, min_alignment));
+        c->next = nullptr;
+        c->size = m_next_size;
+        m_next_size *= 2;
+        if (m_current == nullptr)
+            m_head = c;
+        else
+            m_current->next = c;
+        enter(c);
+        return do_allocate(bytes, alignment);
+    }
+
+    template <class A>
+    void arena_resource<A>::do_deallocate(void*, std::size_t, std::size_t)
+    {
+    }
+
+    template <class A>
+    bool arena_resource<A>::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    template <class A>
+    char* arena_resource<A>::chunk_begin(chunk* c) noexcept
+    {
+        return reinterpret_cast<char*>(c) + header_size;
+    }
+
+    template <class A>
+    char* arena_resource<A>::chunk_end(chunk* c) noexcept
+    {
+        return reinterpret_cast<char*>(c) + c->size;
+    }
+
+    template <class A>
+    void arena_resource<A>::enter(chunk* c) noexcept
+    {
+        m_current = c;
+        m_cursor = c == nullptr ? nullptr : chunk_begin(c);
+        m_end = c == nullptr ? nullptr : chunk_end(c);
+    }
+}
+
+#endif
+
+#endif
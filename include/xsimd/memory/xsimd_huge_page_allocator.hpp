@@ -0,0 +1,569 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_HUGE_PAGE_ALLOCATOR_HPP
+#define XSIMD_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "./xsimd_aligned_allocator.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace xsimd
+{
+    /**
+     * @brief Page backing requested from, and reported by, the huge page
+     * allocation functions.
+     */
+    enum class huge_page_mode
+    {
+        /// regular pages
+        none,
+        /// transparent huge pages, requested with madvise(MADV_HUGEPAGE)
+        transparent,
+        /// explicit 2 MB pages from the hugetlb pool
+        explicit_2mb,
+        /// explicit 1 GB pages from the hugetlb pool
+        explicit_1gb
+    };
+
+    /**
+     * @brief NUMA placement requested from, and reported by, the huge page
+     * allocation functions.
+     */
+    enum class numa_policy
+    {
+        /// leave placement to the kernel default policy
+        none,
+        /// fault every page in from the allocating thread
+        first_touch,
+        /// bind the pages to a single node
+        bind,
+        /// interleave the pages over all online nodes
+        interleave
+    };
+
+    /**
+     * @struct huge_page_options
+     * @brief Placement request for huge_page_malloc and huge_page_allocator.
+     */
+    struct huge_page_options
+    {
+        huge_page_mode pages = huge_page_mode::transparent;
+        numa_policy numa = numa_policy::none;
+        /// node used by numa_policy::bind
+        int node = 0;
+        /// fault the first transparent huge page in and report regular
+        /// pages unless the kernel backed it with a huge page; this reads
+        /// /proc/self/smaps_rollup twice, a walk over the whole process
+        bool verify_transparent = false;
+    };
+
+    XSIMD_INLINE bool operator==(huge_page_options const& lhs, huge_page_options const& rhs) noexcept
+    {
+        return lhs.pages == rhs.pages && lhs.numa == rhs.numa && lhs.node == rhs.node && lhs.verify_transparent == rhs.verify_transparent;
+    }
+
+    XSIMD_INLINE bool operator!=(huge_page_options const& lhs, huge_page_options const& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @struct huge_page_info
+     * @brief Placement that actually took effect for an allocation.
+     *
+     * Huge pages and NUMA policies are best effort: each request falls back
+     * to the next weaker one (1 GB, 2 MB, transparent, regular pages) when
+     * the system cannot honor it.
+     */
+    struct huge_page_info
+    {
+        huge_page_mode pages = huge_page_mode::none;
+        numa_policy numa = numa_policy::none;
+        /// size of the pages backing the mapping
+        std::size_t page_size = 0;
+        /// number of bytes actually mapped
+        std::size_t mapped_size = 0;
+    };
+
+    inline void* huge_page_malloc(std::size_t size, std::size_t alignment, huge_page_options const& options = {});
+    inline void huge_page_free(void* ptr) noexcept;
+    inline huge_page_info huge_page_query(void const* ptr) noexcept;
+
+    inline bool transparent_huge_pages_enabled() noexcept;
+    inline std::size_t free_huge_pages(std::size_t page_size) noexcept;
+
+    /**
+     * @class huge_page_allocator
+     * @brief Allocator for large, aligned, huge page backed buffers.
+     *
+     * The huge_page_allocator class template is a stateful allocator that
+     * carries a huge_page_options placement request. Use huge_page_query()
+     * on the data of a container to know which placement took effect.
+     *
+     * @tparam T type of objects to allocate.
+     * @tparam Align alignment in bytes.
+     */
+    template <class T, size_t Align = aligned_allocator<T>::alignment>
+    class huge_page_allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        static constexpr size_t alignment = Align;
+
+        template <class U>
+        struct rebind
+        {
+            using other = huge_page_allocator<U, Align>;
+        };
+
+        huge_page_allocator() noexcept = default;
+
+        explicit huge_page_allocator(huge_page_options const& options) noexcept
+            : m_options(options)
+        {
+        }
+
+        template <class U>
+        huge_page_allocator(const huge_page_allocator<U, Align>& rhs) noexcept
+            : m_options(rhs.options())
+        {
+        }
+
+        /**
+         * Allocates <tt>n * sizeof(T)</tt> bytes of uninitialized memory, aligned
+         * by \c Align and placed according to the allocator options.
+         * Throws std::bad_array_new_length if that size overflows.
+         */
+        pointer allocate(size_type n)
+        {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T))
+            {
+#if defined(_CPPUNWIND) || defined(__cpp_exceptions)
+                throw std::bad_array_new_length();
+#else
+                return nullptr;
+#endif
+            }
+            return reinterpret_cast<pointer>(huge_page_malloc(sizeof(T) * n, Align, m_options));
+        }
+
+        /**
+         * Deallocates the storage referenced by the pointer p, which must be a
+         * pointer obtained by an earlier call to allocate().
+         */
+        void deallocate(pointer p, size_type) noexcept
+        {
+            huge_page_free(p);
+        }
+
+        huge_page_options const& options() const noexcept
+        {
+            return m_options;
+        }
+
+    private:
+        huge_page_options m_options;
+    };
+
+    template <class T1, size_t A1, class T2, size_t A2>
+    XSIMD_INLINE bool operator==(const huge_page_allocator<T1, A1>& lhs,
+                                 const huge_page_allocator<T2, A2>& rhs) noexcept
+    {
+        return A1 == A2 && lhs.options() == rhs.options();
+    }
+
+    template <class T1, size_t A1, class T2, size_t A2>
+    XSIMD_INLINE bool operator!=(const huge_page_allocator<T1, A1>& lhs,
+                                 const huge_page_allocator<T2, A2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /******************************************
+     * huge page malloc / free implementation *
+     ******************************************/
+
+    namespace detail
+    {
+        // Stored right before the pointer returned to the user, so that
+        // huge_page_free and huge_page_query only need that pointer.
+        struct huge_page_header
+        {
+            void* base;
+            huge_page_info info;
+        };
+
+        constexpr std::size_t huge_page_2mb = std::size_t(1) << 21;
+        constexpr std::size_t huge_page_1gb = std::size_t(1) << 30;
+
+        inline std::size_t round_up_to(std::size_t size, std::size_t multiple) noexcept
+        {
+            return (size + multiple - 1) / multiple * multiple;
+        }
+
+        // Bytes reserved in front of the data for its header and for
+        // aligning it: mappings are only aligned on pages, and alignment may
+        // be larger.
+        inline std::size_t huge_page_overhead(std::size_t alignment) noexcept
+        {
+            return sizeof(huge_page_header) + alignment - 1;
+        }
+
+        inline bool read_sys_file(char const* path, char* buffer, std::size_t size) noexcept
+        {
+            std::FILE* file = std::fopen(path, "r");
+            if (file == nullptr)
+                return false;
+            std::size_t count = std::fread(buffer, 1, size - 1, file);
+            std::fclose(file);
+            buffer[count] = '\0';
+            return count != 0;
+        }
+
+#if defined(__linux__)
+        // Values from <linux/mempolicy.h>, not pulled in to avoid a
+        // dependency on kernel headers or libnuma.
+        constexpr int mpol_bind = 2;
+        constexpr int mpol_interleave = 3;
+        constexpr int map_huge_shift = 26;
+
+        inline std::size_t system_page_size() noexcept
+        {
+            long res = sysconf(_SC_PAGESIZE);
+            return res > 0 ? static_cast<std::size_t>(res) : 4096;
+        }
+
+        // Parses a node list such as "0-1,4" as found in /sys/devices/system/node/online.
+        inline unsigned long online_numa_nodes() noexcept
+        {
+            char buffer[256];
+            if (!read_sys_file("/sys/devices/system/node/online", buffer, sizeof(buffer)))
+                return 1ul;
+            unsigned long mask = 0;
+            char const* cur = buffer;
+            while (*cur >= '0' && *cur <= '9')
+            {
+                char* end;
+                unsigned long first = std::strtoul(cur, &end, 10);
+                unsigned long last = first;
+                if (*end == '-')
+                    last = std::strtoul(end + 1, &end, 10);
+                for (unsigned long n = first; n <= last && n < 8 * sizeof(unsigned long); ++n)
+                    mask |= 1ul << n;
+                cur = *end == ',' ? end + 1 : end;
+            }
+            return mask == 0 ? 1ul : mask;
+        }
+
+        inline bool apply_numa_policy(void* addr, std::size_t size, huge_page_options const& options) noexcept
+        {
+            unsigned long mask;
+            int mode;
+            if (options.numa == numa_policy::bind)
+            {
+                if (options.node < 0 || options.node >= int(8 * sizeof(unsigned long)))
+                    return false;
+                mask = 1ul << options.node;
+                mode = mpol_bind;
+            }
+            else
+            {
+                mask = online_numa_nodes();
+                mode = mpol_interleave;
+            }
+#ifdef SYS_mbind
+            return syscall(SYS_mbind, addr, size, mode, &mask, 8 * sizeof(unsigned long) + 1, 0) == 0;
+#else
+            (void)addr;
+            (void)size;
+            (void)mask;
+            (void)mode;
+            return false;
+#endif
+        }
+
+        inline void* map_explicit(std::size_t size, std::size_t page_size) noexcept
+        {
+#ifdef MAP_HUGETLB
+            int log2_size = page_size == huge_page_1gb ? 30 : 21;
+            void* res = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (log2_size << map_huge_shift), -1, 0);
+            return res == MAP_FAILED ? nullptr : res;
+#else
+            (void)size;
+            (void)page_size;
+            return nullptr;
+#endif
+        }
+
+        // Maps size bytes at an address aligned on 'align', trimming the
+        // over-allocation so that the kernel can back the range with PMD
+        // sized transparent huge pages.
+        inline void* map_aligned(std::size_t size, std::size_t align) noexcept
+        {
+            std::size_t length = size + align;
+            void* raw = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+                return nullptr;
+            std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+            std::uintptr_t aligned = (begin + align - 1) & ~(std::uintptr_t(align) - 1);
+            std::size_t head = aligned - begin;
+            std::size_t tail = length - head - size;
+            if (head != 0)
+                munmap(raw, head);
+            if (tail != 0)
+                munmap(reinterpret_cast<void*>(aligned + size), tail);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // AnonHugePages of the whole process in kB, read from
+        // /proc/self/smaps_rollup; -1 if it cannot be read.
+        inline long anon_huge_pages_kb() noexcept
+        {
+            std::FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+            if (file == nullptr)
+                return -1;
+            char line[256];
+            long res = -1;
+            while (res < 0 && std::fgets(line, sizeof(line), file) != nullptr)
+            {
+                if (std::strncmp(line, "AnonHugePages:", 14) == 0)
+                    res = std::strtol(line + 14, nullptr, 10);
+            }
+            std::fclose(file);
+            return res;
+        }
+
+        // madvise(MADV_HUGEPAGE) succeeds whether or not the kernel finds a
+        // huge page when the range is faulted in, e.g. with defrag disabled
+        // and fragmented memory. Fault the first huge page in and check
+        // that the process gained one; another thread faulting one in at
+        // the same time may hide a fallback.
+        inline bool transparent_huge_page_backed(void* addr) noexcept
+        {
+            long const before = anon_huge_pages_kb();
+            if (before < 0)
+                return false;
+            *static_cast<char volatile*>(addr) = 0;
+            return anon_huge_pages_kb() >= before + long(huge_page_2mb / 1024);
+        }
+
+        inline void* huge_page_map(std::size_t size, huge_page_options const& options, huge_page_info& info) noexcept
+        {
+            // no mapping can be that large, and rounding it up would wrap
+            if (size > std::numeric_limits<std::size_t>::max() - huge_page_1gb)
+                return nullptr;
+            std::size_t const small_page = system_page_size();
+            void* res = nullptr;
+            if (options.pages == huge_page_mode::explicit_1gb)
+            {
+                std::size_t length = round_up_to(size, huge_page_1gb);
+                if ((res = map_explicit(length, huge_page_1gb)) != nullptr)
+                {
+                    info.pages = huge_page_mode::explicit_1gb;
+                    info.page_size = huge_page_1gb;
+                    info.mapped_size = length;
+                    return res;
+                }
+            }
+            if (options.pages == huge_page_mode::explicit_1gb || options.pages == huge_page_mode::explicit_2mb)
+            {
+                std::size_t length = round_up_to(size, huge_page_2mb);
+                if ((res = map_explicit(length, huge_page_2mb)) != nullptr)
+                {
+                    info.pages = huge_page_mode::explicit_2mb;
+                    info.page_size = huge_page_2mb;
+                    info.mapped_size = length;
+                    return res;
+                }
+            }
+            if (options.pages != huge_page_mode::none)
+            {
+                std::size_t length = round_up_to(size, huge_page_2mb);
+                if ((res = map_aligned(length, huge_page_2mb)) != nullptr)
+                {
+                    info.mapped_size = length;
+#ifdef MADV_HUGEPAGE
+                    if (transparent_huge_pages_enabled() && madvise(res, length, MADV_HUGEPAGE) == 0)
+                    {
+                        info.pages = huge_page_mode::transparent;
+                        info.page_size = huge_page_2mb;
+                        return res;
+                    }
+#endif
+                    info.pages = huge_page_mode::none;
+                    info.page_size = small_page;
+                    return res;
+                }
+            }
+            std::size_t length = round_up_to(size, small_page);
+            res = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (res == MAP_FAILED)
+                return nullptr;
+            info.pages = huge_page_mode::none;
+            info.page_size = small_page;
+            info.mapped_size = length;
+            return res;
+        }
+#endif
+    }
+
+    /**
+     * Allocates \c size bytes aligned on \c alignment, backed by huge pages
+     * and placed on NUMA nodes as requested by \c options, falling back to
+     * weaker placements when the request cannot be honored. The memory must
+     * be released with huge_page_free().
+     *
+     * Transparent huge pages are reported once the kernel accepted the
+     * request for the range, which does not guarantee that it finds huge
+     * pages when faulting it in. With huge_page_options::verify_transparent,
+     * they are only reported when the first one was actually backed by a
+     * huge page; the kernel may still split or collapse the rest of the
+     * range later.
+     *
+     * On systems other than Linux, memory comes from malloc and is
+     * reported as huge_page_mode::none and numa_policy::none.
+     *
+     * @param size the number of bytes to allocate.
+     * @param alignment the alignment in bytes, a power of two.
+     * @param options the requested placement.
+     * @return a pointer to the allocated block.
+     */
+    inline void* huge_page_malloc(std::size_t size, std::size_t alignment, huge_page_options const& options)
+    {
+        assert(((alignment & (alignment - 1)) == 0) && "alignment must be a power of two");
+        if (alignment < alignof(detail::huge_page_header))
+            alignment = alignof(detail::huge_page_header);
+        std::size_t const overhead = detail::huge_page_overhead(alignment);
+        huge_page_info info;
+        void* base = nullptr;
+        if (size <= std::numeric_limits<std::size_t>::max() - overhead)
+        {
+#if defined(__linux__)
+            base = detail::huge_page_map(overhead + size, options, info);
+            if (base != nullptr)
+            {
+                if ((options.numa == numa_policy::bind || options.numa == numa_policy::interleave)
+                    && detail::apply_numa_policy(base, info.mapped_size, options))
+                {
+                    info.numa = options.numa;
+                }
+                if (info.pages == huge_page_mode::transparent && options.verify_transparent && !detail::transparent_huge_page_backed(base))
+                {
+                    info.pages = huge_page_mode::none;
+                    info.page_size = detail::system_page_size();
+                }
+                if (options.numa == numa_policy::first_touch)
+                {
+                    // Fault the pages in from this thread so that the default
+                    // local policy places them on its node.
+                    char* bytes = static_cast<char*>(base);
+                    std::size_t const step = detail::system_page_size();
+                    for (std::size_t i = 0; i < info.mapped_size; i += step)
+                        bytes[i] = 0;
+                    info.numa = numa_policy::first_touch;
+                }
+            }
+#else
+            (void)options;
+            base = std::malloc(overhead + size);
+            info.mapped_size = overhead + size;
+#endif
+        }
+        if (base == nullptr)
+        {
+#if defined(_CPPUNWIND) || defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#else
+            return nullptr;
+#endif
+        }
+        // align the absolute address, past the header
+        std::uintptr_t const data = (reinterpret_cast<std::uintptr_t>(base) + sizeof(detail::huge_page_header) + alignment - 1)
+            & ~(std::uintptr_t(alignment) - 1);
+        char* res = reinterpret_cast<char*>(data);
+        auto* header = reinterpret_cast<detail::huge_page_header*>(res) - 1;
+        header->base = base;
+        header->info = info;
+        return res;
+    }
+
+    /**
+     * Releases memory obtained from huge_page_malloc().
+     */
+    inline void huge_page_free(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+        auto* header = reinterpret_cast<detail::huge_page_header*>(ptr) - 1;
+#if defined(__linux__)
+        munmap(header->base, header->info.mapped_size);
+#else
+        std::free(header->base);
+#endif
+    }
+
+    /**
+     * Returns the placement that took effect for a block obtained from
+     * huge_page_malloc() or huge_page_allocator.
+     */
+    inline huge_page_info huge_page_query(void const* ptr) noexcept
+    {
+        return (reinterpret_cast<detail::huge_page_header const*>(ptr) - 1)->info;
+    }
+
+    /**
+     * Checks whether transparent huge pages can be requested with
+     * madvise, i.e. whether they are not disabled system-wide.
+     */
+    inline bool transparent_huge_pages_enabled() noexcept
+    {
+        char buffer[128];
+        if (!detail::read_sys_file("/sys/kernel/mm/transparent_hugepage/enabled", buffer, sizeof(buffer)))
+            return false;
+        return std::strstr(buffer, "[never]") == nullptr;
+    }
+
+    /**
+     * Returns the number of free pages of \c page_size bytes in the explicit
+     * huge page pool, 0 when there is no such pool.
+     */
+    inline std::size_t free_huge_pages(std::size_t page_size) noexcept
+    {
+        char path[96];
+        std::snprintf(path, sizeof(path), "/sys/kernel/mm/hugepages/hugepages-%zukB/free_hugepages", page_size / 1024);
+        char buffer[32];
+        if (!detail::read_sys_file(path, buffer, sizeof(buffer)))
+            return 0;
+        return static_cast<std::size_t>(std::strtoull(buffer, nullptr, 10));
+    }
+}
+
+#endif
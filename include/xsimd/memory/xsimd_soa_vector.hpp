@@ -0,0 +1,558 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_SOA_VECTOR_HPP
+#define XSIMD_SOA_VECTOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../xsimd.hpp"
+
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+namespace xsimd
+{
+    /**
+     * @struct soa_fields
+     * @brief List of data members describing the layout of a soa_vector.
+     *
+     * Each template argument is a pointer to a data member of the same
+     * aggregate, e.g. <tt>soa_fields<&particle::x, &particle::y></tt>.
+     */
+    template <auto... Members>
+    struct soa_fields
+    {
+        static constexpr std::size_t size = sizeof...(Members);
+    };
+
+    /**
+     * @struct soa_layout
+     * @brief Customization point mapping a structure to its soa_fields.
+     *
+     * Specialize this trait for the structures stored in a soa_vector:
+     *
+     * @code{.cpp}
+     * template <>
+     * struct xsimd::soa_layout<particle>
+     * {
+     *     using type = xsimd::soa_fields<&particle::x, &particle::y, &particle::z>;
+     * };
+     * @endcode
+     */
+    template <class S>
+    struct soa_layout;
+
+    namespace detail
+    {
+        template <class M>
+        struct soa_member_traits;
+
+        template <class C, class T>
+        struct soa_member_traits<T C::*>
+        {
+            using class_type = C;
+            using value_type = T;
+        };
+
+        template <auto Member>
+        using soa_member_t = typename soa_member_traits<decltype(Member)>::value_type;
+
+        template <class S, class A, class Layout>
+        struct soa_storage;
+
+        template <class S, class A, auto... Members>
+        struct soa_storage<S, A, soa_fields<Members...>>
+        {
+            static_assert(sizeof...(Members) > 0, "soa_fields must hold at least one member");
+            static_assert((std::is_same_v<typename soa_member_traits<decltype(Members)>::class_type, S> && ...),
+                          "every soa field must be a data member of the stored structure");
+            static_assert((std::is_arithmetic_v<soa_member_t<Members>> && ...),
+                          "soa fields must have arithmetic types");
+
+            using first_type = std::tuple_element_t<0, std::tuple<soa_member_t<Members>...>>;
+            static_assert(((sizeof(soa_member_t<Members>) == sizeof(first_type)) && ...),
+                          "soa fields must have the same size so that a row block maps to one batch per field");
+
+            template <class T>
+            using vector_type = std::vector<T, aligned_allocator<T, A::alignment()>>;
+
+            using vectors_type = std::tuple<vector_type<soa_member_t<Members>>...>;
+            using batch_tuple = std::tuple<batch<soa_member_t<Members>, A>...>;
+            using members_type = std::tuple<decltype(Members)...>;
+
+            static constexpr std::size_t batch_size = batch<first_type, A>::size;
+
+            static constexpr members_type members() noexcept
+            {
+                return members_type(Members...);
+            }
+        };
+    }
+
+    /**
+     * @class soa_vector
+     * @brief Structure-of-arrays container with batch-wise field access.
+     *
+     * A soa_vector stores each field of \c S, as described by
+     * <tt>soa_layout<S>::type</tt>, in its own aligned buffer. Buffers are
+     * padded to a multiple of the batch size so that the row block \c i
+     * (rows <tt>[i * batch_size, (i + 1) * batch_size)</tt>) can always be
+     * loaded and stored with aligned accesses, one batch per field. The
+     * content of padding rows is value-initialized when the container grows
+     * and unspecified after a store to the last row block.
+     *
+     * @tparam S structure type whose fields are stored.
+     * @tparam A architecture used for the batches and the alignment.
+     */
+    template <class S, class A = default_arch>
+    class soa_vector
+    {
+        using storage_type = detail::soa_storage<S, A, typename soa_layout<S>::type>;
+
+    public:
+        using value_type = S;
+        using arch_type = A;
+        using size_type = std::size_t;
+        using batch_tuple = typename storage_type::batch_tuple;
+
+        template <std::size_t I>
+        using field_type = typename std::tuple_element_t<I, batch_tuple>::value_type;
+
+        template <std::size_t I>
+        using field_batch = std::tuple_element_t<I, batch_tuple>;
+
+        static constexpr size_type batch_size = storage_type::batch_size;
+        static constexpr size_type field_count = std::tuple_size_v<batch_tuple>;
+
+        class tile;
+        class tile_iterator;
+
+        soa_vector() = default;
+        explicit soa_vector(size_type n);
+
+        size_type size() const noexcept;
+        size_type padded_size() const noexcept;
+        size_type batch_count() const noexcept;
+        bool empty() const noexcept;
+
+        void reserve(size_type n);
+        void resize(size_type n);
+        void clear() noexcept;
+
+        void push_back(S const& value);
+        S get(size_type i) const;
+        void set(size_type i, S const& value);
+        S operator[](size_type i) const;
+
+        template <std::size_t I>
+        field_type<I>* data() noexcept;
+        template <std::size_t I>
+        field_type<I> const* data() const noexcept;
+
+        batch_tuple load_batch(size_type i) const noexcept;
+        void store_batch(size_type i, batch_tuple const& values) noexcept;
+
+        template <std::size_t I>
+        field_batch<I> load_field(size_type i) const noexcept;
+        template <std::size_t I>
+        void store_field(size_type i, field_batch<I> const& value) noexcept;
+
+        tile_iterator tile_begin() noexcept;
+        tile_iterator tile_end() noexcept;
+
+    private:
+        static constexpr size_type round_up(size_type n) noexcept;
+
+        template <std::size_t... Is>
+        void resize_storage(size_type n, std::index_sequence<Is...>);
+        template <std::size_t... Is>
+        void reserve_storage(size_type n, std::index_sequence<Is...>);
+        template <std::size_t... Is>
+        void clear_rows(size_type first, size_type last, std::index_sequence<Is...>);
+        template <std::size_t... Is>
+        S get_impl(size_type i, std::index_sequence<Is...>) const;
+        template <std::size_t... Is>
+        void set_impl(size_type i, S const& value, std::index_sequence<Is...>);
+        template <std::size_t... Is>
+        batch_tuple load_impl(size_type i, std::index_sequence<Is...>) const noexcept;
+        template <std::size_t... Is>
+        void store_impl(size_type i, batch_tuple const& values, std::index_sequence<Is...>) noexcept;
+
+        using index_sequence = std::make_index_sequence<field_count>;
+
+        typename storage_type::vectors_type m_fields;
+        size_type m_size = 0;
+    };
+
+    /**
+     * @class soa_vector::tile
+     * @brief Proxy on one batch-sized row block of a soa_vector.
+     */
+    template <class S, class A>
+    class soa_vector<S, A>::tile
+    {
+    public:
+        tile(soa_vector& vec, size_type index) noexcept
+            : m_vec(&vec)
+            , m_index(index)
+        {
+        }
+
+        /// Index of the row block in the parent container.
+        size_type index() const noexcept { return m_index; }
+        /// Loads one batch per field for this row block.
+        batch_tuple load() const noexcept { return m_vec->load_batch(m_index); }
+        /// Stores one batch per field for this row block.
+        void store(batch_tuple const& values) noexcept { m_vec->store_batch(m_index, values); }
+
+    private:
+        soa_vector* m_vec;
+        size_type m_index;
+    };
+
+    /**
+     * @class soa_vector::tile_iterator
+     * @brief Random access iterator over the row blocks of a soa_vector.
+     */
+    template <class S, class A>
+    class soa_vector<S, A>::tile_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = tile;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = tile;
+
+        tile_iterator(soa_vector& vec, size_type index) noexcept
+            : m_vec(&vec)
+            , m_index(index)
+        {
+        }
+
+        tile operator*() const noexcept { return tile(*m_vec, m_index); }
+        tile operator[](difference_type n) const noexcept { return tile(*m_vec, m_index + n); }
+
+        tile_iterator& operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+        tile_iterator operator++(int) noexcept
+        {
+            tile_iterator tmp(*this);
+            ++m_index;
+            return tmp;
+        }
+        tile_iterator& operator--() noexcept
+        {
+            --m_index;
+            return *this;
+        }
+        tile_iterator operator--(int) noexcept
+        {
+            tile_iterator tmp(*this);
+            --m_index;
+            return tmp;
+        }
+        tile_iterator& operator+=(difference_type n) noexcept
+        {
+            m_index += n;
+            return *this;
+        }
+        tile_iterator& operator-=(difference_type n) noexcept
+        {
+            m_index -= n;
+            return *this;
+        }
+        tile_iterator operator+(difference_type n) const noexcept { return tile_iterator(*m_vec, m_index + n); }
+        tile_iterator operator-(difference_type n) const noexcept { return tile_iterator(*m_vec, m_index - n); }
+        difference_type operator-(tile_iterator const& rhs) const noexcept
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        bool operator==(tile_iterator const& rhs) const noexcept { return m_index == rhs.m_index; }
+        bool operator!=(tile_iterator const& rhs) const noexcept { return m_index != rhs.m_index; }
+        bool operator<(tile_iterator const& rhs) const noexcept { return m_index < rhs.m_index; }
+        bool operator<=(tile_iterator const& rhs) const noexcept { return m_index <= rhs.m_index; }
+        bool operator>(tile_iterator const& rhs) const noexcept { return m_index > rhs.m_index; }
+        bool operator>=(tile_iterator const& rhs) const noexcept { return m_index >= rhs.m_index; }
+
+    private:
+        soa_vector* m_vec;
+        size_type m_index;
+    };
+
+    /*****************************
+     * soa_vector implementation *
+     *****************************/
+
+    /**
+     * Creates a container holding \c n value-initialized rows.
+     */
+    template <class S, class A>
+    soa_vector<S, A>::soa_vector(size_type n)
+    {
+        resize(n);
+    }
+
+    /**
+     * Returns the number of rows.
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns the number of rows including the padding of the last row block.
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::padded_size() const noexcept -> size_type
+    {
+        return round_up(m_size);
+    }
+
+    /**
+     * Returns the number of row blocks, the last one being possibly partial.
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::batch_count() const noexcept -> size_type
+    {
+        return round_up(m_size) / batch_size;
+    }
+
+    template <class S, class A>
+    bool soa_vector<S, A>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * Reserves storage for at least \c n rows in every field.
+     */
+    template <class S, class A>
+    void soa_vector<S, A>::reserve(size_type n)
+    {
+        reserve_storage(round_up(n), index_sequence {});
+    }
+
+    /**
+     * Resizes the container to \c n rows. New rows, and new padding rows,
+     * are value-initialized.
+     */
+    template <class S, class A>
+    void soa_vector<S, A>::resize(size_type n)
+    {
+        // rows past the size may hold former values even when the storage
+        // keeps its size, whether from a store to the last row block or
+        // from a previous shrink
+        resize_storage(round_up(n), index_sequence {});
+        clear_rows(std::min(m_size, n), round_up(n), index_sequence {});
+        m_size = n;
+    }
+
+    template <class S, class A>
+    void soa_vector<S, A>::clear() noexcept
+    {
+        resize_storage(0, index_sequence {});
+        m_size = 0;
+    }
+
+    /**
+     * Appends the fields of \c value as a new row.
+     */
+    template <class S, class A>
+    void soa_vector<S, A>::push_back(S const& value)
+    {
+        if (m_size == round_up(m_size))
+        {
+            resize_storage(m_size + batch_size, index_sequence {});
+        }
+        set_impl(m_size, value, index_sequence {});
+        ++m_size;
+    }
+
+    /**
+     * Gathers the fields of row \c i into a structure. Members of \c S that
+     * are not part of the layout are value-initialized.
+     */
+    template <class S, class A>
+    S soa_vector<S, A>::get(size_type i) const
+    {
+        return get_impl(i, index_sequence {});
+    }
+
+    /**
+     * Scatters the fields of \c value to row \c i.
+     */
+    template <class S, class A>
+    void soa_vector<S, A>::set(size_type i, S const& value)
+    {
+        set_impl(i, value, index_sequence {});
+    }
+
+    template <class S, class A>
+    S soa_vector<S, A>::operator[](size_type i) const
+    {
+        return get_impl(i, index_sequence {});
+    }
+
+    /**
+     * Returns the aligned buffer holding the \c I-th field.
+     */
+    template <class S, class A>
+    template <std::size_t I>
+    auto soa_vector<S, A>::data() noexcept -> field_type<I>*
+    {
+        return std::get<I>(m_fields).data();
+    }
+
+    template <class S, class A>
+    template <std::size_t I>
+    auto soa_vector<S, A>::data() const noexcept -> field_type<I> const*
+    {
+        return std::get<I>(m_fields).data();
+    }
+
+    /**
+     * Loads the row block \c i, returning one batch per field.
+     * @param i index of the row block, lower than batch_count().
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::load_batch(size_type i) const noexcept -> batch_tuple
+    {
+        return load_impl(i, index_sequence {});
+    }
+
+    /**
+     * Stores one batch per field to the row block \c i.
+     * @param i index of the row block, lower than batch_count().
+     * @param values the batches to store, in layout order.
+     */
+    template <class S, class A>
+    void soa_vector<S, A>::store_batch(size_type i, batch_tuple const& values) noexcept
+    {
+        store_impl(i, values, index_sequence {});
+    }
+
+    /**
+     * Loads the \c I-th field of the row block \c i.
+     */
+    template <class S, class A>
+    template <std::size_t I>
+    auto soa_vector<S, A>::load_field(size_type i) const noexcept -> field_batch<I>
+    {
+        assert(i < batch_count() && "row block index out of bounds");
+        return field_batch<I>::load_aligned(data<I>() + i * batch_size);
+    }
+
+    /**
+     * Stores the \c I-th field of the row block \c i.
+     */
+    template <class S, class A>
+    template <std::size_t I>
+    void soa_vector<S, A>::store_field(size_type i, field_batch<I> const& value) noexcept
+    {
+        assert(i < batch_count() && "row block index out of bounds");
+        value.store_aligned(data<I>() + i * batch_size);
+    }
+
+    /**
+     * Returns an iterator to the first row block.
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::tile_begin() noexcept -> tile_iterator
+    {
+        return tile_iterator(*this, 0);
+    }
+
+    /**
+     * Returns an iterator past the last row block.
+     */
+    template <class S, class A>
+    auto soa_vector<S, A>::tile_end() noexcept -> tile_iterator
+    {
+        return tile_iterator(*this, batch_count());
+    }
+
+    template <class S, class A>
+    constexpr auto soa_vector<S, A>::round_up(size_type n) noexcept -> size_type
+    {
+        return (n + batch_size - 1) / batch_size * batch_size;
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    void soa_vector<S, A>::resize_storage(size_type n, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(m_fields).resize(n), ...);
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    void soa_vector<S, A>::reserve_storage(size_type n, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(m_fields).reserve(n), ...);
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    void soa_vector<S, A>::clear_rows(size_type first, size_type last, std::index_sequence<Is...>)
+    {
+        (std::fill(std::get<Is>(m_fields).begin() + first, std::get<Is>(m_fields).begin() + last, field_type<Is> {}), ...);
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    S soa_vector<S, A>::get_impl(size_type i, std::index_sequence<Is...>) const
+    {
+        constexpr auto members = storage_type::members();
+        S res {};
+        ((res.*std::get<Is>(members) = std::get<Is>(m_fields)[i]), ...);
+        return res;
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    void soa_vector<S, A>::set_impl(size_type i, S const& value, std::index_sequence<Is...>)
+    {
+        constexpr auto members = storage_type::members();
+        ((std::get<Is>(m_fields)[i] = value.*std::get<Is>(members)), ...);
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    auto soa_vector<S, A>::load_impl(size_type i, std::index_sequence<Is...>) const noexcept -> batch_tuple
+    {
+        return batch_tuple(load_field<Is>(i)...);
+    }
+
+    template <class S, class A>
+    template <std::size_t... Is>
+    void soa_vector<S, A>::store_impl(size_type i, batch_tuple const& values, std::index_sequence<Is...>) noexcept
+    {
+        (store_field<Is>(i, std::get<Is>(values)), ...);
+    }
+}
+
+#endif
+
+#endif
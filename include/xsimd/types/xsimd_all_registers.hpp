@@ -11,6 +11,7 @@
  ****************************************************************************/
 
 #include "./xsimd_avx2_register.hpp"
+#include "./xsimd_avx512bitalg_register.hpp"
 #include "./xsimd_avx512bw_register.hpp"
 #include "./xsimd_avx512cd_register.hpp"
 #include "./xsimd_avx512dq_register.hpp"
@@ -23,6 +24,7 @@
 #include "./xsimd_avx512vl_register.hpp"
 #include "./xsimd_avx512vnni_avx512bw_register.hpp"
 #include "./xsimd_avx512vnni_avx512vbmi2_register.hpp"
+#include "./xsimd_avx512vpopcntdq_register.hpp"
 #include "./xsimd_avx_register.hpp"
 #include "./xsimd_avxvnni_register.hpp"
 #include "./xsimd_fma3_avx2_128_register.hpp"
@@ -706,6 +706,38 @@ namespace xsimd
         return kernel::count<A>(x, A {});
     }
 
+    /**
+     * @ingroup batch_bitwise
+     *
+     * Count the leading (most significant) zero bits of each lane of \c x,
+     * as \c std::countl_zero. Lanes equal to zero yield their width in bits.
+     * @param x batch of integer values.
+     * @return the number of leading zero bits of each lane of \c x.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> countl_zero(batch<T, A> const& x) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "countl_zero counts the bits of integers");
+        detail::static_check_supported_config<T, A>();
+        return kernel::countl_zero<A>(x, A {});
+    }
+
+    /**
+     * @ingroup batch_bitwise
+     *
+     * Count the trailing (least significant) zero bits of each lane of \c x,
+     * as \c std::countr_zero. Lanes equal to zero yield their width in bits.
+     * @param x batch of integer values.
+     * @return the number of trailing zero bits of each lane of \c x.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> countr_zero(batch<T, A> const& x) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "countr_zero counts the bits of integers");
+        detail::static_check_supported_config<T, A>();
+        return kernel::countr_zero<A>(x, A {});
+    }
+
     /**
      * @ingroup batch_arithmetic
      *
@@ -1251,6 +1283,67 @@ namespace xsimd
         return kernel::insert<A>(x, val, pos, A {});
     }
 
+    /**
+     * @ingroup batch_complex
+     *
+     * Divides the complex numbers stored interleaved in \c x, as pairs of
+     * consecutive <tt>(real, imaginary)</tt> lanes, by those stored the same
+     * way in \c y. The divisor is scaled by the inverse of its largest
+     * component before its norm is computed, which avoids spurious overflow
+     * and underflow.
+     * @param x batch of interleaved complex values.
+     * @param y batch of interleaved complex values.
+     * @return the interleaved complex quotients <tt>x / y</tt>.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> interleaved_div(batch<T, A> const& x, batch<T, A> const& y) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "interleaved complex arithmetic requires floating point values");
+        static_assert(batch<T, A>::size % 2 == 0, "interleaved complex values span pairs of lanes");
+        detail::static_check_supported_config<T, A>();
+        return kernel::interleaved_div<A>(x, y, A {});
+    }
+
+    /**
+     * @ingroup batch_complex
+     *
+     * Computes <tt>x * y + z</tt> on complex numbers stored interleaved, as
+     * pairs of consecutive <tt>(real, imaginary)</tt> lanes.
+     * @param x batch of interleaved complex values.
+     * @param y batch of interleaved complex values.
+     * @param z batch of interleaved complex values.
+     * @return the interleaved complex results of <tt>x * y + z</tt>.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> interleaved_fma(batch<T, A> const& x, batch<T, A> const& y, batch<T, A> const& z) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "interleaved complex arithmetic requires floating point values");
+        static_assert(batch<T, A>::size % 2 == 0, "interleaved complex values span pairs of lanes");
+        detail::static_check_supported_config<T, A>();
+        return kernel::interleaved_fma<A>(x, y, z, A {});
+    }
+
+    /**
+     * @ingroup batch_complex
+     *
+     * Multiplies the complex numbers stored interleaved in \c x, as pairs of
+     * consecutive <tt>(real, imaginary)</tt> lanes, by those stored the same
+     * way in \c y. Unlike <tt>batch<std::complex<T>, A></tt>, which keeps the
+     * real and imaginary parts in separate registers, this operates directly
+     * on the memory layout of <tt>std::complex<T></tt> arrays.
+     * @param x batch of interleaved complex values.
+     * @param y batch of interleaved complex values.
+     * @return the interleaved complex products <tt>x * y</tt>.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> interleaved_mul(batch<T, A> const& x, batch<T, A> const& y) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "interleaved complex arithmetic requires floating point values");
+        static_assert(batch<T, A>::size % 2 == 0, "interleaved complex values span pairs of lanes");
+        detail::static_check_supported_config<T, A>();
+        return kernel::interleaved_mul<A>(x, y, A {});
+    }
+
     /**
      * @ingroup batch_logical
      *
@@ -1946,6 +2039,22 @@ namespace xsimd
         return kernel::polar<A>(r, theta, A {});
     }
 
+    /**
+     * @ingroup batch_bitwise
+     *
+     * Count the bits set in each lane of \c x, as \c std::popcount. Signed
+     * lanes are counted on their two's complement representation.
+     * @param x batch of integer values.
+     * @return the number of bits set in each lane of \c x.
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<T, A> popcount(batch<T, A> const& x) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "popcount counts the bits of integers");
+        detail::static_check_supported_config<T, A>();
+        return kernel::popcount<A>(x, A {});
+    }
+
     /**
      * @ingroup batch_arithmetic
      *
@@ -3173,6 +3282,62 @@ namespace xsimd
         return kernel::widen<A>(x, A {});
     }
 
+    /**
+     * @ingroup batch_conversion
+     *
+     * Narrow batches \c lo and \c hi from type \c T to a type with half as
+     * many bytes and the same sign (for integers) or from double to float,
+     * the inverse of widen(). Integers are truncated to their low half, as
+     * by a \c static_cast, and doubles are rounded to float.
+     * @param lo batch of \c T, the first lanes of the result.
+     * @param hi batch of \c T, the last lanes of the result.
+     * @return a batch of \c narrow_t<T>
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<narrow_t<T>, A> narrow(batch<T, A> const& lo, batch<T, A> const& hi) noexcept
+    {
+        detail::static_check_supported_config<T, A>();
+        return kernel::narrow<A>(lo, hi, A {});
+    }
+
+    /**
+     * @ingroup batch_conversion
+     *
+     * Narrow batches \c lo and \c hi as narrow(), but saturating each lane
+     * to the range of the narrower type. Finite doubles out of the range of
+     * float become <tt>-FLT_MAX</tt> or \c FLT_MAX rather than infinities.
+     * @param lo batch of \c T, the first lanes of the result.
+     * @param hi batch of \c T, the last lanes of the result.
+     * @return a batch of \c narrow_t<T>
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch<narrow_t<T>, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi) noexcept
+    {
+        detail::static_check_supported_config<T, A>();
+        return kernel::narrow_saturate<A>(lo, hi, kernel::convert<narrow_t<T>> {}, A {});
+    }
+
+    /**
+     * @ingroup batch_conversion
+     *
+     * Narrow integer batches \c lo and \c hi to \c T_out, an integer type
+     * of half the size of \c T with either sign, saturating each lane to the
+     * range of \c T_out. For instance, \c narrow_saturate<uint8_t> turns
+     * int16 pixels into clamped 8-bit ones.
+     * @tparam T_out the integer type of the result.
+     * @param lo batch of \c T, the first lanes of the result.
+     * @param hi batch of \c T, the last lanes of the result.
+     * @return a batch of \c T_out
+     */
+    template <class T_out, class T, class A>
+    XSIMD_INLINE batch<T_out, A> narrow_saturate(batch<T, A> const& lo, batch<T, A> const& hi) noexcept
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<T_out> && 2 * sizeof(T_out) == sizeof(T),
+                      "narrow_saturate converts to an integer type of half the size");
+        detail::static_check_supported_config<T, A>();
+        return kernel::narrow_saturate<A>(lo, hi, kernel::convert<T_out> {}, A {});
+    }
+
     /**
      * @ingroup batch_miscellaneous
      *
@@ -0,0 +1,51 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XSIMD_AVX512BITALG_REGISTER_HPP
+#define XSIMD_AVX512BITALG_REGISTER_HPP
+
+#include "./xsimd_avx512vpopcntdq_register.hpp"
+
+namespace xsimd
+{
+
+    /**
+     * @ingroup architectures
+     *
+     * AVX512BITALG instructions
+     */
+    struct avx512bitalg : avx512vpopcntdq
+    {
+        static constexpr bool supported() noexcept { return XSIMD_WITH_AVX512BITALG; }
+        static constexpr bool available() noexcept { return true; }
+        static constexpr char const* name() noexcept { return "avx512bitalg"; }
+    };
+
+#if XSIMD_WITH_AVX512BITALG
+
+#if !XSIMD_WITH_AVX512VPOPCNTDQ
+#error "architecture inconsistency: avx512bitalg requires avx512vpopcntdq"
+#endif
+
+    namespace types
+    {
+        template <class T>
+        struct get_bool_simd_register<T, avx512bitalg>
+        {
+            using type = simd_avx512_bool_register<T>;
+        };
+
+        XSIMD_DECLARE_SIMD_REGISTER_ALIAS(avx512bitalg, avx512vpopcntdq);
+
+    }
+#endif
+}
+#endif
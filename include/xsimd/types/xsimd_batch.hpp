@@ -24,25 +24,38 @@
 
 namespace xsimd
 {
-    namespace detail
-    {
-        // Does batch<T, A> have a real predicated masked load/store, vs. the
-        // emulated scalar `requires_arch<common>` fallback? Compile-time signal to
-        // pick a masked single-loop over a vector+trailer loop. Size-keyed.
-        // Internal/undocumented for now; promote once the dispatch API settles.
-        template <class B>
-        struct has_mask_load : std::false_type
-        {
-        };
-        template <class B>
-        struct has_mask_store : std::false_type
-        {
-        };
+    /**
+     * @ingroup batch_traits
+     *
+     * Whether the masked loads of \c B are predicated in hardware (AVX-512
+     * k-masks, AVX @c vmaskmov, SVE and RVV predicates) rather than emulated
+     * lane by lane. Loops use it to handle their last, partial batch with a
+     * masked load instead of a scalar remainder.
+     *
+     * @tparam B the batch type.
+     */
+    template <class B>
+    struct has_mask_load : std::false_type
+    {
+    };
+
+    /**
+     * @ingroup batch_traits
+     *
+     * Whether the masked stores of \c B are predicated in hardware, see
+     * has_mask_load.
+     *
+     * @tparam B the batch type.
+     */
+    template <class B>
+    struct has_mask_store : std::false_type
+    {
+    };
 
-        template <class B>
-        constexpr bool has_mask_load_v = has_mask_load<B>::value;
-        template <class B>
-        constexpr bool has_mask_store_v = has_mask_store<B>::value;
+    template <class B>
+    constexpr bool has_mask_load_v = has_mask_load<B>::value;
+    template <class B>
+    constexpr bool has_mask_store_v = has_mask_store<B>::value;
 
 #define XSIMD_DECLARE_MASK_MEMORY(ARCH, SIZE_PREDICATE)                             \
     template <class T>                                                              \
@@ -66,65 +79,66 @@ namespace xsimd
     {                                                                      \
     }
 
-        XSIMD_DECLARE_MASK_MEMORY(avx, sizeof(T) == 4 || sizeof(T) == 8);
-        XSIMD_DECLARE_MASK_MEMORY(avx_128, sizeof(T) == 4 || sizeof(T) == 8);
-        XSIMD_DECLARE_MASK_MEMORY(avx512f, sizeof(T) == 4 || sizeof(T) == 8);
-        XSIMD_DECLARE_MASK_MEMORY(avx512bw, sizeof(T) >= 1 && sizeof(T) <= 8);
-        XSIMD_DECLARE_MASK_MEMORY(avx512vl_128, sizeof(T) == 4 || sizeof(T) == 8);
-        XSIMD_DECLARE_MASK_MEMORY(avx512vl_256, sizeof(T) == 4 || sizeof(T) == 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx, sizeof(T) == 4 || sizeof(T) == 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx_128, sizeof(T) == 4 || sizeof(T) == 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx512f, sizeof(T) == 4 || sizeof(T) == 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx512bw, sizeof(T) >= 1 && sizeof(T) <= 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx512vl_128, sizeof(T) == 4 || sizeof(T) == 8);
+    XSIMD_DECLARE_MASK_MEMORY(avx512vl_256, sizeof(T) == 4 || sizeof(T) == 8);
 
-        // sve / rvv: width-templated, predicate-native at every lane size
-        template <class T, size_t W>
-        struct has_mask_load<batch<T, sve<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
-        {
-        };
-        template <class T, size_t W>
-        struct has_mask_store<batch<T, sve<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
-        {
-        };
-        template <class T, size_t W>
-        struct has_mask_load<batch<T, rvv<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
-        {
-        };
-        template <class T, size_t W>
-        struct has_mask_store<batch<T, rvv<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
-        {
-        };
+    // sve / rvv: width-templated, predicate-native at every lane size
+    template <class T, size_t W>
+    struct has_mask_load<batch<T, detail::sve<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
+    {
+    };
+    template <class T, size_t W>
+    struct has_mask_store<batch<T, detail::sve<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
+    {
+    };
+    template <class T, size_t W>
+    struct has_mask_load<batch<T, detail::rvv<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
+    {
+    };
+    template <class T, size_t W>
+    struct has_mask_store<batch<T, detail::rvv<W>>> : std::integral_constant<bool, std::is_arithmetic_v<T>>
+    {
+    };
 
-        // descendants inherit their base
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx2, avx);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avxvnni, avx2);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx2_128, avx_128);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512cd, avx512f);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512dq, avx512cd);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512er, avx512cd);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512pf, avx512er);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vl, avx512cd);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512ifma, avx512bw);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vbmi, avx512ifma);
-        XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vbmi2, avx512vbmi);
-
-        // wrapper arches follow their parameter
-        template <class T, class A>
-        struct has_mask_load<batch<T, fma3<A>>> : has_mask_load<batch<T, A>>
-        {
-        };
-        template <class T, class A>
-        struct has_mask_store<batch<T, fma3<A>>> : has_mask_store<batch<T, A>>
-        {
-        };
-        template <class T, class A>
-        struct has_mask_load<batch<T, avx512vnni<A>>> : has_mask_load<batch<T, A>>
-        {
-        };
-        template <class T, class A>
-        struct has_mask_store<batch<T, avx512vnni<A>>> : has_mask_store<batch<T, A>>
-        {
-        };
+    // descendants inherit their base
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx2, avx);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avxvnni, avx2);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx2_128, avx_128);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512cd, avx512f);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512dq, avx512cd);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512er, avx512cd);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512pf, avx512er);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vl, avx512cd);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512ifma, avx512bw);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vbmi, avx512ifma);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vbmi2, avx512vbmi);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512vpopcntdq, avx512vnni<avx512vbmi2>);
+    XSIMD_DECLARE_MASK_MEMORY_ALIAS(avx512bitalg, avx512vpopcntdq);
+
+    // wrapper arches follow their parameter
+    template <class T, class A>
+    struct has_mask_load<batch<T, fma3<A>>> : has_mask_load<batch<T, A>>
+    {
+    };
+    template <class T, class A>
+    struct has_mask_store<batch<T, fma3<A>>> : has_mask_store<batch<T, A>>
+    {
+    };
+    template <class T, class A>
+    struct has_mask_load<batch<T, avx512vnni<A>>> : has_mask_load<batch<T, A>>
+    {
+    };
+    template <class T, class A>
+    struct has_mask_store<batch<T, avx512vnni<A>>> : has_mask_store<batch<T, A>>
+    {
+    };
 
 #undef XSIMD_DECLARE_MASK_MEMORY
 #undef XSIMD_DECLARE_MASK_MEMORY_ALIAS
-    }
 
     namespace types
     {
@@ -465,6 +479,7 @@ namespace xsimd
         // mask operations
         XSIMD_INLINE uint64_t mask() const noexcept;
         XSIMD_INLINE static batch_bool from_mask(uint64_t mask) noexcept;
+        XSIMD_INLINE static batch_bool first_n(std::size_t n) noexcept;
 
         // comparison operators
         XSIMD_INLINE batch_bool operator==(batch_bool const& other) const noexcept;
@@ -1282,6 +1297,20 @@ namespace xsimd
         return kernel::from_mask(batch_bool<T, A>(), mask, A {});
     }
 
+    /**
+     * Build a @c batch_bool whose first @c n lanes are set and whose other
+     * lanes are cleared, as the SVE @c whilelt instruction. It is the mask of
+     * the @c n remaining elements of an array when @c n is lower than @c size,
+     * and is all set otherwise.
+     *
+     * @return the predicate of the first @c n lanes
+     */
+    template <class T, class A>
+    XSIMD_INLINE batch_bool<T, A> batch_bool<T, A>::first_n(std::size_t n) noexcept
+    {
+        return kernel::first_n(batch_bool<T, A>(), n, A {});
+    }
+
     template <class T, class A>
     XSIMD_INLINE bool batch_bool<T, A>::get(std::size_t i) const noexcept
     {
@@ -140,6 +140,46 @@ namespace xsimd
      */
     template <typename T>
     using widen_t = typename detail::remap_num<T, /* factor= */ 2>::type;
+
+    namespace detail
+    {
+        template <typename T, typename = void>
+        struct halve_num
+        {
+            using type = void;
+        };
+
+        template <typename T>
+        struct halve_num<T, std::enable_if_t<std::is_floating_point_v<T>>>
+        {
+            using type = xsimd::sized_fp_t<sizeof(T) / 2>;
+        };
+
+        template <typename T>
+        struct halve_num<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) > 1)>>
+        {
+            using type = xsimd::sized_int_t<sizeof(T) / 2>;
+        };
+
+        template <typename T>
+        struct halve_num<T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && (sizeof(T) > 1)>>
+        {
+            using type = xsimd::sized_uint_t<sizeof(T) / 2>;
+        };
+    }
+
+    /**
+     * @ingroup type_traits
+     *
+     * The next-narrower arithmetic type for @c T, the inverse of @c widen_t:
+     * halves the size while preserving signedness for integers and yields
+     * @c float for @c double.
+     * Supported input types: @c [u]int{16,32,64}_t and @c double.
+     *
+     * @tparam T arithmetic type to narrow.
+     */
+    template <typename T>
+    using narrow_t = typename detail::halve_num<T>::type;
 }
 
 #endif
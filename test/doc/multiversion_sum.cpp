@@ -0,0 +1,3 @@
+// compiled once per architecture by xsimd_add_multiversion
+#include "multiversion_sum.hpp"
+template float multiversion_sum::operator()<XSIMD_MULTIVERSION_ARCH, float>(XSIMD_MULTIVERSION_ARCH, float const*, unsigned);
@@ -0,0 +1,34 @@
+#ifndef _MULTIVERSION_SUM_HPP
+#define _MULTIVERSION_SUM_HPP
+#include "xsimd/xsimd.hpp"
+
+// Generated by xsimd_add_multiversion(test_doc_multiversion_sum ...)
+#include "test_doc_multiversion_sum_archs.hpp"
+
+struct multiversion_sum
+{
+    template <class Arch, class T>
+    T operator()(Arch, T const* data, unsigned size);
+};
+
+template <class Arch, class T>
+T multiversion_sum::operator()(Arch, T const* data, unsigned size)
+{
+    using batch = xsimd::batch<T, Arch>;
+    batch acc(static_cast<T>(0));
+    const unsigned n = size / batch::size * batch::size;
+    for (unsigned i = 0; i != n; i += batch::size)
+        acc += batch::load_unaligned(data + i);
+    T star_acc = xsimd::reduce_add(acc);
+    for (unsigned i = n; i < size; ++i)
+        star_acc += data[i];
+    return star_acc;
+}
+
+// Inform the compiler that the implementations for every architecture
+// passed to xsimd_add_multiversion are found in other compilation units.
+#define MULTIVERSION_SUM_EXTERN(ARCH) \
+    extern template float multiversion_sum::operator()<ARCH, float>(ARCH, float const*, unsigned);
+TEST_DOC_MULTIVERSION_SUM_FOR_EACH_ARCH(MULTIVERSION_SUM_EXTERN)
+#undef MULTIVERSION_SUM_EXTERN
+#endif
@@ -0,0 +1,11 @@
+// compiled without any architecture specific flag
+#include "multiversion_sum.hpp"
+
+float dispatched_sum(float const* data, unsigned size)
+{
+    // Resolved once, on first call, to the best available implementation.
+    static const xsimd::dispatch_table<float(float const*, unsigned),
+                                       TEST_DOC_MULTIVERSION_SUM_ARCH_LIST>
+        table(multiversion_sum {});
+    return table(data, size);
+}
@@ -144,6 +144,19 @@ TEST_CASE("[multi arch support]")
 #endif
     }
 
+    SUBCASE("xsimd::dispatch_table")
+    {
+        float data[17] = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f, 16.f, 17.f };
+        float ref = std::accumulate(std::begin(data), std::end(data), 0.f);
+
+        static const xsimd::dispatch_table<float(float const*, unsigned)> table(sum {});
+        CHECK_EQ(ref, table(data, 17));
+        CHECK_EQ(std::string(table.arch_name()), std::string(xsimd::best_arch::name()));
+
+        xsimd::dispatch_table<float(float const*, unsigned), xsimd::arch_list<xsimd::best_arch>> best(sum {});
+        CHECK_EQ(ref, best.function()(data, 17));
+    }
+
     SUBCASE("xsimd::make_sized_batch_t")
     {
         using batch4f = xsimd::make_sized_batch_t<float, 4>;
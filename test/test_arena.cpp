@@ -0,0 +1,84 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/memory/xsimd_arena.hpp"
+#if defined(__cpp_lib_memory_resource)
+
+#include <doctest/doctest.h>
+
+#include <type_traits>
+
+TEST_SUITE("arena")
+{
+    TEST_CASE("aligned blocks")
+    {
+        xsimd::arena_resource<> arena(256);
+        for (std::size_t i = 1; i < 100; ++i)
+        {
+            void* p = arena.allocate(i * 3, 1);
+            CHECK_UNARY(xsimd::is_aligned(p));
+        }
+        void* p = arena.allocate(64, 4096);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(p) % 4096, std::uintptr_t(0));
+    }
+
+    TEST_CASE("reset reuses chunks")
+    {
+        xsimd::arena_resource<> arena(1024);
+        void* first = arena.allocate(100);
+        for (int i = 0; i < 50; ++i)
+            (void)arena.allocate(100);
+        std::size_t capacity = arena.capacity();
+        arena.reset();
+        CHECK_EQ(arena.allocate(100), first);
+        for (int i = 0; i < 50; ++i)
+            (void)arena.allocate(100);
+        CHECK_EQ(arena.capacity(), capacity);
+        arena.release();
+        CHECK_EQ(arena.capacity(), std::size_t(0));
+    }
+
+    TEST_CASE("scratch scope")
+    {
+        auto& arena = xsimd::scratch_arena();
+        void* outer = arena.allocate(32);
+        void* inner;
+        {
+            xsimd::scratch_scope<> scope;
+            inner = arena.allocate(32);
+            CHECK_NE(inner, outer);
+        }
+        CHECK_EQ(arena.allocate(32), inner);
+        arena.reset();
+    }
+
+    TEST_CASE("pmr containers")
+    {
+        xsimd::arena_resource<> arena;
+        std::pmr::vector<float> v(&arena);
+        v.resize(1000, 1.f);
+        CHECK_UNARY(xsimd::is_aligned(v.data()));
+
+        xsimd::pmr::aligned_vector<double> w(&arena);
+        w.resize(17, 2.);
+        CHECK_UNARY(xsimd::is_aligned(w.data()));
+        CHECK_UNARY((std::is_same_v<xsimd::container_alignment_t<decltype(w)>, xsimd::aligned_mode>));
+
+        using batch_type = xsimd::batch<double>;
+        auto b = batch_type::load(w.data(), xsimd::container_alignment_t<decltype(w)> {});
+        CHECK_EQ(xsimd::reduce_add(b), 2. * batch_type::size);
+    }
+}
+#endif
+#endif
@@ -739,6 +739,19 @@ struct batch_bool_test
         CHECK_EQ(batch_bool_type::from_mask(bool_g.interspersed.mask()).mask(), bool_g.interspersed.mask());
     }
 
+    void test_first_n() const
+    {
+        constexpr std::size_t size = batch_bool_type::size;
+        const uint64_t full_mask = ((uint64_t)-1) >> (64 - size);
+        for (std::size_t n = 0; n <= size + 2; ++n)
+        {
+            INFO("n = ", n);
+            const uint64_t expected = n >= size ? full_mask : ((uint64_t)1 << n) - 1;
+            CHECK_EQ(batch_bool_type::first_n(n).mask(), expected);
+        }
+        CHECK_EQ(batch_bool_type::first_n(std::size_t(-1)).mask(), full_mask);
+    }
+
     void test_count() const
     {
         auto bool_g = xsimd::get_bool<batch_bool_type> {};
@@ -914,6 +927,8 @@ TEST_CASE_TEMPLATE("[xsimd batch bool]", B, BATCH_TYPES)
 
     SUBCASE("mask") { Test.test_mask(); }
 
+    SUBCASE("first_n") { Test.test_first_n(); }
+
     SUBCASE("count") { Test.test_count(); }
 
     SUBCASE("count{l,r}_{zero,one}") { Test.test_count_lr(); }
@@ -226,4 +226,61 @@ TEST_CASE_TEMPLATE("[bit operations]", T,
     SUBCASE("countr_one") { Test.test_countr_one(); }
 }
 
+// lane-wise popcount, countl_zero and countr_zero of integer batches
+template <class B>
+struct batch_bit_test
+{
+    using batch_type = B;
+    using value_type = typename B::value_type;
+    static constexpr size_t size = B::size;
+    using array_type = std::array<value_type, size>;
+
+    void test_bit_count() const
+    {
+        using unsigned_type = std::make_unsigned_t<value_type>;
+        constexpr int bits = sizeof(value_type) * CHAR_BIT;
+        // zero, all ones, single bits at both ends and mixed patterns
+        std::array<unsigned_type, 8> const patterns = { {
+            unsigned_type(0),
+            unsigned_type(~unsigned_type(0)),
+            unsigned_type(1),
+            unsigned_type(unsigned_type(1) << (bits - 1)),
+            unsigned_type(0x5A),
+            unsigned_type(unsigned_type(0x0F) << (bits - 8)),
+            unsigned_type(unsigned_type(0xA5A5A5A5A5A5A5A5ull) & unsigned_type(~unsigned_type(3))),
+            unsigned_type(0x1230) } };
+
+        array_type input, popcount_expected, countl_expected, countr_expected;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            unsigned_type const u = patterns[i % patterns.size()] ^ unsigned_type(i / patterns.size());
+            int ones = 0, leading = 0, trailing = 0;
+            for (int b = 0; b < bits; ++b)
+                ones += (u >> b) & 1;
+            while (leading < bits && !((u >> (bits - 1 - leading)) & 1))
+                ++leading;
+            while (trailing < bits && !((u >> trailing) & 1))
+                ++trailing;
+            input[i] = static_cast<value_type>(u);
+            popcount_expected[i] = static_cast<value_type>(ones);
+            countl_expected[i] = static_cast<value_type>(leading);
+            countr_expected[i] = static_cast<value_type>(trailing);
+        }
+        batch_type const x = batch_type::load_unaligned(input.data());
+        INFO("popcount");
+        CHECK_BATCH_EQ(xsimd::popcount(x), popcount_expected);
+        INFO("countl_zero");
+        CHECK_BATCH_EQ(xsimd::countl_zero(x), countl_expected);
+        INFO("countr_zero");
+        CHECK_BATCH_EQ(xsimd::countr_zero(x), countr_expected);
+    }
+};
+
+TEST_CASE_TEMPLATE("[batch bit operations]", T,
+                   uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { batch_bit_test<decltype(b)>().test_bit_count(); });
+}
+
 #endif
@@ -0,0 +1,132 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_bitmap.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // random words, with some all-zero and all-one words mixed in
+    std::vector<uint64_t> make_bitmap(std::size_t words, uint64_t seed)
+    {
+        auto bits = detail::make_random_words(words, seed);
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if (i % 11 == 3)
+                bits[i] = 0;
+            else if (i % 13 == 5)
+                bits[i] = ~uint64_t(0);
+        }
+        return bits;
+    }
+
+    std::size_t scalar_cardinality(std::vector<uint64_t> const& bits)
+    {
+        std::size_t count = 0;
+        for (uint64_t word : bits)
+            for (; word != 0; word &= word - 1)
+                ++count;
+        return count;
+    }
+}
+
+template <class B>
+struct bitmap_test
+{
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    // below, at and past the sixteen batches of the Harley-Seal loop, with
+    // every tail of batches and of words
+    static std::vector<std::size_t> lengths()
+    {
+        return { 0, 1, 3, size, 16 * size - 1, 16 * size, 16 * size + 1, 32 * size + size + 1, 515 };
+    }
+
+    void test_operations() const
+    {
+        for (std::size_t words : lengths())
+        {
+            INFO("words = ", words);
+            auto const a = make_bitmap(words, 0x9E3779B97F4A7C15ull);
+            auto const b = make_bitmap(words, 0xD1B54A32D192ED03ull);
+            std::vector<uint64_t> expected_and(words), expected_or(words), expected_xor(words), expected_andnot(words);
+            for (std::size_t i = 0; i < words; ++i)
+            {
+                expected_and[i] = a[i] & b[i];
+                expected_or[i] = a[i] | b[i];
+                expected_xor[i] = a[i] ^ b[i];
+                expected_andnot[i] = a[i] & ~b[i];
+            }
+
+            CHECK_EQ(xsimd::bitmap_cardinality<arch_type>(a.data(), words), scalar_cardinality(a));
+
+            std::vector<uint64_t> out(words);
+            CHECK_EQ(xsimd::bitmap_and<arch_type>(a.data(), b.data(), out.data(), words), scalar_cardinality(expected_and));
+            CHECK(out == expected_and);
+            CHECK_EQ(xsimd::bitmap_or<arch_type>(a.data(), b.data(), out.data(), words), scalar_cardinality(expected_or));
+            CHECK(out == expected_or);
+            CHECK_EQ(xsimd::bitmap_xor<arch_type>(a.data(), b.data(), out.data(), words), scalar_cardinality(expected_xor));
+            CHECK(out == expected_xor);
+            CHECK_EQ(xsimd::bitmap_andnot<arch_type>(a.data(), b.data(), out.data(), words), scalar_cardinality(expected_andnot));
+            CHECK(out == expected_andnot);
+
+            CHECK_EQ(xsimd::bitmap_and_cardinality<arch_type>(a.data(), b.data(), words), scalar_cardinality(expected_and));
+            CHECK_EQ(xsimd::bitmap_or_cardinality<arch_type>(a.data(), b.data(), words), scalar_cardinality(expected_or));
+            CHECK_EQ(xsimd::bitmap_xor_cardinality<arch_type>(a.data(), b.data(), words), scalar_cardinality(expected_xor));
+            CHECK_EQ(xsimd::bitmap_andnot_cardinality<arch_type>(a.data(), b.data(), words), scalar_cardinality(expected_andnot));
+
+            // in place
+            out = a;
+            xsimd::bitmap_and<arch_type>(out.data(), b.data(), out.data(), words);
+            CHECK(out == expected_and);
+        }
+
+        // all ones, so that every counter of the adder tree carries
+        std::vector<uint64_t> const ones(32 * size + 3, ~uint64_t(0));
+        CHECK_EQ(xsimd::bitmap_cardinality<arch_type>(ones.data(), ones.size()), 64 * ones.size());
+    }
+
+    void test_to_indices() const
+    {
+        for (std::size_t words : lengths())
+        {
+            INFO("words = ", words);
+            auto const a = make_bitmap(words, 0x9E3779B97F4A7C15ull);
+            std::vector<uint32_t> expected_indices;
+            for (std::size_t i = 0; i < 64 * words; ++i)
+                if ((a[i / 64] >> (i % 64)) & 1)
+                    expected_indices.push_back(static_cast<uint32_t>(i + 5));
+            std::vector<uint32_t> indices(expected_indices.size() + 1, 0xFFFFFFFFu);
+            CHECK_EQ(xsimd::bitmap_to_indices<arch_type>(a.data(), words, indices.data(), 5), expected_indices.size());
+            CHECK_EQ(indices.back(), 0xFFFFFFFFu);
+            indices.pop_back();
+            CHECK(indices == expected_indices);
+        }
+    }
+};
+
+TEST_CASE("[bitmap]")
+{
+    for_each_arch_batch<uint64_t>([](auto b)
+                                  {
+        bitmap_test<decltype(b)> Test;
+        Test.test_operations();
+        Test.test_to_indices(); });
+}
+#endif
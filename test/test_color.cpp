@@ -0,0 +1,395 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_color.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    using xsimd::pixel_format;
+    using xsimd::yuv_standard;
+
+    struct image_size
+    {
+        std::size_t width;
+        std::size_t height;
+    };
+
+    // includes rows shorter than a batch and odd sizes
+    image_size const image_sizes[] = { { 1, 1 }, { 3, 2 }, { 17, 5 }, { 64, 4 }, { 131, 7 } };
+    yuv_standard const standards[] = { yuv_standard::bt601, yuv_standard::bt709 };
+
+    struct rgb
+    {
+        int r, g, b;
+    };
+
+    template <pixel_format F>
+    constexpr std::size_t bytes_per_pixel()
+    {
+        return F == pixel_format::rgb || F == pixel_format::bgr ? 3 : 4;
+    }
+
+    template <pixel_format F>
+    rgb get_pixel(uint8_t const* p)
+    {
+        if constexpr (F == pixel_format::bgr || F == pixel_format::bgra)
+            return { p[2], p[1], p[0] };
+        else
+            return { p[0], p[1], p[2] };
+    }
+
+    std::vector<uint8_t> make_bytes(std::size_t n, std::size_t seed)
+    {
+        std::vector<uint8_t> res(n);
+        for (std::size_t i = 0; i < n; ++i)
+            res[i] = static_cast<uint8_t>((i * 73 + seed * 31 + i / 5) % 256);
+        // saturated colors at both ends of the range
+        for (std::size_t i = 0; i < n && i < 8; ++i)
+            res[i] = i % 2 ? 255 : 0;
+        return res;
+    }
+
+    // conversions in double precision, then rounded as the integer formulas
+    struct matrix
+    {
+        double y[3], u[3], v[3], r[2], g[2], b[2];
+    };
+
+    matrix get_matrix(yuv_standard s)
+    {
+        if (s == yuv_standard::bt601)
+            return { { 66, 129, 25 }, { -38, -74, 112 }, { 112, -94, -18 }, { 0, 409 }, { -100, -208 }, { 516, 0 } };
+        else
+            return { { 47, 157, 16 }, { -26, -86, 112 }, { 112, -102, -10 }, { 0, 459 }, { -55, -136 }, { 541, 0 } };
+    }
+
+    int shift8(double x)
+    {
+        return static_cast<int>(std::floor((x + 128.) / 256.));
+    }
+
+    uint8_t ref_y(matrix const& m, rgb p) { return uint8_t(shift8(m.y[0] * p.r + m.y[1] * p.g + m.y[2] * p.b) + 16); }
+    uint8_t ref_u(matrix const& m, rgb p) { return uint8_t(shift8(m.u[0] * p.r + m.u[1] * p.g + m.u[2] * p.b) + 128); }
+    uint8_t ref_v(matrix const& m, rgb p) { return uint8_t(shift8(m.v[0] * p.r + m.v[1] * p.g + m.v[2] * p.b) + 128); }
+
+    rgb ref_rgb(matrix const& m, int y, int u, int v)
+    {
+        auto channel = [&](double const* k)
+        { return std::min(std::max(shift8(298. * (y - 16) + k[0] * (u - 128) + k[1] * (v - 128)), 0), 255); };
+        return { channel(m.r), channel(m.g), channel(m.b) };
+    }
+
+    template <pixel_format F>
+    void check_pixel(uint8_t const* p, rgb expected)
+    {
+        rgb const res = get_pixel<F>(p);
+        CHECK_EQ(res.r, expected.r);
+        CHECK_EQ(res.g, expected.g);
+        CHECK_EQ(res.b, expected.b);
+        if constexpr (bytes_per_pixel<F>() == 4)
+            CHECK_EQ(int(p[3]), 255);
+    }
+
+    // rounded average of the 2x2 block at (x, y), borders replicated
+    template <pixel_format F>
+    rgb block_average(std::vector<uint8_t> const& src, std::size_t stride, image_size size, std::size_t x, std::size_t y)
+    {
+        constexpr std::size_t bpp = bytes_per_pixel<F>();
+        std::size_t const x1 = std::min(x + 1, size.width - 1), y1 = std::min(y + 1, size.height - 1);
+        rgb const p[4] = { get_pixel<F>(&src[y * stride + x * bpp]), get_pixel<F>(&src[y * stride + x1 * bpp]),
+                           get_pixel<F>(&src[y1 * stride + x * bpp]), get_pixel<F>(&src[y1 * stride + x1 * bpp]) };
+        return { (p[0].r + p[1].r + p[2].r + p[3].r + 2) / 4, (p[0].g + p[1].g + p[2].g + p[3].g + 2) / 4,
+                 (p[0].b + p[1].b + p[2].b + p[3].b + 2) / 4 };
+    }
+
+    template <pixel_format format, class A>
+    void check_yuv444()
+    {
+        constexpr std::size_t bpp = bytes_per_pixel<format>();
+        for (auto standard : standards)
+            for (auto size : image_sizes)
+            {
+                INFO("standard = ", int(standard), ", width = ", size.width, ", height = ", size.height);
+                matrix const m = get_matrix(standard);
+                std::size_t const stride = size.width * bpp + 5, plane_stride = size.width + 3;
+                auto const src = make_bytes(stride * size.height, 1);
+                std::vector<uint8_t> y(plane_stride * size.height), u(y.size()), v(y.size());
+                xsimd::rgb_to_yuv444<format, A>(src.data(), stride, y.data(), plane_stride, u.data(), plane_stride, v.data(), plane_stride,
+                                                size.width, size.height, standard);
+                for (std::size_t row = 0; row < size.height; ++row)
+                    for (std::size_t col = 0; col < size.width; ++col)
+                    {
+                        rgb const p = get_pixel<format>(&src[row * stride + col * bpp]);
+                        std::size_t const i = row * plane_stride + col;
+                        CHECK_EQ(int(y[i]), int(ref_y(m, p)));
+                        CHECK_EQ(int(u[i]), int(ref_u(m, p)));
+                        CHECK_EQ(int(v[i]), int(ref_v(m, p)));
+                    }
+
+                // arbitrary planes, including values outside of the studio range
+                auto const yp = make_bytes(y.size(), 2), up = make_bytes(y.size(), 3), vp = make_bytes(y.size(), 4);
+                std::vector<uint8_t> dst(stride * size.height);
+                xsimd::yuv444_to_rgb<format, A>(yp.data(), plane_stride, up.data(), plane_stride, vp.data(), plane_stride, dst.data(), stride,
+                                                size.width, size.height, standard);
+                for (std::size_t row = 0; row < size.height; ++row)
+                    for (std::size_t col = 0; col < size.width; ++col)
+                    {
+                        std::size_t const i = row * plane_stride + col;
+                        check_pixel<format>(&dst[row * stride + col * bpp], ref_rgb(m, yp[i], up[i], vp[i]));
+                    }
+            }
+    }
+
+    template <pixel_format format, class A>
+    void check_yuv420()
+    {
+        constexpr std::size_t bpp = bytes_per_pixel<format>();
+        for (auto standard : standards)
+            for (auto size : image_sizes)
+            {
+                INFO("standard = ", int(standard), ", width = ", size.width, ", height = ", size.height);
+                matrix const m = get_matrix(standard);
+                std::size_t const cw = (size.width + 1) / 2, ch = (size.height + 1) / 2;
+                std::size_t const stride = size.width * bpp + 1, y_stride = size.width + 2, c_stride = cw + 1, uv_stride = 2 * cw + 4;
+                auto const src = make_bytes(stride * size.height, 5);
+
+                std::vector<uint8_t> y(y_stride * size.height), u(c_stride * ch), v(c_stride * ch);
+                xsimd::rgb_to_i420<format, A>(src.data(), stride, y.data(), y_stride, u.data(), c_stride, v.data(), c_stride, size.width,
+                                              size.height, standard);
+                std::vector<uint8_t> y12(y.size()), uv(uv_stride * ch);
+                xsimd::rgb_to_nv12<format, A>(src.data(), stride, y12.data(), y_stride, uv.data(), uv_stride, size.width, size.height, standard);
+                CHECK_EQ(y12, y);
+                for (std::size_t row = 0; row < size.height; ++row)
+                    for (std::size_t col = 0; col < size.width; ++col)
+                        CHECK_EQ(int(y[row * y_stride + col]), int(ref_y(m, get_pixel<format>(&src[row * stride + col * bpp]))));
+                for (std::size_t row = 0; row < ch; ++row)
+                    for (std::size_t col = 0; col < cw; ++col)
+                    {
+                        rgb const p = block_average<format>(src, stride, size, 2 * col, 2 * row);
+                        CHECK_EQ(int(u[row * c_stride + col]), int(ref_u(m, p)));
+                        CHECK_EQ(int(v[row * c_stride + col]), int(ref_v(m, p)));
+                        CHECK_EQ(int(uv[row * uv_stride + 2 * col]), int(ref_u(m, p)));
+                        CHECK_EQ(int(uv[row * uv_stride + 2 * col + 1]), int(ref_v(m, p)));
+                    }
+
+                auto const yp = make_bytes(y.size(), 6), up = make_bytes(u.size(), 7), vp = make_bytes(v.size(), 8);
+                std::vector<uint8_t> uvp(uv.size());
+                for (std::size_t row = 0; row < ch; ++row)
+                    for (std::size_t col = 0; col < cw; ++col)
+                    {
+                        uvp[row * uv_stride + 2 * col] = up[row * c_stride + col];
+                        uvp[row * uv_stride + 2 * col + 1] = vp[row * c_stride + col];
+                    }
+                std::vector<uint8_t> dst(stride * size.height), dst12(dst.size());
+                xsimd::i420_to_rgb<format, A>(yp.data(), y_stride, up.data(), c_stride, vp.data(), c_stride, dst.data(), stride, size.width,
+                                              size.height, standard);
+                xsimd::nv12_to_rgb<format, A>(yp.data(), y_stride, uvp.data(), uv_stride, dst12.data(), stride, size.width, size.height, standard);
+                CHECK_EQ(dst12, dst);
+                for (std::size_t row = 0; row < size.height; ++row)
+                    for (std::size_t col = 0; col < size.width; ++col)
+                    {
+                        std::size_t const c = row / 2 * c_stride + col / 2;
+                        check_pixel<format>(&dst[row * stride + col * bpp], ref_rgb(m, yp[row * y_stride + col], up[c], vp[c]));
+                    }
+            }
+    }
+}
+
+TEST_CASE_TEMPLATE("[yuv 444]", F, std::integral_constant<pixel_format, pixel_format::rgb>,
+                   std::integral_constant<pixel_format, pixel_format::bgr>, std::integral_constant<pixel_format, pixel_format::rgba>,
+                   std::integral_constant<pixel_format, pixel_format::bgra>)
+{
+    for_each_arch([](auto arch)
+                  { check_yuv444<F::value, decltype(arch)>(); });
+}
+
+TEST_CASE_TEMPLATE("[yuv 420]", F, std::integral_constant<pixel_format, pixel_format::rgb>,
+                   std::integral_constant<pixel_format, pixel_format::bgr>, std::integral_constant<pixel_format, pixel_format::rgba>,
+                   std::integral_constant<pixel_format, pixel_format::bgra>)
+{
+    for_each_arch([](auto arch)
+                  { check_yuv420<F::value, decltype(arch)>(); });
+}
+
+namespace
+{
+    template <class A>
+    void check_known_colors()
+    {
+        std::size_t const n = 67;
+        for (auto standard : standards)
+        {
+            std::vector<uint8_t> white(3 * n, 255), black(3 * n, 0), y(n), u(n), v(n);
+            xsimd::rgb_to_yuv444<pixel_format::rgb, A>(white.data(), 3 * n, y.data(), n, u.data(), n, v.data(), n, n, 1, standard);
+            CHECK_EQ(y, std::vector<uint8_t>(n, 235));
+            CHECK_EQ(u, std::vector<uint8_t>(n, 128));
+            CHECK_EQ(v, std::vector<uint8_t>(n, 128));
+            xsimd::rgb_to_yuv444<pixel_format::rgb, A>(black.data(), 3 * n, y.data(), n, u.data(), n, v.data(), n, n, 1, standard);
+            CHECK_EQ(y, std::vector<uint8_t>(n, 16));
+            CHECK_EQ(u, std::vector<uint8_t>(n, 128));
+            CHECK_EQ(v, std::vector<uint8_t>(n, 128));
+
+            // round trip of the studio range extremes
+            std::vector<uint8_t> rgb(3 * n);
+            std::fill(y.begin(), y.end(), uint8_t(235));
+            std::fill(u.begin(), u.end(), uint8_t(128));
+            std::fill(v.begin(), v.end(), uint8_t(128));
+            xsimd::yuv444_to_rgb<pixel_format::rgb, A>(y.data(), n, u.data(), n, v.data(), n, rgb.data(), 3 * n, n, 1, standard);
+            CHECK_EQ(rgb, white);
+            std::fill(y.begin(), y.end(), uint8_t(16));
+            xsimd::yuv444_to_rgb<pixel_format::rgb, A>(y.data(), n, u.data(), n, v.data(), n, rgb.data(), 3 * n, n, 1, standard);
+            CHECK_EQ(rgb, black);
+        }
+    }
+}
+
+TEST_CASE("[yuv known colors]")
+{
+    for_each_arch([](auto arch)
+                  { check_known_colors<decltype(arch)>(); });
+}
+
+namespace
+{
+    template <pixel_format From, pixel_format To, class A>
+    void check_convert_pixels()
+    {
+        constexpr std::size_t from_bpp = bytes_per_pixel<From>(), to_bpp = bytes_per_pixel<To>();
+        for (std::size_t n : { 1, 5, 16, 33, 100, 257 })
+        {
+            INFO("from = ", int(From), ", to = ", int(To), ", n = ", n);
+            auto const src = make_bytes(n * from_bpp, 9);
+            std::vector<uint8_t> dst(n * to_bpp);
+            xsimd::convert_pixels<From, To, A>(src.data(), dst.data(), n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                rgb const p = get_pixel<From>(&src[i * from_bpp]), q = get_pixel<To>(&dst[i * to_bpp]);
+                CHECK_EQ(q.r, p.r);
+                CHECK_EQ(q.g, p.g);
+                CHECK_EQ(q.b, p.b);
+                if constexpr (to_bpp == 4)
+                    CHECK_EQ(int(dst[i * to_bpp + 3]), from_bpp == 4 ? int(src[i * from_bpp + 3]) : 255);
+            }
+        }
+    }
+
+    template <pixel_format From, class A>
+    void check_convert_pixels_from()
+    {
+        check_convert_pixels<From, pixel_format::rgb, A>();
+        check_convert_pixels<From, pixel_format::bgr, A>();
+        check_convert_pixels<From, pixel_format::rgba, A>();
+        check_convert_pixels<From, pixel_format::bgra, A>();
+    }
+}
+
+TEST_CASE("[convert pixels]")
+{
+    for_each_arch([](auto arch)
+                  {
+        using A = decltype(arch);
+        check_convert_pixels_from<pixel_format::rgb, A>();
+        check_convert_pixels_from<pixel_format::bgr, A>();
+        check_convert_pixels_from<pixel_format::rgba, A>();
+        check_convert_pixels_from<pixel_format::bgra, A>(); });
+}
+
+namespace
+{
+    template <class A>
+    void check_premultiply_alpha()
+    {
+        // every color and alpha combination
+        std::size_t const n = 256 * 256 + 3;
+        std::vector<uint8_t> src(4 * n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            src[4 * i] = static_cast<uint8_t>(i % 256);
+            src[4 * i + 1] = static_cast<uint8_t>(255 - i % 256);
+            src[4 * i + 2] = static_cast<uint8_t>(i * 7 % 256);
+            src[4 * i + 3] = static_cast<uint8_t>(i / 256 % 256);
+        }
+        std::vector<uint8_t> premultiplied(src.size());
+        xsimd::premultiply_alpha<A>(src.data(), premultiplied.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            int const a = src[4 * i + 3];
+            CHECK_EQ(int(premultiplied[4 * i + 3]), a);
+            for (std::size_t k = 0; k < 3; ++k)
+                CHECK_EQ(int(premultiplied[4 * i + k]), int(std::lround(src[4 * i + k] * a / 255.)));
+        }
+
+        std::vector<uint8_t> res(src.size());
+        xsimd::unpremultiply_alpha<A>(premultiplied.data(), res.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            int const a = premultiplied[4 * i + 3];
+            CHECK_EQ(int(res[4 * i + 3]), a);
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                int const c = premultiplied[4 * i + k];
+                int const expected = a == 0 ? 0 : std::min((2 * 255 * c + a) / (2 * a), 255);
+                CHECK_EQ(int(res[4 * i + k]), expected);
+            }
+        }
+
+        // in place
+        res = src;
+        xsimd::premultiply_alpha<A>(res.data(), res.data(), n);
+        CHECK_EQ(res, premultiplied);
+    }
+}
+
+TEST_CASE("[premultiply alpha]")
+{
+    for_each_arch([](auto arch)
+                  { check_premultiply_alpha<decltype(arch)>(); });
+}
+
+namespace
+{
+    template <pixel_format format, class A>
+    void check_rgb_to_gray()
+    {
+        constexpr std::size_t bpp = bytes_per_pixel<format>();
+        for (std::size_t n : { 1, 7, 32, 65, 300 })
+        {
+            INFO("n = ", n);
+            auto const src = make_bytes(n * bpp, 10);
+            std::vector<uint8_t> dst(n);
+            xsimd::rgb_to_gray<format, A>(src.data(), dst.data(), n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                rgb const p = get_pixel<format>(&src[i * bpp]);
+                CHECK_EQ(int(dst[i]), int(std::floor((77. * p.r + 150. * p.g + 29. * p.b) / 256. + 0.5)));
+            }
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("[rgb to gray]", F, std::integral_constant<pixel_format, pixel_format::rgb>,
+                   std::integral_constant<pixel_format, pixel_format::bgr>, std::integral_constant<pixel_format, pixel_format::rgba>,
+                   std::integral_constant<pixel_format, pixel_format::bgra>)
+{
+    for_each_arch([](auto arch)
+                  { check_rgb_to_gray<F::value, decltype(arch)>(); });
+}
+#endif
@@ -0,0 +1,135 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_complex_mac.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // small multiples of 1/4, so that products and short sums are exact
+    template <class T>
+    std::vector<std::complex<T>> make_complex_operand(std::size_t size, std::size_t seed)
+    {
+        std::vector<std::complex<T>> res(size);
+        for (std::size_t i = 0; i < size; ++i)
+            res[i] = { static_cast<T>(int((i * 7 + seed * 13) % 17) - 8) / T(4),
+                       static_cast<T>(int((i * 5 + seed * 11) % 13) - 6) / T(4) };
+        return res;
+    }
+
+    template <class T>
+    bool near(std::complex<T> x, std::complex<T> y, T tol)
+    {
+        return std::abs(x - y) <= tol * std::max(T(1), std::abs(y));
+    }
+}
+
+TEST_CASE_TEMPLATE("[interleaved complex]", T, float, double)
+{
+    using batch_type = xsimd::batch<T>;
+    constexpr std::size_t n = batch_type::size / 2;
+    auto const x = make_complex_operand<T>(n, 1);
+    auto y = make_complex_operand<T>(n, 2);
+    auto const z = make_complex_operand<T>(n, 3);
+    for (auto& v : y)
+        if (v == std::complex<T>(0))
+            v = { T(1), T(-1) };
+
+    auto const xb = batch_type::load_unaligned(reinterpret_cast<T const*>(x.data()));
+    auto const yb = batch_type::load_unaligned(reinterpret_cast<T const*>(y.data()));
+    auto const zb = batch_type::load_unaligned(reinterpret_cast<T const*>(z.data()));
+    std::vector<std::complex<T>> res(n);
+
+    SUBCASE("mul")
+    {
+        xsimd::interleaved_mul(xb, yb).store_unaligned(reinterpret_cast<T*>(res.data()));
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK_EQ(res[i], x[i] * y[i]);
+    }
+
+    SUBCASE("fma")
+    {
+        xsimd::interleaved_fma(xb, yb, zb).store_unaligned(reinterpret_cast<T*>(res.data()));
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK_EQ(res[i], x[i] * y[i] + z[i]);
+    }
+
+    SUBCASE("div")
+    {
+        xsimd::interleaved_div(xb, yb).store_unaligned(reinterpret_cast<T*>(res.data()));
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK_UNARY(near(res[i], x[i] / y[i], 4 * std::numeric_limits<T>::epsilon()));
+    }
+
+    SUBCASE("div without overflow")
+    {
+        T const big = std::numeric_limits<T>::max() / T(4);
+        T const tiny = std::numeric_limits<T>::min() * T(4);
+        std::vector<std::complex<T>> num(n), den(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            num[i] = i % 2 ? std::complex<T>(tiny, tiny) : std::complex<T>(big, T(0));
+            den[i] = i % 2 ? std::complex<T>(tiny, -tiny) : std::complex<T>(big, big);
+        }
+        auto const q = xsimd::interleaved_div(batch_type::load_unaligned(reinterpret_cast<T const*>(num.data())),
+                                              batch_type::load_unaligned(reinterpret_cast<T const*>(den.data())));
+        q.store_unaligned(reinterpret_cast<T*>(res.data()));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const expected = i % 2 ? std::complex<T>(T(0), T(1)) : std::complex<T>(T(0.5), T(-0.5));
+            CHECK_UNARY(near(res[i], expected, 4 * std::numeric_limits<T>::epsilon()));
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("[complex mac]", T, float, double)
+{
+    for (std::size_t n : { 0, 1, 3, 8, 17, 64, 101 })
+    {
+        auto const x = make_complex_operand<T>(n, 1);
+        auto const y = make_complex_operand<T>(n, 2);
+
+        std::complex<T> dot(0), dotc(0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            dot += x[i] * y[i];
+            dotc += std::conj(x[i]) * y[i];
+        }
+        CHECK_EQ(xsimd::complex_dot(x.data(), y.data(), n), dot);
+        CHECK_EQ(xsimd::complex_dotc(x.data(), y.data(), n), dotc);
+
+        auto acc = make_complex_operand<T>(n + 1, 3);
+        auto expected = acc;
+        for (std::size_t i = 0; i < n; ++i)
+            expected[i] += x[i] * y[i];
+        xsimd::complex_mac(x.data(), y.data(), acc.data(), n);
+        CHECK_EQ(acc, expected);
+
+        std::complex<T> const a(T(0.75), T(-1.5));
+        auto out = make_complex_operand<T>(n + 1, 4);
+        expected = out;
+        for (std::size_t i = 0; i < n; ++i)
+            expected[i] += a * x[i];
+        xsimd::complex_axpy(a, x.data(), out.data(), n);
+        CHECK_EQ(out, expected);
+    }
+}
+#endif
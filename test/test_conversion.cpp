@@ -12,6 +12,8 @@
 #include "xsimd/xsimd.hpp"
 #ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
 
+#include <cstring>
+
 #include "test_utils.hpp"
 
 #if !XSIMD_WITH_NEON || XSIMD_WITH_NEON64
@@ -257,6 +259,27 @@ struct widening_test
         CHECK_BATCH_EQ(widened_batch[0], wvalue);
         CHECK_BATCH_EQ(widened_batch[1], wvalue);
     }
+
+    // distinct lanes of both signs, so that the lane order and the sign or
+    // zero extension are checked
+    void test_widen_lanes()
+    {
+        using wide_type = xsimd::widen_t<T>;
+        constexpr std::size_t size = xsimd::batch<T>::size;
+        std::array<T, size> in;
+        std::array<wide_type, size> expected;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            in[i] = static_cast<T>(i % 2 ? i * 37 + 3 : std::numeric_limits<T>::max() - static_cast<T>(i));
+            if constexpr (std::is_signed_v<T>)
+                in[i] = i % 4 == 0 ? -in[i] : in[i];
+            expected[i] = static_cast<wide_type>(in[i]);
+        }
+        auto const widened_batch = xsimd::widen(xsimd::batch<T>::load_unaligned(in.data()));
+        constexpr std::size_t half = xsimd::batch<wide_type>::size;
+        CHECK_BATCH_EQ(widened_batch[0], xsimd::batch<wide_type>::load_unaligned(expected.data()));
+        CHECK_BATCH_EQ(widened_batch[1], xsimd::batch<wide_type>::load_unaligned(expected.data() + half));
+    }
 };
 
 TEST_CASE_TEMPLATE("[widening]", T, int8_t, int16_t, int32_t, uint8_t, uint16_t, uint32_t, float)
@@ -273,6 +296,114 @@ TEST_CASE_TEMPLATE("[widening]", T, int8_t, int16_t, int32_t, uint8_t, uint16_t,
         Test.test_widen(std::numeric_limits<T>::max());
         Test.test_widen(std::numeric_limits<T>::min());
     }
+
+    SUBCASE("lanes")
+    {
+        Test.test_widen_lanes();
+    }
+}
+
+template <class B>
+struct narrowing_test
+{
+    using batch_type = B;
+    using T = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    using narrow_type = xsimd::narrow_t<T>;
+    static constexpr std::size_t size = batch_type::size;
+
+    // distinct lanes spanning the whole range of T, so that both the lane
+    // order and the handling of out of range values are checked
+    static std::array<T, 2 * size> make_input()
+    {
+        std::array<T, 2 * size> res;
+        for (std::size_t i = 0; i < res.size(); ++i)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                T const values[] = { T(1.5), T(-2.25), T(1e300), T(-1e300), T(0.1), std::numeric_limits<T>::infinity(), T(3e38), T(-4e38) };
+                res[i] = values[i % 8] + T(i / 8);
+            }
+            else
+            {
+                T const values[] = { T(1), T(-1), std::numeric_limits<T>::max(), std::numeric_limits<T>::min(),
+                                     T(std::numeric_limits<narrow_type>::max()), T(std::numeric_limits<narrow_type>::min()),
+                                     T(T(std::numeric_limits<narrow_type>::max()) + 1), T(T(std::numeric_limits<narrow_type>::min()) - 1) };
+                res[i] = T(std::make_unsigned_t<T>(values[i % 8]) + std::make_unsigned_t<T>(i / 8));
+            }
+        }
+        return res;
+    }
+
+    template <class U>
+    static U saturate(T x)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isfinite(x) && std::abs(x) > T(std::numeric_limits<U>::max()))
+                return std::copysign(std::numeric_limits<U>::max(), U(x));
+            return static_cast<U>(x);
+        }
+        else
+        {
+            // U is narrower than T, so that its range fits in the 64-bit type of the sign of T
+            using wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+            if (std::is_signed_v<T> && wide(x) < wide(std::numeric_limits<U>::min()))
+                return std::numeric_limits<U>::min();
+            if (wide(x) > wide(std::numeric_limits<U>::max()))
+                return std::numeric_limits<U>::max();
+            return static_cast<U>(x);
+        }
+    }
+
+    template <class U>
+    static void check(xsimd::batch<U, arch_type> const& res, std::array<T, 2 * size> const& in, bool saturating)
+    {
+        std::array<U, 2 * size> out;
+        res.store_unaligned(out.data());
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            INFO("lane ", i);
+            U const expected = saturating ? saturate<U>(in[i]) : static_cast<U>(in[i]);
+            if constexpr (std::is_floating_point_v<U>)
+                CHECK_EQ(std::memcmp(&out[i], &expected, sizeof(U)), 0);
+            else
+                CHECK_EQ(out[i], expected);
+        }
+    }
+
+    void test_narrow()
+    {
+        auto const in = make_input();
+        auto const lo = batch_type::load_unaligned(in.data());
+        auto const hi = batch_type::load_unaligned(in.data() + size);
+        check<narrow_type>(xsimd::narrow(lo, hi), in, false);
+        check<narrow_type>(xsimd::narrow_saturate(lo, hi), in, true);
+        if constexpr (std::is_integral_v<T>)
+        {
+            using other_sign = std::conditional_t<std::is_signed_v<narrow_type>, std::make_unsigned_t<narrow_type>, std::make_signed_t<narrow_type>>;
+            check<other_sign>(xsimd::narrow_saturate<other_sign>(lo, hi), in, true);
+        }
+    }
+
+    void test_round_trip()
+    {
+        std::array<narrow_type, 2 * size> in;
+        for (std::size_t i = 0; i < in.size(); ++i)
+            in[i] = static_cast<narrow_type>(i * 37 + 3);
+        auto const x = xsimd::batch<narrow_type, arch_type>::load_unaligned(in.data());
+        auto const wide = xsimd::widen(x);
+        CHECK_BATCH_EQ(xsimd::narrow(wide[0], wide[1]), x);
+    }
+};
+
+TEST_CASE_TEMPLATE("[narrowing]", T, int16_t, int32_t, int64_t, uint16_t, uint32_t, uint64_t, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           {
+        narrowing_test<decltype(b)> Test;
+        Test.test_narrow();
+        Test.test_round_trip(); });
 }
 
 #endif
@@ -9,6 +9,7 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include "xsimd/config/xsimd_cpu_topology.hpp"
 #include "xsimd/xsimd.hpp"
 
 #include <doctest/doctest.h>
@@ -78,6 +79,8 @@ TEST_CASE("[cpu_features] x86 implication chains")
     CHECK_IMPLICATION(cpu.avx512vbmi(), cpu.avx512f());
     CHECK_IMPLICATION(cpu.avx512vbmi2(), cpu.avx512f());
     CHECK_IMPLICATION(cpu.avx512vnni_bw(), cpu.avx512bw());
+    CHECK_IMPLICATION(cpu.avx512_vpopcntdq(), cpu.avx512f());
+    CHECK_IMPLICATION(cpu.avx512_bitalg(), cpu.avx512f());
     CHECK_IMPLICATION(cpu.avxvnni(), cpu.avx2());
 }
 
@@ -185,3 +188,29 @@ TEST_CASE("[cpu_features] IBM Z (s390x) features from environment")
 
     CHECK_ENV_FEATURE("XSIMD_TEST_CPU_ASSUME_VXE", cpu.vxe());
 }
+
+TEST_CASE("[cpu_topology] consistency")
+{
+    auto const& topo = xsimd::available_topology();
+
+    CHECK_EQ(&topo, &xsimd::available_topology());
+    CHECK_GE(topo.logical_cores, 1u);
+    CHECK_GE(topo.threads_per_core, 1u);
+    CHECK_GE(topo.physical_cores, 1u);
+    CHECK_LE(topo.physical_cores, topo.logical_cores);
+
+    auto const line = topo.cache_line_size();
+    CHECK_UNARY(line != 0 && (line & (line - 1)) == 0);
+
+    CHECK_EQ(topo.cache_size(1), topo.l1d.size);
+    CHECK_EQ(topo.cache_size(2), topo.l2.size);
+    CHECK_EQ(topo.cache_size(3), topo.l3.size);
+    CHECK_EQ(topo.cache_size(4), 0u);
+
+    CHECK_IMPLICATION(topo.l1d.size != 0 && topo.l2.size != 0, topo.l1d.size <= topo.l2.size);
+    CHECK_IMPLICATION(topo.l1d.size != 0, topo.l1d.line_size != 0);
+#if XSIMD_TARGET_X86
+    // cpuid leaf 4 or 0x8000001D is available on every x86-64 processor in use
+    CHECK_IMPLICATION(xsimd::available_architectures().sse2 && sizeof(void*) == 8, topo.l1d.size != 0);
+#endif
+}
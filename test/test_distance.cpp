@@ -0,0 +1,296 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_distance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // half bit pattern of a value above, all exactly representable
+    xsimd::fp16 to_fp16(float x)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        uint16_t const sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        if ((bits & 0x7FFFFFFFu) == 0)
+            return { sign };
+        uint32_t const exp = ((bits >> 23) & 0xFFu) - 127u + 15u;
+        return { static_cast<uint16_t>(sign | (exp << 10) | ((bits >> 13) & 0x3FFu)) };
+    }
+
+    float from_fp16(uint16_t h)
+    {
+        int const exp = (h >> 10) & 0x1F;
+        int const mantissa = h & 0x3FF;
+        float const sign = (h & 0x8000) ? -1.f : 1.f;
+        if (exp == 0)
+            return sign * std::ldexp(float(mantissa), -24);
+        if (exp == 31)
+            return mantissa ? std::numeric_limits<float>::quiet_NaN() : sign * std::numeric_limits<float>::infinity();
+        return sign * std::ldexp(float(mantissa | 0x400), exp - 25);
+    }
+
+    template <class T>
+    struct vectors
+    {
+        std::vector<T> queries, points;
+        std::vector<double> fq, fp; // the same values, for the reference
+    };
+
+    template <class T>
+    T encode(float x);
+    template <>
+    float encode<float>(float x) { return x; }
+    template <>
+    xsimd::fp16 encode<xsimd::fp16>(float x) { return to_fp16(x); }
+    template <>
+    int8_t encode<int8_t>(float x) { return static_cast<int8_t>(x * 32.f); }
+
+    template <class T>
+    double decode(float x) { return std::is_same<T, int8_t>::value ? double(x * 32.f) : double(x); }
+
+    // multiples of 1/4 in [-4, 4), so that float sums over the tested
+    // dimensions are exact whatever their order; the moduli differ so that
+    // no point repeats a query
+    template <class T>
+    vectors<T> make_vectors(std::size_t nq, std::size_t np, std::size_t dim)
+    {
+        vectors<T> v;
+        for (int x : detail::make_hashed_values<int>(nq * dim, 32, -16))
+        {
+            v.queries.push_back(encode<T>(float(x) / 4.f));
+            v.fq.push_back(decode<T>(float(x) / 4.f));
+        }
+        for (int x : detail::make_hashed_values<int>(np * dim, 31, -15))
+        {
+            v.points.push_back(encode<T>(float(x) / 4.f));
+            v.fp.push_back(decode<T>(float(x) / 4.f));
+        }
+        return v;
+    }
+}
+
+template <class T, class A>
+struct distance_test
+{
+    using value_type = T;
+    using arch_type = A;
+
+    // the unrolled, single batch and scalar parts of the sums
+    void test_distances() const
+    {
+        constexpr std::size_t nq = 6, np = 5;
+        constexpr std::size_t size = xsimd::batch<xsimd::distance_t<T>, A>::size;
+        for (std::size_t dim : { std::size_t(1), std::size_t(3), size - 1, size, size + 1, 4 * size, 4 * size + 3, std::size_t(37), std::size_t(100), std::size_t(259) })
+        {
+            INFO("dim = ", dim);
+            auto const v = make_vectors<T>(nq, np, dim);
+            std::vector<xsimd::distance_t<T>> l2(nq * np), dot(nq * np);
+            std::vector<float> cosine(nq * np);
+            xsimd::squared_l2_distances<A>(v.queries.data(), nq, v.points.data(), np, dim, l2.data());
+            xsimd::inner_products<A>(v.queries.data(), nq, v.points.data(), np, dim, dot.data());
+            xsimd::cosine_distances<A>(v.queries.data(), nq, v.points.data(), np, dim, cosine.data());
+
+            for (std::size_t q = 0; q < nq; ++q)
+            {
+                std::vector<xsimd::distance_t<T>> l2_row(np), dot_row(np);
+                std::vector<float> cosine_row(np);
+                T const* const query = v.queries.data() + q * dim;
+                xsimd::squared_l2_distances<A>(query, v.points.data(), np, dim, l2_row.data());
+                xsimd::inner_products<A>(query, v.points.data(), np, dim, dot_row.data());
+                xsimd::cosine_distances<A>(query, v.points.data(), np, dim, cosine_row.data());
+
+                for (std::size_t j = 0; j < np; ++j)
+                {
+                    double ref_l2 = 0, ref_dot = 0, xx = 0, yy = 0;
+                    for (std::size_t i = 0; i < dim; ++i)
+                    {
+                        double const x = v.fq[q * dim + i], y = v.fp[j * dim + i];
+                        ref_l2 += (x - y) * (x - y);
+                        ref_dot += x * y;
+                        xx += x * x;
+                        yy += y * y;
+                    }
+                    double const ref_cosine = 1. - ref_dot / std::sqrt(xx * yy);
+                    T const* const point = v.points.data() + j * dim;
+
+                    CHECK_EQ(double(l2[q * np + j]), ref_l2);
+                    CHECK_EQ(double(dot[q * np + j]), ref_dot);
+                    CHECK_EQ(double(l2_row[j]), ref_l2);
+                    CHECK_EQ(double(dot_row[j]), ref_dot);
+                    CHECK_EQ(double(xsimd::squared_l2_distance<A>(query, point, dim)), ref_l2);
+                    CHECK_EQ(double(xsimd::inner_product<A>(query, point, dim)), ref_dot);
+                    CHECK(std::fabs(cosine[q * np + j] - ref_cosine) < 1e-5);
+                    CHECK(std::fabs(cosine_row[j] - ref_cosine) < 1e-5);
+                    CHECK(std::fabs(xsimd::cosine_distance<A>(query, point, dim) - ref_cosine) < 1e-5);
+                }
+            }
+        }
+    }
+};
+
+template <class B>
+struct hamming_test
+{
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    void test_hamming() const
+    {
+        constexpr std::size_t nq = 5, np = 7;
+        for (std::size_t words : { std::size_t(1), std::size_t(2), size - 1, size, size + 1, 4 * size, 4 * size + 1 })
+        {
+            INFO("words = ", words);
+            auto const queries = detail::make_random_words(nq * words, 0x9E3779B97F4A7C15ull);
+            auto const codes = detail::make_random_words(np * words, 0xD1B54A32D192ED03ull);
+            std::vector<uint32_t> block(nq * np), row(np);
+            xsimd::hamming_distances<arch_type>(queries.data(), nq, codes.data(), np, words, block.data());
+            for (std::size_t q = 0; q < nq; ++q)
+            {
+                xsimd::hamming_distances<arch_type>(queries.data() + q * words, codes.data(), np, words, row.data());
+                for (std::size_t j = 0; j < np; ++j)
+                {
+                    uint32_t expected = 0;
+                    for (std::size_t i = 0; i < words; ++i)
+                        for (uint64_t bits = queries[q * words + i] ^ codes[j * words + i]; bits != 0; bits &= bits - 1)
+                            ++expected;
+                    CHECK_EQ(block[q * np + j], expected);
+                    CHECK_EQ(row[j], expected);
+                    CHECK_EQ(xsimd::hamming_distance<arch_type>(queries.data() + q * words, codes.data() + j * words, words), expected);
+                }
+            }
+        }
+    }
+};
+
+template <class B>
+struct nearest_k_test
+{
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    void test_nearest_k() const
+    {
+        for (std::size_t n : { std::size_t(0), std::size_t(5), size, size + 1, std::size_t(100), std::size_t(1000) })
+        {
+            auto distances = detail::make_hashed_values<value_type>(n, 211); // with ties
+            if (std::is_floating_point<value_type>::value && n > 3)
+                distances[3] = std::numeric_limits<value_type>::quiet_NaN();
+
+            std::vector<uint32_t> expected;
+            for (std::size_t i = 0; i < n; ++i)
+                if (distances[i] == distances[i])
+                    expected.push_back(static_cast<uint32_t>(i));
+            std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b)
+                             { return distances[a] < distances[b]; });
+
+            for (std::size_t k : { std::size_t(0), std::size_t(1), std::size_t(4), size + 2, std::size_t(2000) })
+            {
+                INFO("n = ", n, ", k = ", k);
+                std::vector<uint32_t> indices(k, 0xFFFFFFFFu);
+                std::size_t const found = xsimd::nearest_k<arch_type>(distances.data(), n, k, indices.data());
+                REQUIRE_EQ(found, std::min(k, expected.size()));
+                for (std::size_t j = 0; j < found; ++j)
+                    CHECK_EQ(indices[j], expected[j]);
+            }
+        }
+    }
+};
+
+namespace
+{
+    struct nearest_l2
+    {
+        template <class Arch>
+        std::size_t operator()(Arch, float const* query, float const* points, std::size_t n, std::size_t dim, float* distances, std::size_t k, uint32_t* indices) const
+        {
+            xsimd::squared_l2_distances<Arch>(query, points, n, dim, distances);
+            return xsimd::nearest_k<Arch>(distances, n, k, indices);
+        }
+    };
+}
+
+TEST_CASE_TEMPLATE("[distances]", T, float, xsimd::fp16, int8_t)
+{
+    for_each_arch([](auto arch)
+                  { distance_test<T, decltype(arch)>().test_distances(); });
+}
+
+TEST_CASE("[fp16 conversion]")
+{
+    using batch_type = xsimd::batch<uint32_t>;
+    constexpr std::size_t size = batch_type::size;
+    for (uint32_t h = 0; h < 0x10000u; h += size)
+    {
+        alignas(xsimd::default_arch::alignment()) uint32_t bits[size];
+        alignas(xsimd::default_arch::alignment()) float values[size];
+        for (std::size_t i = 0; i < size; ++i)
+            bits[i] = h + static_cast<uint32_t>(i);
+        xsimd::detail::fp16_to_float(batch_type::load_aligned(bits)).store_aligned(values);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            float const expected = from_fp16(static_cast<uint16_t>(bits[i]));
+            float const scalar = xsimd::detail::fp16_to_float(static_cast<uint16_t>(bits[i]));
+            if (expected != expected)
+            {
+                CHECK(values[i] != values[i]);
+                CHECK(scalar != scalar);
+            }
+            else
+            {
+                CHECK_EQ(values[i], expected);
+                CHECK_EQ(scalar, expected);
+                CHECK_EQ(std::signbit(values[i]), std::signbit(expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("[distances dispatch]")
+{
+    constexpr std::size_t n = 50, dim = 24, k = 5;
+    auto const v = make_vectors<float>(1, n, dim);
+    std::vector<float> distances(n), expected_distances(n);
+    uint32_t indices[k], expected_indices[k];
+    xsimd::squared_l2_distances(v.queries.data(), v.points.data(), n, dim, expected_distances.data());
+    xsimd::nearest_k(expected_distances.data(), n, k, expected_indices);
+
+    auto dispatched = xsimd::dispatch(nearest_l2 {});
+    CHECK_EQ(dispatched(v.queries.data(), v.points.data(), n, dim, distances.data(), k, indices), k);
+    CHECK(distances == expected_distances);
+    for (std::size_t j = 0; j < k; ++j)
+        CHECK_EQ(indices[j], expected_indices[j]);
+}
+
+TEST_CASE("[hamming distances]")
+{
+    for_each_arch_batch<uint64_t>([](auto b)
+                                  { hamming_test<decltype(b)>().test_hamming(); });
+}
+
+TEST_CASE_TEMPLATE("[nearest k]", T, float, int32_t, uint32_t)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { nearest_k_test<decltype(b)>().test_nearest_k(); });
+}
+#endif
@@ -0,0 +1,142 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_fft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    template <class T>
+    std::vector<std::complex<T>> make_signal(std::size_t n)
+    {
+        std::vector<std::complex<T>> res(n);
+        for (std::size_t i = 0; i < n; ++i)
+            res[i] = { static_cast<T>(std::sin(0.37 * double(i) + 0.1)), static_cast<T>(std::cos(1.3 * double(i) * double(i) / double(n))) };
+        return res;
+    }
+
+    template <class T>
+    std::vector<std::complex<long double>> reference_dft(std::vector<std::complex<T>> const& x, bool inverse)
+    {
+        std::size_t const n = x.size();
+        long double const pi = 3.141592653589793238462643383279502884L;
+        std::vector<std::complex<long double>> res(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            std::complex<long double> acc = 0;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                long double const angle = (inverse ? 2 : -2) * pi * static_cast<long double>((j * k) % n) / static_cast<long double>(n);
+                acc += std::complex<long double>(x[j].real(), x[j].imag()) * std::complex<long double>(std::cos(angle), std::sin(angle));
+            }
+            res[k] = acc;
+        }
+        return res;
+    }
+
+    // maximum error relative to the norm of the expected spectrum
+    template <class T>
+    double relative_error(std::complex<T> const* res, std::vector<std::complex<long double>> const& expected, std::size_t count)
+    {
+        long double err = 0, norm = 0;
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            err = std::max(err, std::abs(std::complex<long double>(res[k].real(), res[k].imag()) - expected[k]));
+            norm = std::max(norm, std::abs(expected[k]));
+        }
+        return static_cast<double>(err / std::max(norm, 1.L));
+    }
+
+    template <class T>
+    double tolerance(std::size_t n)
+    {
+        return 8 * std::numeric_limits<T>::epsilon() * std::log2(double(n) + 1);
+    }
+}
+
+TEST_CASE_TEMPLATE("[fft]", T, float, double)
+{
+    for (std::size_t n : { 1, 2, 3, 4, 5, 6, 8, 9, 12, 15, 16, 25, 30, 32, 60, 64, 100, 128, 243, 256, 360, 625, 960, 1024, 4096 })
+    {
+        INFO("n = ", n);
+        CHECK_UNARY(xsimd::fft_supported_size(n));
+        xsimd::fft_plan<T> const plan(n);
+        CHECK_EQ(plan.size(), n);
+        auto const x = make_signal<T>(n);
+        std::vector<std::complex<T>> res(n);
+
+        plan.forward(x.data(), res.data());
+        CHECK_LE(relative_error(res.data(), reference_dft(x, false), n), tolerance<T>(n));
+
+        plan.inverse(x.data(), res.data());
+        CHECK_LE(relative_error(res.data(), reference_dft(x, true), n), tolerance<T>(n));
+
+        // in place round trip
+        res = x;
+        plan.forward(res.data(), res.data());
+        plan.inverse(res.data(), res.data());
+        for (auto& v : res)
+            v /= T(n);
+        std::vector<std::complex<long double>> expected(x.begin(), x.end());
+        CHECK_LE(relative_error(res.data(), expected, n), tolerance<T>(n));
+    }
+    CHECK_FALSE(xsimd::fft_supported_size(0));
+    CHECK_FALSE(xsimd::fft_supported_size(7));
+    CHECK_FALSE(xsimd::fft_supported_size(6 * 11));
+    CHECK_THROWS_AS(xsimd::fft_plan<T>(0), std::invalid_argument);
+    CHECK_THROWS_AS(xsimd::fft_plan<T>(7), std::invalid_argument);
+    CHECK_THROWS_AS(xsimd::fft_plan<T>(6 * 11), std::invalid_argument);
+}
+
+TEST_CASE_TEMPLATE("[rfft]", T, float, double)
+{
+    for (std::size_t n : { 1, 2, 3, 4, 6, 9, 10, 15, 16, 25, 30, 32, 50, 64, 120, 256, 1000, 2048 })
+    {
+        INFO("n = ", n);
+        xsimd::rfft_plan<T> const plan(n);
+        CHECK_EQ(plan.size(), n);
+        CHECK_EQ(plan.spectrum_size(), n / 2 + 1);
+        auto const signal = make_signal<T>(n);
+        std::vector<T> x(n);
+        std::vector<std::complex<T>> x_complex(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[i] = signal[i].real();
+            x_complex[i] = x[i];
+        }
+
+        std::vector<std::complex<T>> spectrum(plan.spectrum_size());
+        plan.forward(x.data(), spectrum.data());
+        auto const expected = reference_dft(x_complex, false);
+        CHECK_LE(relative_error(spectrum.data(), expected, spectrum.size()), tolerance<T>(n));
+
+        std::vector<T> back(n);
+        plan.inverse(spectrum.data(), back.data());
+        double err = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            err = std::max(err, double(std::abs(back[i] / T(n) - x[i])));
+        CHECK_LE(err, tolerance<T>(n));
+    }
+    CHECK_THROWS_AS(xsimd::rfft_plan<T>(0), std::invalid_argument);
+    CHECK_THROWS_AS(xsimd::rfft_plan<T>(14), std::invalid_argument);
+}
+#endif
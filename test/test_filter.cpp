@@ -0,0 +1,276 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_filter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    template <class T>
+    std::vector<T> make_samples(std::size_t n, std::size_t seed)
+    {
+        std::vector<T> res(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double const v = std::sin(0.37 * double(i * (seed + 1)) + 0.1 * double(seed));
+            if constexpr (std::is_integral_v<T>)
+                res[i] = static_cast<T>(std::lround(v * 32000));
+            else
+                res[i] = static_cast<T>(v);
+        }
+        return res;
+    }
+
+    template <class T>
+    std::vector<T> make_taps(std::size_t n)
+    {
+        // sum of absolute values below 1 so that Q15 accumulation is safe
+        std::vector<T> res(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            double const v = (k % 3 == 1 ? -0.5 : 1.) / double(n + 1);
+            if constexpr (std::is_integral_v<T>)
+                res[k] = static_cast<T>(std::lround(v * 32768));
+            else
+                res[k] = static_cast<T>(v);
+        }
+        return res;
+    }
+
+    // y[i] = sum_k taps[k] * x[i - k], rounded the same way as the filters
+    template <class T>
+    T reference_fir(std::vector<T> const& taps, std::vector<T> const& x, std::size_t i)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            int32_t acc = 0;
+            for (std::size_t k = 0; k < taps.size() && k <= i; ++k)
+                acc += int32_t(taps[k]) * int32_t(x[i - k]);
+            return static_cast<T>(std::min(std::max((acc + (1 << 14)) >> 15, -32768), 32767));
+        }
+        else
+        {
+            long double acc = 0;
+            for (std::size_t k = 0; k < taps.size() && k <= i; ++k)
+                acc += static_cast<long double>(taps[k]) * x[i - k];
+            return static_cast<T>(acc);
+        }
+    }
+
+    template <class T>
+    void check_close(std::vector<T> const& res, std::vector<T> const& expected)
+    {
+        REQUIRE_EQ(res.size(), expected.size());
+        for (std::size_t i = 0; i < res.size(); ++i)
+        {
+            INFO("i = ", i);
+            if constexpr (std::is_integral_v<T>)
+                CHECK_EQ(res[i], expected[i]);
+            else
+                CHECK_LE(std::abs(res[i] - expected[i]), 64 * std::numeric_limits<T>::epsilon());
+        }
+    }
+
+    // uneven block sizes, including empty blocks and blocks shorter than the filter
+    std::vector<std::size_t> make_blocks(std::size_t total)
+    {
+        std::vector<std::size_t> res;
+        std::size_t const pattern[] = { 1, 0, 7, 64, 3, 129, 16, 33 };
+        for (std::size_t i = 0; total > 0; ++i)
+        {
+            std::size_t const n = std::min(total, pattern[i % 8]);
+            res.push_back(n);
+            total -= n;
+        }
+        return res;
+    }
+}
+
+TEST_CASE_TEMPLATE("[fir filter]", T, float, double, int16_t)
+{
+    std::size_t const total = 700;
+    auto const x = make_samples<T>(total, 1);
+    for (std::size_t count : { 1, 2, 5, 16, 31, 64 })
+    {
+        INFO("taps = ", count);
+        auto const taps = make_taps<T>(count);
+        std::vector<T> expected(total);
+        for (std::size_t i = 0; i < total; ++i)
+            expected[i] = reference_fir(taps, x, i);
+
+        xsimd::fir_filter<T> filter(taps.data(), taps.size());
+        CHECK_EQ(filter.size(), count);
+        std::vector<T> res(total);
+        std::size_t offset = 0;
+        for (std::size_t n : make_blocks(total))
+        {
+            filter.process(x.data() + offset, res.data() + offset, n);
+            offset += n;
+        }
+        check_close(res, expected);
+
+        // in place, in a single block, after a reset
+        filter.reset();
+        res = x;
+        filter.process(res.data(), res.data(), total);
+        check_close(res, expected);
+    }
+}
+
+TEST_CASE_TEMPLATE("[static fir filter]", T, float, double, int16_t)
+{
+    std::size_t const total = 300;
+    auto const x = make_samples<T>(total, 2);
+    auto const taps = make_taps<T>(12);
+    std::array<T, 12> static_taps;
+    std::copy(taps.begin(), taps.end(), static_taps.begin());
+
+    xsimd::static_fir_filter<T, 12> filter(static_taps);
+    CHECK_EQ(filter.size(), 12);
+    std::vector<T> res(total), expected(total);
+    for (std::size_t i = 0; i < total; ++i)
+        expected[i] = reference_fir(taps, x, i);
+    std::size_t offset = 0;
+    for (std::size_t n : make_blocks(total))
+    {
+        filter.process(x.data() + offset, res.data() + offset, n);
+        offset += n;
+    }
+    check_close(res, expected);
+}
+
+TEST_CASE_TEMPLATE("[fir decimator]", T, float, double, int16_t)
+{
+    std::size_t const total = 500;
+    auto const x = make_samples<T>(total, 3);
+    for (std::size_t factor : { 1, 2, 3, 8 })
+    {
+        for (std::size_t count : { 1, 7, 24 })
+        {
+            INFO("factor = ", factor, ", taps = ", count);
+            auto const taps = make_taps<T>(count);
+            std::vector<T> expected;
+            for (std::size_t i = 0; i < total; i += factor)
+                expected.push_back(reference_fir(taps, x, i));
+
+            xsimd::fir_decimator<T> decimator(taps.data(), taps.size(), factor);
+            CHECK_EQ(decimator.factor(), factor);
+            std::vector<T> res(total);
+            std::size_t offset = 0, produced = 0;
+            for (std::size_t n : make_blocks(total))
+            {
+                produced += decimator.process(x.data() + offset, n, res.data() + produced);
+                offset += n;
+            }
+            res.resize(produced);
+            check_close(res, expected);
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("[fir interpolator]", T, float, double, int16_t)
+{
+    std::size_t const total = 300;
+    auto const x = make_samples<T>(total, 4);
+    for (std::size_t factor : { 1, 2, 3, 4 })
+    {
+        for (std::size_t count : { 1, 6, 13, 32 })
+        {
+            INFO("factor = ", factor, ", taps = ", count);
+            auto const taps = make_taps<T>(count);
+            std::vector<T> upsampled(total * factor, T(0));
+            for (std::size_t i = 0; i < total; ++i)
+                upsampled[i * factor] = x[i];
+            std::vector<T> expected(total * factor);
+            for (std::size_t i = 0; i < expected.size(); ++i)
+                expected[i] = reference_fir(taps, upsampled, i);
+
+            xsimd::fir_interpolator<T> interpolator(taps.data(), taps.size(), factor);
+            CHECK_EQ(interpolator.factor(), factor);
+            std::vector<T> res(total * factor);
+            std::size_t offset = 0;
+            for (std::size_t n : make_blocks(total))
+            {
+                interpolator.process(x.data() + offset, n, res.data() + offset * factor);
+                offset += n;
+            }
+            check_close(res, expected);
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("[biquad cascade]", T, float, double)
+{
+    std::size_t const frames = 257;
+    // a low-pass and a resonant section
+    std::vector<xsimd::biquad_coefficients<T>> const sections = {
+        { T(0.2), T(0.4), T(0.2), T(-0.6), T(0.25) },
+        { T(1), T(-0.3), T(0.1), T(-1.2), T(0.7) },
+    };
+    for (std::size_t channels : { 1, 3, 8, 37 })
+    {
+        INFO("channels = ", channels);
+        auto const x = make_samples<T>(frames * channels, 5);
+
+        std::vector<T> expected(x.size());
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            std::vector<long double> signal(frames);
+            for (std::size_t f = 0; f < frames; ++f)
+                signal[f] = x[f * channels + c];
+            for (auto const& s : sections)
+            {
+                long double s1 = 0, s2 = 0;
+                for (auto& v : signal)
+                {
+                    long double const y = s.b0 * v + s1;
+                    s1 = s.b1 * v - s.a1 * y + s2;
+                    s2 = s.b2 * v - s.a2 * y;
+                    v = y;
+                }
+            }
+            for (std::size_t f = 0; f < frames; ++f)
+                expected[f * channels + c] = static_cast<T>(signal[f]);
+        }
+
+        xsimd::biquad_cascade<T> cascade(sections.data(), sections.size(), channels);
+        CHECK_EQ(cascade.size(), sections.size());
+        CHECK_EQ(cascade.channels(), channels);
+        std::vector<T> res(x.size());
+        std::size_t offset = 0;
+        for (std::size_t n : make_blocks(frames))
+        {
+            cascade.process(x.data() + offset * channels, res.data() + offset * channels, n);
+            offset += n;
+        }
+        for (std::size_t i = 0; i < res.size(); ++i)
+            CHECK_LE(std::abs(res[i] - expected[i]), 256 * std::numeric_limits<T>::epsilon());
+
+        cascade.reset();
+        res = x;
+        cascade.process(res.data(), res.data(), frames);
+        for (std::size_t i = 0; i < res.size(); ++i)
+            CHECK_LE(std::abs(res[i] - expected[i]), 256 * std::numeric_limits<T>::epsilon());
+    }
+}
+#endif
@@ -0,0 +1,85 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_for_each.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "test_utils.hpp"
+
+template <class B>
+struct for_each_test
+{
+    using batch_type = B;
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    static value_type sentinel()
+    {
+        return value_type(-7);
+    }
+
+    // x -> 3x + 1, exactly representable for every tested type
+    static batch_type f(batch_type x)
+    {
+        return x * batch_type(value_type(3)) + batch_type(value_type(1));
+    }
+
+    // every tail length, below and above a full batch; the tails are
+    // masked on the architectures with predicated memory accesses, and
+    // overlapping or padded on the others
+    void test_for_each_batch() const
+    {
+        for (std::size_t n = 0; n <= 3 * size + 1; ++n)
+        {
+            INFO("n = ", n, ", batch size = ", size);
+            auto const input = detail::make_hashed_values<value_type>(n, 53, -20);
+            std::vector<value_type> data(n + size, sentinel());
+            std::copy(input.begin(), input.end(), data.begin());
+            std::vector<value_type> const src = data;
+
+            // offset destination, to exercise unaligned accesses
+            std::vector<value_type> dst(n + size + 1, sentinel());
+            xsimd::for_each_batch<arch_type>(src.data(), dst.data() + 1, n, f);
+            xsimd::for_each_batch<arch_type>(data.data(), n, f);
+
+            CHECK_EQ(dst[0], sentinel());
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto const expected = static_cast<value_type>(3 * input[i] + 1);
+                CHECK_EQ(data[i], expected);
+                CHECK_EQ(dst[i + 1], expected);
+            }
+            for (std::size_t i = n; i < n + size; ++i)
+            {
+                CHECK_EQ(data[i], sentinel());
+                CHECK_EQ(dst[i + 1], sentinel());
+            }
+        }
+
+        // an empty range may come without storage
+        xsimd::for_each_batch<arch_type>(static_cast<value_type*>(nullptr), 0, f);
+        xsimd::for_each_batch<arch_type>(static_cast<value_type const*>(nullptr), static_cast<value_type*>(nullptr), 0, f);
+    }
+};
+
+TEST_CASE_TEMPLATE("[for each batch]", T, int8_t, uint16_t, int32_t, int64_t, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { for_each_test<decltype(b)>().test_for_each_batch(); });
+}
+#endif
@@ -0,0 +1,145 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_gemm.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    template <class T>
+    std::vector<T> make_operand(std::size_t size, std::size_t seed)
+    {
+        std::vector<T> res(size);
+        for (std::size_t i = 0; i < size; ++i)
+            res[i] = static_cast<T>(int((i * 7 + seed * 13) % 17) - 8) / T(4);
+        return res;
+    }
+
+    // element (i, j) of a matrix with leading dimension ld
+    template <class T>
+    T& at(std::vector<T>& v, xsimd::matrix_layout layout, std::size_t ld, std::size_t i, std::size_t j)
+    {
+        return layout == xsimd::matrix_layout::row_major ? v[i * ld + j] : v[j * ld + i];
+    }
+
+    template <class T>
+    T at(std::vector<T> const& v, xsimd::matrix_layout layout, std::size_t ld, std::size_t i, std::size_t j)
+    {
+        return layout == xsimd::matrix_layout::row_major ? v[i * ld + j] : v[j * ld + i];
+    }
+
+    template <class T>
+    bool check_gemm(xsimd::matrix_layout layout, std::size_t m, std::size_t n, std::size_t k, T alpha, T beta)
+    {
+        bool const row_major = layout == xsimd::matrix_layout::row_major;
+        std::size_t const lda = (row_major ? k : m) + 3;
+        std::size_t const ldb = (row_major ? n : k) + 1;
+        std::size_t const ldc = (row_major ? n : m) + 2;
+        auto const a = make_operand<T>(lda * (row_major ? m : k), 1);
+        auto const b = make_operand<T>(ldb * (row_major ? k : n), 2);
+        auto c = make_operand<T>(ldc * (row_major ? m : n), 3);
+        auto expected = c;
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                T acc = 0;
+                for (std::size_t p = 0; p < k; ++p)
+                    acc += at(a, layout, lda, i, p) * at(b, layout, ldb, p, j);
+                at(expected, layout, ldc, i, j) = alpha * acc + beta * at(c, layout, ldc, i, j);
+            }
+        }
+        xsimd::gemm(layout, m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+        // operands are small multiples of 1/4, the products are exact
+        return c == expected;
+    }
+}
+
+TEST_CASE_TEMPLATE("[gemm]", T, float, double)
+{
+    constexpr std::array<std::array<std::size_t, 3>, 8> shapes = { { { 1, 1, 1 }, { 3, 5, 2 }, { 8, 8, 8 }, { 13, 31, 17 }, { 64, 64, 64 }, { 97, 33, 130 }, { 20, 300, 5 }, { 150, 70, 600 } } };
+
+    SUBCASE("row major")
+    {
+        for (auto const& s : shapes)
+            CHECK_UNARY(check_gemm<T>(xsimd::matrix_layout::row_major, s[0], s[1], s[2], T(1), T(0)));
+    }
+
+    SUBCASE("column major")
+    {
+        for (auto const& s : shapes)
+            CHECK_UNARY(check_gemm<T>(xsimd::matrix_layout::column_major, s[0], s[1], s[2], T(1), T(0)));
+    }
+
+    SUBCASE("alpha and beta")
+    {
+        for (auto const& s : shapes)
+        {
+            CHECK_UNARY(check_gemm<T>(xsimd::matrix_layout::row_major, s[0], s[1], s[2], T(0.5), T(2)));
+            CHECK_UNARY(check_gemm<T>(xsimd::matrix_layout::column_major, s[0], s[1], s[2], T(-1), T(1)));
+        }
+    }
+
+    SUBCASE("empty inner dimension")
+    {
+        CHECK_UNARY(check_gemm<T>(xsimd::matrix_layout::row_major, 5, 7, 0, T(1), T(3)));
+    }
+
+    SUBCASE("beta zero ignores c")
+    {
+        std::vector<T> const a(4, T(1)), b(4, T(2));
+        std::vector<T> c(4, std::nan(""));
+        xsimd::gemm(2, 2, 2, a.data(), b.data(), c.data());
+        CHECK_EQ(c, std::vector<T>(4, T(4)));
+    }
+}
+
+namespace
+{
+    template <std::size_t M, std::size_t N, std::size_t K, class T>
+    bool check_matmul()
+    {
+        auto const a = make_operand<T>(M * K, 4);
+        auto const b = make_operand<T>(K * N, 5);
+        std::vector<T> c(M * N + 1, T(42));
+        std::vector<T> expected(M * N + 1, T(42));
+        for (std::size_t i = 0; i < M; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                T acc = 0;
+                for (std::size_t p = 0; p < K; ++p)
+                    acc += a[i * K + p] * b[p * N + j];
+                expected[i * N + j] = acc;
+            }
+        xsimd::matmul<M, N, K>(a.data(), b.data(), c.data());
+        return c == expected;
+    }
+}
+
+TEST_CASE_TEMPLATE("[matmul]", T, float, double)
+{
+    CHECK_UNARY((check_matmul<1, 1, 1, T>()));
+    CHECK_UNARY((check_matmul<2, 3, 4, T>()));
+    CHECK_UNARY((check_matmul<4, 4, 4, T>()));
+    CHECK_UNARY((check_matmul<8, 8, 8, T>()));
+    CHECK_UNARY((check_matmul<7, 19, 5, T>()));
+    CHECK_UNARY((check_matmul<16, 16, 16, T>()));
+    CHECK_UNARY((check_matmul<33, 10, 12, T>()));
+}
+#endif
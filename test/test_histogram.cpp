@@ -0,0 +1,133 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // increasing with repeats, within the range of the values
+    template <class T>
+    std::vector<T> make_boundaries(std::size_t nb)
+    {
+        std::vector<T> boundaries(nb);
+        for (std::size_t i = 0; i < nb; ++i)
+            boundaries[i] = static_cast<T>(double(int(i * 500 / (nb + 1)) - 250) / (std::is_floating_point<T>::value ? 4. : 1.));
+        if (nb > 3)
+            boundaries[2] = boundaries[1];
+        return boundaries;
+    }
+}
+
+template <class B>
+struct histogram_test
+{
+    using batch_type = B;
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    // multiples of 1/4 in [-64, 64), some equal to boundaries
+    static std::vector<value_type> make_values(std::size_t n)
+    {
+        auto values = detail::make_hashed_values<value_type>(n, 512, -256);
+        if constexpr (std::is_floating_point<value_type>::value)
+            for (auto& x : values)
+                x /= 4;
+        return values;
+    }
+
+    static void check_bucketize(std::vector<value_type> const& values, std::vector<value_type> const& boundaries)
+    {
+        std::vector<uint32_t> buckets(values.size() + 1, 0xFFFFFFFFu);
+        xsimd::bucketize<arch_type>(values.data(), values.size(), boundaries.data(), boundaries.size(), buckets.data());
+        CHECK_EQ(buckets.back(), 0xFFFFFFFFu);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            auto const expected = std::upper_bound(boundaries.begin(), boundaries.end(), values[i]) - boundaries.begin();
+            CHECK_EQ(buckets[i], uint32_t(expected));
+        }
+    }
+
+    static void check_histograms(std::vector<value_type> const& values, std::vector<value_type> const& boundaries)
+    {
+        std::size_t const nb = boundaries.size();
+        std::vector<uint32_t> counts(nb + 2, 1), expected(nb + 2, 1);
+        for (value_type x : values)
+            if (x == x)
+                ++expected[std::upper_bound(boundaries.begin(), boundaries.end(), x) - boundaries.begin()];
+        xsimd::histogram<arch_type>(values.data(), values.size(), boundaries.data(), nb, counts.data());
+        CHECK(counts == expected);
+
+        for (std::size_t bins : { 1, 3, 10, 64, 1000 })
+        {
+            INFO("bins = ", bins);
+            value_type const lo = value_type(-50), hi = value_type(30);
+            std::vector<uint32_t> fixed(bins + 1, 0), expected_fixed(bins + 1, 0);
+            for (value_type x : values)
+            {
+                if (x != x)
+                    continue;
+                double const t = std::floor((double(x) - lo) * double(bins) / (double(hi) - lo));
+                ++expected_fixed[std::size_t(std::min(std::max(t, 0.), double(bins - 1)))];
+            }
+            xsimd::histogram<arch_type>(values.data(), values.size(), lo, hi, bins, fixed.data());
+            CHECK(fixed == expected_fixed);
+        }
+    }
+
+    // linear, in-register and gathered lookups of the boundaries, the
+    // second up to a batch of them
+    void test_histogram() const
+    {
+        for (std::size_t nb : { std::size_t(0), std::size_t(1), std::size_t(3), std::size_t(4), std::size_t(5), size, size + 1, std::size_t(11), std::size_t(100), std::size_t(1000) })
+        {
+            INFO("nb = ", nb);
+            auto const boundaries = make_boundaries<value_type>(nb);
+            for (std::size_t n : { std::size_t(0), std::size_t(1), size + 1, std::size_t(100), std::size_t(3001) })
+            {
+                INFO("n = ", n);
+                auto values = make_values(n);
+                check_bucketize(values, boundaries);
+                if constexpr (std::is_floating_point<value_type>::value)
+                {
+                    check_histograms(values, boundaries);
+                    if (n > 50)
+                    {
+                        values[3] = std::numeric_limits<value_type>::quiet_NaN();
+                        values[40] = std::numeric_limits<value_type>::infinity();
+                        values[41] = -std::numeric_limits<value_type>::infinity();
+                        values[n - 1] = std::numeric_limits<value_type>::quiet_NaN();
+                        check_bucketize(values, boundaries);
+                        check_histograms(values, boundaries);
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE_TEMPLATE("[histogram]", T, float, double, int32_t, int64_t)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { histogram_test<decltype(b)>().test_histogram(); });
+}
+#endif
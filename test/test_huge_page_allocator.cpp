@@ -0,0 +1,133 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/memory/xsimd_huge_page_allocator.hpp"
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+TEST_SUITE("huge_page_allocator")
+{
+    TEST_CASE("regular pages")
+    {
+        xsimd::huge_page_options options;
+        options.pages = xsimd::huge_page_mode::none;
+        void* ptr = xsimd::huge_page_malloc(1000, 64, options);
+        REQUIRE(ptr != nullptr);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, std::uintptr_t(0));
+        auto info = xsimd::huge_page_query(ptr);
+        CHECK_UNARY(info.pages == xsimd::huge_page_mode::none);
+        CHECK_UNARY(info.numa == xsimd::numa_policy::none);
+        CHECK_GE(info.mapped_size, std::size_t(1000));
+        xsimd::huge_page_free(ptr);
+    }
+
+    TEST_CASE("transparent pages")
+    {
+        std::size_t size = std::size_t(3) << 20;
+        for (bool verify : { false, true })
+        {
+            xsimd::huge_page_options options;
+            options.verify_transparent = verify;
+            void* ptr = xsimd::huge_page_malloc(size, 64, options);
+            REQUIRE(ptr != nullptr);
+            auto info = xsimd::huge_page_query(ptr);
+#if defined(__linux__)
+            // only reported when enabled, and once verified when requested
+            if (!xsimd::transparent_huge_pages_enabled())
+                CHECK_UNARY(info.pages == xsimd::huge_page_mode::none);
+            else if (!verify)
+                CHECK_UNARY(info.pages == xsimd::huge_page_mode::transparent);
+            if (info.pages == xsimd::huge_page_mode::transparent)
+                CHECK_EQ(info.page_size, std::size_t(2) << 20);
+            else
+                CHECK_UNARY(info.pages == xsimd::huge_page_mode::none);
+            CHECK_EQ(info.mapped_size % info.page_size, std::size_t(0));
+#endif
+            CHECK_GE(info.mapped_size, size);
+            static_cast<char*>(ptr)[size - 1] = 1;
+            xsimd::huge_page_free(ptr);
+        }
+    }
+
+    TEST_CASE("alignment larger than a page")
+    {
+        for (std::size_t alignment : { std::size_t(1), std::size_t(1) << 13, std::size_t(1) << 16, std::size_t(4) << 20 })
+        {
+            for (auto pages : { xsimd::huge_page_mode::none, xsimd::huge_page_mode::transparent })
+            {
+                xsimd::huge_page_options options;
+                options.pages = pages;
+                void* ptr = xsimd::huge_page_malloc(5000, alignment, options);
+                REQUIRE(ptr != nullptr);
+                CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, std::uintptr_t(0));
+                static_cast<char*>(ptr)[4999] = 1;
+                xsimd::huge_page_free(ptr);
+            }
+        }
+    }
+
+    TEST_CASE("explicit pages fall back")
+    {
+        xsimd::huge_page_options options;
+        options.pages = xsimd::huge_page_mode::explicit_1gb;
+        void* ptr = xsimd::huge_page_malloc(4096, 32, options);
+        REQUIRE(ptr != nullptr);
+        auto info = xsimd::huge_page_query(ptr);
+        if (xsimd::free_huge_pages(std::size_t(1) << 30) == 0 && xsimd::free_huge_pages(std::size_t(2) << 20) == 0)
+        {
+            CHECK_UNARY(info.pages != xsimd::huge_page_mode::explicit_1gb);
+            CHECK_UNARY(info.pages != xsimd::huge_page_mode::explicit_2mb);
+        }
+        CHECK_GE(info.mapped_size, std::size_t(4096));
+        xsimd::huge_page_free(ptr);
+    }
+
+    TEST_CASE("numa placement")
+    {
+        xsimd::huge_page_options options;
+        options.numa = xsimd::numa_policy::first_touch;
+        void* ptr = xsimd::huge_page_malloc(1 << 16, 64, options);
+        REQUIRE(ptr != nullptr);
+#if defined(__linux__)
+        CHECK_UNARY(xsimd::huge_page_query(ptr).numa == xsimd::numa_policy::first_touch);
+#endif
+        xsimd::huge_page_free(ptr);
+
+        options.numa = xsimd::numa_policy::bind;
+        ptr = xsimd::huge_page_malloc(1 << 16, 64, options);
+        REQUIRE(ptr != nullptr);
+        auto numa = xsimd::huge_page_query(ptr).numa;
+        CHECK_UNARY((numa == xsimd::numa_policy::bind || numa == xsimd::numa_policy::none));
+        xsimd::huge_page_free(ptr);
+    }
+
+    TEST_CASE("allocator")
+    {
+        using allocator_type = xsimd::huge_page_allocator<double, 64>;
+        xsimd::huge_page_options options;
+        options.numa = xsimd::numa_policy::interleave;
+        std::vector<double, allocator_type> v(1 << 18, 1., allocator_type(options));
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % 64, std::uintptr_t(0));
+        CHECK_EQ(v.back(), 1.);
+        CHECK_UNARY(v.get_allocator() == allocator_type(options));
+        CHECK_UNARY(v.get_allocator() != allocator_type());
+        CHECK_GE(xsimd::huge_page_query(v.data()).mapped_size, v.size() * sizeof(double));
+
+        allocator_type alloc;
+        CHECK_THROWS_AS(alloc.allocate(std::numeric_limits<std::size_t>::max() / 4), std::bad_array_new_length);
+        CHECK_THROWS_AS(xsimd::huge_page_malloc(std::numeric_limits<std::size_t>::max() - 8, 64), std::bad_alloc);
+    }
+}
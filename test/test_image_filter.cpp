@@ -0,0 +1,214 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_image_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    struct plane_size
+    {
+        std::size_t width;
+        std::size_t height;
+    };
+
+    // includes planes narrower than a batch and than the kernels
+    plane_size const plane_sizes[] = { { 1, 1 }, { 2, 3 }, { 7, 5 }, { 33, 17 }, { 100, 41 } };
+    xsimd::border_mode const border_modes[] = { xsimd::border_mode::replicate, xsimd::border_mode::reflect, xsimd::border_mode::zero };
+
+    template <class T>
+    std::vector<T> make_plane(std::size_t stride, std::size_t height)
+    {
+        std::vector<T> res(stride * height);
+        for (std::size_t i = 0; i < res.size(); ++i)
+        {
+            if constexpr (std::is_same_v<T, float>)
+                res[i] = static_cast<float>((i * 37 + i / 7) % 256) / 8.f;
+            else
+                res[i] = static_cast<T>((i * 37 + i / 7) * (sizeof(T) == 1 ? 1 : 251) % (std::size_t(std::numeric_limits<T>::max()) + 1));
+        }
+        return res;
+    }
+
+    // same index mapping as the filters, written independently
+    std::ptrdiff_t border_index(std::ptrdiff_t i, std::ptrdiff_t n, xsimd::border_mode border)
+    {
+        while (i < 0 || i >= n)
+        {
+            if (border == xsimd::border_mode::zero)
+                return -1;
+            if (border == xsimd::border_mode::replicate || n == 1)
+                return std::min(std::max<std::ptrdiff_t>(i, 0), n - 1);
+            i = i < 0 ? -i : 2 * (n - 1) - i;
+        }
+        return i;
+    }
+
+    template <class T>
+    double pixel(std::vector<T> const& src, std::size_t stride, plane_size size, std::ptrdiff_t y, std::ptrdiff_t x, xsimd::border_mode border)
+    {
+        std::ptrdiff_t const row = border_index(y, std::ptrdiff_t(size.height), border);
+        std::ptrdiff_t const col = border_index(x, std::ptrdiff_t(size.width), border);
+        return row < 0 || col < 0 ? 0. : double(src[std::size_t(row) * stride + std::size_t(col)]);
+    }
+
+    // general correlation with a size_y x size_x kernel
+    template <class T, class R = T>
+    std::vector<R> reference_filter(std::vector<T> const& src, std::size_t stride, plane_size size, std::vector<double> const& kernel,
+                                    std::size_t size_x, std::size_t size_y, xsimd::border_mode border)
+    {
+        std::vector<R> res(size.width * size.height);
+        std::ptrdiff_t const rx = std::ptrdiff_t(size_x / 2), ry = std::ptrdiff_t(size_y / 2);
+        for (std::ptrdiff_t y = 0; y < std::ptrdiff_t(size.height); ++y)
+            for (std::ptrdiff_t x = 0; x < std::ptrdiff_t(size.width); ++x)
+            {
+                double acc = 0;
+                for (std::ptrdiff_t j = 0; j < std::ptrdiff_t(size_y); ++j)
+                    for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(size_x); ++i)
+                        acc += kernel[std::size_t(j) * size_x + std::size_t(i)] * pixel(src, stride, size, y + j - ry, x + i - rx, border);
+                if constexpr (std::is_same_v<R, float>)
+                    res[std::size_t(y) * size.width + std::size_t(x)] = static_cast<float>(acc);
+                else
+                {
+                    double const lo = double(std::numeric_limits<R>::min()), hi = double(std::numeric_limits<R>::max());
+                    res[std::size_t(y) * size.width + std::size_t(x)] = static_cast<R>(std::nearbyint(std::min(std::max(acc, lo), hi)));
+                }
+            }
+        return res;
+    }
+
+    template <class T>
+    void check_plane(std::vector<T> const& res, std::size_t stride, std::vector<T> const& expected, plane_size size, double tol)
+    {
+        for (std::size_t y = 0; y < size.height; ++y)
+            for (std::size_t x = 0; x < size.width; ++x)
+            {
+                INFO("y = ", y, ", x = ", x);
+                CHECK_LE(std::abs(double(res[y * stride + x]) - double(expected[y * size.width + x])), tol);
+            }
+    }
+
+    template <class T>
+    double tolerance()
+    {
+        // the test kernels are dyadic, so that integer results are exact
+        return std::is_same_v<T, float> ? 1e-4 : 0.;
+    }
+}
+
+TEST_CASE_TEMPLATE("[separable filter]", T, uint8_t, uint16_t, float)
+{
+    std::vector<float> const kernel_x = { 0.25f, 0.5f, 0.25f };
+    std::vector<float> const kernel_y = { 0.0625f, -0.25f, 1.375f, -0.25f, 0.125f };
+    std::vector<double> kernel;
+    for (float ky : kernel_y)
+        for (float kx : kernel_x)
+            kernel.push_back(double(ky) * double(kx));
+
+    for (auto size : plane_sizes)
+        for (auto border : border_modes)
+            for (std::size_t threads : { 1, 3 })
+            {
+                INFO("width = ", size.width, ", height = ", size.height, ", border = ", int(border), ", threads = ", threads);
+                std::size_t const stride = size.width + 3;
+                auto const src = make_plane<T>(stride, size.height);
+                std::vector<T> dst(stride * size.height);
+                xsimd::separable_filter(src.data(), stride, dst.data(), stride, size.width, size.height,
+                                        kernel_x.data(), kernel_x.size(), kernel_y.data(), kernel_y.size(), border, threads);
+                check_plane(dst, stride, reference_filter(src, stride, size, kernel, 3, 5, border), size, tolerance<T>());
+            }
+}
+
+TEST_CASE_TEMPLATE("[convolve 2d]", T, uint8_t, uint16_t, float)
+{
+    for (std::size_t ksize : { 1, 3, 5, 7 })
+    {
+        std::vector<float> kernel(ksize * ksize);
+        std::vector<double> kernel_ref(ksize * ksize);
+        for (std::size_t i = 0; i < kernel.size(); ++i)
+        {
+            kernel[i] = float(int(i % 5) - 1) / 16.f;
+            kernel_ref[i] = kernel[i];
+        }
+        for (auto size : plane_sizes)
+            for (auto border : border_modes)
+            {
+                INFO("ksize = ", ksize, ", width = ", size.width, ", height = ", size.height, ", border = ", int(border));
+                auto const src = make_plane<T>(size.width, size.height);
+                std::vector<T> dst(src.size());
+                xsimd::convolve_2d(src.data(), size.width, dst.data(), size.width, size.width, size.height,
+                                   kernel.data(), ksize, border, 2);
+                check_plane(dst, size.width, reference_filter(src, size.width, size, kernel_ref, ksize, ksize, border), size, tolerance<T>());
+            }
+    }
+}
+
+TEST_CASE_TEMPLATE("[box blur]", T, uint8_t, uint16_t, float)
+{
+    for (std::size_t radius : { 0, 1, 2, 6 })
+    {
+        std::size_t const ksize = 2 * radius + 1;
+        std::vector<double> kernel(ksize * ksize, 1. / double(ksize * ksize));
+        for (auto size : plane_sizes)
+            for (auto border : border_modes)
+                for (std::size_t threads : { 1, 4 })
+                {
+                    INFO("radius = ", radius, ", width = ", size.width, ", height = ", size.height, ", border = ", int(border));
+                    std::size_t const stride = size.width + 1;
+                    auto const src = make_plane<T>(stride, size.height);
+                    std::vector<T> dst(stride * size.height);
+                    xsimd::box_blur(src.data(), stride, dst.data(), stride, size.width, size.height, radius, border, threads);
+                    check_plane(dst, stride, reference_filter(src, stride, size, kernel, ksize, ksize, border), size, tolerance<T>());
+                }
+    }
+
+    // large windows shrink the column tiles below the width of the plane
+    plane_size const size = { 1500, 3 };
+    std::size_t const radius = 60, ksize = 2 * radius + 1;
+    std::vector<double> kernel(ksize * ksize, 1. / double(ksize * ksize));
+    auto const src = make_plane<T>(size.width, size.height);
+    std::vector<T> dst(src.size());
+    xsimd::box_blur(src.data(), size.width, dst.data(), size.width, size.width, size.height, radius, xsimd::border_mode::reflect);
+    check_plane(dst, size.width, reference_filter(src, size.width, size, kernel, ksize, ksize, xsimd::border_mode::reflect), size, 1e-3);
+}
+
+TEST_CASE_TEMPLATE("[sobel]", T, uint8_t, uint16_t, float)
+{
+    using G = xsimd::sobel_value_t<T>;
+    std::vector<double> const kernel_x = { -1, 0, 1, -2, 0, 2, -1, 0, 1 };
+    std::vector<double> const kernel_y = { -1, -2, -1, 0, 0, 0, 1, 2, 1 };
+    for (auto size : plane_sizes)
+        for (auto border : border_modes)
+        {
+            INFO("width = ", size.width, ", height = ", size.height, ", border = ", int(border));
+            auto const src = make_plane<T>(size.width, size.height);
+            std::vector<G> dx(src.size()), dy(src.size());
+            xsimd::sobel(src.data(), size.width, dx.data(), size.width, dy.data(), size.width, size.width, size.height, border, 2);
+            check_plane(dx, size.width, reference_filter<T, G>(src, size.width, size, kernel_x, 3, 3, border), size, tolerance<T>());
+            check_plane(dy, size.width, reference_filter<T, G>(src, size.width, size, kernel_y, 3, 3, border), size, tolerance<T>());
+
+            std::vector<G> only_dy(src.size());
+            xsimd::sobel(src.data(), size.width, static_cast<G*>(nullptr), 0, only_dy.data(), size.width, size.width, size.height, border);
+            CHECK_EQ(only_dy, dy);
+        }
+}
+#endif
@@ -18,7 +18,7 @@
 #include <random>
 #include <type_traits>
 
-// Anti-rot guard for the internal has_mask_load_v / has_mask_store_v trait. It is
+// Anti-rot guard for the has_mask_load_v / has_mask_store_v traits. It is
 // a pure type-level computation (no batch instantiation), and every arch tag is
 // always declared, so the value is build-independent -- the whole (size x arch)
 // matrix is asserted unconditionally, no XSIMD_WITH_* guards. Capability is per
@@ -27,8 +27,8 @@
 namespace test_has_mask_trait
 {
     using xsimd::batch;
-    using xsimd::detail::has_mask_load_v;
-    using xsimd::detail::has_mask_store_v;
+    using xsimd::has_mask_load_v;
+    using xsimd::has_mask_store_v;
 
     template <class A>
     constexpr bool caps(bool b1, bool b2, bool b4, bool b8)
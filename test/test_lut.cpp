@@ -0,0 +1,129 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_lut.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // interpolated in double, with the grid coordinate rounded as by the
+    // table so that the tolerance does not grow with its size
+    template <class T>
+    double reference(std::vector<double> const& y, T lo, T hi, T x, xsimd::lut_interpolation method)
+    {
+        std::size_t const n = y.size();
+        if (n == 1)
+            return y[0];
+        T const scale = T(n - 1) / (hi - lo);
+        double const t = std::min(std::max(double((x - lo) * scale), 0.), double(n - 1));
+        std::size_t const i = std::min(std::size_t(t), n - 1);
+        double const f = t - double(i);
+        auto at = [&](std::ptrdiff_t j)
+        { return y[std::size_t(std::min(std::max(j, std::ptrdiff_t(0)), std::ptrdiff_t(n - 1)))]; };
+        double const p0 = at(std::ptrdiff_t(i) - 1), p1 = at(std::ptrdiff_t(i)), p2 = at(std::ptrdiff_t(i) + 1), p3 = at(std::ptrdiff_t(i) + 2);
+        if (method == xsimd::lut_interpolation::linear)
+            return p1 + f * (p2 - p1);
+        return p1 + 0.5 * f * ((p2 - p0) + f * ((2 * p0 - 5 * p1 + 4 * p2 - p3) + f * (3 * (p1 - p2) + p3 - p0)));
+    }
+}
+
+template <class B>
+struct lut_test
+{
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    void check_lut(std::size_t n, xsimd::lut_interpolation method) const
+    {
+        using T = value_type;
+        T const lo = T(-1.5), hi = T(2.5);
+        std::vector<T> table(n);
+        std::vector<double> y(n);
+        for (std::size_t i = 0; i < n; ++i)
+            y[i] = double(table[i] = T(std::sin(0.7 * double(i)) * 4));
+
+        // grid points, between them, and out of range
+        std::vector<T> x;
+        for (std::size_t i = 0; i < 8 * n + 19; ++i)
+            x.push_back(T(-2 + 5 * double(i) / double(8 * n + 18)));
+        for (std::size_t i = 0; i < n; ++i)
+            x.push_back(T(lo + (hi - lo) * T(i) / T(std::max<std::size_t>(n - 1, 1))));
+        x.push_back(hi);
+        x.push_back(std::numeric_limits<T>::infinity());
+        x.push_back(-std::numeric_limits<T>::infinity());
+        x.push_back(std::numeric_limits<T>::quiet_NaN());
+
+        xsimd::uniform_lut<T, arch_type> const lut(table.data(), n, lo, hi, method);
+        CHECK_EQ(lut.size(), n);
+        std::vector<T> out(x.size() + 1, T(42));
+        lut(x.data(), x.size(), out.data());
+        CHECK_EQ(out.back(), T(42));
+        std::vector<T> free_out(x.size());
+        xsimd::lut_lookup<arch_type>(table.data(), n, lo, hi, x.data(), x.size(), free_out.data(), method);
+
+        double const tolerance = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            INFO("x = ", x[i]);
+            if (std::isnan(x[i]))
+            {
+                CHECK(std::isnan(out[i]));
+                continue;
+            }
+            double const expected = reference(y, lo, hi, x[i], method);
+            CHECK(std::fabs(out[i] - expected) < tolerance * 8);
+            CHECK_EQ(free_out[i], out[i]);
+            CHECK_EQ(lut(x[i]), out[i]);
+        }
+
+        // the table itself at the grid points, up to the rounding of the argument
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK(std::fabs(out[8 * n + 19 + i] - table[i]) < tolerance * 8);
+    }
+
+    void test_lookup() const
+    {
+        // the table and its three padding values fill one to four
+        // registers exactly or with a spare lane, then are gathered
+        std::vector<std::size_t> lengths = { 1, 2, 3, 5, 100, 1000 };
+        for (std::size_t r = 1; r <= 5; ++r)
+        {
+            if (r * size > 3)
+            {
+                lengths.push_back(r * size - 3);
+                lengths.push_back(r * size - 2);
+            }
+        }
+        for (std::size_t n : lengths)
+        {
+            INFO("n = ", n);
+            check_lut(n, xsimd::lut_interpolation::linear);
+            check_lut(n, xsimd::lut_interpolation::catmull_rom);
+        }
+    }
+};
+
+TEST_CASE_TEMPLATE("[lookup tables]", T, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { lut_test<decltype(b)>().test_lookup(); });
+}
+#endif
@@ -0,0 +1,169 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_transpose.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    template <class T>
+    std::vector<T> make_matrix(std::size_t rows, std::size_t cols)
+    {
+        std::vector<T> res(rows * cols);
+        for (std::size_t i = 0; i < res.size(); ++i)
+            res[i] = static_cast<T>(i % 251);
+        return res;
+    }
+
+    template <class T>
+    bool is_transpose(std::vector<T> const& src, std::vector<T> const& dst, std::size_t rows, std::size_t cols)
+    {
+        for (std::size_t i = 0; i < rows; ++i)
+            for (std::size_t j = 0; j < cols; ++j)
+                if (!(dst[j * rows + i] == src[i * cols + j]))
+                    return false;
+        return true;
+    }
+
+    constexpr std::array<std::array<std::size_t, 2>, 7> shapes = { { { 1, 1 }, { 3, 5 }, { 16, 16 }, { 17, 33 }, { 64, 7 }, { 100, 100 }, { 131, 259 } } };
+}
+
+template <class B>
+struct matrix_transpose_test
+{
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    using T = value_type;
+
+    void test_out_of_place() const
+    {
+        for (auto const& shape : shapes)
+        {
+            auto const src = make_matrix<T>(shape[0], shape[1]);
+            std::vector<T> dst(src.size());
+            xsimd::transpose_matrix<arch_type>(src.data(), dst.data(), shape[0], shape[1]);
+            CHECK_UNARY(is_transpose(src, dst, shape[0], shape[1]));
+        }
+    }
+
+    void test_strided() const
+    {
+        std::size_t const rows = 21, cols = 37, src_stride = 40, dst_stride = 25;
+        std::vector<T> src(rows * src_stride, T(1));
+        std::vector<T> dst(cols * dst_stride, T(2));
+        for (std::size_t i = 0; i < rows; ++i)
+            for (std::size_t j = 0; j < cols; ++j)
+                src[i * src_stride + j] = static_cast<T>(i * 3 + j);
+        xsimd::transpose_matrix<arch_type>(src.data(), src_stride, dst.data(), dst_stride, rows, cols);
+        bool ok = true;
+        for (std::size_t j = 0; j < cols; ++j)
+        {
+            for (std::size_t i = 0; i < rows; ++i)
+                ok = ok && dst[j * dst_stride + i] == src[i * src_stride + j];
+            for (std::size_t i = rows; i < dst_stride; ++i)
+                ok = ok && dst[j * dst_stride + i] == T(2);
+        }
+        CHECK_UNARY(ok);
+    }
+
+    void test_in_place() const
+    {
+        for (auto const& shape : shapes)
+        {
+            auto const src = make_matrix<T>(shape[0], shape[1]);
+            auto data = src;
+            xsimd::transpose_matrix<arch_type>(data.data(), shape[0], shape[1]);
+            CHECK_UNARY(is_transpose(src, data, shape[0], shape[1]));
+        }
+    }
+
+    void test_parallel() const
+    {
+        for (auto const& shape : shapes)
+        {
+            auto const src = make_matrix<T>(shape[0], shape[1]);
+            std::vector<T> dst(src.size());
+            xsimd::parallel_transpose_matrix<arch_type>(src.data(), dst.data(), shape[0], shape[1], 3);
+            CHECK_UNARY(is_transpose(src, dst, shape[0], shape[1]));
+        }
+    }
+};
+
+TEST_CASE_TEMPLATE("[matrix transpose]", T, uint8_t, int16_t, int32_t, float, double, uint64_t)
+{
+    for_each_arch_batch<T>([](auto b)
+                           {
+        matrix_transpose_test<decltype(b)> Test;
+        Test.test_out_of_place();
+        Test.test_strided();
+        Test.test_in_place();
+        Test.test_parallel(); });
+}
+
+TEST_CASE("[matrix transpose] non vectorized elements")
+{
+    struct rgb
+    {
+        uint8_t r, g, b;
+        bool operator==(rgb const& other) const { return r == other.r && g == other.g && b == other.b; }
+    };
+    std::size_t const rows = 19, cols = 45;
+    std::vector<rgb> src(rows * cols);
+    for (std::size_t i = 0; i < src.size(); ++i)
+        src[i] = { uint8_t(i), uint8_t(i >> 8), uint8_t(i * 7) };
+    std::vector<rgb> dst(src.size());
+    xsimd::transpose_matrix(src.data(), dst.data(), rows, cols);
+    CHECK_UNARY(is_transpose(src, dst, rows, cols));
+
+    auto data = src;
+    xsimd::transpose_matrix(data.data(), rows, cols);
+    CHECK_UNARY(is_transpose(src, data, rows, cols));
+}
+
+TEST_CASE("[parallel bands]")
+{
+    for (std::size_t threads : { 0, 1, 3, 8 })
+    {
+        for (std::size_t count : { 0, 1, 5, 100 })
+        {
+            std::vector<int> hits(count, 0);
+            xsimd::detail::parallel_bands(count, threads, [&](std::size_t begin, std::size_t end)
+                                          { for (std::size_t i = begin; i < end; ++i) ++hits[i]; });
+            CHECK_UNARY(std::all_of(hits.begin(), hits.end(), [](int h)
+                                    { return h == 1; }));
+        }
+    }
+
+    // a band throwing, on another thread or on the calling one, is rethrown
+    // once every band is done
+    for (std::size_t failing : { 1, 3 })
+    {
+        std::vector<int> done(4, 0);
+        CHECK_THROWS_AS(xsimd::detail::parallel_bands(4, 4, [&](std::size_t begin, std::size_t)
+                                                      {
+                            if (begin == failing)
+                                throw std::runtime_error("band");
+                            done[begin] = 1; }),
+                        std::runtime_error);
+        CHECK_EQ(done[0] + done[1] + done[2] + done[3], 3);
+    }
+}
+#endif
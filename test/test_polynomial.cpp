@@ -0,0 +1,168 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_polynomial.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // alternating and decaying, so that no term dominates on [-1, 1]
+    template <class T>
+    std::vector<T> make_coeffs(std::size_t n, std::size_t seed)
+    {
+        std::vector<T> coeffs(n);
+        for (std::size_t i = 0; i < n; ++i)
+            coeffs[i] = T(((i + seed) % 3 == 0 ? -1. : 1.) * (1. + double((i * 7 + seed) % 5)) / double(i + 1));
+        return coeffs;
+    }
+
+    template <class T>
+    std::vector<T> make_arguments(std::size_t count)
+    {
+        std::vector<T> x(count);
+        for (std::size_t i = 0; i < count; ++i)
+            x[i] = T(-1 + 2 * double(i) / double(count - 1));
+        return x;
+    }
+
+    // value, and sum of the magnitudes of the terms to scale the tolerance
+    struct reference_value
+    {
+        long double value;
+        long double magnitude;
+    };
+
+    template <class T>
+    reference_value reference_poly(std::vector<T> const& coeffs, T x)
+    {
+        reference_value res { 0, 0 };
+        for (std::size_t i = coeffs.size(); i > 0; --i)
+        {
+            res.value = res.value * x + coeffs[i - 1];
+            res.magnitude = res.magnitude * std::fabs(x) + std::fabs(coeffs[i - 1]);
+        }
+        return res;
+    }
+
+    template <class T>
+    reference_value reference_cheb(std::vector<T> const& coeffs, T x)
+    {
+        reference_value res { 0, 0 };
+        long double t0 = 1, t1 = x;
+        for (std::size_t k = 0; k < coeffs.size(); ++k)
+        {
+            res.value += coeffs[k] * t0;
+            res.magnitude += std::fabs(coeffs[k]);
+            long double const t2 = 2 * (long double)x * t1 - t0;
+            t0 = t1;
+            t1 = t2;
+        }
+        return res;
+    }
+
+    template <class T>
+    bool close(T actual, reference_value const& expected, double ulps)
+    {
+        double const eps = std::numeric_limits<T>::epsilon();
+        return std::fabs((long double)actual - expected.value) <= ulps * eps * expected.magnitude + std::numeric_limits<T>::min();
+    }
+}
+
+template <class B>
+struct polynomial_test
+{
+    using batch_type = B;
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    static void check_polynomials(std::size_t n)
+    {
+        auto const p = make_coeffs<value_type>(n, 0);
+        auto const q = make_coeffs<value_type>(n / 2 + 1, 1);
+        auto const x = make_arguments<value_type>(5 * size + 3);
+        double const ulps = 4. * double(n + 1);
+
+        for (std::size_t i = 0; i + size <= x.size(); i += size)
+        {
+            auto const b = batch_type::load_unaligned(x.data() + i);
+            auto const horner = xsimd::polyval_horner(b, p.data(), n);
+            auto const estrin = xsimd::polyval_estrin(b, p.data(), n);
+            auto const chosen = xsimd::polyval(b, p.data(), n);
+            CHECK_BATCH_EQ(chosen, n > xsimd::polyval_estrin_degree ? estrin : horner);
+            auto const rational = xsimd::ratval(b, p.data(), n, q.data(), q.size());
+            CHECK_BATCH_EQ(rational, chosen / xsimd::polyval(b, q.data(), q.size()));
+            auto const cheb = xsimd::chebval(b, p.data(), n);
+            for (std::size_t j = 0; j < size; ++j)
+            {
+                INFO("x = ", x[i + j]);
+                auto const expected = reference_poly(p, x[i + j]);
+                CHECK(close(horner.get(j), expected, ulps));
+                CHECK(close(estrin.get(j), expected, ulps));
+                // Clenshaw's error grows with the square of the degree
+                CHECK(close(cheb.get(j), reference_cheb(p, x[i + j]), ulps * double(n + 1)));
+            }
+        }
+
+        // the array forms, the tail included, compute as the batch ones
+        for (std::size_t count : { std::size_t(0), std::size_t(1), size - 1, size + 1, x.size() })
+        {
+            INFO("count = ", count);
+            std::vector<value_type> poly(count + 1, value_type(42)), rational(count + 1, value_type(42)), cheb(count + 1, value_type(42));
+            xsimd::polyval<arch_type>(p.data(), n, x.data(), count, poly.data());
+            xsimd::ratval<arch_type>(p.data(), n, q.data(), q.size(), x.data(), count, rational.data());
+            xsimd::chebval<arch_type>(p.data(), n, x.data(), count, cheb.data());
+            CHECK_EQ(poly[count], value_type(42));
+            CHECK_EQ(rational[count], value_type(42));
+            CHECK_EQ(cheb[count], value_type(42));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                batch_type const b(x[i]);
+                CHECK_EQ(poly[i], xsimd::polyval(b, p.data(), n).get(0));
+                CHECK_EQ(rational[i], xsimd::ratval(b, p.data(), n, q.data(), q.size()).get(0));
+                CHECK_EQ(cheb[i], xsimd::chebval(b, p.data(), n).get(0));
+            }
+        }
+    }
+
+    void test_polynomials() const
+    {
+        // Horner's rule, then Estrin's scheme over one to five blocks
+        for (std::size_t n = 0; n <= 40; ++n)
+        {
+            INFO("n = ", n);
+            check_polynomials(n);
+        }
+
+        // T_2(x) = 2 x^2 - 1 and T_3(x) = 4 x^3 - 3 x, exactly at 1/2
+        value_type const t2[] = { 0, 0, 1 }, t3[] = { 0, 0, 0, 1 };
+        CHECK_BATCH_EQ(xsimd::chebval(batch_type(value_type(0.5)), t2, 3), batch_type(value_type(-0.5)));
+        CHECK_BATCH_EQ(xsimd::chebval(batch_type(value_type(0.5)), t3, 4), batch_type(value_type(-1)));
+        value_type const one[] = { 1 }, two[] = { 1, 1 };
+        CHECK_BATCH_EQ(xsimd::ratval(batch_type(value_type(3)), two, 2, one, 1), batch_type(value_type(4)));
+        CHECK(xsimd::all(xsimd::isinf(xsimd::ratval(batch_type(value_type(-1)), one, 1, two, 2))));
+    }
+};
+
+TEST_CASE_TEMPLATE("[polynomials]", T, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { polynomial_test<decltype(b)>().test_polynomials(); });
+}
+#endif
@@ -0,0 +1,206 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_quantize.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // covers several full blocks and every tail length of the widest one
+    std::size_t const lengths[] = { 0, 1, 7, 63, 64, 65, 128, 255, 256, 257, 1000 };
+
+    // values around the range, with exact ties and saturating outliers
+    std::vector<float> make_values(std::size_t n, float scale)
+    {
+        std::vector<float> res(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            float const q = float(int(i * 37 % 301) - 150) * 0.5f;
+            res[i] = i % 11 == 0 ? q * 1e3f : q * scale;
+        }
+        return res;
+    }
+
+    // written independently of the kernels: round half to even by hand
+    int round_half_even(double v)
+    {
+        double const f = std::floor(v);
+        double const d = v - f;
+        long r = long(f);
+        if (d > 0.5 || (d == 0.5 && r % 2 != 0))
+            ++r;
+        return int(r);
+    }
+
+    int reference_quantize(float x, float scale, int zero_point, int lo, int hi)
+    {
+        float const v = x * (1.f / scale);
+        int const q = round_half_even(double(std::min(std::max(v, -1e6f), 1e6f))) + zero_point;
+        return std::min(std::max(q, lo), hi);
+    }
+
+    template <class T>
+    std::vector<T> reference_int4(std::vector<uint8_t> const& packed, std::size_t n)
+    {
+        std::vector<T> res(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            int const nibble = (packed[i / 2] >> (4 * (i % 2))) & 0x0F;
+            res[i] = static_cast<T>(std::is_signed_v<T> && nibble >= 8 ? nibble - 16 : nibble);
+        }
+        return res;
+    }
+}
+
+TEST_CASE_TEMPLATE("[quantize]", T, int8_t, uint8_t)
+{
+    int const lo = std::numeric_limits<T>::min(), hi = std::numeric_limits<T>::max();
+    for (std::size_t n : lengths)
+        for (T zero_point : { T(0), T(std::is_signed_v<T> ? -5 : 128) })
+        {
+            INFO("n = ", n, ", zero point = ", int(zero_point));
+            float const scale = 0.25f;
+            auto const src = make_values(n, scale);
+            std::vector<T> q(n + 1, T(42));
+            xsimd::quantize(src.data(), q.data(), n, scale, zero_point);
+            for (std::size_t i = 0; i < n; ++i)
+                CHECK_EQ(int(q[i]), reference_quantize(src[i], scale, zero_point, lo, hi));
+            CHECK_EQ(q[n], T(42));
+
+            std::vector<float> back(n);
+            xsimd::dequantize(q.data(), back.data(), n, scale, zero_point);
+            for (std::size_t i = 0; i < n; ++i)
+                CHECK_EQ(back[i], float(int(q[i]) - int(zero_point)) * scale);
+        }
+}
+
+TEST_CASE("[quantize integer zero point]")
+{
+    // a plain int zero point selects the single scale overloads, not the
+    // per channel ones, whatever the type of dst
+    std::size_t const n = 40;
+    auto const src = make_values(n, 0.05f);
+    int8_t dst[n];
+    xsimd::quantize(src.data(), dst, n, 0.05f, 0);
+    for (std::size_t i = 0; i < n; ++i)
+        CHECK_EQ(int(dst[i]), reference_quantize(src[i], 0.05f, 0, -128, 127));
+    uint8_t udst[n];
+    xsimd::quantize(src.data(), udst, n, 0.05f, 128);
+    for (std::size_t i = 0; i < n; ++i)
+        CHECK_EQ(int(udst[i]), reference_quantize(src[i], 0.05f, 128, 0, 255));
+    float back[n];
+    xsimd::dequantize(udst, back, n, 0.05f, 128);
+    for (std::size_t i = 0; i < n; ++i)
+        CHECK_EQ(back[i], float(int(udst[i]) - 128) * 0.05f);
+
+    uint8_t packed[n / 2];
+    xsimd::quantize_int4(src.data(), packed, n, 0.05f, 1);
+    auto const q = reference_int4<int8_t>(std::vector<uint8_t>(packed, packed + n / 2), n);
+    for (std::size_t i = 0; i < n; ++i)
+        CHECK_EQ(int(q[i]), reference_quantize(src[i], 0.05f, 1, -8, 7));
+    xsimd::dequantize_int4(packed, back, n, 0.05f, 1);
+    for (std::size_t i = 0; i < n; ++i)
+        CHECK_EQ(back[i], float(int(q[i]) - 1) * 0.05f);
+}
+
+TEST_CASE_TEMPLATE("[quantize per channel]", T, int8_t, uint8_t)
+{
+    int const lo = std::numeric_limits<T>::min(), hi = std::numeric_limits<T>::max();
+    std::size_t const channels = 5;
+    for (std::size_t channel_size : { 1, 33, 130 })
+    {
+        INFO("channel size = ", channel_size);
+        std::vector<float> const scales = { 0.5f, 0.125f, 1.f, 3.f, 0.01f };
+        std::vector<T> const zero_points = { T(0), T(3), T(10), T(1), T(7) };
+        auto const src = make_values(channels * channel_size, 0.5f);
+        std::vector<T> q(src.size()), q_symmetric(src.size());
+        xsimd::quantize_per_channel(src.data(), q.data(), channels, channel_size, scales.data(), zero_points.data());
+        xsimd::quantize_per_channel(src.data(), q_symmetric.data(), channels, channel_size, scales.data());
+        std::vector<float> back(src.size());
+        xsimd::dequantize_per_channel(q.data(), back.data(), channels, channel_size, scales.data(), zero_points.data());
+        for (std::size_t c = 0; c < channels; ++c)
+            for (std::size_t i = 0; i < channel_size; ++i)
+            {
+                std::size_t const k = c * channel_size + i;
+                CHECK_EQ(int(q[k]), reference_quantize(src[k], scales[c], zero_points[c], lo, hi));
+                CHECK_EQ(int(q_symmetric[k]), reference_quantize(src[k], scales[c], 0, lo, hi));
+                CHECK_EQ(back[k], float(int(q[k]) - int(zero_points[c])) * scales[c]);
+            }
+    }
+}
+
+TEST_CASE_TEMPLATE("[int4]", T, int8_t, uint8_t)
+{
+    int const lo = std::is_signed_v<T> ? -8 : 0, hi = std::is_signed_v<T> ? 7 : 15;
+    for (std::size_t n : lengths)
+    {
+        INFO("n = ", n);
+        std::vector<T> values(n);
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = static_cast<T>(lo + int(i * 7 % 16));
+        std::vector<uint8_t> packed((n + 1) / 2 + 1, 0xAB);
+        xsimd::pack_int4(values.data(), packed.data(), n);
+        CHECK_EQ(packed[(n + 1) / 2], 0xAB);
+        if (n % 2 == 1)
+            CHECK_EQ(packed[n / 2] >> 4, 0);
+        CHECK_EQ(reference_int4<T>(packed, n), values);
+
+        std::vector<T> unpacked(n);
+        xsimd::unpack_int4(packed.data(), unpacked.data(), n);
+        CHECK_EQ(unpacked, values);
+
+        float const scale = 0.5f;
+        T const zero_point = T(std::is_signed_v<T> ? 1 : 8);
+        auto const src = make_values(n, scale);
+        std::fill(packed.begin(), packed.end(), uint8_t(0xAB));
+        xsimd::quantize_int4<xsimd::default_arch, T>(src.data(), packed.data(), n, scale, zero_point);
+        CHECK_EQ(packed[(n + 1) / 2], 0xAB);
+        auto const q = reference_int4<T>(packed, n);
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK_EQ(int(q[i]), reference_quantize(src[i], scale, zero_point, lo, hi));
+
+        std::vector<float> back(n);
+        xsimd::dequantize_int4<xsimd::default_arch, T>(packed.data(), back.data(), n, scale, zero_point);
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK_EQ(back[i], float(int(q[i]) - int(zero_point)) * scale);
+    }
+
+    // per channel: odd channel sizes start each channel on a byte boundary
+    std::size_t const channels = 3, channel_size = 71, channel_bytes = 36;
+    std::vector<float> const scales = { 0.5f, 2.f, 0.1f };
+    std::vector<T> const zero_points = { T(0), T(2), T(3) };
+    auto const src = make_values(channels * channel_size, 1.f);
+    std::vector<uint8_t> packed(channels * channel_bytes);
+    xsimd::quantize_int4_per_channel(src.data(), packed.data(), channels, channel_size, scales.data(), zero_points.data());
+    std::vector<float> back(src.size());
+    xsimd::dequantize_int4_per_channel(packed.data(), back.data(), channels, channel_size, scales.data(), zero_points.data());
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+        auto const q = reference_int4<T>(std::vector<uint8_t>(packed.begin() + c * channel_bytes, packed.begin() + (c + 1) * channel_bytes), channel_size);
+        for (std::size_t i = 0; i < channel_size; ++i)
+        {
+            std::size_t const k = c * channel_size + i;
+            CHECK_EQ(int(q[i]), reference_quantize(src[k], scales[c], zero_points[c], lo, hi));
+            CHECK_EQ(back[k], float(int(q[i]) - int(zero_points[c])) * scales[c]);
+        }
+    }
+}
+#endif
@@ -0,0 +1,121 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_search.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    // even numbers with runs of repeats, so that odd keys fall between
+    // elements and even ones on them
+    template <class T>
+    std::vector<T> make_sorted(std::size_t n)
+    {
+        std::vector<T> sorted(n);
+        for (std::size_t i = 0; i < n; ++i)
+            sorted[i] = static_cast<T>(2 * (i - i % 3 / 2) + 10);
+        return sorted;
+    }
+
+    template <class T>
+    std::vector<T> make_keys(std::size_t n)
+    {
+        auto keys = detail::make_hashed_values<T>(2 * n + 25, 2 * n + 25);
+        keys.push_back(std::numeric_limits<T>::lowest());
+        keys.push_back(std::numeric_limits<T>::max());
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            keys.push_back(std::numeric_limits<T>::quiet_NaN());
+            keys.push_back(std::numeric_limits<T>::infinity());
+            keys.push_back(-std::numeric_limits<T>::infinity());
+            keys.push_back(T(10.5));
+        }
+        return keys;
+    }
+}
+
+template <class B>
+struct search_test
+{
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    static void check_bounds(std::vector<value_type> const& sorted, std::vector<value_type> const& keys)
+    {
+        std::vector<uint32_t> lower(keys.size() + 1, 0xFFFFFFFFu), upper(keys.size() + 1, 0xFFFFFFFFu);
+        xsimd::lower_bounds<arch_type>(sorted.data(), sorted.size(), keys.data(), keys.size(), lower.data());
+        xsimd::upper_bounds<arch_type>(sorted.data(), sorted.size(), keys.data(), keys.size(), upper.data());
+        CHECK_EQ(lower.back(), 0xFFFFFFFFu);
+        CHECK_EQ(upper.back(), 0xFFFFFFFFu);
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            INFO("key = ", keys[i]);
+            CHECK_EQ(lower[i], uint32_t(std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin()));
+            CHECK_EQ(upper[i], uint32_t(std::upper_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin()));
+        }
+    }
+
+    static void check_btree(std::vector<value_type> const& sorted, std::vector<value_type> const& keys)
+    {
+        xsimd::btree_index<value_type, arch_type> const index(sorted.data(), sorted.size());
+        CHECK_EQ(index.size(), sorted.size());
+        std::vector<uint32_t> positions(keys.size());
+        index.lower_bounds(keys.data(), keys.size(), positions.data());
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            INFO("key = ", keys[i]);
+            auto const expected = std::size_t(std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin());
+            CHECK_EQ(index.lower_bound(keys[i]), expected);
+            CHECK_EQ(positions[i], uint32_t(expected));
+            bool const found = expected < sorted.size() && sorted[expected] == keys[i];
+            CHECK_EQ(index.find(keys[i]), found ? expected : sorted.size());
+        }
+    }
+
+    void test_search() const
+    {
+        // linear, in-register and gathered lookups; trees of one to four levels
+        for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(3), std::size_t(4), std::size_t(5),
+                               size, size + 1, std::size_t(13), std::size_t(100), std::size_t(289), std::size_t(1000), std::size_t(5000) })
+        {
+            INFO("n = ", n);
+            auto const sorted = make_sorted<value_type>(n);
+            auto const keys = make_keys<value_type>(n);
+            check_bounds(sorted, keys);
+            check_btree(sorted, keys);
+        }
+
+        // the largest value, also used to pad the tree
+        std::vector<value_type> top(40, value_type(1));
+        std::fill(top.begin() + 30, top.end(), std::numeric_limits<value_type>::max());
+        if constexpr (std::numeric_limits<value_type>::has_infinity)
+            top.back() = std::numeric_limits<value_type>::infinity();
+        check_bounds(top, make_keys<value_type>(3));
+        check_btree(top, make_keys<value_type>(3));
+    }
+};
+
+TEST_CASE_TEMPLATE("[search]", T, float, double, int32_t, uint32_t, int64_t)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { search_test<decltype(b)>().test_search(); });
+}
+#endif
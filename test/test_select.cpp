@@ -74,6 +74,27 @@ struct select_test
             CHECK_BATCH_EQ(ref_b, out_b);
         }
     }
+
+    // the complement of a comparison as the condition, a blend on which
+    // some compilers fold wrongly
+    void test_select_negated()
+    {
+        for (size_t i = 0; i < nb_input; ++i)
+        {
+            expected[i] = !(lhs_input[i] < rhs_input[i]) ? lhs_input[i] : rhs_input[i];
+        }
+
+        for (size_t i = 0; i < nb_input; i += size)
+        {
+            batch_type lhs_in, rhs_in, out, ref;
+            detail::load_batch(lhs_in, lhs_input, i);
+            detail::load_batch(rhs_in, rhs_input, i);
+            out = xsimd::select(!(lhs_in < rhs_in), lhs_in, rhs_in);
+            detail::load_batch(ref, expected, i);
+            CHECK_BATCH_EQ(ref, out);
+        }
+    }
+
     struct pattern
     {
         static constexpr bool get(std::size_t i, std::size_t) { return i % 2; }
@@ -115,4 +136,36 @@ TEST_CASE_TEMPLATE("[select]", B, BATCH_TYPES)
     SUBCASE("select_dynamic") { Test->test_select_dynamic(); }
     SUBCASE("select_static") { Test->test_select_static(); }
 }
+
+#if XSIMD_WITH_AVX512BW
+// set in the upper half of the lanes too, which a truncated kmask would drop
+struct select_high_lanes_pattern
+{
+    static constexpr bool get(std::size_t i, std::size_t n) { return i % 3 == 0 || i >= n - 5; }
+};
+
+TEST_CASE_TEMPLATE("[select avx512bw constant mask]", T, int8_t, uint8_t, int16_t, uint16_t)
+{
+    using batch_type = xsimd::batch<T, xsimd::avx512bw>;
+    constexpr std::size_t size = batch_type::size;
+    constexpr auto mask = xsimd::make_batch_bool_constant<T, select_high_lanes_pattern, xsimd::avx512bw>();
+    std::array<T, size> lhs, rhs, expected;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        lhs[i] = static_cast<T>(i + 1);
+        rhs[i] = static_cast<T>(100 - i);
+        expected[i] = select_high_lanes_pattern::get(i, size) ? lhs[i] : rhs[i];
+    }
+    auto const res = xsimd::select(mask, batch_type::load_unaligned(lhs.data()), batch_type::load_unaligned(rhs.data()));
+    CHECK_BATCH_EQ(res, expected);
+}
+#endif
+
+TEST_CASE_TEMPLATE("[select negated comparison]", T, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           {
+        std::unique_ptr<select_test<decltype(b)>> Test { new select_test<decltype(b)> };
+        Test->test_select_negated(); });
+}
 #endif
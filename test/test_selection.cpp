@@ -0,0 +1,150 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/algorithms/xsimd_selection.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace
+{
+    template <class T>
+    bool is_nan(T x)
+    {
+        return x != x;
+    }
+
+    template <class T>
+    std::size_t reference_arg(std::vector<T> const& values, bool largest, xsimd::nan_policy policy)
+    {
+        std::size_t best = values.size();
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            if (is_nan(values[i]))
+            {
+                if (policy == xsimd::nan_policy::propagate)
+                    return i;
+                continue;
+            }
+            if (best == values.size() || (largest ? values[i] > values[best] : values[i] < values[best]))
+                best = i;
+        }
+        return best;
+    }
+
+    template <class T>
+    std::vector<uint32_t> reference_top_k(std::vector<T> const& values, std::size_t k, xsimd::nan_policy policy)
+    {
+        std::vector<uint32_t> nans, numbers;
+        for (std::size_t i = 0; i < values.size(); ++i)
+            (is_nan(values[i]) ? nans : numbers).push_back(static_cast<uint32_t>(i));
+        std::stable_sort(numbers.begin(), numbers.end(), [&](uint32_t a, uint32_t b)
+                         { return values[a] > values[b]; });
+        std::vector<uint32_t> res;
+        if (policy == xsimd::nan_policy::propagate)
+            res = nans;
+        res.insert(res.end(), numbers.begin(), numbers.end());
+        res.resize(std::min(k, res.size()));
+        return res;
+    }
+}
+
+template <class B>
+struct selection_test
+{
+    using batch_type = B;
+    using value_type = typename B::value_type;
+    using arch_type = typename B::arch_type;
+    static constexpr std::size_t size = B::size;
+
+    static void check_selection(std::vector<value_type> const& values)
+    {
+        std::size_t const n = values.size();
+        for (auto policy : { xsimd::nan_policy::propagate, xsimd::nan_policy::omit })
+        {
+            INFO("n = ", n, ", propagate = ", policy == xsimd::nan_policy::propagate);
+            CHECK_EQ(xsimd::argmin<arch_type>(values.data(), n, policy), reference_arg(values, false, policy));
+            CHECK_EQ(xsimd::argmax<arch_type>(values.data(), n, policy), reference_arg(values, true, policy));
+            for (std::size_t k : { std::size_t(0), std::size_t(1), std::size_t(3), size, std::size_t(100), std::size_t(400) })
+            {
+                INFO("k = ", k);
+                auto const expected = reference_top_k(values, k, policy);
+                std::vector<uint32_t> indices(k + 1, 0xFFFFFFFFu);
+                REQUIRE_EQ(xsimd::top_k<arch_type>(values.data(), n, k, indices.data(), policy), expected.size());
+                CHECK_EQ(indices[expected.size()], 0xFFFFFFFFu);
+                indices.resize(expected.size());
+                CHECK(indices == expected);
+            }
+        }
+    }
+
+    // with ties, and long enough to wrap 8-bit batch counters
+    void test_selection() const
+    {
+        for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(5), size - 1, size, size + 1, std::size_t(100), std::size_t(1000), std::size_t(70000) })
+        {
+            auto values = detail::make_hashed_values<value_type>(n, 113, -50);
+            check_selection(values);
+            if (n > 40)
+            {
+                // extremes in the scalar tail and repeated across lanes
+                values[n - 1] = std::numeric_limits<value_type>::max();
+                values[n / 2] = std::numeric_limits<value_type>::max();
+                values[7] = std::numeric_limits<value_type>::lowest();
+                check_selection(values);
+            }
+        }
+
+        // all equal to the initial value of the lanes
+        check_selection(std::vector<value_type>(37, std::numeric_limits<value_type>::lowest()));
+        check_selection(std::vector<value_type>(37, std::numeric_limits<value_type>::max()));
+    }
+
+    void test_nan() const
+    {
+        value_type const nan = std::numeric_limits<value_type>::quiet_NaN();
+        value_type const inf = std::numeric_limits<value_type>::infinity();
+        auto values = detail::make_hashed_values<value_type>(300, 113, -50);
+        values[250] = nan;
+        values[120] = nan;
+        values[299] = nan;
+        check_selection(values);
+        values[3] = inf;
+        values[4] = -inf;
+        check_selection(values);
+        check_selection(std::vector<value_type>(40, nan));
+        check_selection(std::vector<value_type>(40, -inf));
+        std::vector<value_type> mixed(40, nan);
+        mixed[21] = -inf;
+        mixed[33] = inf;
+        check_selection(mixed);
+    }
+};
+
+TEST_CASE_TEMPLATE("[selection]", T, int8_t, uint8_t, int16_t, int32_t, uint32_t, int64_t, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { selection_test<decltype(b)>().test_selection(); });
+}
+
+TEST_CASE_TEMPLATE("[selection nan]", T, float, double)
+{
+    for_each_arch_batch<T>([](auto b)
+                           { selection_test<decltype(b)>().test_nan(); });
+}
+#endif
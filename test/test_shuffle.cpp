@@ -101,13 +101,7 @@ struct zip_test : zip_base<typename B::value_type, B::size>
     }
 };
 
-#if !XSIMD_WITH_AVX512F || XSIMD_WITH_AVX512BW
-#define ZIP_BATCH_TYPES BATCH_TYPES
-#else
-#define ZIP_BATCH_TYPES xsimd::batch<float>, xsimd::batch<double>, xsimd::batch<int32_t>, xsimd::batch<int64_t>
-#endif
-
-TEST_CASE_TEMPLATE("[zip]", B, ZIP_BATCH_TYPES)
+TEST_CASE_TEMPLATE("[zip]", B, BATCH_TYPES)
 
 {
     zip_test<B> Test;
@@ -0,0 +1,135 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+ * Martin Renou                                                             *
+ * Copyright (c) QuantStack                                                 *
+ * Copyright (c) Serge Guelton                                              *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include "xsimd/xsimd.hpp"
+#ifndef XSIMD_NO_SUPPORTED_ARCHITECTURE
+
+#include "xsimd/memory/xsimd_soa_vector.hpp"
+
+#include <doctest/doctest.h>
+
+namespace
+{
+    struct particle
+    {
+        float x;
+        float y;
+        float mass;
+        int32_t id;
+    };
+}
+
+template <>
+struct xsimd::soa_layout<particle>
+{
+    using type = xsimd::soa_fields<&particle::x, &particle::y, &particle::mass, &particle::id>;
+};
+
+TEST_SUITE("soa_vector")
+{
+    using soa_type = xsimd::soa_vector<particle>;
+    constexpr std::size_t bsize = soa_type::batch_size;
+
+    TEST_CASE("layout")
+    {
+        soa_type v(2 * bsize + 1);
+        CHECK_EQ(v.size(), 2 * bsize + 1);
+        CHECK_EQ(v.padded_size(), 3 * bsize);
+        CHECK_EQ(v.batch_count(), std::size_t(3));
+        CHECK_UNARY(xsimd::is_aligned(v.data<0>()));
+        CHECK_UNARY(xsimd::is_aligned(v.data<3>()));
+        CHECK_EQ(v.data<2>()[3 * bsize - 1], 0.f);
+    }
+
+    TEST_CASE("push_back / get")
+    {
+        soa_type v;
+        for (int32_t i = 0; i < 3 * int32_t(bsize) + 2; ++i)
+        {
+            v.push_back({ float(i), float(2 * i), 1.f, i });
+        }
+        CHECK_EQ(v.size(), 3 * bsize + 2);
+        CHECK_EQ(v.batch_count(), std::size_t(4));
+        particle p = v[bsize + 1];
+        CHECK_EQ(p.x, float(bsize + 1));
+        CHECK_EQ(p.y, float(2 * (bsize + 1)));
+        CHECK_EQ(p.id, int32_t(bsize + 1));
+
+        v.set(0, { -1.f, -2.f, 3.f, 42 });
+        CHECK_EQ(v.get(0).id, 42);
+        CHECK_EQ(v.data<1>()[0], -2.f);
+    }
+
+    TEST_CASE("resize")
+    {
+        soa_type v(2 * bsize);
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            v.set(i, { 1.f, 2.f, 3.f, 4 });
+        }
+        // shrinking and growing back within the same padded size keeps
+        // the storage, whose former rows must not reappear
+        v.resize(bsize + 1);
+        CHECK_EQ(v.padded_size(), 2 * bsize);
+        CHECK_EQ(v.data<0>()[2 * bsize - 1], 0.f);
+        v.resize(2 * bsize);
+        for (std::size_t i = bsize + 1; i < 2 * bsize; ++i)
+        {
+            CHECK_EQ(v[i].y, 0.f);
+            CHECK_EQ(v[i].id, 0);
+        }
+        CHECK_EQ(v[bsize].x, 1.f);
+        v.resize(3 * bsize);
+        CHECK_EQ(v[3 * bsize - 1].mass, 0.f);
+    }
+
+    TEST_CASE("load_batch / store_batch")
+    {
+        soa_type v;
+        for (int32_t i = 0; i < 2 * int32_t(bsize); ++i)
+        {
+            v.push_back({ float(i), 1.f, 2.f, i });
+        }
+        auto [x, y, mass, id] = v.load_batch(1);
+        CHECK_EQ(x.get(0), float(bsize));
+        CHECK_EQ(id.get(bsize - 1), int32_t(2 * bsize - 1));
+        v.store_batch(1, std::make_tuple(x + y, y, mass * x, id + 1));
+        CHECK_EQ(v[bsize].x, float(bsize) + 1.f);
+        CHECK_EQ(v[bsize + 1].mass, 2.f * float(bsize + 1));
+        CHECK_EQ(v[2 * bsize - 1].id, int32_t(2 * bsize));
+        CHECK_EQ(v[0].x, 0.f);
+    }
+
+    TEST_CASE("tile iteration")
+    {
+        soa_type v(3 * bsize);
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            v.set(i, { float(i), 0.f, 1.f, 0 });
+        }
+        std::size_t count = 0;
+        for (auto it = v.tile_begin(); it != v.tile_end(); ++it, ++count)
+        {
+            auto tile = *it;
+            CHECK_EQ(tile.index(), count);
+            auto fields = tile.load();
+            std::get<1>(fields) = std::get<0>(fields) * std::get<2>(fields) + 1.f;
+            tile.store(fields);
+        }
+        CHECK_EQ(count, std::size_t(3));
+        CHECK_EQ(v.tile_end() - v.tile_begin(), 3);
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            CHECK_EQ(v[i].y, float(i) + 1.f);
+        }
+    }
+}
+#endif
@@ -16,6 +16,7 @@
 #include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -497,6 +498,71 @@ namespace detail
 
 #define BATCH_SWIZZLE_TYPES BATCH_FLOAT_TYPES, BATCH_COMPLEX_TYPES, BATCH_INT_TYPES
 
+/*******************************
+ * Algorithm testing utilities *
+ *******************************/
+
+/*
+ * Calls f(A {}) for each architecture A enabled in the build and available
+ * at run time, so that the algorithms are checked on the kernels of every
+ * instruction set they have one for, not only on the default architecture.
+ */
+template <class F>
+void for_each_arch(F&& f)
+{
+    xsimd::supported_architectures::for_each([&](auto arch)
+                                             {
+        using arch_type = decltype(arch);
+        if (arch_type::available())
+        {
+            INFO("arch: ", arch_type::name());
+            f(arch);
+        } });
+}
+
+/*
+ * Calls f(xsimd::batch<T, A> {}) for each architecture A of for_each_arch,
+ * to instantiate the xxx_test<B> fixtures of the algorithms.
+ */
+template <class T, class F>
+void for_each_arch_batch(F&& f)
+{
+    for_each_arch([&](auto arch)
+                  { f(xsimd::batch<T, decltype(arch)> {}); });
+}
+
+namespace detail
+{
+    /*
+     * n values (i * 7919) % modulus + offset: the multiplication by a prime
+     * visits the residues in an order that is neither sorted nor periodic in
+     * the batch size, so that repeats and extremes fall in every lane and in
+     * the scalar tails.
+     */
+    template <class T>
+    std::vector<T> make_hashed_values(std::size_t n, std::size_t modulus, long offset = 0)
+    {
+        std::vector<T> values(n);
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = static_cast<T>(static_cast<long>((i * 7919) % modulus) + offset);
+        return values;
+    }
+
+    // n xorshift words
+    inline std::vector<uint64_t> make_random_words(std::size_t n, uint64_t seed)
+    {
+        std::vector<uint64_t> words(n);
+        for (auto& word : words)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            word = seed;
+        }
+        return words;
+    }
+}
+
 /********************
  * conversion utils *
  ********************/